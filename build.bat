@@ -1,7 +1,7 @@
 @echo off
 echo [AURA] Proje Derleniyor...
 
-gcc -Wall -Wextra -std=c99 -Iinclude -Isrc/scanner -Isrc/value -o aura.exe src/main.c src/scanner/scanner.c src/value/value.c
+gcc -Wall -Wextra -std=c99 -pthread -D_POSIX_C_SOURCE=200809L -Iinclude -Isrc/scanner -Isrc/value -Isrc/string -o aura.exe src/main.c src/scanner/scanner.c src/value/value.c src/value/vec3.c src/string/aura_string.c src/string/intern.c src/memory/arena.c src/memory/slab.c src/memory/aligned.c src/memory/tensor_pool.c src/system/cpu.c src/system/thread_pool.c src/tensor/tensor_ops.c src/tensor/kernels_scalar.c src/tensor/kernels_sse2.c src/tensor/kernels_avx2.c src/tensor/kernels_avx512.c src/tensor/gemm.c src/tensor/tensor_view.c src/tensor/tensor_expr.c src/tensor/tensor_file.c src/tensor/tensor_dtype.c src/tensor/kernels_dtype.c src/tensor/tensor_reduce.c src/tensor/sparse_tensor.c src/tensor/vec3_array.c src/bigint/bigint.c src/bigint/limbs.c src/bigint/bigint_mul.c src/bigint/bigint_div.c src/bigint/bigint_radix.c -lm -lpthread
 
 if %errorlevel% neq 0 (
     echo [HATA] Derleme basarisiz oldu!
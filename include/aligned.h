@@ -0,0 +1,30 @@
+#ifndef minijs_aligned_h
+#define minijs_aligned_h
+
+/**
+ * @file aligned.h
+ * @brief Portable over-aligned heap allocation.
+ *
+ * C99 has no aligned allocator and `posix_memalign` is missing on Windows, so
+ * these helpers over-allocate with `malloc` and remember the original pointer
+ * just below the aligned block.
+ */
+
+#include "common.h"
+
+/**
+ * Allocates `size` bytes aligned to `alignment` (a power of two).
+ *
+ * @param size Number of bytes.
+ * @param alignment Required alignment in bytes.
+ * @return The memory (uninitialized), or NULL on overflow or allocation failure.
+ * @complexity O(1)
+ */
+void* auraAlignedAlloc(size_t size, size_t alignment);
+
+/**
+ * Releases memory obtained from `auraAlignedAlloc` (NULL is ignored).
+ */
+void auraAlignedFree(void* memory);
+
+#endif
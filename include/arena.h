@@ -0,0 +1,85 @@
+#ifndef minijs_arena_h
+#define minijs_arena_h
+
+/**
+ * @file arena.h
+ * @brief Region (arena) allocator for short-lived values.
+ *
+ * An arena hands out memory by bumping a pointer inside large chunks and frees
+ * everything it ever returned in a single `auraArenaReset`/`auraArenaDestroy`
+ * call. It is meant for a script run or a request: allocate freely, then drop
+ * the whole region at once instead of calling `freeValue` on every value.
+ *
+ * Values created in an arena (`createSTRINGInArena`, `createTENSORInArena`)
+ * carry the AURA_OBJ_ARENA flag; `freeValue` ignores them. They must not be
+ * used, or referenced from heap values, after their arena is reset.
+ *
+ * An arena is not synchronized: each thread or request should own its own.
+ */
+
+#include "common.h"
+
+/** Default chunk size used when `auraArenaCreate` is given 0. */
+#define AURA_ARENA_DEFAULT_CHUNK (64 * 1024)
+
+/** Alignment of every arena allocation (enough for any scalar type). */
+#define AURA_ARENA_ALIGNMENT 16
+
+typedef struct AuraArenaChunk AuraArenaChunk;
+
+/**
+ * @brief A bump-pointer region made of a list of chunks.
+ *
+ * `current` is the chunk being carved; older chunks are kept in the list until
+ * the arena is reset.
+ */
+typedef struct AuraArena {
+    AuraArenaChunk* current;
+    size_t chunkSize;
+    size_t bytesUsed;       // Sum of all requested sizes since the last reset.
+    size_t bytesReserved;   // Sum of all chunk capacities currently held.
+} AuraArena;
+
+/**
+ * Creates an empty arena.
+ *
+ * @param chunkSize Capacity of each chunk in bytes (0 for AURA_ARENA_DEFAULT_CHUNK).
+ * @return The new arena, or NULL on allocation failure.
+ * @complexity O(1)
+ */
+AuraArena* auraArenaCreate(size_t chunkSize);
+
+/**
+ * Allocates `size` bytes aligned to AURA_ARENA_ALIGNMENT.
+ *
+ * OPTIMIZATION: The common path is a bounds check and a pointer bump. Requests
+ * larger than a quarter of the chunk size get a dedicated chunk, so they
+ * neither waste the tail of the current chunk nor force chunks to grow.
+ *
+ * @param arena The arena.
+ * @param size Number of bytes (the memory is not zeroed).
+ * @return Pointer to the memory, or NULL on overflow or allocation failure.
+ * @complexity O(1)
+ */
+void* auraArenaAlloc(AuraArena* arena, size_t size);
+
+/**
+ * Releases every allocation of the arena at once.
+ *
+ * One chunk is kept for reuse, so an arena reset after each request reaches a
+ * steady state with no calls to `malloc` at all.
+ *
+ * @param arena The arena.
+ * @complexity O(chunks)
+ */
+void auraArenaReset(AuraArena* arena);
+
+/**
+ * Releases every allocation of the arena and the arena itself.
+ *
+ * @param arena The arena (may be NULL).
+ * @complexity O(chunks)
+ */
+void auraArenaDestroy(AuraArena* arena);
+
+#endif
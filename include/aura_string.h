@@ -0,0 +1,368 @@
+#ifndef minijs_aura_string_h
+#define minijs_aura_string_h
+
+/**
+ * @file aura_string.h
+ * @brief String representations of the Aura language.
+ *
+ * An AURA_STRING value uses one of these physical layouts:
+ * - Short strings (up to AURA_SSO_MAX bytes) are stored inline in the value
+ *   itself and never touch the heap.
+ * - Flat strings live in a single heap allocation holding the length, a
+ *   cached hash and the NUL-terminated characters.
+ * - Ropes are the result of a concatenation: a node that references both
+ *   operands and is only flattened into a flat string when its bytes are read.
+ * - Slices are the result of substring/trim/split: a window (offset, length)
+ *   into a flat parent string, sharing its bytes instead of copying them.
+ *
+ * Callers should read strings through `auraStringData`/`auraStringLength`
+ * (zero-copy, not NUL-terminated) or `auraStringChars` (NUL-terminated) instead
+ * of touching any layout directly.
+ *
+ * Heap strings are reference counted so ropes can share their operands:
+ * `freeValue` drops one reference and `auraStringRetain` adds one.
+ *
+ * Flat strings can additionally be interned: an interned string is the unique
+ * heap object for its contents, so two interned strings are equal exactly when
+ * they are the same pointer. The intern table only holds weak references; an
+ * entry disappears as soon as the last owner frees its string.
+ */
+
+#include "value.h"
+
+/**
+ * Concatenations shorter than this are copied into a flat string right away:
+ * below it a rope node costs more than the bytes it avoids copying.
+ */
+#define AURA_ROPE_MIN_LENGTH 32
+
+/**
+ * Substrings shorter than this are copied: below it a slice node costs about as
+ * much as the bytes it shares.
+ */
+#define AURA_SLICE_MIN_LENGTH 32
+
+/**
+ * Anti-pinning heuristic: a slice of at most AURA_SLICE_PIN_LIMIT bytes taken
+ * from a parent more than AURA_SLICE_PIN_RATIO times larger is copied out, so a
+ * short-lived huge buffer is not kept alive by a handful of tiny fragments.
+ * Longer fields keep sharing the parent's bytes.
+ */
+#define AURA_SLICE_PIN_LIMIT 64
+#define AURA_SLICE_PIN_RATIO 1024
+
+/**
+ * @brief Physical layout of a heap string.
+ */
+typedef enum {
+    AURA_STRING_FLAT,
+    AURA_STRING_ROPE,
+    AURA_STRING_SLICE
+} AuraStringKind;
+
+/**
+ * @brief Fields shared by every heap string layout.
+ *
+ * `hash` is only meaningful when `hashed` is set: always for flat strings,
+ * after flattening for ropes and after the first hash request for slices.
+ */
+typedef struct {
+    AuraObj obj;
+    uint8_t kind;       // AuraStringKind
+    bool interned;
+    bool hashed;
+    uint32_t refs;
+    uint32_t hash;
+    size_t length;
+} AuraStringHeader;
+
+/**
+ * @brief Flat heap representation of strings and symbols.
+ *
+ * Header, length, hash and characters share one allocation, so reading a long
+ * string costs a single pointer chase and its length is never recomputed.
+ */
+typedef struct {
+    AuraStringHeader header;
+    char chars[];
+} AuraString;
+
+/**
+ * @brief Lazy concatenation node (`left + right`).
+ *
+ * The node owns a reference to each operand until it is flattened. Flattening
+ * stores the result in `flat` and releases the operands, so later reads cost
+ * the same as reading a flat string.
+ */
+typedef struct {
+    AuraStringHeader header;
+    AuraValue left;
+    AuraValue right;
+    AuraString* flat;
+} AuraRope;
+
+/**
+ * @brief Zero-copy window into a flat parent string.
+ *
+ * `chars` points into `parent` and is not NUL-terminated unless the slice ends
+ * where the parent does. When a NUL-terminated view is requested anyway, the
+ * bytes are copied once into `flat` and the parent is released.
+ */
+typedef struct {
+    AuraStringHeader header;
+    AuraString* parent;
+    const char* chars;
+    AuraString* flat;
+} AuraSlice;
+
+/**
+ * @brief Occupancy snapshot of the global intern table.
+ */
+typedef struct {
+    size_t live;
+    size_t tombstones;
+    size_t capacity;
+} AuraInternStats;
+
+#define AURA_AS_STRING_HEADER(v) ((AuraStringHeader*)AURA_AS_OBJ(v))
+#define AURA_AS_STRING(v)      ((AuraString*)AURA_AS_OBJ(v))
+#define AURA_IS_STRING_KIND(v, k) (AURA_IS_STRING(v) && AURA_IS_OBJ(v) && \
+                                   AURA_AS_STRING_HEADER(v)->kind == (k))
+#define AURA_IS_ROPE(v)        AURA_IS_STRING_KIND(v, AURA_STRING_ROPE)
+#define AURA_IS_SLICE(v)       AURA_IS_STRING_KIND(v, AURA_STRING_SLICE)
+#define AURA_AS_CSTRING(v)     auraStringChars(&(v))
+
+/**
+ * Hashes a byte sequence (32-bit FNV-1a).
+ *
+ * @param chars The bytes to hash.
+ * @param length Number of bytes.
+ * @return The hash value.
+ * @complexity O(N)
+ */
+uint32_t auraHashChars(const char* chars, size_t length);
+
+/**
+ * Creates a string value from `length` bytes, choosing the inline or heap layout.
+ *
+ * @param chars The characters to copy (need not be NUL-terminated).
+ * @param length Number of bytes to copy.
+ * @return A AuraValue with type AURA_STRING, or AURA_NULL on allocation failure.
+ * @complexity O(N)
+ */
+AuraValue auraCopyString(const char* chars, size_t length);
+
+/**
+ * Same as `auraCopyString`, but a heap block is carved out of `arena`.
+ *
+ * Arena strings are never interned (`auraIntern` copies them to the heap) and
+ * releasing them is a no-op.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param chars The characters to copy.
+ * @param length Number of bytes to copy.
+ * @return A AuraValue with type AURA_STRING, or AURA_NULL on allocation failure.
+ * @complexity O(N)
+ */
+AuraValue auraCopyStringInArena(AuraArena* arena, const char* chars, size_t length);
+
+/**
+ * Adds a reference to a string value (no-op for inline strings).
+ *
+ * @param v A value of type AURA_STRING.
+ * @return `v`, now carrying one more owner.
+ * @complexity O(1)
+ */
+AuraValue auraStringRetain(AuraValue v);
+
+/**
+ * Releases one reference to a heap string (called by `freeValue`).
+ *
+ * The last release frees the string, evicting it from the intern table if
+ * needed and releasing the operands of a rope. Rope chains are walked with an
+ * explicit stack, so arbitrarily deep ropes cannot overflow the C stack.
+ *
+ * @param string The string object to release.
+ * @complexity O(1) unless this was the last reference, then O(nodes freed).
+ */
+void auraFreeString(AuraStringHeader* string);
+
+/**
+ * Concatenates two strings without copying their bytes.
+ *
+ * Neither operand is consumed. Short results are copied into a flat string;
+ * longer ones become a rope node referencing both operands, making repeated
+ * `s = s + piece` linear overall instead of quadratic.
+ *
+ * @param a Left string value.
+ * @param b Right string value.
+ * @return A new owned AURA_STRING value, or AURA_NULL on allocation failure.
+ * @complexity O(1) (O(AURA_ROPE_MIN_LENGTH) for short results).
+ */
+AuraValue auraConcat(AuraValue a, AuraValue b);
+
+/**
+ * Materializes the bytes of a rope (no-op for other layouts).
+ *
+ * Flattening is iterative and writes every byte exactly once.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return false if the flat buffer could not be allocated.
+ * @complexity O(N) the first time, O(1) afterwards.
+ */
+bool auraStringFlatten(AuraValue v);
+
+/**
+ * Returns a NUL-terminated view of the characters of a string value.
+ *
+ * For inline strings the pointer refers to the memory of `*v` itself, so it is
+ * only valid while that variable is alive and unmodified. Ropes are flattened
+ * on first access, and slices that do not end with their parent are copied
+ * once; prefer `auraStringData` when the length is known.
+ *
+ * @param v Pointer to a value of type AURA_STRING.
+ * @return Pointer to the characters.
+ * @complexity O(1), or O(N) for the first read of a rope or inner slice.
+ */
+const char* auraStringChars(const AuraValue* v);
+
+/**
+ * Returns the bytes of a string value without guaranteeing a NUL terminator.
+ *
+ * Use together with `auraStringLength`. Slices are never copied by this call.
+ * The same lifetime rule as `auraStringChars` applies to inline strings.
+ *
+ * @param v Pointer to a value of type AURA_STRING.
+ * @return Pointer to the first byte.
+ * @complexity O(1), or O(N) for the first read of a rope.
+ */
+const char* auraStringData(const AuraValue* v);
+
+/**
+ * Returns the length in bytes of a string value.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return The length, without the terminating NUL.
+ * @complexity O(1)
+ */
+size_t auraStringLength(AuraValue v);
+
+/**
+ * Returns the hash of a string value (cached for heap strings).
+ *
+ * @param v A value of type AURA_STRING.
+ * @return The FNV-1a hash of the characters.
+ * @complexity O(1) for flat strings, O(AURA_SSO_MAX) for inline ones, and
+ *             O(N) for the first hash of a rope (which flattens it) or slice.
+ */
+uint32_t auraStringHash(AuraValue v);
+
+/**
+ * Compares two string values by content.
+ *
+ * @param a First string value.
+ * @param b Second string value.
+ * @return true if both hold the same bytes.
+ * @complexity O(1) for interned strings or differing hashes, O(N) otherwise.
+ */
+bool auraStringsEqual(AuraValue a, AuraValue b);
+
+// --- Slicing ---
+
+/**
+ * Returns the characters in [start, end) of a string (JS `substring`).
+ *
+ * Indices are clamped to the string length and swapped if `start > end`. The
+ * result shares the bytes of the source when it is long enough (see
+ * AURA_SLICE_MIN_LENGTH and the anti-pinning heuristic), otherwise it is copied.
+ * The source is not consumed.
+ *
+ * @param s A value of type AURA_STRING.
+ * @param start Index of the first byte.
+ * @param end Index one past the last byte.
+ * @return A new owned AURA_STRING value, or AURA_NULL on allocation failure.
+ * @complexity O(1) for slices, O(end - start) for copies.
+ */
+AuraValue auraSubstring(AuraValue s, size_t start, size_t end);
+
+/**
+ * Removes leading and trailing ASCII whitespace (JS `trim`).
+ *
+ * @param s A value of type AURA_STRING.
+ * @return A new owned AURA_STRING value sharing the bytes of `s` when possible.
+ * @complexity O(W) where W is the amount of whitespace removed.
+ */
+AuraValue auraStringTrim(AuraValue s);
+
+/**
+ * Splits a string around every occurrence of a separator (JS `split`).
+ *
+ * An empty separator splits the string into single bytes. The parts share the
+ * bytes of `s` whenever they are long enough to be sliced.
+ *
+ * @param s A value of type AURA_STRING.
+ * @param separator The separator bytes.
+ * @param separatorLength Length of the separator.
+ * @param count Receives the number of parts.
+ * @return A malloc'ed array of owned parts (free each part, then the array),
+ *         or NULL on allocation failure.
+ * @complexity O(N * separatorLength) for the scan, O(parts) for the slices.
+ */
+AuraValue* auraStringSplit(AuraValue s, const char* separator, size_t separatorLength, size_t* count);
+
+// --- Interning ---
+
+/**
+ * Returns the interned string for the given characters, creating it if needed.
+ *
+ * Every call returns a new owned reference that must be released with `freeValue`.
+ * Strings short enough to be stored inline are already canonical and are
+ * returned inline without touching the table.
+ *
+ * @param chars The characters (need not be NUL-terminated).
+ * @param length Number of bytes.
+ * @return An interned AURA_STRING value, or AURA_NULL on allocation failure.
+ * @complexity O(N) to hash the input, O(1) expected table probing.
+ */
+AuraValue auraInternString(const char* chars, size_t length);
+
+/**
+ * Interns an existing string value, consuming it.
+ *
+ * If an equal string is already interned, `string` is released and the
+ * canonical one is returned instead. Ropes and slices are flattened first.
+ *
+ * @param string A string value owned by the caller.
+ * @return An owned reference to the canonical string.
+ * @complexity O(1) expected (the hash is cached).
+ */
+AuraValue auraIntern(AuraValue string);
+
+/**
+ * Checks whether a value is an interned heap string.
+ */
+bool auraIsInterned(AuraValue v);
+
+/**
+ * Drops every table entry whose string a tracing collector found unreachable.
+ *
+ * The strings themselves are not freed; this only keeps the table from
+ * resurrecting objects the collector is about to reclaim.
+ *
+ * @param isLive Callback returning true for strings that survive the collection.
+ * @complexity O(capacity)
+ */
+void auraInternSweep(bool (*isLive)(const AuraString* string));
+
+/**
+ * Returns the current occupancy of the intern table.
+ */
+AuraInternStats auraInternStats(void);
+
+/**
+ * Releases the storage of the intern table itself (strings are not freed, but
+ * are no longer marked interned).
+ */
+void auraFreeInternTable(void);
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef minijs_bigint_h
+#define minijs_bigint_h
+
+/**
+ * @file bigint.h
+ * @brief Arbitrary-precision integers (AURA_BIGINT).
+ *
+ * A BigInt is a sign and a magnitude of 64-bit limbs (see AuraBigInt), so it
+ * grows as needed instead of wrapping at 2^63. Products switch from the
+ * schoolbook method to Karatsuba and then Toom-3 as operands grow; division
+ * is Knuth's algorithm D. Decimal parsing and printing divide and conquer
+ * around powers of ten, so they stay subquadratic for long values.
+ *
+ * BigInts are immutable: every operation allocates its result, and the
+ * operands stay owned by the caller. Like the other value APIs, operations
+ * print a diagnostic and return AURA_NULL when an operand is not a BigInt,
+ * on division by zero, or when a result would exceed AURA_BIGINT_MAX_LIMBS.
+ */
+
+#include "value.h"
+
+/** Largest BigInt magnitude in limbs (2^30 bits, the limit of common JS engines). */
+#define AURA_BIGINT_MAX_LIMBS ((size_t)1 << 24)
+
+// --- Construction & Conversion ---
+
+/**
+ * Creates a BigInt from a 64-bit integer.
+ *
+ * @complexity O(1)
+ */
+AuraValue auraBigIntFromInt64(int64_t val);
+
+/**
+ * Creates a BigInt from a magnitude and a sign.
+ *
+ * @param limbs The magnitude, least significant limb first (leading zero
+ *              limbs are allowed).
+ * @param length Number of limbs.
+ * @param negative true for a negative value (ignored for zero).
+ * @return A new BigInt, or AURA_NULL if it would be too large.
+ * @complexity O(length)
+ */
+AuraValue auraBigIntFromLimbs(const uint64_t* limbs, size_t length, bool negative);
+
+/**
+ * Converts a BigInt to an int64 if it fits.
+ *
+ * @param v A BigInt value.
+ * @param out Receives the value.
+ * @return false if `v` is not a BigInt or is out of the int64 range.
+ * @complexity O(1)
+ */
+bool auraBigIntToInt64(AuraValue v, int64_t* out);
+
+/**
+ * Parses a decimal BigInt: an optional '-', at least one digit and an
+ * optional `n` suffix, so the text of a TOKEN_BIGINT can be passed as is.
+ *
+ * @param chars The text (not necessarily NUL-terminated).
+ * @param length Number of characters.
+ * @return A new BigInt, or AURA_NULL if the text is malformed or too long.
+ * @complexity O(M(n) log n) for n limbs, where M is the cost of a product.
+ */
+AuraValue auraBigIntFromString(const char* chars, size_t length);
+
+/**
+ * Formats a BigInt in decimal, without the `n` suffix.
+ *
+ * @param v A BigInt value.
+ * @return A new string, or AURA_NULL if `v` is not a BigInt.
+ * @complexity O(M(n) log n) for n limbs, where M is the cost of a product.
+ */
+AuraValue auraBigIntToString(AuraValue v);
+
+// --- Arithmetic ---
+
+/** Returns -a. @complexity O(n) */
+AuraValue auraBigIntNegate(AuraValue a);
+
+/** Returns a + b. @complexity O(n) */
+AuraValue auraBigIntAdd(AuraValue a, AuraValue b);
+
+/** Returns a - b. @complexity O(n) */
+AuraValue auraBigIntSub(AuraValue a, AuraValue b);
+
+/**
+ * Returns a * b.
+ *
+ * @complexity O(n^2) below AURA_BIGINT_KARATSUBA_THRESHOLD limbs, then
+ *             O(n^1.585) (Karatsuba) and O(n^1.465) (Toom-3).
+ */
+AuraValue auraBigIntMul(AuraValue a, AuraValue b);
+
+/**
+ * Returns a / b truncated toward zero, as the JS `/` operator on BigInts.
+ *
+ * @return The quotient, or AURA_NULL if b is zero.
+ * @complexity O(bn * (an - bn + 1))
+ */
+AuraValue auraBigIntDiv(AuraValue a, AuraValue b);
+
+/**
+ * Returns the remainder of a / b, with the sign of a (JS `%`).
+ *
+ * @return The remainder, or AURA_NULL if b is zero.
+ * @complexity O(bn * (an - bn + 1))
+ */
+AuraValue auraBigIntRem(AuraValue a, AuraValue b);
+
+// --- Comparison ---
+
+/**
+ * Compares two BigInts.
+ *
+ * @return -1, 0 or 1 as a is less than, equal to or greater than b.
+ * @complexity O(n)
+ */
+int auraBigIntCompare(AuraValue a, AuraValue b);
+
+#endif
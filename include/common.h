@@ -10,10 +10,60 @@
  */
 
 #define _CRT_SECURE_NO_WARNINGS
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L   // Also passed by the build, before any system header.
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
+/**
+ * Value representation switch.
+ *
+ * By default every `AuraValue` is NaN-boxed into a single 64-bit word. Building
+ * with `-DAURA_NO_NAN_BOXING` falls back to the classic tagged union, which is
+ * larger but much easier to inspect in a debugger.
+ */
+#ifndef AURA_NO_NAN_BOXING
+#define AURA_NAN_BOXING
+#endif
+
+/**
+ * Small-object allocator switch.
+ *
+ * By default heap objects of up to 512 bytes come from the size-class slab
+ * allocator (see slab.h). Building with `-DAURA_NO_SLAB` sends every object to
+ * `calloc`/`free`, which lets AddressSanitizer and Valgrind track each one.
+ */
+#ifndef AURA_NO_SLAB
+#define AURA_SLAB
+#endif
+
+/**
+ * Tensor storage pool switch.
+ *
+ * By default the storage of freed heap tensors is recycled by the tensor pool
+ * (see tensor_pool.h). Building with `-DAURA_NO_TENSOR_POOL` allocates and
+ * frees every tensor individually, for the same reasons as AURA_NO_SLAB.
+ */
+#ifndef AURA_NO_TENSOR_POOL
+#define AURA_TENSOR_POOL
+#endif
+
+/** Storage class for per-thread variables (C99 has no `_Thread_local`). */
+#if defined(_MSC_VER)
+#define AURA_THREAD_LOCAL __declspec(thread)
+#else
+#define AURA_THREAD_LOCAL __thread
+#endif
+
+/** Minimum alignment of a type, placed after `struct` (C99 has no `_Alignas`). */
+#if defined(_MSC_VER)
+#define AURA_ALIGNED(n) __declspec(align(n))
+#else
+#define AURA_ALIGNED(n) __attribute__((aligned(n)))
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef minijs_cpu_h
+#define minijs_cpu_h
+
+/**
+ * @file cpu.h
+ * @brief Runtime CPU feature detection used to pick vector kernels.
+ *
+ * Features are read once with CPUID (and XGETBV, so that AVX/AVX-512 are only
+ * reported when the OS saves the wide registers). Kernels compiled for several
+ * instruction sets choose among themselves at runtime with these flags; the
+ * binary itself is built for the baseline ISA.
+ *
+ * Setting the environment variable `AURA_SIMD` to `scalar`, `sse2`, `avx2` or
+ * `avx512` caps the level reported by `auraCpuSimdLevel` (useful to compare
+ * kernels or to reproduce a result on a smaller machine).
+ */
+
+#include "common.h"
+
+/**
+ * @brief Vector instruction set tiers, in increasing order of width.
+ */
+typedef enum {
+    AURA_SIMD_SCALAR,
+    AURA_SIMD_SSE2,
+    AURA_SIMD_AVX2,     // AVX2 + FMA
+    AURA_SIMD_AVX512,   // AVX-512 F + BW + DQ + VL
+    AURA_SIMD_LEVEL_COUNT
+} AuraSimdLevel;
+
+/**
+ * @brief Instruction set extensions usable on this machine.
+ */
+typedef struct {
+    bool sse2;
+    bool avx;
+    bool avx2;
+    bool fma;
+    bool f16c;
+    bool avx512f;
+    bool avx512bw;
+    bool avx512dq;
+    bool avx512vl;
+    bool avx512vnni;
+    bool avx512bf16;
+    bool avxvnni;
+} AuraCpuFeatures;
+
+/**
+ * Returns the features of the running CPU (detected on first call).
+ *
+ * @return Pointer to a process-wide, read-only structure.
+ * @complexity O(1) after the first call.
+ */
+const AuraCpuFeatures* auraCpuFeatures(void);
+
+/**
+ * Returns the widest supported SIMD tier, capped by `AURA_SIMD` if set.
+ *
+ * @return The tier kernels should use by default.
+ */
+AuraSimdLevel auraCpuSimdLevel(void);
+
+/**
+ * Returns the widest tier the hardware supports, ignoring `AURA_SIMD`.
+ */
+AuraSimdLevel auraCpuMaxSimdLevel(void);
+
+/**
+ * Returns a short lowercase name for a tier ("scalar", "sse2", "avx2", "avx512").
+ */
+const char* auraSimdLevelName(AuraSimdLevel level);
+
+#endif
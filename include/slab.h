@@ -0,0 +1,114 @@
+#ifndef minijs_slab_h
+#define minijs_slab_h
+
+/**
+ * @file slab.h
+ * @brief Thread-caching size-class allocator for small runtime objects.
+ *
+ * Requests of up to AURA_SLAB_MAX_SIZE bytes are rounded up to one of
+ * AURA_SLAB_CLASS_COUNT size classes. Every thread keeps a free list per class
+ * and allocates and frees without any locking; only when a list runs empty or
+ * grows too long does it exchange a batch of objects with the central pool of
+ * that class, which is protected by a mutex.
+ *
+ * Memory is carved out of large spans that are never returned to the system:
+ * the pool's footprint is the high-water mark of live small objects.
+ *
+ * Freed objects must be given back with their size class (or size); the
+ * allocator keeps no per-object header.
+ */
+
+#include "common.h"
+#include <stdint.h>
+
+/** Largest request served by the slab allocator. */
+#define AURA_SLAB_MAX_SIZE 512
+
+/** Number of size classes (16, 32, 48, 64, 96, 128, 192, 256, 384, 512 bytes). */
+#define AURA_SLAB_CLASS_COUNT 10
+
+/**
+ * @brief Occupancy of one size class, summed over all threads.
+ */
+typedef struct {
+    size_t objectSize;     // Bytes handed out per object of this class.
+    size_t liveObjects;    // Objects currently allocated and not yet freed.
+    size_t liveBytes;      // liveObjects * objectSize.
+} AuraSlabClassStats;
+
+/**
+ * Returns the size class serving `size` bytes.
+ *
+ * @param size The request size.
+ * @return The class index, or -1 if `size` exceeds AURA_SLAB_MAX_SIZE.
+ * @complexity O(1)
+ */
+int auraSlabClassOf(size_t size);
+
+/**
+ * Returns the object size of a size class.
+ *
+ * @param sizeClass A class index in [0, AURA_SLAB_CLASS_COUNT).
+ * @return The number of usable bytes of every object in the class.
+ */
+size_t auraSlabClassSize(int sizeClass);
+
+/**
+ * Allocates one object of a size class.
+ *
+ * OPTIMIZATION: The common path pops the head of a thread-local free list with
+ * no atomic operation; the central pool is only locked once per batch.
+ *
+ * @param sizeClass A class index in [0, AURA_SLAB_CLASS_COUNT).
+ * @return Uninitialized memory aligned to 16 bytes, or NULL on failure.
+ * @complexity O(1) amortized.
+ */
+void* auraSlabAllocClass(int sizeClass);
+
+/**
+ * Returns an object to its size class (the calling thread need not be the one
+ * that allocated it).
+ *
+ * @param memory An object obtained from `auraSlabAllocClass(sizeClass)`.
+ * @param sizeClass The class it was allocated from.
+ * @complexity O(1) amortized.
+ */
+void auraSlabFreeClass(void* memory, int sizeClass);
+
+/**
+ * Allocates `size` bytes (at most AURA_SLAB_MAX_SIZE) from the matching class.
+ *
+ * @param size The request size.
+ * @return Uninitialized memory, or NULL if `size` is too large or on failure.
+ */
+void* auraSlabAlloc(size_t size);
+
+/**
+ * Frees memory obtained from `auraSlabAlloc(size)`.
+ *
+ * @param memory The memory (may be NULL).
+ * @param size The size passed to `auraSlabAlloc`.
+ */
+void auraSlabFree(void* memory, size_t size);
+
+/**
+ * Returns every cached object of the calling thread to the central pools.
+ *
+ * Threads do this automatically when they exit.
+ *
+ * @complexity O(cached objects)
+ */
+void auraSlabFlushThreadCache(void);
+
+/**
+ * Reports the live objects and bytes of every size class.
+ *
+ * The counters are maintained per thread and summed here, so they are exact
+ * once the other threads are quiescent and approximate while they run.
+ *
+ * @param stats Receives AURA_SLAB_CLASS_COUNT entries.
+ * @complexity O(threads * classes)
+ */
+void auraSlabStats(AuraSlabClassStats stats[AURA_SLAB_CLASS_COUNT]);
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef minijs_sparse_tensor_h
+#define minijs_sparse_tensor_h
+
+/**
+ * @file sparse_tensor.h
+ * @brief Sparse float32 matrices (AURA_SPARSE_TENSOR) and their products.
+ *
+ * A sparse tensor stores only its non-zero elements in compressed sparse row
+ * form (see AuraSparseTensor), so a 100000 x 100000 matrix with a million
+ * non-zeros takes about 9 MB instead of 40 GB. Products with dense tensors
+ * return dense tensors. Like the dense operations, they print a diagnostic
+ * and return AURA_NULL on invalid operands, and split large inputs by rows
+ * over the thread pool.
+ *
+ * Sparse tensors are immutable once built; `freeValue` releases them.
+ */
+
+#include "value.h"
+
+// --- Construction ---
+
+/**
+ * Builds a sparse tensor from the non-zero elements of a dense one.
+ *
+ * @param t A 2-D float32 tensor or view. Elements equal to 0 (either sign)
+ *          are dropped; NaNs are kept.
+ * @return A new sparse tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraSparseFromDense(AuraValue t);
+
+/**
+ * Builds a sparse tensor from coordinate triplets (row[i], col[i], value[i]),
+ * in any order, without materializing the dense matrix. Values at the same
+ * position are added together.
+ *
+ * @param rows Number of rows (1..INT_MAX).
+ * @param cols Number of columns (1..INT_MAX).
+ * @param rowIndex Row of each triplet.
+ * @param colIndex Column of each triplet.
+ * @param values Value of each triplet.
+ * @param count Number of triplets.
+ * @return A new sparse tensor, or AURA_NULL if a coordinate is out of range.
+ * @complexity O(count + rows + cols)
+ */
+AuraValue auraSparseFromTriplets(size_t rows, size_t cols, const uint32_t* rowIndex, const uint32_t* colIndex,
+                                 const float* values, size_t count);
+
+/**
+ * Expands a sparse tensor into a new dense rows x cols tensor.
+ *
+ * @param s A sparse tensor.
+ * @return The dense tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraSparseToDense(AuraValue s);
+
+/**
+ * Adds the compressed sparse column form to a sparse tensor, if it does not
+ * have it yet, which doubles its memory. Dense x sparse products then read
+ * the matrix by column with gathered dot products instead of scattering into
+ * the result.
+ *
+ * @param s A sparse tensor.
+ * @return true on success.
+ * @complexity O(nnz + cols)
+ */
+bool auraSparseBuildCsc(AuraValue s);
+
+// --- Products ---
+
+/**
+ * Computes the sparse matrix-vector product `s x v` (SpMV).
+ *
+ * Each result element is a dot product of one row's non-zeros with the
+ * elements of `v` they select, fetched with vector gathers (AVX2/AVX-512).
+ *
+ * @param s A rows x cols sparse tensor.
+ * @param v A 1-D float32 tensor of `cols` elements.
+ * @return A new 1-D tensor of `rows` elements, or AURA_NULL on invalid operands.
+ * @complexity O(nnz + rows)
+ */
+AuraValue auraSparseMatvec(AuraValue s, AuraValue v);
+
+/**
+ * Computes the product `s x b` of a sparse and a dense matrix.
+ *
+ * Row i of the result accumulates the rows of `b` selected by the non-zeros
+ * of row i of `s`, scaled by them (vector multiply-adds over whole rows).
+ *
+ * @param s An m x k sparse tensor.
+ * @param b A k x n float32 tensor.
+ * @return A new m x n tensor, or AURA_NULL on invalid operands.
+ * @complexity O(nnz * n + m * n)
+ */
+AuraValue auraSparseMatmul(AuraValue s, AuraValue b);
+
+/**
+ * Computes the product `a x s` of a dense and a sparse matrix.
+ *
+ * With the CSC form (see auraSparseBuildCsc) each result element is a
+ * gathered dot product of a row of `a` with a column of `s`; without it the
+ * non-zeros of `s` are scattered into the result row by row.
+ *
+ * @param a An m x k float32 tensor.
+ * @param s A k x n sparse tensor.
+ * @return A new m x n tensor, or AURA_NULL on invalid operands.
+ * @complexity O(m * (nnz + n))
+ */
+AuraValue auraTensorMatmulSparse(AuraValue a, AuraValue s);
+
+#endif
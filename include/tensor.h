@@ -0,0 +1,374 @@
+#ifndef minijs_tensor_h
+#define minijs_tensor_h
+
+/**
+ * @file tensor.h
+ * @brief Numerical operations on AURA_TENSOR values.
+ *
+ * Every operation allocates and returns a new tensor (the operands are not
+ * consumed) or AURA_NULL after printing a diagnostic when the operands are not
+ * tensors or their shapes are incompatible.
+ *
+ * Tensors have up to AURA_TENSOR_MAX_DIMS dimensions. Elementwise operations
+ * broadcast like NumPy: shapes are aligned at their last dimension, and a
+ * dimension of size 1 (or a missing leading one) is repeated to match the
+ * other operands, so a [3] bias adds to every row of a [2, 4, 3] batch. The
+ * repetition is a stride of 0, never a copy.
+ *
+ * Operands may be views (transposes, slices) with arbitrary strides. Rows that
+ * are contiguous in memory are fed to the kernels directly; strided rows are
+ * gathered into a scratch row first. Results are always dense tensors.
+ *
+ * Operations compute in float32 and expect float32 operands. Tensors of the
+ * reduced-precision dtypes (see AuraDType) are converted with
+ * `auraTensorConvert` and multiplied with `auraTensorMatmulTransposed`.
+ *
+ * The inner loops run on vector kernels compiled for SSE2, AVX2 and AVX-512;
+ * the widest one the CPU supports is selected on first use (see cpu.h). A
+ * portable scalar implementation serves as the reference and as the fallback
+ * on other architectures.
+ */
+
+#include "value.h"
+#include "cpu.h"
+
+/**
+ * @brief Elementwise binary operations.
+ */
+typedef enum {
+    AURA_TENSOR_ADD,
+    AURA_TENSOR_SUB,
+    AURA_TENSOR_MUL,
+    AURA_TENSOR_DIV,
+    AURA_TENSOR_BINARY_OP_COUNT
+} AuraTensorBinaryOp;
+
+/**
+ * @brief Elementwise unary operations (activations).
+ */
+typedef enum {
+    AURA_TENSOR_RELU,
+    AURA_TENSOR_SIGMOID,
+    AURA_TENSOR_TANH,
+    AURA_TENSOR_EXP,
+    AURA_TENSOR_UNARY_OP_COUNT
+} AuraTensorUnaryOp;
+
+/**
+ * @brief Reductions.
+ */
+typedef enum {
+    AURA_TENSOR_SUM,
+    AURA_TENSOR_MEAN,
+    AURA_TENSOR_MAX,
+    AURA_TENSOR_ARGMAX,
+    AURA_TENSOR_NORM,            // Euclidean (L2) norm.
+    AURA_TENSOR_REDUCE_OP_COUNT
+} AuraTensorReduceOp;
+
+/** Axis argument that reduces every element of a tensor to one number. */
+#define AURA_TENSOR_ALL_AXES (-1)
+
+// --- Kernel selection ---
+
+/**
+ * Returns the SIMD tier used by the tensor kernels.
+ */
+AuraSimdLevel auraTensorSimdLevel(void);
+
+/**
+ * Forces the tensor kernels to a SIMD tier (clamped to what the CPU supports).
+ *
+ * Meant for tests and benchmarks; not synchronized with running operations.
+ *
+ * @param level The requested tier.
+ * @return The tier actually selected.
+ */
+AuraSimdLevel auraTensorSetSimdLevel(AuraSimdLevel level);
+
+// --- Views ---
+
+/**
+ * Adds a reference to a tensor value (`freeValue` drops one).
+ *
+ * @param v A value of type AURA_TENSOR.
+ * @return `v`.
+ * @complexity O(1)
+ */
+AuraValue auraTensorRetain(AuraValue v);
+
+/**
+ * Returns the transpose of a tensor as a view sharing its storage.
+ *
+ * Writes through either tensor are visible in the other. The storage stays
+ * alive until the original and every view of it have been freed.
+ *
+ * @param t The tensor.
+ * @return A view with the last two dimensions swapped (`t` itself, retained,
+ *         for 1-D tensors), or AURA_NULL if `t` is not a tensor.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorTranspose(AuraValue t);
+
+/**
+ * Returns indices [start, end) along one dimension of a tensor as a view
+ * sharing its storage.
+ *
+ * @param t The tensor.
+ * @param axis The dimension, 0 being the outermost.
+ * @param start First index.
+ * @param end One past the last index.
+ * @return The view, or AURA_NULL if the range is empty or out of bounds.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorSliceAxis(AuraValue t, int axis, size_t start, size_t end);
+
+/**
+ * Returns rows [rowStart, rowEnd) and columns [colStart, colEnd) of a tensor
+ * (of each matrix, for batched N-D tensors) as a view sharing its storage.
+ *
+ * @param t The tensor.
+ * @param rowStart First row.
+ * @param rowEnd One past the last row.
+ * @param colStart First column.
+ * @param colEnd One past the last column.
+ * @return The view, or AURA_NULL if the range is empty or out of bounds.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorSlice(AuraValue t, size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd);
+
+/**
+ * Returns a tensor with its own aligned, row-contiguous storage.
+ *
+ * @param t The tensor or view.
+ * @return `t` (retained) if it already is one, else a dense copy; AURA_NULL
+ *         if `t` is not a tensor.
+ * @complexity O(1) for dense tensors, O(rows * cols) for views.
+ */
+AuraValue auraTensorContiguous(AuraValue t);
+
+// --- Elementwise operations ---
+
+/**
+ * Applies a binary operation elementwise.
+ *
+ * Either operand may be a number instead of a tensor; it is then broadcast to
+ * every element (`tensor - 1`, `2 / tensor`, ...). Two tensors broadcast to
+ * their common shape.
+ *
+ * @param op The operation.
+ * @param a Left operand (tensor or number).
+ * @param b Right operand (tensor or number).
+ * @return A new tensor, or AURA_NULL on invalid operands.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorBinary(AuraTensorBinaryOp op, AuraValue a, AuraValue b);
+
+AuraValue auraTensorAdd(AuraValue a, AuraValue b);
+AuraValue auraTensorSub(AuraValue a, AuraValue b);
+AuraValue auraTensorMul(AuraValue a, AuraValue b);
+AuraValue auraTensorDiv(AuraValue a, AuraValue b);
+
+/**
+ * Computes `a * b + c` elementwise with a single rounding where FMA exists.
+ *
+ * @param a First factor (tensor).
+ * @param b Second factor (tensor broadcastable with `a`).
+ * @param c Addend (tensor broadcastable with `a` and `b`).
+ * @return A new tensor, or AURA_NULL on invalid operands.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorFma(AuraValue a, AuraValue b, AuraValue c);
+
+/**
+ * Applies an activation elementwise.
+ *
+ * The vector `exp` (also behind sigmoid and tanh) is a degree-6 polynomial
+ * accurate to a few ulp that saturates outside [-87, 88].
+ *
+ * @param op The activation.
+ * @param a The input tensor.
+ * @return A new tensor, or AURA_NULL if `a` is not a tensor.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorUnary(AuraTensorUnaryOp op, AuraValue a);
+
+AuraValue auraTensorRelu(AuraValue a);
+AuraValue auraTensorSigmoid(AuraValue a);
+AuraValue auraTensorTanh(AuraValue a);
+AuraValue auraTensorExp(AuraValue a);
+
+// --- Reductions ---
+
+/**
+ * Reduces a tensor along one axis, or entirely.
+ *
+ * Reducing the last axis gives one value per row, the one before it one
+ * value per column, and so on; the result has that dimension removed.
+ * Reducing every axis (AURA_TENSOR_ALL_AXES, or the only axis of a 1-D
+ * tensor) gives a number. ARGMAX gives the index of the first largest
+ * element: along an axis, as a float (exact below 2^24); over all axes, as
+ * the row-major position in the whole tensor. MAX and ARGMAX ignore NaNs.
+ *
+ * Sums (behind SUM, MEAN and NORM) accumulate in float32 with several
+ * independent vector accumulators and pairwise combination, so their rounding
+ * error grows with log(n) rather than n, and do not depend on the number of
+ * threads. Results may differ in the last bits between SIMD tiers.
+ *
+ * @param op The reduction.
+ * @param t A float32 tensor or view.
+ * @param axis The dimension to reduce (0 being the outermost) or
+ *             AURA_TENSOR_ALL_AXES.
+ * @return A new tensor or a number, or AURA_NULL on invalid arguments.
+ * @complexity O(elements)
+ */
+AuraValue auraTensorReduce(AuraTensorReduceOp op, AuraValue t, int axis);
+
+AuraValue auraTensorSum(AuraValue t, int axis);
+AuraValue auraTensorMean(AuraValue t, int axis);
+AuraValue auraTensorMax(AuraValue t, int axis);
+AuraValue auraTensorArgmax(AuraValue t, int axis);
+AuraValue auraTensorNorm(AuraValue t, int axis);
+
+// --- Lazy expressions ---
+
+/**
+ * @brief A recorded DAG of elementwise operations, evaluated in one pass.
+ *
+ * Chaining eager operations (`a * b + c`, then an activation) allocates a
+ * temporary tensor per step and streams each one through memory. An
+ * expression records the steps instead; evaluation walks the result once in
+ * cache-sized blocks and runs every step on a block while it is in L1, so
+ * only the inputs are read and only the result is written.
+ *
+ * Nodes are small integers local to their expression, and a node may feed
+ * any number of later ones. After an error an operation returns a negative
+ * node, and operations on a negative node return one too (without a second
+ * diagnostic), so a chain can be built and checked once at the end.
+ * Broadcasting follows the eager operations.
+ */
+typedef struct AuraTensorExpr AuraTensorExpr;
+typedef int AuraExprNode;
+
+/**
+ * Creates an empty expression.
+ *
+ * @return The expression, or NULL if out of memory.
+ */
+AuraTensorExpr* auraTensorExprCreate(void);
+
+/**
+ * Frees an expression and drops its references to its input tensors.
+ *
+ * @param expr The expression (NULL is ignored).
+ */
+void auraTensorExprFree(AuraTensorExpr* expr);
+
+/**
+ * Adds an input: a tensor (retained until the expression is freed) or a number.
+ *
+ * Tensors are read when the expression is evaluated, so an expression can be
+ * built once and evaluated again after its inputs have been updated in place.
+ *
+ * @param expr The expression.
+ * @param v A tensor or a number.
+ * @return The node, or a negative value if `v` is neither.
+ * @complexity O(1) amortized
+ */
+AuraExprNode auraTensorExprInput(AuraTensorExpr* expr, AuraValue v);
+
+/**
+ * Records `a op b`.
+ *
+ * @return The node, or a negative value on invalid or incompatible operands.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprBinary(AuraTensorExpr* expr, AuraTensorBinaryOp op, AuraExprNode a, AuraExprNode b);
+
+/**
+ * Records `a * b + c` (single rounding, like auraTensorFma).
+ *
+ * @return The node, or a negative value on invalid or incompatible operands.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprFma(AuraTensorExpr* expr, AuraExprNode a, AuraExprNode b, AuraExprNode c);
+
+/**
+ * Records an activation of `a`.
+ *
+ * @return The node, or a negative value on an invalid operand.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprUnary(AuraTensorExpr* expr, AuraTensorUnaryOp op, AuraExprNode a);
+
+/**
+ * Computes the value of a node as a new tensor.
+ *
+ * Only the nodes `root` depends on are computed, each once per block however
+ * many nodes use it. Results are bit-identical to the same chain of eager
+ * operations.
+ *
+ * @param expr The expression.
+ * @param root The node to materialize; it must depend on at least one tensor.
+ * @return A new tensor, or AURA_NULL on an invalid node.
+ * @complexity O(elements * nodes), in a single pass over memory.
+ */
+AuraValue auraTensorExprEvaluate(const AuraTensorExpr* expr, AuraExprNode root);
+
+// --- Linear algebra ---
+
+/**
+ * Computes the matrix product `a x b` (single precision).
+ *
+ * Runs a cache-blocked GEMM: operands are packed into panels sized for the
+ * cache hierarchy and multiplied by a register-tiled FMA microkernel of the
+ * active SIMD tier. Accumulation order differs from a naive triple loop, so
+ * results may differ in the last bits.
+ *
+ * @param a Left operand (2-D m x k tensor).
+ * @param b Right operand (2-D k x n tensor).
+ * @return A new m x n tensor, or AURA_NULL on invalid operands.
+ * @complexity O(m * n * k)
+ */
+AuraValue auraTensorMatmul(AuraValue a, AuraValue b);
+
+// --- Element types ---
+
+/**
+ * Converts a tensor to another element type.
+ *
+ * Float16 and bfloat16 round to nearest even. Int8 quantizes each row
+ * symmetrically: its largest magnitude maps to 127 and the row's scale is
+ * that magnitude / 127. Converting back to float32 is exact for float16 and
+ * bfloat16 and gives `scale * q` for int8. The conversion kernels use F16C
+ * and AVX2/AVX-512 and produce bit-identical results on every tier.
+ *
+ * @param t A tensor of any dtype; float32 views are accepted.
+ * @param dtype The element type of the result.
+ * @return `t` itself (retained) if it already has that type, else a new
+ *         dense tensor; AURA_NULL on invalid arguments.
+ * @complexity O(elements)
+ */
+AuraValue auraTensorConvert(AuraValue t, AuraDType dtype);
+
+/**
+ * Computes the matrix product `a x b^T` as float32.
+ *
+ * This is the layout of a linear layer with weights stored one output per
+ * row: both operands are read along their rows, where reduced-precision
+ * kernels can stream them. Int8 x int8 products accumulate exactly in int32
+ * (with AVX-512 VNNI or AVX-VNNI when present) and are then scaled by the two
+ * row scales; bfloat16 products use AVX-512 BF16 dot products when present,
+ * float16 products widen with F16C. Either operand may be float32 when the
+ * other is not: it is converted (for int8, quantized) to the other's type
+ * first. Float32 x float32 runs on the regular GEMM.
+ *
+ * @param a Left operand (2-D m x k tensor).
+ * @param b Right operand (2-D n x k tensor).
+ * @return A new m x n float32 tensor, or AURA_NULL on invalid operands
+ *         (including int8 depths k above 133144, which could overflow int32).
+ * @complexity O(m * n * k)
+ */
+AuraValue auraTensorMatmulTransposed(AuraValue a, AuraValue b);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef minijs_tensor_file_h
+#define minijs_tensor_file_h
+
+/**
+ * @file tensor_file.h
+ * @brief On-disk tensor format that loads by memory mapping, without copying.
+ *
+ * A file holds any number of named tensors of any dtype. Each payload is
+ * stored exactly as it lies in memory (rows padded to 64 bytes, then the
+ * per-row scales and sums of int8 tensors) at a 64-byte aligned offset, so
+ * opening a file only maps it and validates the directory; tensors point
+ * straight into the mapping and their pages are read by the first access.
+ * Startup cost is page faults, not parsing.
+ *
+ * Layout (little-endian):
+ *
+ *     offset 0    header     magic "AURATENS", version, byte-order mark,
+ *                            tensor count, total file size (64 bytes)
+ *     offset 64   directory  one 192-byte entry per tensor: name, dtype,
+ *                            rank, shape, payload offset and size
+ *     ...         payloads   each 64-byte aligned, zero bytes in between
+ *
+ * Loaded tensors are read-only (`readOnly` is set and writes fault); every
+ * operation still works on them, since operations allocate their results.
+ * The mapping stays alive until the file is closed and every tensor loaded
+ * from it (and every view of those) has been freed.
+ */
+
+#include "value.h"
+
+/** Longest tensor name, excluding the terminating NUL. */
+#define AURA_TENSOR_FILE_NAME_MAX 63
+
+typedef struct AuraTensorFile AuraTensorFile;
+
+/**
+ * Writes tensors to a file, replacing it.
+ *
+ * Views are written densely, in the layout of `auraTensorContiguous`; the
+ * directory records each tensor's AuraDType.
+ *
+ * @param path The file to create.
+ * @param names One name per tensor: unique, 1..AURA_TENSOR_FILE_NAME_MAX bytes.
+ * @param tensors The tensors.
+ * @param count Number of tensors.
+ * @return true on success; false, after printing a diagnostic, otherwise.
+ * @complexity O(total elements)
+ */
+bool auraTensorFileWrite(const char* path, const char* const* names, const AuraValue* tensors, size_t count);
+
+/**
+ * Maps a tensor file read-only and validates its directory.
+ *
+ * @param path The file.
+ * @return The open file, or NULL (after printing a diagnostic) if it cannot
+ *         be mapped or is malformed.
+ * @complexity O(tensors); payloads are not read.
+ */
+AuraTensorFile* auraTensorFileOpen(const char* path);
+
+/**
+ * Closes a file. Tensors loaded from it remain valid.
+ *
+ * @param file The file (NULL is ignored).
+ */
+void auraTensorFileClose(AuraTensorFile* file);
+
+/**
+ * Returns the number of tensors in a file.
+ */
+size_t auraTensorFileCount(const AuraTensorFile* file);
+
+/**
+ * Returns the name of the tensor at `index`, or NULL if out of range.
+ */
+const char* auraTensorFileName(const AuraTensorFile* file, size_t index);
+
+/**
+ * Returns a tensor of the file as a read-only value backed by the mapping.
+ *
+ * @param file The file.
+ * @param name The tensor's name.
+ * @return A new tensor value (freed with `freeValue`), or AURA_NULL if no
+ *         tensor has that name.
+ * @complexity O(tensors) for the lookup; no data is copied.
+ */
+AuraValue auraTensorFileLoad(AuraTensorFile* file, const char* name);
+
+#endif
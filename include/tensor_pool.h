@@ -0,0 +1,110 @@
+#ifndef minijs_tensor_pool_h
+#define minijs_tensor_pool_h
+
+/**
+ * @file tensor_pool.h
+ * @brief Recycling allocator for tensor storage.
+ *
+ * Numeric loops free and recreate tensors of the same shape every iteration;
+ * going through `calloc`/`free` each time costs a zero-fill and, for large
+ * payloads, fresh page faults. The pool keeps freed blocks on per-bucket free
+ * lists and hands them back to the next request of a similar size.
+ *
+ * Requests are rounded up to a bucket: four per power of two (1 KB, 1.25 KB,
+ * 1.5 KB, 1.75 KB, 2 KB, ...), so a block fits any request of its bucket and
+ * wastes at most 25%. The bytes held on the free lists never exceed a limit,
+ * 256 MB unless the environment variable `AURA_TENSOR_POOL_MB` or
+ * `auraTensorPoolSetLimit` says otherwise; blocks that do not fit are returned
+ * to the system.
+ */
+
+#include "common.h"
+
+/** Smallest bucket; requests below it are rounded up to it. */
+#define AURA_TENSOR_POOL_MIN_SIZE ((size_t)1 << 10)
+
+/** Largest bucket; bigger requests bypass the pool. */
+#define AURA_TENSOR_POOL_MAX_SIZE ((size_t)1 << 40)
+
+/** Number of buckets between the two bounds. */
+#define AURA_TENSOR_POOL_BUCKETS 121
+
+/** Default cap on the bytes cached by the pool. */
+#define AURA_TENSOR_POOL_DEFAULT_LIMIT ((size_t)256 << 20)
+
+/**
+ * @brief Counters of the pool.
+ */
+typedef struct {
+    size_t hits;            // Requests served from a free list.
+    size_t misses;          // Requests that had to allocate a new block.
+    size_t releases;        // Freed blocks returned to the system because of the limit.
+    size_t cachedBlocks;    // Blocks currently on the free lists.
+    size_t cachedBytes;     // Their total size.
+    size_t limit;           // Cap on cachedBytes.
+} AuraTensorPoolStats;
+
+/**
+ * Returns the bucket serving `size` bytes.
+ *
+ * @return The bucket index, or -1 if `size` exceeds AURA_TENSOR_POOL_MAX_SIZE.
+ * @complexity O(1)
+ */
+int auraTensorPoolBucketOf(size_t size);
+
+/**
+ * Returns the block size of a bucket.
+ *
+ * @param bucket A bucket index in [0, AURA_TENSOR_POOL_BUCKETS).
+ */
+size_t auraTensorPoolBucketSize(int bucket);
+
+/**
+ * Allocates a block of at least the bucket's size.
+ *
+ * OPTIMIZATION: With `zeroFill` false a recycled block is returned as it was
+ * left, saving a pass over memory when the caller overwrites it anyway; a new
+ * zero-filled block comes from `calloc`, which the system can serve with
+ * already-zero pages.
+ *
+ * @param bucket A bucket index in [0, AURA_TENSOR_POOL_BUCKETS).
+ * @param zeroFill Whether the first `size` bytes must be zero.
+ * @param size Bytes that must be zeroed when `zeroFill` is set.
+ * @return The block, or NULL if out of memory.
+ * @complexity O(1), plus O(size) for a recycled zero-filled block.
+ */
+void* auraTensorPoolAlloc(int bucket, size_t size, bool zeroFill);
+
+/**
+ * Returns a block to its bucket, or to the system if the pool is full.
+ *
+ * @param block A block from `auraTensorPoolAlloc(bucket, ...)`.
+ * @param bucket Its bucket.
+ * @complexity O(1)
+ */
+void auraTensorPoolFree(void* block, int bucket);
+
+/**
+ * Changes the cap on cached bytes, releasing blocks until it holds.
+ *
+ * @param bytes The new limit (0 disables caching).
+ * @return The previous limit.
+ * @complexity O(released blocks)
+ */
+size_t auraTensorPoolSetLimit(size_t bytes);
+
+/**
+ * Returns every cached block to the system (the limit is unchanged).
+ *
+ * @complexity O(cached blocks)
+ */
+void auraTensorPoolTrim(void);
+
+/**
+ * Reports the pool's counters.
+ *
+ * @param stats Receives the counters.
+ */
+void auraTensorPoolStats(AuraTensorPoolStats* stats);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef minijs_thread_pool_h
+#define minijs_thread_pool_h
+
+/**
+ * @file thread_pool.h
+ * @brief Process-wide worker pool for data-parallel loops.
+ *
+ * The pool is started on first use with one thread per online CPU (the
+ * calling thread counts as one of them). Setting the environment variable
+ * `AURA_THREADS` to a positive number overrides the size; `AURA_THREADS=1`
+ * keeps everything on the calling thread.
+ *
+ * Work is submitted as a range [0, count) that is cut into contiguous chunks;
+ * the caller runs chunks too and returns once all of them are done. A loop
+ * started from inside a chunk runs inline, so parallel operations may call
+ * each other freely.
+ */
+
+#include "common.h"
+
+/** Upper bound on the pool size, whatever the CPU count or `AURA_THREADS` say. */
+#define AURA_THREAD_POOL_MAX 256
+
+/**
+ * Body of a parallel loop: processes indices [begin, end).
+ *
+ * @param context The pointer passed to `auraParallelFor`.
+ */
+typedef void (*AuraParallelTask)(void* context, size_t begin, size_t end);
+
+/**
+ * Returns the number of threads that execute parallel loops (at least 1).
+ */
+size_t auraThreadPoolSize(void);
+
+/**
+ * Restarts the pool with `threads` threads (0 restores the default size).
+ *
+ * Meant for tests and benchmarks; must not race with running parallel loops.
+ *
+ * @param threads The requested number of threads, capped at AURA_THREAD_POOL_MAX.
+ * @return The size actually in effect.
+ */
+size_t auraThreadPoolSetSize(size_t threads);
+
+/**
+ * Runs `task` over [0, count) split across the pool.
+ *
+ * Chunks hold at least `grain` indices; when the range is too small for two
+ * chunks (or the pool has a single thread) `task` runs once, inline, over the
+ * whole range. Chunks are contiguous and cover the range exactly once.
+ *
+ * @param count Number of indices.
+ * @param grain Minimum indices per chunk (0 is treated as 1).
+ * @param task The loop body.
+ * @param context Passed through to `task`.
+ * @complexity O(count) work spread over the pool, plus O(threads) scheduling.
+ */
+void auraParallelFor(size_t count, size_t grain, AuraParallelTask task, void* context);
+
+#endif
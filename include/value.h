@@ -5,12 +5,22 @@
  * @file value.h
  * @brief Defines the core data types and structures for the Aura language.
  *
- * This file contains the definition of `AuraValue`, which is a tagged union
- * representing all possible values in the language (primitives and objects),
- * along with their specific type enumerations and helper structures.
+ * This file contains the definition of `AuraValue`, the dynamic value that can
+ * hold every type of the language (primitives and objects), along with the type
+ * enumerations, heap object layouts and the accessor macros used to inspect it.
+ *
+ * Two physical representations are available (see `AURA_NAN_BOXING` in common.h):
+ * - NaN-boxing: a value is a single `uint64_t`. Doubles are stored unboxed and
+ *   every other kind lives in the payload of a negative quiet NaN.
+ * - Tagged union: a small tag followed by a union (debug friendly, 32 bytes).
+ *
+ * Code outside of the value module must only use the `AURA_*` macros and the
+ * `create*` functions so that it stays agnostic of the active representation.
  */
 
 #include "common.h"
+#include "arena.h"
+#include <stdint.h>
 
 /**
  * @brief Enumeration of all supported Aura data types.
@@ -31,6 +41,8 @@ typedef enum {
     // --- AURA SPECIAL TYPES ---
     AURA_TENSOR,
     AURA_VEC3,
+    AURA_SPARSE_TENSOR,
+    AURA_VEC3_ARRAY,
 
     // --- Object (Reference) Types ---
     AURA_OBJECT,
@@ -43,61 +55,621 @@ typedef enum {
     AURA_FUNCTION
 } AuraType;
 
+/**
+ * @brief Physical representation tag of an `AuraValue`.
+ *
+ * This is an implementation detail of the value module: several tags may map to
+ * the same `AuraType` (e.g. an unboxed and a boxed Vec3). Under NaN-boxing the
+ * first eight tags are encoded in bits 48..50 of the boxed NaN, so their numeric
+ * values must stay below 8.
+ */
+typedef enum {
+    AURA_TAG_OBJ = 0,       // Pointer to a heap object (`AuraObj*`).
+    AURA_TAG_UNDEFINED = 1,
+    AURA_TAG_NULL = 2,
+    AURA_TAG_BOOL = 3,
+    AURA_TAG_INT = 4,       // 32-bit small integer (language type AURA_NUMBER).
+    AURA_TAG_SSTR = 5,      // Short string stored inline (language type AURA_STRING).
+    AURA_TAG_SBIG = 6,      // BigInt stored inline (language type AURA_BIGINT).
+
+    // --- Tags that only exist as explicit values in the tagged union ---
+    AURA_TAG_NUMBER = 8,
+    AURA_TAG_VEC3
+} AuraTag;
+
 /**
  * @brief Represents a 3-dimensional vector.
  * Used for mathematical and graphical operations.
+ *
+ * Padded to 16 bytes and aligned to 16, so a vector is exactly one SSE
+ * register: the native operations of vec3.h move it with one aligned load or
+ * store. `w` is padding and must stay 0 (brace initializers with three
+ * components do that), since dot products sum all four lanes.
  */
-typedef struct {
+typedef struct AURA_ALIGNED(16) {
     float x, y, z;
+    float w;
 } AuraVec3;
 
+/**
+ * @brief Allocation flags stored in every heap object header.
+ */
+typedef enum {
+    AURA_OBJ_ARENA = 1 << 0     // Owned by an AuraArena: `freeValue` leaves it alone.
+} AuraObjFlags;
+
+/**
+ * @brief Common header of every heap-allocated value.
+ *
+ * A NaN-boxed value only carries a raw pointer, so the dynamic type of a heap
+ * payload has to be stored in the payload itself. Every boxed structure starts
+ * with this header, which makes it safe to cast any of them to `AuraObj*`.
+ * All fields are bytes so the header packs with the fields that follow it.
+ */
+typedef struct {
+    uint8_t type;       // AuraType
+    uint8_t flags;      // AuraObjFlags
+    uint8_t sizeClass;  // Slab size class + 1, or 0 for objects from calloc or an arena.
+} AuraObj;
+
+/**
+ * @brief An arbitrary-precision integer (see bigint.h).
+ *
+ * Sign and magnitude: `limbs` holds `length` 64-bit limbs, least significant
+ * first, and shares one allocation with the header. The top limb is never
+ * zero, so zero has length 0 and is never negative.
+ *
+ * Only BigInts outside [AURA_SBIG_MIN, AURA_SBIG_MAX] live on the heap;
+ * smaller ones are stored inline in the value (AURA_TAG_SBIG).
+ */
+typedef struct {
+    AuraObj obj;
+    bool negative;
+    uint32_t length;
+    uint64_t limbs[];
+} AuraBigInt;
+
+/**
+ * @brief Heap box for a Vec3 (used when the value is too small to hold 16 bytes).
+ *
+ * Object allocations are 16-byte aligned, so `vec` is too.
+ */
+typedef struct {
+    AuraObj obj;
+    AuraVec3 vec;
+} AuraVec3Box;
+
+/** Alignment in bytes of tensor payloads and of every tensor row (one cache line). */
+#define AURA_TENSOR_ALIGNMENT 64
+
+/** Row stride granularity in floats: rows are padded to whole cache lines. */
+#define AURA_TENSOR_ROW_FLOATS (AURA_TENSOR_ALIGNMENT / sizeof(float))
+
+/** Maximum number of tensor dimensions. */
+#define AURA_TENSOR_MAX_DIMS 8
+
+/**
+ * @brief Element types of tensor storage.
+ *
+ * Operations compute in float32. The reduced-precision types are storage
+ * formats for large read-mostly tensors (e.g. weights): they are produced by
+ * `auraTensorConvert` and consumed by the conversion and quantized matrix
+ * product paths (see tensor.h).
+ */
+typedef enum {
+    AURA_DTYPE_F32,             // IEEE binary32 (the default).
+    AURA_DTYPE_F16,             // IEEE binary16.
+    AURA_DTYPE_BF16,            // bfloat16: the upper half of a binary32.
+    AURA_DTYPE_I8,              // Signed 8-bit integers times a per-row float scale.
+    AURA_DTYPE_COUNT
+} AuraDType;
+
+/** Bytes per element of a dtype. */
+static inline size_t auraDTypeSize(AuraDType dtype) {
+    return dtype == AURA_DTYPE_F32 ? 4 : dtype == AURA_DTYPE_I8 ? 1 : 2;
+}
+
+/** Short lowercase name of a dtype ("f32", "f16", "bf16", "i8"). */
+static inline const char* auraDTypeName(AuraDType dtype) {
+    static const char* names[AURA_DTYPE_COUNT] = { "f32", "f16", "bf16", "i8" };
+    return dtype < AURA_DTYPE_COUNT ? names[dtype] : "?";
+}
+
 /**
  * @brief Represents a multi-dimensional tensor structure.
  *
- * Designed for high-performance numerical computations.
- * Uses a Flexible Array Member for `data` to ensure spatial locality and reduce cache misses.
+ * Designed for high-performance numerical computations. Header and payload
+ * share one allocation to ensure spatial locality and reduce cache misses, but
+ * the payload starts at the next 64-byte boundary after the header and each
+ * row is padded to a multiple of 16 floats (`stride`), so every row begins on
+ * a cache line and vector kernels can use aligned loads without line splits.
+ * Padding elements are zero.
+ *
+ * `dtype` gives the element type; `data`, strides and `stride` are in
+ * elements of that type, and rows are padded to 64 bytes whatever it is.
+ * Tensors of another type than AURA_DTYPE_F32 are always dense owners, and
+ * int8 tensors keep one dequantization scale per row in `scales`, after the
+ * payload: element (r, c) stands for `scales[r] * q[r][c]`. The integer sum
+ * of each row follows in `rowSums`, for the VNNI dot products.
+ *
+ * A tensor has 1 to AURA_TENSOR_MAX_DIMS dimensions described by `shape` and
+ * `strides` (in floats). Only the last dimension is padded; the others are
+ * packed, so the leading dimensions of a dense tensor collapse into `rows`
+ * rows of `cols` elements and every N-D tensor can also be processed as a
+ * matrix. `rows`, `cols`, `stride` and `colStride` cache that matrix view
+ * (see auraTensorUpdateLayout); for 2-D tensors they are exactly the shape
+ * and strides.
+ *
+ * A view (see `auraTensorTranspose`, `auraTensorSlice`) has no payload of its
+ * own: `data` points into the storage of `base`, which it keeps alive through
+ * `base->refs`, and its strides need not be dense; a transpose simply swaps
+ * the last two strides.
+ *
+ * An owner may also keep its payload outside its allocation, e.g. in a
+ * read-only file mapping (see tensor_file.h): `releaseStorage(storageOwner)`
+ * then runs when the tensor is freed.
+ *
+ * Element (r, c) of the matrix view lives at `data[r * stride + c * colStride]`
+ * (see AURA_TENSOR_AT) when `uniformRows` is set, which always holds for 2-D
+ * tensors. Otherwise use auraTensorRowPointer to find row r.
+ */
+typedef struct AuraTensor {
+    AuraObj obj;
+    uint8_t ndim;               // Number of dimensions, 1..AURA_TENSOR_MAX_DIMS.
+    bool uniformRows;           // Row r of the matrix view starts at data + r * stride.
+    uint8_t poolBucket;         // Tensor pool bucket + 1, or 0 if not from the pool.
+    bool readOnly;              // The payload must not be written (e.g. a file mapping).
+    uint8_t dtype;              // AuraDType of the elements.
+    uint32_t refs;              // The value itself plus every view of this storage.
+    size_t rows;                // Product of all dimensions but the last (1 for 1-D).
+    size_t cols;                // Last dimension.
+    size_t stride;              // Elements between the starts of consecutive rows.
+    size_t colStride;           // Elements between consecutive elements of a row (1 unless a view).
+    float* data;                // Owners: aligned to AURA_TENSOR_ALIGNMENT, inside this allocation
+                                // unless `releaseStorage` is set. Other dtypes: cast as needed.
+    float* scales;              // AURA_DTYPE_I8: one scale per row; NULL otherwise.
+    int32_t* rowSums;           // AURA_DTYPE_I8: sum of each row's integers; NULL otherwise.
+    struct AuraTensor* base;    // Owner of the storage for views, NULL for owners.
+    void (*releaseStorage)(void* storageOwner);   // Owners with external storage, else NULL.
+    void* storageOwner;
+    size_t shape[AURA_TENSOR_MAX_DIMS];
+    size_t strides[AURA_TENSOR_MAX_DIMS];
+} AuraTensor;
+
+#define AURA_TENSOR_ROW(t, r)     ((t)->data + (size_t)(r) * (t)->stride)
+#define AURA_TENSOR_AT(t, r, c)   (AURA_TENSOR_ROW(t, r)[(size_t)(c) * (t)->colStride])
+
+/**
+ * Returns the first element of row `row` of a tensor's matrix view.
+ *
+ * @complexity O(1) for uniform rows, O(ndim) otherwise.
+ */
+static inline float* auraTensorRowPointer(const AuraTensor* t, size_t row) {
+    if (t->uniformRows) return AURA_TENSOR_ROW(t, row);
+    size_t offset = 0;
+    for (int d = t->ndim - 2; d >= 0; d--) {
+        offset += (row % t->shape[d]) * t->strides[d];
+        row /= t->shape[d];
+    }
+    return t->data + offset;
+}
+
+/**
+ * Returns the storage of row `row` of a dense tensor of any dtype.
+ */
+static inline void* auraTensorRowStorage(const AuraTensor* t, size_t row) {
+    return (char*)t->data + row * t->stride * auraDTypeSize((AuraDType)t->dtype);
+}
+
+/** True when the elements of each row are adjacent, so kernels can stream them. */
+#define AURA_TENSOR_ROWS_CONTIGUOUS(t) ((t)->colStride == 1)
+
+/**
+ * @brief A 2-D float32 matrix storing only its non-zero elements.
+ *
+ * The compressed sparse row (CSR) form is always present: the non-zeros of
+ * row r are `values[rowStart[r] .. rowStart[r + 1])`, in ascending column
+ * order, with their columns in `colIndex`. It shares one allocation with the
+ * header, so memory is O(rows + nnz) whatever the shape.
+ *
+ * The compressed sparse column (CSC) form is the same matrix grouped by
+ * column; it is only built on request (see auraSparseBuildCsc) and then
+ * serves products that read the matrix by column. NULL until then.
  */
 typedef struct {
+    AuraObj obj;
     size_t rows;
     size_t cols;
-    float data[];
-} AuraTensor;
+    size_t nnz;                 // Stored elements.
+    size_t* rowStart;           // rows + 1 offsets into values / colIndex.
+    float* values;
+    uint32_t* colIndex;
+    size_t* colStart;           // CSC: cols + 1 offsets into cscValues / rowIndex, or NULL.
+                                // One allocation holding the whole CSC form.
+    float* cscValues;
+    uint32_t* rowIndex;
+} AuraSparseTensor;
+
+/**
+ * @brief An array of 3-D vectors in structure-of-arrays layout.
+ *
+ * Element i is `(x[i], y[i], z[i])`: each component is a separate float array,
+ * so batched operations load VW consecutive x (or y, or z) values per vector
+ * instead of shuffling interleaved triples. The three arrays share one
+ * allocation with the header; each starts on a cache line and is zero-padded
+ * to `capacity` elements, a multiple of AURA_TENSOR_ROW_FLOATS.
+ */
+typedef struct {
+    AuraObj obj;
+    size_t length;
+    size_t capacity;            // Elements per component array, padding included.
+    float* x;
+    float* y;
+    float* z;
+} AuraVec3Array;
+
+#ifdef AURA_NAN_BOXING
+
+/**
+ * @brief Represents a dynamic Aura value as a NaN-boxed 64-bit word.
+ *
+ * Layout of a boxed (non-double) value:
+ *
+ *   63      51 50  48 47                                           0
+ *   [1 1...1 1][ tag ][                   payload                  ]
+ *
+ * All thirteen top bits set is a negative quiet NaN, which real arithmetic never
+ * produces once NaNs are canonicalized to `AURA_QNAN` on the way in.
+ */
+typedef uint64_t AuraValue;
+
+#define AURA_QNAN          ((uint64_t)0x7ff8000000000000ULL)
+#define AURA_BOX_MASK      ((uint64_t)0xfff8000000000000ULL)
+#define AURA_PAYLOAD_MASK  ((uint64_t)0x0000ffffffffffffULL)
+#define AURA_TAG_SHIFT     48
+
+#define AURA_BOX(tag, payload) \
+    (AURA_BOX_MASK | ((uint64_t)(tag) << AURA_TAG_SHIFT) | ((uint64_t)(payload) & AURA_PAYLOAD_MASK))
+#define AURA_PAYLOAD(v)    ((v) & AURA_PAYLOAD_MASK)
 
+#define AURA_IS_BOXED(v)   (((v) & AURA_BOX_MASK) == AURA_BOX_MASK)
+#define AURA_TAG(v)        (AURA_IS_BOXED(v) ? (AuraTag)(((v) >> AURA_TAG_SHIFT) & 7) : AURA_TAG_NUMBER)
 
 /**
- * @brief Represents a dynamic Aura value.
- * 
- * Uses a "Tagged Union" pattern where the `type` field indicates which member
- * of the `union` is currently valid and active.
+ * Maximum length of a string stored inline in the value.
+ *
+ * The characters occupy the low payload bytes, so on little-endian targets the
+ * value's own memory is a valid NUL-terminated C string as long as the sixth
+ * payload byte stays zero. Big-endian targets always use the heap representation.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define AURA_SSO_MAX 0
+#else
+#define AURA_SSO_MAX 5
+#endif
+
+/**
+ * Reinterprets a double as its IEEE-754 bit pattern, canonicalizing NaNs so a
+ * computed NaN can never be mistaken for a boxed value.
+ */
+static inline AuraValue auraNumberToValue(double num) {
+    union { double d; uint64_t bits; } u;
+    if (num != num) return AURA_QNAN;
+    u.d = num;
+    return u.bits;
+}
+
+static inline double auraValueToNumber(AuraValue v) {
+    union { double d; uint64_t bits; } u;
+    u.bits = v;
+    return u.d;
+}
+
+#define AURA_UNDEFINED_VAL     AURA_BOX(AURA_TAG_UNDEFINED, 0)
+#define AURA_NULL_VAL          AURA_BOX(AURA_TAG_NULL, 0)
+#define AURA_BOOL_VAL(b)       AURA_BOX(AURA_TAG_BOOL, (b) ? 1 : 0)
+#define AURA_INT_VAL(i)        AURA_BOX(AURA_TAG_INT, (uint32_t)(int32_t)(i))
+#define AURA_SBIG_VAL(i)       AURA_BOX(AURA_TAG_SBIG, (uint64_t)(int64_t)(i))
+#define AURA_NUMBER_VAL(num)   auraNumberToValue(num)
+#define AURA_OBJ_VAL(ptr)      AURA_BOX(AURA_TAG_OBJ, (uintptr_t)(ptr))
+
+#define AURA_IS_NUMBER(v)      (!AURA_IS_BOXED(v))
+#define AURA_IS_OBJ(v)         (AURA_IS_BOXED(v) && AURA_TAG(v) == AURA_TAG_OBJ)
+
+#define AURA_AS_BOOL(v)        ((int)AURA_PAYLOAD(v))
+#define AURA_AS_INT(v)         ((int32_t)(uint32_t)AURA_PAYLOAD(v))
+#define AURA_AS_NUMBER(v)      auraValueToNumber(v)
+#define AURA_AS_OBJ(v)         ((AuraObj*)(uintptr_t)AURA_PAYLOAD(v))
+
+/** Inline BigInts are 48-bit two's complement payloads (sign-extended on the way out). */
+#define AURA_SBIG_MIN          (-((int64_t)1 << 47))
+#define AURA_SBIG_MAX          (((int64_t)1 << 47) - 1)
+#define AURA_SBIG_SIGN         ((uint64_t)1 << 47)
+#define AURA_AS_SBIG(v)        ((int64_t)((AURA_PAYLOAD(v) ^ AURA_SBIG_SIGN) - AURA_SBIG_SIGN))
+
+/**
+ * Packs up to AURA_SSO_MAX characters (without embedded NULs) into a value.
+ */
+static inline AuraValue auraShortStringToValue(const char* chars, size_t length) {
+    uint64_t bits = 0;
+    memcpy(&bits, chars, length);
+    return AURA_BOX(AURA_TAG_SSTR, 0) | bits;
+}
+
+#define AURA_SSO_CHARS(vp)     ((const char*)(vp))
+#define AURA_SSO_LENGTH(vp)    strlen((const char*)(vp))
+
+#else
+
+/**
+ * @brief Represents a dynamic Aura value as a tagged union.
+ *
+ * The `tag` field indicates which member of the `union` is currently valid and active.
  */
 typedef struct {
-    AuraType type;
+    AuraTag tag;
 
     union
     {
         double number;
         int boolean;
-        char* string;
-        char* symbol;
-        long long bigint;
+        int32_t integer;
+        int64_t bigint;
         AuraVec3 vec3;
-        AuraTensor* tensor;
-        void* object;
-        void* function;
+        AuraObj* obj;
+        struct {
+            char chars[15];
+            uint8_t length;
+        } small;
     } as;
 } AuraValue;
 
+/** Maximum length of a string stored inline in the value (`small.chars` keeps a NUL). */
+#define AURA_SSO_MAX 14
+
+static inline AuraValue auraMakeValue(AuraTag tag) {
+    AuraValue v;
+    memset(&v, 0, sizeof(v));
+    v.tag = tag;
+    return v;
+}
+
+static inline AuraValue auraNumberToValue(double num) {
+    AuraValue v = auraMakeValue(AURA_TAG_NUMBER);
+    v.as.number = num;
+    return v;
+}
+
+static inline AuraValue auraBoolToValue(int b) {
+    AuraValue v = auraMakeValue(AURA_TAG_BOOL);
+    v.as.boolean = b ? 1 : 0;
+    return v;
+}
+
+static inline AuraValue auraIntToValue(int32_t i) {
+    AuraValue v = auraMakeValue(AURA_TAG_INT);
+    v.as.integer = i;
+    return v;
+}
+
+static inline AuraValue auraSmallBigIntToValue(int64_t i) {
+    AuraValue v = auraMakeValue(AURA_TAG_SBIG);
+    v.as.bigint = i;
+    return v;
+}
+
+static inline AuraValue auraObjToValue(AuraObj* obj) {
+    AuraValue v = auraMakeValue(AURA_TAG_OBJ);
+    v.as.obj = obj;
+    return v;
+}
+
+static inline AuraValue auraShortStringToValue(const char* chars, size_t length) {
+    AuraValue v = auraMakeValue(AURA_TAG_SSTR);
+    memcpy(v.as.small.chars, chars, length);
+    v.as.small.length = (uint8_t)length;
+    return v;
+}
+
+#define AURA_SSO_CHARS(vp)     ((const char*)(vp)->as.small.chars)
+#define AURA_SSO_LENGTH(vp)    ((size_t)(vp)->as.small.length)
+
+#define AURA_TAG(v)            ((v).tag)
+
+#define AURA_UNDEFINED_VAL     auraMakeValue(AURA_TAG_UNDEFINED)
+#define AURA_NULL_VAL          auraMakeValue(AURA_TAG_NULL)
+#define AURA_BOOL_VAL(b)       auraBoolToValue(b)
+#define AURA_INT_VAL(i)        auraIntToValue(i)
+#define AURA_SBIG_VAL(i)       auraSmallBigIntToValue(i)
+#define AURA_NUMBER_VAL(num)   auraNumberToValue(num)
+#define AURA_OBJ_VAL(ptr)      auraObjToValue((AuraObj*)(ptr))
+
+#define AURA_IS_NUMBER(v)      ((v).tag == AURA_TAG_NUMBER)
+#define AURA_IS_OBJ(v)         ((v).tag == AURA_TAG_OBJ)
+
+#define AURA_AS_BOOL(v)        ((v).as.boolean)
+#define AURA_AS_INT(v)         ((v).as.integer)
+#define AURA_AS_SBIG(v)        ((v).as.bigint)
+#define AURA_AS_NUMBER(v)      ((v).as.number)
+#define AURA_AS_OBJ(v)         ((v).as.obj)
+
+/** Inline BigInts are whole int64s. */
+#define AURA_SBIG_MIN          INT64_MIN
+#define AURA_SBIG_MAX          INT64_MAX
+
+#endif
+
+// --- Representation-independent helpers ---
+#define AURA_IS_UNDEFINED(v)   (AURA_TAG(v) == AURA_TAG_UNDEFINED)
+#define AURA_IS_NULL(v)        (AURA_TAG(v) == AURA_TAG_NULL)
+#define AURA_IS_BOOL(v)        (AURA_TAG(v) == AURA_TAG_BOOL)
+#define AURA_IS_INT(v)         (AURA_TAG(v) == AURA_TAG_INT)
+#define AURA_IS_SSTR(v)        (AURA_TAG(v) == AURA_TAG_SSTR)
+#define AURA_IS_SBIG(v)        (AURA_TAG(v) == AURA_TAG_SBIG)
+
+#define AURA_OBJ_TYPE(v)       (AURA_AS_OBJ(v)->type)
+#define AURA_IS_OBJ_TYPE(v, t) (AURA_IS_OBJ(v) && AURA_OBJ_TYPE(v) == (t))
+#define AURA_IS_STRING(v)      (AURA_IS_SSTR(v) || AURA_IS_OBJ_TYPE(v, AURA_STRING))
+#define AURA_IS_TENSOR(v)      AURA_IS_OBJ_TYPE(v, AURA_TENSOR)
+
+#define AURA_AS_TENSOR(v)      ((AuraTensor*)AURA_AS_OBJ(v))
+#define AURA_IS_BIGINT(v)      (AURA_IS_SBIG(v) || AURA_IS_OBJ_TYPE(v, AURA_BIGINT))
+#define AURA_AS_BIGINT(v)      ((AuraBigInt*)AURA_AS_OBJ(v))   // Heap BigInts only.
+#define AURA_IS_SPARSE(v)      AURA_IS_OBJ_TYPE(v, AURA_SPARSE_TENSOR)
+#define AURA_AS_SPARSE(v)      ((AuraSparseTensor*)AURA_AS_OBJ(v))
+#define AURA_IS_VEC3_ARRAY(v)  AURA_IS_OBJ_TYPE(v, AURA_VEC3_ARRAY)
+#define AURA_AS_VEC3_ARRAY(v)  ((AuraVec3Array*)AURA_AS_OBJ(v))
+
+#ifdef AURA_NAN_BOXING
+#define AURA_IS_VEC3(v)        AURA_IS_OBJ_TYPE(v, AURA_VEC3)
+#else
+#define AURA_IS_VEC3(v)        (AURA_TAG(v) == AURA_TAG_VEC3)
+#endif
+
+/**
+ * Extracts the components of a Vec3 value.
+ *
+ * @param v A value for which AURA_IS_VEC3 holds.
+ * @return A copy of the vector.
+ * @complexity O(1): one aligned 16-byte load.
+ */
+static inline AuraVec3 auraAsVec3(AuraValue v) {
+#ifdef AURA_NAN_BOXING
+    return ((AuraVec3Box*)AURA_AS_OBJ(v))->vec;
+#else
+    return v.as.vec3;
+#endif
+}
+
+// --- Small Integer Arithmetic ---
+//
+// Numbers have two representations: 32-bit small integers (AURA_TAG_INT) and
+// doubles. Both report AURA_NUMBER as their type. The helpers below keep integer
+// operands in integer registers and only promote to a double when the exact
+// result does not fit into an int32 (or would be -0, which ints cannot encode).
+
+#define AURA_IS_NUMERIC(v)     (AURA_IS_INT(v) || AURA_IS_NUMBER(v))
+
+/**
+ * Converts a numeric value (small int or double) to a double.
+ *
+ * @param v A value for which AURA_IS_NUMERIC holds.
+ * @return The numeric value as a double.
+ * @complexity O(1)
+ */
+static inline double auraToNumber(AuraValue v) {
+    return AURA_IS_INT(v) ? (double)AURA_AS_INT(v) : AURA_AS_NUMBER(v);
+}
+
+/**
+ * Builds the result of an integer operation computed in 64 bits, staying a small
+ * int when it fits into 32 bits and promoting to a double otherwise.
+ */
+static inline AuraValue auraIntResult(int64_t result) {
+    if (result >= INT32_MIN && result <= INT32_MAX) return AURA_INT_VAL((int32_t)result);
+    return AURA_NUMBER_VAL((double)result);
+}
+
+/**
+ * Adds two numeric values.
+ *
+ * @complexity O(1). The int32 + int32 path never touches the FPU.
+ */
+static inline AuraValue auraNumberAdd(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) {
+        return auraIntResult((int64_t)AURA_AS_INT(a) + (int64_t)AURA_AS_INT(b));
+    }
+    return AURA_NUMBER_VAL(auraToNumber(a) + auraToNumber(b));
+}
+
+/**
+ * Subtracts two numeric values (a - b).
+ *
+ * @complexity O(1)
+ */
+static inline AuraValue auraNumberSub(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) {
+        return auraIntResult((int64_t)AURA_AS_INT(a) - (int64_t)AURA_AS_INT(b));
+    }
+    return AURA_NUMBER_VAL(auraToNumber(a) - auraToNumber(b));
+}
+
+/**
+ * Multiplies two numeric values.
+ *
+ * The product of two int32 always fits into an int64, so the check is exact.
+ * A zero product with a negative operand is -0 in JS and must become a double.
+ *
+ * @complexity O(1)
+ */
+static inline AuraValue auraNumberMul(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) {
+        int64_t result = (int64_t)AURA_AS_INT(a) * (int64_t)AURA_AS_INT(b);
+        if (result != 0 || (AURA_AS_INT(a) >= 0 && AURA_AS_INT(b) >= 0)) {
+            return auraIntResult(result);
+        }
+    }
+    return AURA_NUMBER_VAL(auraToNumber(a) * auraToNumber(b));
+}
+
+/**
+ * Numeric equality (`===` on numbers): 1 === 1.0 holds, NaN never equals itself.
+ */
+static inline bool auraNumbersEqual(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) return AURA_AS_INT(a) == AURA_AS_INT(b);
+    return auraToNumber(a) == auraToNumber(b);
+}
+
+/**
+ * Numeric less-than (a < b). Any comparison involving NaN is false.
+ */
+static inline bool auraNumberLess(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) return AURA_AS_INT(a) < AURA_AS_INT(b);
+    return auraToNumber(a) < auraToNumber(b);
+}
+
+/**
+ * Numeric less-than-or-equal (a <= b). Any comparison involving NaN is false.
+ */
+static inline bool auraNumberLessEqual(AuraValue a, AuraValue b) {
+    if (AURA_IS_INT(a) && AURA_IS_INT(b)) return AURA_AS_INT(a) <= AURA_AS_INT(b);
+    return auraToNumber(a) <= auraToNumber(b);
+}
+
 // --- Value Creation & Management ---
+AuraObj* auraAllocateObject(size_t size, AuraType type);
+AuraObj* auraAllocateObjectInArena(AuraArena* arena, size_t size, AuraType type);
+void auraFreeObject(AuraObj* obj);
+void auraFreeTensor(AuraTensor* tensor);
+void auraFreeSparseTensor(AuraSparseTensor* sparse);
+void auraTensorUpdateLayout(AuraTensor* tensor);
+
 AuraValue createUNDEFINED();
 AuraValue createNULL();
 AuraValue createBOOLEAN(int val);
 AuraValue createNUMBER(double val);
+AuraValue createINT(int32_t val);
 AuraValue createSTRING(char* val);
 AuraValue createBIGINT(long long val);
 AuraValue createVEC3(float x, float y, float z);
+AuraValue createVEC3FromRaw(AuraVec3 vec);
 AuraValue createTENSOR(int rows, int cols);
+AuraValue createTENSORND(int ndim, const int* shape);
+AuraValue createTENSORNDUninitialized(int ndim, const int* shape);
+AuraValue createTENSORNDTyped(AuraDType dtype, int ndim, const int* shape);
+
+// Arena variants: the value lives until the arena is reset (see arena.h).
+AuraValue createSTRINGInArena(AuraArena* arena, char* val);
+AuraValue createTENSORInArena(AuraArena* arena, int rows, int cols);
+AuraValue createTENSORNDInArena(AuraArena* arena, int ndim, const int* shape);
+
+// --- Inspection ---
+AuraType auraTypeOf(AuraValue v);
+long long auraAsBigInt(AuraValue v);
+int32_t auraToInt32(AuraValue v);
+bool auraValuesEqual(AuraValue a, AuraValue b);
 
 void printValue(AuraValue v);
 void freeValue(AuraValue v);
 
-#endif
\ No newline at end of file
+#endif
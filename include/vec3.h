@@ -0,0 +1,216 @@
+#ifndef minijs_vec3_h
+#define minijs_vec3_h
+
+/**
+ * @file vec3.h
+ * @brief Native operations on single AURA_VEC3 values.
+ *
+ * An AuraVec3 is one 16-byte aligned SSE register (x, y, z and a zero pad
+ * lane), so on x86 each operation below is a handful of instructions on an
+ * `__m128`: one aligned load per operand, the arithmetic, one aligned store.
+ * Other targets use the equivalent scalar code.
+ *
+ * The `*Raw` functions work on AuraVec3 structures and are inline, for the
+ * runtime's own vector math. The AuraValue functions are the value API used
+ * for script operations: like the tensor operations, they print a diagnostic
+ * and return AURA_NULL when an operand is not a Vec3. Every result keeps the
+ * pad lane at 0.
+ *
+ * For many vectors at once, Vec3 arrays (vec3_array.h) are far faster.
+ */
+
+#include "value.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AURA_VEC3_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef AURA_VEC3_SSE
+
+static inline __m128 auraVec3Load(AuraVec3 v) {
+    return _mm_load_ps(&v.x);
+}
+
+static inline AuraVec3 auraVec3Store(__m128 m) {
+    AuraVec3 v;
+    _mm_store_ps(&v.x, m);
+    return v;
+}
+
+/** Broadcasts `s` to the x, y and z lanes and 0 to the pad lane. */
+static inline __m128 auraVec3Splat(float s) {
+    return _mm_set_ps(0.0f, s, s, s);
+}
+
+/** Sum of the four lanes, in every lane. */
+static inline __m128 auraVec3HorizontalSum(__m128 m) {
+    m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+#endif
+
+static inline AuraVec3 auraVec3AddRaw(AuraVec3 a, AuraVec3 b) {
+#ifdef AURA_VEC3_SSE
+    return auraVec3Store(_mm_add_ps(auraVec3Load(a), auraVec3Load(b)));
+#else
+    AuraVec3 r = { a.x + b.x, a.y + b.y, a.z + b.z, 0.0f };
+    return r;
+#endif
+}
+
+static inline AuraVec3 auraVec3SubRaw(AuraVec3 a, AuraVec3 b) {
+#ifdef AURA_VEC3_SSE
+    return auraVec3Store(_mm_sub_ps(auraVec3Load(a), auraVec3Load(b)));
+#else
+    AuraVec3 r = { a.x - b.x, a.y - b.y, a.z - b.z, 0.0f };
+    return r;
+#endif
+}
+
+static inline AuraVec3 auraVec3ScaleRaw(AuraVec3 a, float s) {
+#ifdef AURA_VEC3_SSE
+    return auraVec3Store(_mm_mul_ps(auraVec3Load(a), auraVec3Splat(s)));
+#else
+    AuraVec3 r = { a.x * s, a.y * s, a.z * s, 0.0f };
+    return r;
+#endif
+}
+
+static inline float auraVec3DotRaw(AuraVec3 a, AuraVec3 b) {
+#ifdef AURA_VEC3_SSE
+    return _mm_cvtss_f32(auraVec3HorizontalSum(_mm_mul_ps(auraVec3Load(a), auraVec3Load(b))));
+#else
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+#endif
+}
+
+/**
+ * a x b = a.yzx * b.zxy - a.zxy * b.yzx, computed as
+ * (a * b.yzx - a.yzx * b).yzx to need three shuffles instead of four.
+ */
+static inline AuraVec3 auraVec3CrossRaw(AuraVec3 a, AuraVec3 b) {
+#ifdef AURA_VEC3_SSE
+    __m128 va = auraVec3Load(a), vb = auraVec3Load(b);
+    __m128 aYzx = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bYzx = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(va, bYzx), _mm_mul_ps(aYzx, vb));
+    return auraVec3Store(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+#else
+    AuraVec3 r = { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x, 0.0f };
+    return r;
+#endif
+}
+
+static inline float auraVec3LengthRaw(AuraVec3 a) {
+#ifdef AURA_VEC3_SSE
+    __m128 v = auraVec3Load(a);
+    return _mm_cvtss_f32(_mm_sqrt_ss(auraVec3HorizontalSum(_mm_mul_ps(v, v))));
+#else
+    return sqrtf(a.x * a.x + a.y * a.y + a.z * a.z);
+#endif
+}
+
+/**
+ * Scales a vector to unit length with an exact division; a zero vector stays zero.
+ */
+static inline AuraVec3 auraVec3NormalizeRaw(AuraVec3 a) {
+#ifdef AURA_VEC3_SSE
+    __m128 v = auraVec3Load(a);
+    __m128 length = _mm_sqrt_ps(auraVec3HorizontalSum(_mm_mul_ps(v, v)));
+    // Keep x, y and z where the length is positive; this also clears the 0 / 0 pad lane.
+    __m128 keep = _mm_and_ps(_mm_cmpgt_ps(length, _mm_setzero_ps()),
+                             _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+    return auraVec3Store(_mm_and_ps(_mm_div_ps(v, length), keep));
+#else
+    float length = sqrtf(a.x * a.x + a.y * a.y + a.z * a.z);
+    AuraVec3 r = { 0.0f, 0.0f, 0.0f, 0.0f };
+    if (length > 0.0f) {
+        r.x = a.x / length;
+        r.y = a.y / length;
+        r.z = a.z / length;
+    }
+    return r;
+#endif
+}
+
+/** a + (b - a) * t: `a` at t = 0, `b` at t = 1. */
+static inline AuraVec3 auraVec3LerpRaw(AuraVec3 a, AuraVec3 b, float t) {
+#ifdef AURA_VEC3_SSE
+    __m128 va = auraVec3Load(a);
+    return auraVec3Store(_mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(auraVec3Load(b), va), auraVec3Splat(t))));
+#else
+    AuraVec3 r = { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, 0.0f };
+    return r;
+#endif
+}
+
+// --- Value API ---
+
+/**
+ * Adds two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Add(AuraValue a, AuraValue b);
+
+/**
+ * Subtracts two Vec3 values (a - b).
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Sub(AuraValue a, AuraValue b);
+
+/**
+ * Multiplies a Vec3 by a scalar.
+ *
+ * @return A new Vec3, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Scale(AuraValue a, float s);
+
+/**
+ * Dot product of two Vec3 values.
+ *
+ * @return A number, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Dot(AuraValue a, AuraValue b);
+
+/**
+ * Cross product a x b of two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Cross(AuraValue a, AuraValue b);
+
+/**
+ * Euclidean length of a Vec3.
+ *
+ * @return A number, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Length(AuraValue a);
+
+/**
+ * Scales a Vec3 to unit length. A zero vector stays zero.
+ *
+ * @return A new Vec3, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Normalize(AuraValue a);
+
+/**
+ * Linear interpolation a + (b - a) * t between two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Lerp(AuraValue a, AuraValue b, float t);
+
+#endif
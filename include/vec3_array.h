@@ -0,0 +1,135 @@
+#ifndef minijs_vec3_array_h
+#define minijs_vec3_array_h
+
+/**
+ * @file vec3_array.h
+ * @brief Batched 3-D vector math on AURA_VEC3_ARRAY values.
+ *
+ * A Vec3 array stores n vectors as three float arrays (see AuraVec3Array), so
+ * 100000 particle positions are one object instead of 100000 boxed Vec3
+ * values, and every operation runs over whole arrays with the vector kernels
+ * of the active SIMD tier: 4, 8 or 16 elements per instruction for SSE2, AVX2
+ * and AVX-512.
+ *
+ * Like the tensor operations, every operation allocates its result, prints a
+ * diagnostic and returns AURA_NULL on invalid operands, and splits large
+ * arrays over the thread pool. Binary operations accept either a Vec3 array
+ * of the same length or a single Vec3 value, which is applied to every
+ * element (e.g. adding gravity to every velocity).
+ */
+
+#include "value.h"
+
+// --- Construction ---
+
+/**
+ * Creates a Vec3 array of `length` zero vectors.
+ *
+ * @param length Number of vectors (1..INT_MAX).
+ * @return A new AURA_VEC3_ARRAY value, or AURA_NULL on invalid arguments.
+ * @complexity O(length)
+ */
+AuraValue auraVec3ArrayCreate(size_t length);
+
+/**
+ * Creates a Vec3 array from the rows of an n x 3 tensor.
+ *
+ * @param t A 2-D float32 tensor (or view) with 3 columns.
+ * @return A new Vec3 array of n vectors, or AURA_NULL on invalid arguments.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayFromTensor(AuraValue t);
+
+/**
+ * Copies a Vec3 array into a new n x 3 tensor, one vector per row.
+ *
+ * @param a A Vec3 array.
+ * @return The tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayToTensor(AuraValue a);
+
+/**
+ * Returns element `index` of a Vec3 array as a Vec3 value.
+ *
+ * @return The vector, or AURA_NULL if `index` is out of range.
+ * @complexity O(1)
+ */
+AuraValue auraVec3ArrayGet(AuraValue a, size_t index);
+
+/**
+ * Stores a Vec3 value into element `index` of a Vec3 array.
+ *
+ * @return true on success; false, after printing a diagnostic, if `v` is not
+ *         a Vec3 or `index` is out of range.
+ * @complexity O(1)
+ */
+bool auraVec3ArraySet(AuraValue a, size_t index, AuraValue v);
+
+// --- Batched operations ---
+
+/**
+ * Adds `b` to every element of `a`.
+ *
+ * @param a A Vec3 array.
+ * @param b A Vec3 array of the same length, or a Vec3.
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayAdd(AuraValue a, AuraValue b);
+
+/**
+ * Subtracts `b` from every element of `a`.
+ *
+ * @param a A Vec3 array.
+ * @param b A Vec3 array of the same length, or a Vec3.
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArraySub(AuraValue a, AuraValue b);
+
+/**
+ * Multiplies every element of `a` by the scalar `s`.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayScale(AuraValue a, float s);
+
+/**
+ * Computes the dot product of each element of `a` with `b`.
+ *
+ * @param a A Vec3 array.
+ * @param b A Vec3 array of the same length, or a Vec3.
+ * @return A new 1-D tensor of n elements, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayDot(AuraValue a, AuraValue b);
+
+/**
+ * Computes the cross product `a[i] x b[i]` of each element.
+ *
+ * @param a A Vec3 array.
+ * @param b A Vec3 array of the same length, or a Vec3.
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayCross(AuraValue a, AuraValue b);
+
+/**
+ * Computes the Euclidean length of each element.
+ *
+ * @return A new 1-D tensor of n elements, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayLength(AuraValue a);
+
+/**
+ * Scales each element to unit length. Zero vectors stay zero.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayNormalize(AuraValue a);
+
+#endif
@@ -0,0 +1,429 @@
+/**
+ * @file bigint.c
+ * @brief Value API of the arbitrary-precision integers.
+ *
+ * OPTIMIZATION: When both operands are inline (AURA_TAG_SBIG) the operation
+ * runs on int64s with overflow-checked builtins and, if the result fits, never
+ * touches the heap. Only an overflow, or a heap operand, takes the general
+ * path: it sizes the result for the worst case, runs the magnitude routines of
+ * limbs.h on the limbs and fixes up the sign.
+ *
+ * Results are canonical: a value in the inline range is always inline, and a
+ * heap magnitude has no leading zero limb. Equal values therefore always have
+ * the same representation.
+ */
+
+#include "bigint.h"
+#include "aura_string.h"
+#include "limbs.h"
+
+/**
+ * @brief Sign and magnitude of any BigInt value, inline or on the heap.
+ *
+ * For inline values `limbs` points at `limb`, so a view must not be copied.
+ */
+typedef struct {
+    const uint64_t* limbs;
+    size_t length;
+    bool negative;
+    uint64_t limb;
+} BigIntView;
+
+static void viewOf(AuraValue v, BigIntView* view) {
+    if (AURA_IS_SBIG(v)) {
+        int64_t small = AURA_AS_SBIG(v);
+        view->negative = small < 0;
+        view->limb = small < 0 ? 0 - (uint64_t)small : (uint64_t)small;
+        view->limbs = &view->limb;
+        view->length = small != 0;
+    } else {
+        const AuraBigInt* bigint = AURA_AS_BIGINT(v);
+        view->negative = bigint->negative;
+        view->limbs = bigint->limbs;
+        view->length = bigint->length;
+    }
+}
+
+// --- Overflow-checked int64 arithmetic ---
+
+#if defined(__GNUC__)
+#define checkedAdd(a, b, r) __builtin_add_overflow(a, b, r)
+#define checkedSub(a, b, r) __builtin_sub_overflow(a, b, r)
+#define checkedMul(a, b, r) __builtin_mul_overflow(a, b, r)
+#else
+static bool checkedAdd(int64_t a, int64_t b, int64_t* r) {
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return true;
+    *r = a + b;
+    return false;
+}
+
+static bool checkedSub(int64_t a, int64_t b, int64_t* r) {
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b)) return true;
+    *r = a - b;
+    return false;
+}
+
+static bool checkedMul(int64_t a, int64_t b, int64_t* r) {
+    bool negative = (a < 0) != (b < 0);
+    uint64_t lo;
+    uint64_t hi = auraMulWide(a < 0 ? 0 - (uint64_t)a : (uint64_t)a, b < 0 ? 0 - (uint64_t)b : (uint64_t)b, &lo);
+    if (hi != 0 || lo > (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX)) return true;
+    *r = negative ? (int64_t)(0 - lo) : (int64_t)lo;
+    return false;
+}
+#endif
+
+/**
+ * Allocates a BigInt with room for `length` zero limbs, or prints a
+ * diagnostic naming `op` and returns NULL.
+ */
+static AuraBigInt* allocateBigInt(size_t length, const char* op) {
+    if (length > AURA_BIGINT_MAX_LIMBS) {
+        fprintf(stderr, "[Security] BigInt %s result exceeds %zu limbs.\n", op, AURA_BIGINT_MAX_LIMBS);
+        return NULL;
+    }
+    AuraBigInt* bigint = (AuraBigInt*)auraAllocateObject(sizeof(AuraBigInt) + length * sizeof(uint64_t), AURA_BIGINT);
+    if (bigint == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory in BigInt %s.\n", op);
+        return NULL;
+    }
+    bigint->length = (uint32_t)length;
+    return bigint;
+}
+
+/**
+ * Returns the inline form of `magnitude` with the given sign in `*out`, or
+ * false if it is outside the inline range.
+ */
+static bool toSmall(uint64_t magnitude, bool negative, int64_t* out) {
+    if (negative) {
+        if (magnitude > 0 - (uint64_t)AURA_SBIG_MIN) return false;
+        *out = (int64_t)(0 - magnitude);
+    } else {
+        if (magnitude > (uint64_t)AURA_SBIG_MAX) return false;
+        *out = (int64_t)magnitude;
+    }
+    return true;
+}
+
+/**
+ * Normalizes a freshly computed heap result: drops leading zero limbs, clears
+ * the sign of zero and moves values of the inline range out of the heap.
+ */
+static AuraValue finishBigInt(AuraBigInt* bigint, bool negative) {
+    bigint->length = (uint32_t)auraLimbsNormalize(bigint->limbs, bigint->length);
+    bigint->negative = negative && bigint->length != 0;
+
+    int64_t small;
+    if (bigint->length <= 1 && toSmall(bigint->length == 0 ? 0 : bigint->limbs[0], bigint->negative, &small)) {
+        auraFreeObject(&bigint->obj);
+        return AURA_SBIG_VAL(small);
+    }
+    return AURA_OBJ_VAL(bigint);
+}
+
+/**
+ * Returns true if `a` and `b` are BigInts; otherwise prints a diagnostic
+ * naming `op` and returns false.
+ */
+static bool requireBigInt(const char* op, AuraValue a, AuraValue b) {
+    if (AURA_IS_BIGINT(a) && AURA_IS_BIGINT(b)) return true;
+    fprintf(stderr, "[Security] BigInt %s expects BigInt operands.\n", op);
+    return false;
+}
+
+// --- CONSTRUCTION & CONVERSION ---
+
+/**
+ * Creates a BigInt from a 64-bit integer.
+ *
+ * @complexity O(1); no allocation inside the inline range.
+ */
+AuraValue auraBigIntFromInt64(int64_t val) {
+    if (val >= AURA_SBIG_MIN && val <= AURA_SBIG_MAX) return AURA_SBIG_VAL(val);
+
+    AuraBigInt* bigint = allocateBigInt(1, "creation");
+    if (bigint == NULL) return createNULL();
+    bigint->limbs[0] = val < 0 ? 0 - (uint64_t)val : (uint64_t)val;
+    bigint->negative = val < 0;
+    return AURA_OBJ_VAL(bigint);
+}
+
+/**
+ * Creates a BigInt from a magnitude (least significant limb first) and a sign.
+ *
+ * @return A new BigInt, or AURA_NULL if it would be too large.
+ * @complexity O(length)
+ */
+AuraValue auraBigIntFromLimbs(const uint64_t* limbs, size_t length, bool negative) {
+    length = auraLimbsNormalize(limbs, length);
+    int64_t small;
+    if (length <= 1 && toSmall(length == 0 ? 0 : limbs[0], negative, &small)) return AURA_SBIG_VAL(small);
+
+    AuraBigInt* bigint = allocateBigInt(length, "creation");
+    if (bigint == NULL) return createNULL();
+    memcpy(bigint->limbs, limbs, length * sizeof(uint64_t));
+    bigint->negative = negative;
+    return AURA_OBJ_VAL(bigint);
+}
+
+/**
+ * Converts a BigInt to an int64.
+ *
+ * @return false if `v` is not a BigInt or does not fit.
+ * @complexity O(1)
+ */
+bool auraBigIntToInt64(AuraValue v, int64_t* out) {
+    if (AURA_IS_SBIG(v)) {
+        *out = AURA_AS_SBIG(v);
+        return true;
+    }
+    if (!AURA_IS_BIGINT(v)) return false;
+    const AuraBigInt* bigint = AURA_AS_BIGINT(v);
+    if (bigint->length > 1) return false;
+    uint64_t magnitude = bigint->length == 0 ? 0 : bigint->limbs[0];
+    if (magnitude > (bigint->negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX)) return false;
+    *out = bigint->negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return true;
+}
+
+/**
+ * Parses an optional '-', decimal digits and an optional 'n' suffix (the text
+ * of a TOKEN_BIGINT) into a BigInt.
+ */
+AuraValue auraBigIntFromString(const char* chars, size_t length) {
+    bool negative = length > 0 && chars[0] == '-';
+    size_t start = negative ? 1 : 0;
+    size_t end = length > start && chars[length - 1] == 'n' ? length - 1 : length;
+    bool valid = end > start;
+    for (size_t i = start; i < end && valid; i++) valid = chars[i] >= '0' && chars[i] <= '9';
+    if (!valid) {
+        fprintf(stderr, "[Security] Invalid BigInt literal '%.*s'.\n", (int)length, chars);
+        return createNULL();
+    }
+    while (start < end - 1 && chars[start] == '0') start++;
+
+    size_t count = end - start;
+    if (count <= 18) {
+        int64_t val = 0;
+        for (size_t i = start; i < end; i++) val = val * 10 + (chars[i] - '0');
+        return auraBigIntFromInt64(negative ? -val : val);
+    }
+
+    size_t limbs = (count + AURA_DECIMAL_CHUNK_DIGITS - 1) / AURA_DECIMAL_CHUNK_DIGITS;
+    AuraBigInt* bigint = allocateBigInt(limbs, "parse");
+    if (bigint == NULL) return createNULL();
+    if (!auraLimbsFromDecimal(bigint->limbs, chars + start, count)) {
+        auraFreeObject(&bigint->obj);
+        fprintf(stderr, "[Fatal Error] Out of memory in BigInt parse.\n");
+        return createNULL();
+    }
+    return finishBigInt(bigint, negative);
+}
+
+/**
+ * Formats a BigInt in decimal (see bigint_radix.c).
+ */
+AuraValue auraBigIntToString(AuraValue v) {
+    if (!AURA_IS_BIGINT(v)) {
+        fprintf(stderr, "[Security] BigInt toString expects a BigInt.\n");
+        return createNULL();
+    }
+    BigIntView x;
+    viewOf(v, &x);
+
+    // 64 bits are less than 19.3 decimal digits: 20 per limb always suffices.
+    char* buffer = (char*)malloc(x.length * 20 + 2);
+    size_t count = 0;
+    if (buffer == NULL || !auraLimbsToDecimal(buffer + 1, &count, x.limbs, x.length)) {
+        free(buffer);
+        fprintf(stderr, "[Fatal Error] Out of memory in BigInt toString.\n");
+        return createNULL();
+    }
+    buffer[0] = '-';
+
+    AuraValue result = x.negative ? auraCopyString(buffer, count + 1) : auraCopyString(buffer + 1, count);
+    free(buffer);
+    return result;
+}
+
+// --- ARITHMETIC ---
+
+/** Returns (aNegative ? -1 : 1) * a + (bNegative ? -1 : 1) * b. */
+static AuraValue addSigned(const BigIntView* a, bool aNegative, const BigIntView* b, bool bNegative, const char* op) {
+    if (a->length < b->length) {
+        const BigIntView* t = a; a = b; b = t;
+        bool tn = aNegative; aNegative = bNegative; bNegative = tn;
+    }
+
+    if (aNegative == bNegative) {
+        AuraBigInt* r = allocateBigInt(a->length + 1, op);
+        if (r == NULL) return createNULL();
+        r->limbs[a->length] = auraLimbsAdd(r->limbs, a->limbs, a->length, b->limbs, b->length);
+        return finishBigInt(r, aNegative);
+    }
+
+    // Opposite signs: subtract the smaller magnitude from the larger one.
+    if (auraLimbsCompare(a->limbs, a->length, b->limbs, b->length) < 0) {
+        const BigIntView* t = a; a = b; b = t;
+        bool tn = aNegative; aNegative = bNegative; bNegative = tn;
+    }
+    AuraBigInt* r = allocateBigInt(a->length, op);
+    if (r == NULL) return createNULL();
+    auraLimbsSub(r->limbs, a->limbs, a->length, b->limbs, b->length);
+    return finishBigInt(r, aNegative);
+}
+
+/**
+ * Negates a BigInt.
+ *
+ * @return A new BigInt, or AURA_NULL if `a` is not a BigInt.
+ * @complexity O(1) inline, O(n) otherwise.
+ */
+AuraValue auraBigIntNegate(AuraValue a) {
+    if (!requireBigInt("negate", a, a)) return createNULL();
+    if (AURA_IS_SBIG(a) && AURA_AS_SBIG(a) != INT64_MIN) return auraBigIntFromInt64(-AURA_AS_SBIG(a));
+
+    BigIntView x;
+    viewOf(a, &x);
+    return auraBigIntFromLimbs(x.limbs, x.length, !x.negative);
+}
+
+/**
+ * Adds two BigInts.
+ *
+ * @return A new BigInt, or AURA_NULL if an operand is not a BigInt.
+ * @complexity O(1) inline, O(n) otherwise.
+ */
+AuraValue auraBigIntAdd(AuraValue a, AuraValue b) {
+    int64_t r;
+    if (AURA_IS_SBIG(a) && AURA_IS_SBIG(b) && !checkedAdd(AURA_AS_SBIG(a), AURA_AS_SBIG(b), &r)) {
+        return auraBigIntFromInt64(r);
+    }
+    if (!requireBigInt("add", a, b)) return createNULL();
+    BigIntView x, y;
+    viewOf(a, &x);
+    viewOf(b, &y);
+    return addSigned(&x, x.negative, &y, y.negative, "add");
+}
+
+/**
+ * Subtracts two BigInts (a - b).
+ *
+ * @return A new BigInt, or AURA_NULL if an operand is not a BigInt.
+ * @complexity O(1) inline, O(n) otherwise.
+ */
+AuraValue auraBigIntSub(AuraValue a, AuraValue b) {
+    int64_t r;
+    if (AURA_IS_SBIG(a) && AURA_IS_SBIG(b) && !checkedSub(AURA_AS_SBIG(a), AURA_AS_SBIG(b), &r)) {
+        return auraBigIntFromInt64(r);
+    }
+    if (!requireBigInt("sub", a, b)) return createNULL();
+    BigIntView x, y;
+    viewOf(a, &x);
+    viewOf(b, &y);
+    return addSigned(&x, x.negative, &y, !y.negative, "sub");
+}
+
+/**
+ * Multiplies two BigInts (see bigint_mul.c for the algorithms).
+ *
+ * @return A new BigInt, or AURA_NULL if an operand is not a BigInt.
+ * @complexity O(1) inline, O(n^2) to O(n^1.465) depending on size otherwise.
+ */
+AuraValue auraBigIntMul(AuraValue a, AuraValue b) {
+    int64_t product;
+    if (AURA_IS_SBIG(a) && AURA_IS_SBIG(b) && !checkedMul(AURA_AS_SBIG(a), AURA_AS_SBIG(b), &product)) {
+        return auraBigIntFromInt64(product);
+    }
+    if (!requireBigInt("mul", a, b)) return createNULL();
+    BigIntView x, y;
+    viewOf(a, &x);
+    viewOf(b, &y);
+
+    AuraBigInt* r = allocateBigInt(x.length + y.length, "mul");
+    if (r == NULL) return createNULL();
+    if (x.length != 0 && y.length != 0 && !auraLimbsMul(r->limbs, x.limbs, x.length, y.limbs, y.length)) {
+        auraFreeObject(&r->obj);
+        fprintf(stderr, "[Fatal Error] Out of memory in BigInt mul.\n");
+        return createNULL();
+    }
+    return finishBigInt(r, x.negative != y.negative);
+}
+
+/**
+ * Computes the truncated quotient or the remainder of a / b; the other one is
+ * not stored.
+ */
+static AuraValue divide(AuraValue a, AuraValue b, bool wantQuotient) {
+    const char* op = wantQuotient ? "div" : "rem";
+    if (!requireBigInt(op, a, b)) return createNULL();
+    BigIntView x, y;
+    viewOf(a, &x);
+    viewOf(b, &y);
+    if (y.length == 0) {
+        fprintf(stderr, "[Security] BigInt division by zero.\n");
+        return createNULL();
+    }
+
+    // INT64_MIN / -1 is the only inline quotient that overflows.
+    if (AURA_IS_SBIG(a) && AURA_IS_SBIG(b) && !(AURA_AS_SBIG(a) == INT64_MIN && AURA_AS_SBIG(b) == -1)) {
+        int64_t n = AURA_AS_SBIG(a), d = AURA_AS_SBIG(b);
+        return auraBigIntFromInt64(wantQuotient ? n / d : n % d);
+    }
+    if (x.length < y.length) {
+        return wantQuotient ? AURA_SBIG_VAL(0) : auraBigIntFromLimbs(x.limbs, x.length, x.negative);
+    }
+
+    size_t length = wantQuotient ? x.length - y.length + 1 : y.length;
+    AuraBigInt* r = allocateBigInt(length, op);
+    if (r == NULL) return createNULL();
+    bool ok = wantQuotient ? auraLimbsDivRem(r->limbs, NULL, x.limbs, x.length, y.limbs, y.length)
+                           : auraLimbsDivRem(NULL, r->limbs, x.limbs, x.length, y.limbs, y.length);
+    if (!ok) {
+        auraFreeObject(&r->obj);
+        fprintf(stderr, "[Fatal Error] Out of memory in BigInt %s.\n", op);
+        return createNULL();
+    }
+    return finishBigInt(r, wantQuotient ? x.negative != y.negative : x.negative);
+}
+
+/**
+ * Divides two BigInts, truncating toward zero.
+ *
+ * @return A new BigInt, or AURA_NULL on invalid operands or division by zero.
+ * @complexity O(1) inline, O(bn * (an - bn + 1)) otherwise.
+ */
+AuraValue auraBigIntDiv(AuraValue a, AuraValue b) {
+    return divide(a, b, true);
+}
+
+/**
+ * Remainder of a / b, with the sign of `a`.
+ *
+ * @return A new BigInt, or AURA_NULL on invalid operands or division by zero.
+ * @complexity O(1) inline, O(bn * (an - bn + 1)) otherwise.
+ */
+AuraValue auraBigIntRem(AuraValue a, AuraValue b) {
+    return divide(a, b, false);
+}
+
+// --- COMPARISON ---
+
+/**
+ * Compares two BigInt values by sign, then by magnitude.
+ *
+ * @return -1, 0 or 1 as a is less than, equal to or greater than b.
+ * @complexity O(1) inline, O(n) otherwise.
+ */
+int auraBigIntCompare(AuraValue a, AuraValue b) {
+    if (AURA_IS_SBIG(a) && AURA_IS_SBIG(b)) {
+        return (AURA_AS_SBIG(a) > AURA_AS_SBIG(b)) - (AURA_AS_SBIG(a) < AURA_AS_SBIG(b));
+    }
+    BigIntView x, y;
+    viewOf(a, &x);
+    viewOf(b, &y);
+    if (x.negative != y.negative) return x.negative ? -1 : 1;
+    int order = auraLimbsCompare(x.limbs, x.length, y.limbs, y.length);
+    return x.negative ? -order : order;
+}
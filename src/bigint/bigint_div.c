@@ -0,0 +1,201 @@
+/**
+ * @file bigint_div.c
+ * @brief Division of BigInt magnitudes.
+ *
+ * Knuth's algorithm D (TAOCP vol. 2, 4.3.1): the divisor is shifted so its
+ * top bit is set, which lets each quotient limb be estimated from the top two
+ * limbs of the running remainder and be off by at most one after a cheap
+ * correction. One estimate costs one 128-by-64-bit division and one fused
+ * multiply-subtract pass, so the whole division is O(bn * (an - bn + 1)).
+ *
+ * A divisor that is used many times (the powers of ten of the decimal
+ * conversion) can instead be divided by through its reciprocal (Barrett):
+ * the quotient is estimated with one product and checked with another, so
+ * the division costs O(M(n)) once the reciprocal is known. The reciprocal
+ * itself comes from one Newton step on a half-precision reciprocal.
+ */
+
+#include "limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+uint64_t auraLimbsDivRem1(uint64_t* q, const uint64_t* a, size_t n, uint64_t d) {
+    uint64_t rem = 0;
+    for (size_t i = n; i-- > 0;) {
+        q[i] = auraDivWide(rem, a[i], d, &rem);
+    }
+    return rem;
+}
+
+/**
+ * Estimates the quotient limb of u[0..2] / (v1 v0) for a normalized v1,
+ * exact or one too large (Knuth D3).
+ */
+static uint64_t estimateQuotient(const uint64_t* u, uint64_t v1, uint64_t v0) {
+    uint64_t qhat, rhat;
+    if (u[2] >= v1) {
+        qhat = UINT64_MAX;
+        rhat = u[1] + v1;
+        if (rhat < v1) return qhat;     // rhat >= B: the test below cannot fail.
+    } else {
+        qhat = auraDivWide(u[2], u[1], v1, &rhat);
+    }
+    for (;;) {
+        uint64_t lo;
+        uint64_t hi = auraMulWide(qhat, v0, &lo);
+        if (hi < rhat || (hi == rhat && lo <= u[0])) break;
+        qhat--;
+        uint64_t next = rhat + v1;
+        if (next < rhat) break;
+        rhat = next;
+    }
+    return qhat;
+}
+
+bool auraLimbsDivRem(uint64_t* q, uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    size_t qn = an - bn + 1;
+    if (bn == 1) {
+        uint64_t* quotient = q != NULL ? q : (uint64_t*)malloc(an * sizeof(uint64_t));
+        if (quotient == NULL) return false;
+        uint64_t rem = auraLimbsDivRem1(quotient, a, an, b[0]);
+        if (r != NULL) r[0] = rem;
+        if (quotient != q) free(quotient);
+        return true;
+    }
+
+    uint64_t* u = (uint64_t*)malloc((an + 1 + bn) * sizeof(uint64_t));
+    if (u == NULL) return false;
+    uint64_t* v = u + an + 1;
+
+    int shift = auraLimbLeadingZeros(b[bn - 1]);
+    if (shift > 0) {
+        auraLimbsShiftLeft(v, b, bn, shift);
+        u[an] = auraLimbsShiftLeft(u, a, an, shift);
+    } else {
+        memcpy(v, b, bn * sizeof(uint64_t));
+        memcpy(u, a, an * sizeof(uint64_t));
+        u[an] = 0;
+    }
+
+    for (size_t j = qn; j-- > 0;) {
+        uint64_t qhat = estimateQuotient(u + j + bn - 2, v[bn - 1], v[bn - 2]);
+        uint64_t borrow = auraLimbsSubMul1(u + j, v, bn, qhat);
+        uint64_t top = u[j + bn];
+        u[j + bn] = top - borrow;
+        if (top < borrow) {
+            // The estimate was one too large: add the divisor back (Knuth D6).
+            qhat--;
+            u[j + bn] += auraLimbsAdd(u + j, u + j, bn, v, bn);
+        }
+        if (q != NULL) q[j] = qhat;
+    }
+
+    if (r != NULL) {
+        // The remainder is below the divisor, so u[bn..an] is zero by now.
+        if (shift > 0) {
+            auraLimbsShiftRight(r, u, bn, shift);
+        } else {
+            memcpy(r, u, bn * sizeof(uint64_t));
+        }
+    }
+    free(u);
+    return true;
+}
+
+// --- Division by a precomputed reciprocal ---
+
+static const uint64_t ONE = 1;
+
+/** Compares x[0..xn) with B^k. */
+static int compareWithPower(const uint64_t* x, size_t xn, size_t k) {
+    xn = auraLimbsNormalize(x, xn);
+    if (xn != k + 1) return xn > k + 1 ? 1 : -1;
+    if (x[k] != 1) return 1;
+    return auraLimbsNormalize(x, k) != 0;
+}
+
+bool auraLimbsReciprocal(uint64_t* v, const uint64_t* d, size_t n) {
+    if (n < AURA_BIGINT_BARRETT_THRESHOLD) {
+        uint64_t* numerator = (uint64_t*)calloc(2 * n + 1, sizeof(uint64_t));
+        if (numerator == NULL) return false;
+        numerator[2 * n] = 1;
+        bool ok = auraLimbsDivRem(v, NULL, numerator, 2 * n + 1, d, n);
+        free(numerator);
+        return ok;
+    }
+
+    // The top h limbs give B^(2n) / d to about h - 1 limbs; one Newton step
+    // doubles that, which with 2h >= n + 4 leaves an error of a few units.
+    size_t h = (n + 1) / 2 + 2;
+    size_t vn = n + 3;
+    size_t en = n + vn;
+    size_t tn = vn + en;
+    uint64_t* block = (uint64_t*)malloc((vn + en + tn) * sizeof(uint64_t));
+    if (block == NULL) return false;
+    uint64_t* v0 = block;
+    uint64_t* e = v0 + vn;
+    uint64_t* t = e + en;
+
+    // v0 = (B^(2h) / dh + 1) * B^(n - h) overestimates B^(2n) / d.
+    memset(v0, 0, vn * sizeof(uint64_t));
+    uint64_t* vh = v0 + (n - h);
+    bool ok = auraLimbsReciprocal(vh, d + (n - h), h);
+    if (ok) {
+        auraLimbsAdd(vh, vh, h + 3, &ONE, 1);
+
+        // e = d * v0 - B^(2n) > 0, then v0 -= v0 * e / B^(2n).
+        ok = auraLimbsMul(e, d, n, v0, vn);
+        if (ok) {
+            auraLimbsSub(e + 2 * n, e + 2 * n, en - 2 * n, &ONE, 1);
+            ok = auraLimbsMul(t, v0, vn, e, en);
+        }
+        if (ok) {
+            auraLimbsSub(v0, v0, vn, t + 2 * n, auraLimbsNormalize(t + 2 * n, tn - 2 * n));
+            ok = auraLimbsMul(e, d, n, v0, vn);
+        }
+    }
+    if (ok) {
+        // Fix the last units so that v0 * d <= B^(2n) < (v0 + 1) * d.
+        while (compareWithPower(e, en, 2 * n) > 0) {
+            auraLimbsSub(v0, v0, vn, &ONE, 1);
+            auraLimbsSub(e, e, en, d, n);
+        }
+        for (;;) {
+            auraLimbsAdd(e, e, en, d, n);
+            if (compareWithPower(e, en, 2 * n) > 0) break;
+            auraLimbsAdd(v0, v0, vn, &ONE, 1);
+        }
+        memcpy(v, v0, (n + 2) * sizeof(uint64_t));
+    }
+    free(block);
+    return ok;
+}
+
+bool auraLimbsDivRemPre(uint64_t* q, uint64_t* r, const uint64_t* a, size_t an, const uint64_t* d, size_t n,
+                        const uint64_t* v) {
+    // The estimate floor(floor(a / B^(n-1)) * v / B^(n+1)) is at most 3 below
+    // the quotient and never above it.
+    size_t top = an - n + 1;
+    size_t tn = top + n + 2;
+    size_t qn = tn - (n + 1);
+    size_t pn = qn + n;
+    uint64_t* block = (uint64_t*)malloc((tn + pn + an) * sizeof(uint64_t));
+    if (block == NULL) return false;
+    uint64_t* t = block;
+    uint64_t* p = t + tn;
+    uint64_t* rem = p + pn;
+    uint64_t* quotient = t + n + 1;
+
+    bool ok = auraLimbsMul(t, a + n - 1, top, v, n + 2) && auraLimbsMul(p, quotient, qn, d, n);
+    if (ok) {
+        auraLimbsSub(rem, a, an, p, auraLimbsNormalize(p, pn));
+        while (auraLimbsCompare(rem, auraLimbsNormalize(rem, an), d, n) >= 0) {
+            auraLimbsSub(rem, rem, an, d, n);
+            auraLimbsAdd(quotient, quotient, qn, &ONE, 1);
+        }
+        if (q != NULL) memcpy(q, quotient, (an - n + 1) * sizeof(uint64_t));
+        if (r != NULL) memcpy(r, rem, n * sizeof(uint64_t));
+    }
+    free(block);
+    return ok;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file bigint_mul.c
+ * @brief Multiplication of BigInt magnitudes.
+ *
+ * Three algorithms, picked by operand size at every level of the recursion:
+ * - Schoolbook, O(n^2), below AURA_BIGINT_KARATSUBA_THRESHOLD limbs, where
+ *   its tight multiply-accumulate loop beats any split.
+ * - Karatsuba, O(n^1.585): three half-size products instead of four.
+ * - Toom-3, O(n^1.465), from AURA_BIGINT_TOOM3_THRESHOLD limbs: five
+ *   third-size products, evaluated at 0, 1, -1, -2 and infinity and
+ *   interpolated with Bodrato's sequence.
+ *
+ * Operands of very different lengths are cut into chunks of the shorter
+ * length first, so the splitting algorithms always see balanced inputs.
+ * Temporaries are allocated per recursion node; the smallest node already
+ * does thousands of limb products, which hides the allocation.
+ */
+
+#include "limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool mulRec(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/** r[0..an + bn) = a * b for 1 <= bn <= an. */
+static void mulSchoolbook(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    r[an] = auraLimbsMul1(r, a, an, b[0]);
+    for (size_t j = 1; j < bn; j++) {
+        r[an + j] = auraLimbsAddMul1(r + j, a, an, b[j]);
+    }
+}
+
+/**
+ * r[0..an + bn) = a * b by cutting `a` into chunks of `chunk` limbs and
+ * accumulating chunk * b, for chunk <= an and bn <= chunk.
+ */
+static bool mulSplit(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, size_t chunk) {
+    uint64_t* t = (uint64_t*)malloc((chunk + bn) * sizeof(uint64_t));
+    if (t == NULL) return false;
+
+    bool ok = mulRec(r, a, chunk, b, bn);
+    for (size_t i = chunk; ok && i < an; i += chunk) {
+        size_t len = an - i < chunk ? an - i : chunk;
+        ok = mulRec(t, a + i, len, b, bn);
+        // r[i + bn ..) has not been written yet.
+        memset(r + i + bn, 0, len * sizeof(uint64_t));
+        auraLimbsAdd(r + i, r + i, len + bn, t, len + bn);
+    }
+    free(t);
+    return ok;
+}
+
+/**
+ * Karatsuba for an/2 < bn <= an: with h = ceil(an / 2),
+ * a * b = z2 B^2h + (z1 - z2 - z0) B^h + z0 where z0 = a0 b0, z2 = a1 b1 and
+ * z1 = (a0 + a1)(b0 + b1). z0 and z2 are computed straight into `r`.
+ */
+static bool mulKaratsuba(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    size_t h = (an + 1) / 2;
+    if (bn <= h) return mulSplit(r, a, an, b, bn, h);
+
+    uint64_t* sa = (uint64_t*)malloc((4 * h + 4) * sizeof(uint64_t));
+    if (sa == NULL) return false;
+    uint64_t* sb = sa + h + 1;
+    uint64_t* z1 = sb + h + 1;
+
+    sa[h] = auraLimbsAdd(sa, a, h, a + h, an - h);
+    sb[h] = auraLimbsAdd(sb, b, h, b + h, bn - h);
+
+    bool ok = mulRec(r, a, h, b, h) &&
+              mulRec(r + 2 * h, a + h, an - h, b + h, bn - h) &&
+              mulRec(z1, sa, h + 1, sb, h + 1);
+    if (ok) {
+        auraLimbsSub(z1, z1, 2 * h + 2, r, 2 * h);
+        auraLimbsSub(z1, z1, 2 * h + 2, r + 2 * h, an + bn - 2 * h);
+        auraLimbsAdd(r + h, r + h, an + bn - h, z1, auraLimbsNormalize(z1, 2 * h + 2));
+    }
+    free(sa);
+    return ok;
+}
+
+// --- Two's complement helpers for Toom-3 ---
+//
+// Evaluation points and interpolation steps go negative, so they work on
+// fixed-width two's complement numbers: plain limb addition and subtraction
+// are then exact as long as every intermediate fits the width.
+
+static bool tcIsNegative(const uint64_t* x, size_t w) {
+    return (x[w - 1] >> 63) != 0;
+}
+
+static void tcNegate(uint64_t* x, size_t w) {
+    uint64_t carry = 1;
+    for (size_t i = 0; i < w; i++) {
+        uint64_t v = ~x[i] + carry;
+        carry = carry && v == 0;
+        x[i] = v;
+    }
+}
+
+/** Copies an n-limb magnitude into a w-limb number, zero-extending it. */
+static void tcLoad(uint64_t* x, size_t w, const uint64_t* src, size_t n) {
+    memcpy(x, src, n * sizeof(uint64_t));
+    memset(x + n, 0, (w - n) * sizeof(uint64_t));
+}
+
+/** x = x / 2 for an even x. */
+static void tcHalve(uint64_t* x, size_t w) {
+    uint64_t sign = x[w - 1] & ((uint64_t)1 << 63);
+    auraLimbsShiftRight(x, x, w, 1);
+    x[w - 1] |= sign;
+}
+
+/**
+ * x = x / 3 for a multiple of 3: the quotient is the only solution of
+ * 3q = x modulo 2^(64w), found limb by limb with the inverse of 3.
+ */
+static void tcDivExact3(uint64_t* x, size_t w) {
+    const uint64_t inverse3 = 0xaaaaaaaaaaaaaaabULL;
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < w; i++) {
+        uint64_t s = x[i];
+        uint64_t l = s - borrow;
+        borrow = l > s;
+        uint64_t q = l * inverse3;
+        x[i] = q;
+        uint64_t lo;
+        borrow += auraMulWide(q, 3, &lo);
+    }
+}
+
+/** out[0..2e) = x * y for e-limb two's complement x and y. */
+static bool tcMul(uint64_t* out, const uint64_t* x, const uint64_t* y, size_t e, uint64_t* scratch) {
+    uint64_t* ax = scratch;
+    uint64_t* ay = scratch + e;
+    bool nx = tcIsNegative(x, e), ny = tcIsNegative(y, e);
+    memcpy(ax, x, e * sizeof(uint64_t));
+    memcpy(ay, y, e * sizeof(uint64_t));
+    if (nx) tcNegate(ax, e);
+    if (ny) tcNegate(ay, e);
+    if (!mulRec(out, ax, e, ay, e)) return false;
+    if (nx != ny) tcNegate(out, 2 * e);
+    return true;
+}
+
+/** Evaluates x0 + x1 t + x2 t^2 (k-limb parts) at 1, -1 and -2 into e-limb numbers. */
+static void toom3Evaluate(uint64_t* p1, uint64_t* pm1, uint64_t* pm2, const uint64_t* x, size_t k, size_t e,
+                          uint64_t* tmp) {
+    tcLoad(p1, e, x, k);
+    tcLoad(tmp, e, x + 2 * k, k);
+    auraLimbsAdd(p1, p1, e, tmp, e);            // x0 + x2
+    tcLoad(pm1, e, x + k, k);
+    auraLimbsSub(pm1, p1, e, pm1, e);           // x0 - x1 + x2
+    tcLoad(pm2, e, x + k, k);
+    auraLimbsAdd(p1, p1, e, pm2, e);            // x0 + x1 + x2
+    auraLimbsAdd(pm2, pm1, e, tmp, e);          // x0 - x1 + 2 x2
+    auraLimbsShiftLeft(pm2, pm2, e, 1);         // 2 x0 - 2 x1 + 4 x2
+    tcLoad(tmp, e, x, k);
+    auraLimbsSub(pm2, pm2, e, tmp, e);          // x0 - 2 x1 + 4 x2
+}
+
+/** Toom-3 for an/2 < bn <= an: both operands are zero-padded to 3k limbs. */
+static bool mulToom3(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    size_t k = (an + 2) / 3;
+    size_t e = k + 2;               // Evaluations: |value| <= 7 B^k.
+    size_t w = 2 * e;               // Products and interpolation: |value| <= 49 B^2k.
+
+    uint64_t* block = (uint64_t*)calloc(6 * k + 8 * e + 5 * w, sizeof(uint64_t));
+    if (block == NULL) return false;
+    uint64_t* pa = block;
+    uint64_t* pb = pa + 3 * k;
+    uint64_t* ea = pb + 3 * k;      // a(1), a(-1), a(-2)
+    uint64_t* eb = ea + 3 * e;      // b(1), b(-1), b(-2)
+    uint64_t* tmp = eb + 3 * e;     // 2e limbs of scratch
+    uint64_t* r0 = tmp + 2 * e;
+    uint64_t* r1 = r0 + w;
+    uint64_t* rm1 = r1 + w;
+    uint64_t* rm2 = rm1 + w;
+    uint64_t* rinf = rm2 + w;
+
+    memcpy(pa, a, an * sizeof(uint64_t));
+    memcpy(pb, b, bn * sizeof(uint64_t));
+    toom3Evaluate(ea, ea + e, ea + 2 * e, pa, k, e, tmp);
+    toom3Evaluate(eb, eb + e, eb + 2 * e, pb, k, e, tmp);
+
+    bool ok = mulRec(r0, pa, k, pb, k) &&
+              mulRec(rinf, pa + 2 * k, k, pb + 2 * k, k) &&
+              tcMul(r1, ea, eb, e, tmp) &&
+              tcMul(rm1, ea + e, eb + e, e, tmp) &&
+              tcMul(rm2, ea + 2 * e, eb + 2 * e, e, tmp);
+    if (ok) {
+        memset(r0 + 2 * k, 0, (w - 2 * k) * sizeof(uint64_t));
+        memset(rinf + 2 * k, 0, (w - 2 * k) * sizeof(uint64_t));
+
+        // Bodrato: r(-2), r(1), r(-1) become the coefficients c3, c1, c2.
+        auraLimbsSub(rm2, rm2, w, r1, w);       // r(-2) - r(1)
+        tcDivExact3(rm2, w);
+        auraLimbsSub(r1, r1, w, rm1, w);        // r(1) - r(-1)
+        tcHalve(r1, w);
+        auraLimbsSub(rm1, rm1, w, r0, w);       // r(-1) - r(0)
+        auraLimbsSub(rm2, rm1, w, rm2, w);
+        tcHalve(rm2, w);
+        auraLimbsAdd(rm2, rm2, w, rinf, w);
+        auraLimbsAdd(rm2, rm2, w, rinf, w);     // c3
+        auraLimbsAdd(rm1, rm1, w, r1, w);
+        auraLimbsSub(rm1, rm1, w, rinf, w);     // c2
+        auraLimbsSub(r1, r1, w, rm2, w);        // c1
+
+        // Every coefficient is non-negative and c_i B^(ik) stays below a * b.
+        size_t rn = an + bn;
+        const uint64_t* coefficients[5] = { r0, r1, rm1, rm2, rinf };
+        memset(r, 0, rn * sizeof(uint64_t));
+        for (size_t i = 0; i < 5; i++) {
+            size_t offset = i * k;
+            size_t cn = auraLimbsNormalize(coefficients[i], w);
+            if (cn == 0) continue;
+            auraLimbsAdd(r + offset, r + offset, rn - offset, coefficients[i], cn);
+        }
+    }
+    free(block);
+    return ok;
+}
+
+/** r[0..an + bn) = a * b for any lengths; the inputs may have leading zero limbs. */
+static bool mulRec(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    size_t rn = an + bn;
+    an = auraLimbsNormalize(a, an);
+    bn = auraLimbsNormalize(b, bn);
+    if (an < bn) {
+        const uint64_t* t = a; a = b; b = t;
+        size_t tn = an; an = bn; bn = tn;
+    }
+    if (bn == 0) {
+        memset(r, 0, rn * sizeof(uint64_t));
+        return true;
+    }
+    memset(r + an + bn, 0, (rn - an - bn) * sizeof(uint64_t));
+
+    if (bn < AURA_BIGINT_KARATSUBA_THRESHOLD) {
+        mulSchoolbook(r, a, an, b, bn);
+        return true;
+    }
+    if (2 * bn <= an) return mulSplit(r, a, an, b, bn, bn);
+    if (bn >= AURA_BIGINT_TOOM3_THRESHOLD) return mulToom3(r, a, an, b, bn);
+    return mulKaratsuba(r, a, an, b, bn);
+}
+
+bool auraLimbsMul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    return mulRec(r, a, an, b, bn);
+}
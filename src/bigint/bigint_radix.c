@@ -0,0 +1,281 @@
+/**
+ * @file bigint_radix.c
+ * @brief Decimal conversion of BigInt magnitudes.
+ *
+ * Both directions divide and conquer around the powers P[k] = 10^(19 * 2^k),
+ * which are computed once per conversion by repeated squaring and shared by
+ * every node of the recursion:
+ * - Parsing splits the digits at 19 * 2^k from the right and computes
+ *   high * P[k] + low, so the work is dominated by a few balanced products
+ *   per level: O(M(n) log n).
+ * - Printing splits the value into value / P[k] and value % P[k], which become
+ *   the leading and the trailing (zero-padded) 19 * 2^k digits. Divisors of
+ *   AURA_BIGINT_BARRETT_THRESHOLD limbs or more are divided through their
+ *   reciprocal, computed once per power, which also makes this
+ *   O(M(n) log n).
+ * Below AURA_BIGINT_RADIX_THRESHOLD limbs both fall back to the quadratic
+ * method: one 19-digit chunk per single-limb multiplication or division.
+ */
+
+#include "limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** 2^64 levels are never reached: AURA_BIGINT_MAX_LIMBS needs about 25. */
+#define MAX_POWERS 48
+
+typedef struct {
+    uint64_t* limbs;
+    size_t length;
+    uint64_t* inverse;      // floor(B^(2 * length) / limbs), computed on first use.
+} Power;
+
+typedef struct {
+    Power powers[MAX_POWERS];
+    size_t count;
+} PowerTable;
+
+/**
+ * Computes P[0..levels), stopping early at the first power longer than
+ * `maxLength` limbs.
+ */
+static bool buildPowers(PowerTable* table, size_t levels, size_t maxLength) {
+    memset(table, 0, sizeof(*table));
+    if (levels > MAX_POWERS) levels = MAX_POWERS;
+    while (table->count < levels) {
+        Power* p = &table->powers[table->count];
+        if (table->count == 0) {
+            p->limbs = (uint64_t*)malloc(sizeof(uint64_t));
+            if (p->limbs == NULL) return false;
+            p->limbs[0] = AURA_DECIMAL_CHUNK;
+            p->length = 1;
+        } else {
+            const Power* previous = p - 1;
+            size_t length = 2 * previous->length;
+            if (length - 1 > maxLength) break;
+            p->limbs = (uint64_t*)malloc(length * sizeof(uint64_t));
+            if (p->limbs == NULL) return false;
+            if (!auraLimbsMul(p->limbs, previous->limbs, previous->length, previous->limbs, previous->length)) {
+                free(p->limbs);
+                p->limbs = NULL;
+                return false;
+            }
+            p->length = auraLimbsNormalize(p->limbs, length);
+            if (p->length > maxLength) {
+                free(p->limbs);
+                p->limbs = NULL;
+                break;
+            }
+        }
+        table->count++;
+    }
+    return true;
+}
+
+static void freePowers(PowerTable* table) {
+    for (size_t i = 0; i < MAX_POWERS; i++) {
+        free(table->powers[i].limbs);
+        free(table->powers[i].inverse);
+    }
+}
+
+// --- Parsing ---
+
+/**
+ * r[0..count) = the number whose base-10^19 digits are chunks[0..count),
+ * least significant first.
+ */
+static bool fromChunks(uint64_t* r, const uint64_t* chunks, size_t count, const PowerTable* table) {
+    if (count <= AURA_BIGINT_RADIX_THRESHOLD) {
+        size_t n = 0;
+        for (size_t i = count; i-- > 0;) {
+            uint64_t carry = auraLimbsMul1(r, r, n, AURA_DECIMAL_CHUNK);
+            uint64_t add = chunks[i];
+            for (size_t j = 0; j < n && add != 0; j++) {
+                r[j] += add;
+                add = r[j] < add;
+            }
+            carry += add;
+            if (carry != 0) r[n++] = carry;
+        }
+        memset(r + n, 0, (count - n) * sizeof(uint64_t));
+        return true;
+    }
+
+    // Split at m = 2^k < count chunks: r = high * P[k] + low.
+    size_t k = 0;
+    while (((size_t)2 << k) < count) k++;
+    size_t m = (size_t)1 << k;
+    const Power* p = &table->powers[k];
+
+    size_t hn = count - m;
+    size_t pn = hn + p->length;
+    size_t wn = pn > count ? pn : count;
+    uint64_t* high = (uint64_t*)malloc((hn + wn) * sizeof(uint64_t));
+    if (high == NULL) return false;
+    uint64_t* product = high + hn;
+
+    bool ok = fromChunks(r, chunks, m, table) &&
+              fromChunks(high, chunks + m, hn, table) &&
+              auraLimbsMul(product, high, hn, p->limbs, p->length);
+    if (ok) {
+        // The sum is below 10^(19 * count) < B^count: limbs past count are zero.
+        memset(product + pn, 0, (wn - pn) * sizeof(uint64_t));
+        auraLimbsAdd(product, product, wn, r, m);
+        memcpy(r, product, count * sizeof(uint64_t));
+    }
+    free(high);
+    return ok;
+}
+
+bool auraLimbsFromDecimal(uint64_t* r, const char* digits, size_t count) {
+    size_t chunkCount = (count + AURA_DECIMAL_CHUNK_DIGITS - 1) / AURA_DECIMAL_CHUNK_DIGITS;
+    if (chunkCount == 0) return true;
+    uint64_t* chunks = (uint64_t*)malloc(chunkCount * sizeof(uint64_t));
+    if (chunks == NULL) return false;
+
+    // Chunk i holds the digits [count - 19 (i + 1), count - 19 i).
+    size_t end = count;
+    for (size_t i = 0; i < chunkCount; i++) {
+        size_t start = end > AURA_DECIMAL_CHUNK_DIGITS ? end - AURA_DECIMAL_CHUNK_DIGITS : 0;
+        uint64_t chunk = 0;
+        for (size_t j = start; j < end; j++) chunk = chunk * 10 + (uint64_t)(digits[j] - '0');
+        chunks[i] = chunk;
+        end = start;
+    }
+
+    size_t levels = 0;
+    while (((size_t)1 << levels) < chunkCount) levels++;
+    PowerTable table;
+    bool ok = buildPowers(&table, levels, chunkCount) && fromChunks(r, chunks, chunkCount, &table);
+    freePowers(&table);
+    free(chunks);
+    return ok;
+}
+
+// --- Printing ---
+
+/** Writes the low `chunkCount` 19-digit chunks of a[0..n) (destroyed), zero-padded, to out. */
+static void chunksToDigits(char* out, uint64_t* a, size_t n, size_t chunkCount) {
+    char* p = out + chunkCount * AURA_DECIMAL_CHUNK_DIGITS;
+    for (size_t i = 0; i < chunkCount; i++) {
+        uint64_t chunk = auraLimbsDivRem1(a, a, n, AURA_DECIMAL_CHUNK);
+        n = auraLimbsNormalize(a, n);
+        for (int j = 0; j < AURA_DECIMAL_CHUNK_DIGITS; j++) {
+            *--p = (char)('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+}
+
+/**
+ * Splits a[0..n) < P[k]^2 into q[0..qn) = a / P[k] and r = a % P[k], which
+ * has P[k].length limbs. q must hold n limbs. `threshold` is the divisor
+ * length from which computing the reciprocal pays off.
+ */
+static bool divideByPower(uint64_t* q, size_t* qn, uint64_t* r, const uint64_t* a, size_t n, Power* p,
+                          size_t threshold) {
+    size_t pn = p->length;
+    if (n < pn) {
+        *qn = 0;
+        memcpy(r, a, n * sizeof(uint64_t));
+        memset(r + n, 0, (pn - n) * sizeof(uint64_t));
+        return true;
+    }
+    *qn = n - pn + 1;
+    if (pn < threshold && p->inverse == NULL) return auraLimbsDivRem(q, r, a, n, p->limbs, pn);
+
+    if (p->inverse == NULL) {
+        p->inverse = (uint64_t*)malloc((pn + 2) * sizeof(uint64_t));
+        if (p->inverse == NULL) return false;
+        if (!auraLimbsReciprocal(p->inverse, p->limbs, pn)) {
+            free(p->inverse);
+            p->inverse = NULL;
+            return false;
+        }
+    }
+    return auraLimbsDivRemPre(q, r, a, n, p->limbs, pn, p->inverse);
+}
+
+/** Writes exactly 19 * 2^k digits of a[0..n) < P[k], zero-padded, to out. */
+static bool toPaddedDigits(char* out, const uint64_t* a, size_t n, size_t k, PowerTable* table) {
+    n = auraLimbsNormalize(a, n);
+    size_t chunkCount = (size_t)1 << k;
+    if (k == 0 || table->powers[k].length <= AURA_BIGINT_RADIX_THRESHOLD) {
+        uint64_t* work = (uint64_t*)malloc((n + 1) * sizeof(uint64_t));
+        if (work == NULL) return false;
+        memcpy(work, a, n * sizeof(uint64_t));
+        chunksToDigits(out, work, n, chunkCount);
+        free(work);
+        return true;
+    }
+
+    Power* half = &table->powers[k - 1];
+    uint64_t* q = (uint64_t*)malloc((n + half->length) * sizeof(uint64_t));
+    if (q == NULL) return false;
+    uint64_t* r = q + n;
+    size_t qn;
+    bool ok = divideByPower(q, &qn, r, a, n, half, AURA_BIGINT_BARRETT_THRESHOLD) &&
+              toPaddedDigits(out, q, qn, k - 1, table) &&
+              toPaddedDigits(out + (chunkCount / 2) * AURA_DECIMAL_CHUNK_DIGITS, r, half->length, k - 1, table);
+    free(q);
+    return ok;
+}
+
+/** Writes the digits of a[0..n) without leading zeros to out and their number to *count. */
+static bool toDigits(char* out, size_t* count, const uint64_t* a, size_t n, PowerTable* table) {
+    n = auraLimbsNormalize(a, n);
+    if (n <= AURA_BIGINT_RADIX_THRESHOLD) {
+        char local[(AURA_BIGINT_RADIX_THRESHOLD + 1) * 20];
+        uint64_t work[AURA_BIGINT_RADIX_THRESHOLD];
+        memcpy(work, a, n * sizeof(uint64_t));
+
+        // Digits are produced least significant first, from the end of the buffer.
+        char* end = local + sizeof(local);
+        char* p = end;
+        while (n > 0) {
+            uint64_t chunk = auraLimbsDivRem1(work, work, n, AURA_DECIMAL_CHUNK);
+            n = auraLimbsNormalize(work, n);
+            for (int i = 0; i < AURA_DECIMAL_CHUNK_DIGITS && (n > 0 || chunk != 0); i++) {
+                *--p = (char)('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        if (p == end) *--p = '0';
+        *count = (size_t)(end - p);
+        memcpy(out, p, *count);
+        return true;
+    }
+
+    // The largest P[k] <= a gives a / P[k] < P[k]: it has no more digits than
+    // the 19 * 2^k of the remainder. This division happens once per level, so
+    // the reciprocal only pays off on much longer divisors than below.
+    size_t k = table->count - 1;
+    while (auraLimbsCompare(table->powers[k].limbs, table->powers[k].length, a, n) > 0) k--;
+    Power* p = &table->powers[k];
+
+    uint64_t* q = (uint64_t*)malloc((n + p->length) * sizeof(uint64_t));
+    if (q == NULL) return false;
+    uint64_t* r = q + n;
+    size_t qn, leading;
+    bool ok = divideByPower(q, &qn, r, a, n, p, 4 * AURA_BIGINT_BARRETT_THRESHOLD) &&
+              toDigits(out, &leading, q, qn, table) &&
+              toPaddedDigits(out + leading, r, p->length, k, table);
+    if (ok) *count = leading + ((size_t)1 << k) * AURA_DECIMAL_CHUNK_DIGITS;
+    free(q);
+    return ok;
+}
+
+bool auraLimbsToDecimal(char* digits, size_t* count, const uint64_t* a, size_t n) {
+    n = auraLimbsNormalize(a, n);
+    PowerTable table;
+    bool ok = true;
+    if (n <= AURA_BIGINT_RADIX_THRESHOLD) {
+        memset(&table, 0, sizeof(table));
+    } else {
+        ok = buildPowers(&table, MAX_POWERS, n);
+    }
+    ok = ok && toDigits(digits, count, a, n, &table);
+    freePowers(&table);
+    return ok;
+}
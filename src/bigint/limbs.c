@@ -0,0 +1,117 @@
+/**
+ * @file limbs.c
+ * @brief Linear-time operations on BigInt magnitudes.
+ *
+ * The building blocks of every BigInt algorithm: carry-propagating addition
+ * and subtraction, multiply-accumulate by one limb and shifts. Each is a
+ * single pass over the limbs.
+ */
+
+#include "limbs.h"
+
+/**
+ * Compares two normalized magnitudes.
+ *
+ * @return -1, 0 or 1 as a is less than, equal to or greater than b.
+ * @complexity O(n)
+ */
+int auraLimbsCompare(const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (size_t i = an; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+uint64_t auraLimbsAdd(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        uint64_t s = a[i] + carry;
+        carry = s < carry;
+        uint64_t t = s + b[i];
+        carry += t < s;
+        r[i] = t;
+    }
+    for (; i < an; i++) {
+        uint64_t s = a[i] + carry;
+        carry = s < carry;
+        r[i] = s;
+    }
+    return carry;
+}
+
+uint64_t auraLimbsSub(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    uint64_t borrow = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        uint64_t d = a[i] - b[i];
+        uint64_t nb = d > a[i];
+        r[i] = d - borrow;
+        borrow = nb + (r[i] > d);
+    }
+    for (; i < an; i++) {
+        uint64_t d = a[i] - borrow;
+        borrow = d > a[i];
+        r[i] = d;
+    }
+    return borrow;
+}
+
+uint64_t auraLimbsMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t lo;
+        uint64_t hi = auraMulWide(a[i], m, &lo);
+        lo += carry;
+        carry = hi + (lo < carry);
+        r[i] = lo;
+    }
+    return carry;
+}
+
+uint64_t auraLimbsAddMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t lo;
+        uint64_t hi = auraMulWide(a[i], m, &lo);
+        lo += carry;
+        hi += lo < carry;
+        uint64_t s = r[i] + lo;
+        carry = hi + (s < lo);
+        r[i] = s;
+    }
+    return carry;
+}
+
+uint64_t auraLimbsSubMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t lo;
+        uint64_t hi = auraMulWide(a[i], m, &lo);
+        lo += borrow;
+        hi += lo < borrow;
+        uint64_t d = r[i] - lo;
+        borrow = hi + (d > r[i]);
+        r[i] = d;
+    }
+    return borrow;
+}
+
+uint64_t auraLimbsShiftLeft(uint64_t* r, const uint64_t* a, size_t n, int shift) {
+    if (n == 0) return 0;
+    uint64_t out = a[n - 1] >> (64 - shift);
+    for (size_t i = n - 1; i > 0; i--) {
+        r[i] = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+    }
+    r[0] = a[0] << shift;
+    return out;
+}
+
+void auraLimbsShiftRight(uint64_t* r, const uint64_t* a, size_t n, int shift) {
+    if (n == 0) return;
+    for (size_t i = 0; i + 1 < n; i++) {
+        r[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+    }
+    r[n - 1] = a[n - 1] >> shift;
+}
@@ -0,0 +1,172 @@
+#ifndef minijs_limbs_h
+#define minijs_limbs_h
+
+/**
+ * @file limbs.h
+ * @brief Private interface of the BigInt magnitude arithmetic.
+ *
+ * A magnitude is an array of 64-bit limbs, least significant first. These
+ * routines never allocate the result: the caller passes an output array of
+ * the documented size. Unless stated otherwise the output must not overlap
+ * the inputs and lengths are not required to be normalized.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Operands shorter than this (in limbs) are multiplied with the schoolbook method. */
+#define AURA_BIGINT_KARATSUBA_THRESHOLD 32
+
+/** Balanced operands of at least this many limbs are multiplied with Toom-3. */
+#define AURA_BIGINT_TOOM3_THRESHOLD 100
+
+/** Reused divisors of at least this many limbs are divided through their reciprocal. */
+#define AURA_BIGINT_BARRETT_THRESHOLD 2000
+
+/** Decimal conversion switches to the quadratic method below this many limbs. */
+#define AURA_BIGINT_RADIX_THRESHOLD 30
+
+/** 10^19, the largest power of ten that fits in a limb. */
+#define AURA_DECIMAL_CHUNK 10000000000000000000ULL
+#define AURA_DECIMAL_CHUNK_DIGITS 19
+
+// --- Double-limb primitives ---
+
+#if defined(__SIZEOF_INT128__)
+
+/** Returns the high limb of `a * b` and stores the low one in `*lo`. */
+static inline uint64_t auraMulWide(uint64_t a, uint64_t b, uint64_t* lo) {
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *lo = (uint64_t)p;
+    return (uint64_t)(p >> 64);
+}
+
+/** Divides `hi:lo` by `d` (requires hi < d): returns the quotient and stores the remainder. */
+static inline uint64_t auraDivWide(uint64_t hi, uint64_t lo, uint64_t d, uint64_t* rem) {
+    unsigned __int128 n = ((unsigned __int128)hi << 64) | lo;
+    *rem = (uint64_t)(n % d);
+    return (uint64_t)(n / d);
+}
+
+#else
+
+static inline uint64_t auraMulWide(uint64_t a, uint64_t b, uint64_t* lo) {
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *lo = (mid << 32) | (uint32_t)p00;
+    return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+/** Bit-serial fallback: only used by compilers without a 128-bit integer type. */
+static inline uint64_t auraDivWide(uint64_t hi, uint64_t lo, uint64_t d, uint64_t* rem) {
+    uint64_t q = 0;
+    for (int i = 63; i >= 0; i--) {
+        uint64_t top = hi >> 63;
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if (top || hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    *rem = hi;
+    return q;
+}
+
+#endif
+
+/** Number of leading zero bits of a non-zero limb. */
+static inline int auraLimbLeadingZeros(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & ((uint64_t)1 << 63))) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+/** Length of `a` without its leading zero limbs. */
+static inline size_t auraLimbsNormalize(const uint64_t* a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) n--;
+    return n;
+}
+
+// --- Linear operations (limbs.c) ---
+
+int auraLimbsCompare(const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/** r[0..an) = a + b for an >= bn; returns the carry. `r` may alias `a`. */
+uint64_t auraLimbsAdd(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/** r[0..an) = a - b for an >= bn; returns the borrow. `r` may alias `a`. */
+uint64_t auraLimbsSub(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/** r[0..n) = a * m; returns the carry limb. `r` may alias `a`. */
+uint64_t auraLimbsMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m);
+
+/** r[0..n) += a * m; returns the carry limb. */
+uint64_t auraLimbsAddMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m);
+
+/** r[0..n) -= a * m; returns the borrow limb. */
+uint64_t auraLimbsSubMul1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m);
+
+/** r[0..n) = a << shift for 0 < shift < 64; returns the bits shifted out. `r` may alias `a`. */
+uint64_t auraLimbsShiftLeft(uint64_t* r, const uint64_t* a, size_t n, int shift);
+
+/** r[0..n) = a >> shift for 0 < shift < 64. `r` may alias `a`. */
+void auraLimbsShiftRight(uint64_t* r, const uint64_t* a, size_t n, int shift);
+
+// --- Multiplication (bigint_mul.c) ---
+
+/**
+ * r[0..an + bn) = a * b, choosing schoolbook, Karatsuba or Toom-3 by size.
+ * Returns false if a temporary buffer could not be allocated.
+ */
+bool auraLimbsMul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+// --- Division (bigint_div.c) ---
+
+/** q[0..n) = a / d; returns the remainder. `q` may alias `a`. */
+uint64_t auraLimbsDivRem1(uint64_t* q, const uint64_t* a, size_t n, uint64_t d);
+
+/**
+ * Divides a (an limbs) by b (bn >= 1 limbs, top limb non-zero, an >= bn):
+ * q[0..an - bn + 1) receives the quotient and r[0..bn) the remainder.
+ * Either output may be NULL when not needed.
+ * Returns false if a temporary buffer could not be allocated.
+ */
+bool auraLimbsDivRem(uint64_t* q, uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/**
+ * v[0..n + 2) = floor(B^(2n) / d) for d of n limbs with a non-zero top limb.
+ * Returns false if a temporary buffer could not be allocated.
+ */
+bool auraLimbsReciprocal(uint64_t* v, const uint64_t* d, size_t n);
+
+/**
+ * Same contract as auraLimbsDivRem for n <= an <= 2n, where v is the
+ * reciprocal of d from auraLimbsReciprocal: O(M(n)) instead of O(n^2).
+ */
+bool auraLimbsDivRemPre(uint64_t* q, uint64_t* r, const uint64_t* a, size_t an, const uint64_t* d, size_t n,
+                        const uint64_t* v);
+
+// --- Decimal conversion (bigint_radix.c) ---
+
+/**
+ * r[0..ceil(count / 19)) = the value of `count` decimal digits (all '0'..'9').
+ * Returns false if a temporary buffer could not be allocated.
+ */
+bool auraLimbsFromDecimal(uint64_t* r, const char* digits, size_t count);
+
+/**
+ * Writes the decimal digits of a[0..n) (no leading zeros, "0" for zero) to
+ * `digits`, which must hold 20 * n + 1 characters, and their number to *count.
+ * Returns false if a temporary buffer could not be allocated.
+ */
+bool auraLimbsToDecimal(char* digits, size_t* count, const uint64_t* a, size_t n);
+
+#endif
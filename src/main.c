@@ -9,13 +9,15 @@
 #include "common.h"
 #include "scanner.h"
 #include "value.h"
+#include "bigint.h"
 
 /**
  * @brief Main execution entry point.
  *
  * Runs a sequence of tests:
  * 1. Creates and prints a BigInt value.
- * 2. Scans a sample source string containing modern JS/Aura syntax and prints tokens.
+ * 2. Scans a sample source string containing modern JS/Aura syntax and prints tokens,
+ *    converting BigInt literals to values.
  *
  * @return 0 on successful execution.
  */
@@ -25,6 +27,7 @@ int main() {
     AuraValue myBigInt = createBIGINT(1234567890123456789LL);
     printf("BigInt created in C: ");
     printValue(myBigInt);
+    freeValue(myBigInt);
     printf("\n");
 
     // --- 2. Scanner Module Test (let, const, 123n) ---
@@ -54,6 +57,13 @@ int main() {
 
         printf("Type: %2d, Text: '%.*s'\n", token.type, (int)token.length, token.start);
 
+        if (token.type == TOKEN_BIGINT) {
+            AuraValue literal = auraBigIntFromString(token.start, token.length);
+            printf("     | BigInt value: ");
+            printValue(literal);
+            freeValue(literal);
+        }
+
         if (token.type == TOKEN_EOF) break;
     }
 
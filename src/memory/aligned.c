@@ -0,0 +1,38 @@
+/**
+ * @file aligned.c
+ * @brief Implementation of the portable aligned allocator.
+ */
+
+#include "aligned.h"
+#include <stdint.h>
+
+/**
+ * Allocates `size` bytes aligned to `alignment` (a power of two).
+ *
+ * @param size Number of bytes.
+ * @param alignment Required alignment in bytes.
+ * @return The memory, or NULL on overflow or allocation failure.
+ * @complexity O(1)
+ */
+void* auraAlignedAlloc(size_t size, size_t alignment) {
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    size_t slack = alignment - 1 + sizeof(void*);
+    if (size > SIZE_MAX - slack) {
+        fprintf(stderr, "[Security] Aligned allocation size overflow.\n");
+        return NULL;
+    }
+
+    void* raw = malloc(size + slack);
+    if (raw == NULL) return NULL;
+
+    uintptr_t aligned = ((uintptr_t)raw + slack) & ~(uintptr_t)(alignment - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+/**
+ * Releases memory obtained from `auraAlignedAlloc`.
+ */
+void auraAlignedFree(void* memory) {
+    if (memory != NULL) free(((void**)memory)[-1]);
+}
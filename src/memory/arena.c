@@ -0,0 +1,160 @@
+/**
+ * @file arena.c
+ * @brief Implementation of the bump-pointer region allocator.
+ */
+
+#include "arena.h"
+#include <stdint.h>
+
+/**
+ * @brief One contiguous block of arena memory.
+ *
+ * The usable bytes follow the header, starting CHUNK_HEADER_SIZE bytes after it
+ * so they keep the alignment of the `malloc` block.
+ */
+struct AuraArenaChunk {
+    AuraArenaChunk* next;
+    size_t capacity;
+    size_t used;
+};
+
+#define CHUNK_HEADER_SIZE \
+    ((sizeof(AuraArenaChunk) + AURA_ARENA_ALIGNMENT - 1) & ~(size_t)(AURA_ARENA_ALIGNMENT - 1))
+#define CHUNK_DATA(chunk) ((unsigned char*)(chunk) + CHUNK_HEADER_SIZE)
+
+/**
+ * Allocates a chunk able to hold `capacity` bytes.
+ *
+ * @return The chunk, or NULL on overflow or allocation failure.
+ */
+static AuraArenaChunk* allocateChunk(size_t capacity) {
+    if (capacity > SIZE_MAX - CHUNK_HEADER_SIZE) {
+        fprintf(stderr, "[Security] Arena chunk size overflow.\n");
+        return NULL;
+    }
+
+    AuraArenaChunk* chunk = (AuraArenaChunk*)malloc(CHUNK_HEADER_SIZE + capacity);
+    if (chunk == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while growing an arena.\n");
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    return chunk;
+}
+
+/**
+ * Creates an empty arena.
+ *
+ * @param chunkSize Capacity of each chunk in bytes (0 for the default).
+ * @return The new arena, or NULL on allocation failure.
+ * @complexity O(1)
+ */
+AuraArena* auraArenaCreate(size_t chunkSize) {
+    AuraArena* arena = (AuraArena*)malloc(sizeof(AuraArena));
+    if (arena == NULL) return NULL;
+
+    arena->current = NULL;
+    arena->chunkSize = chunkSize > 0 ? chunkSize : AURA_ARENA_DEFAULT_CHUNK;
+    arena->bytesUsed = 0;
+    arena->bytesReserved = 0;
+    return arena;
+}
+
+/**
+ * Allocates `size` bytes aligned to AURA_ARENA_ALIGNMENT.
+ *
+ * @param arena The arena.
+ * @param size Number of bytes.
+ * @return Pointer to the memory, or NULL on overflow or allocation failure.
+ * @complexity O(1)
+ */
+void* auraArenaAlloc(AuraArena* arena, size_t size) {
+    if (size > SIZE_MAX - (AURA_ARENA_ALIGNMENT - 1)) {
+        fprintf(stderr, "[Security] Arena allocation size overflow.\n");
+        return NULL;
+    }
+    size_t rounded = (size + AURA_ARENA_ALIGNMENT - 1) & ~(size_t)(AURA_ARENA_ALIGNMENT - 1);
+
+    AuraArenaChunk* chunk = arena->current;
+    if (chunk != NULL && chunk->capacity - chunk->used >= rounded) {
+        void* memory = CHUNK_DATA(chunk) + chunk->used;
+        chunk->used += rounded;
+        arena->bytesUsed += size;
+        return memory;
+    }
+
+    if (rounded > arena->chunkSize / 4) {
+        // Large blocks live in their own chunk, linked behind the current one so
+        // the free space left in the current chunk is still used.
+        AuraArenaChunk* large = allocateChunk(rounded);
+        if (large == NULL) return NULL;
+        large->used = rounded;
+        if (chunk != NULL) {
+            large->next = chunk->next;
+            chunk->next = large;
+        } else {
+            arena->current = large;
+        }
+        arena->bytesUsed += size;
+        arena->bytesReserved += rounded;
+        return CHUNK_DATA(large);
+    }
+
+    AuraArenaChunk* fresh = allocateChunk(arena->chunkSize);
+    if (fresh == NULL) return NULL;
+    fresh->next = chunk;
+    fresh->used = rounded;
+    arena->current = fresh;
+    arena->bytesUsed += size;
+    arena->bytesReserved += fresh->capacity;
+    return CHUNK_DATA(fresh);
+}
+
+/**
+ * Releases every allocation of the arena, keeping one regular chunk for reuse.
+ *
+ * @param arena The arena.
+ * @complexity O(chunks)
+ */
+void auraArenaReset(AuraArena* arena) {
+    AuraArenaChunk* kept = NULL;
+    AuraArenaChunk* chunk = arena->current;
+
+    while (chunk != NULL) {
+        AuraArenaChunk* next = chunk->next;
+        if (kept == NULL && chunk->capacity == arena->chunkSize) {
+            kept = chunk;
+        } else {
+            free(chunk);
+        }
+        chunk = next;
+    }
+
+    if (kept != NULL) {
+        kept->next = NULL;
+        kept->used = 0;
+    }
+    arena->current = kept;
+    arena->bytesUsed = 0;
+    arena->bytesReserved = kept != NULL ? kept->capacity : 0;
+}
+
+/**
+ * Releases every allocation of the arena and the arena itself.
+ *
+ * @param arena The arena (may be NULL).
+ * @complexity O(chunks)
+ */
+void auraArenaDestroy(AuraArena* arena) {
+    if (arena == NULL) return;
+
+    AuraArenaChunk* chunk = arena->current;
+    while (chunk != NULL) {
+        AuraArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
@@ -0,0 +1,342 @@
+/**
+ * @file slab.c
+ * @brief Implementation of the thread-caching size-class allocator.
+ *
+ * Three layers, from fastest to slowest:
+ * - a thread-local free list per class (no synchronization at all);
+ * - a central free list per class, exchanged in batches under a mutex;
+ * - spans of SPAN_SIZE bytes obtained from `malloc` and carved into objects
+ *   when a central list runs dry.
+ *
+ * Live-object counters are kept per thread (written only by their owner) and
+ * summed by `auraSlabStats`; counters of exited threads are folded into a
+ * global total.
+ */
+
+#include "slab.h"
+#include <pthread.h>
+
+/** Bytes requested from `malloc` whenever a central list needs more objects. */
+#define SPAN_SIZE (64 * 1024)
+
+/** Bytes moved between a thread cache and the central pool per exchange. */
+#define BATCH_BYTES 4096
+#define BATCH_MIN 8
+#define BATCH_MAX 64
+
+static const size_t classSizes[AURA_SLAB_CLASS_COUNT] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+
+/** Size class for each request size rounded up to 16 bytes (index = (size + 15) / 16). */
+static const uint8_t classBySixteenths[AURA_SLAB_MAX_SIZE / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 4, 5, 5,
+    6, 6, 6, 6, 7, 7, 7, 7,
+    8, 8, 8, 8, 8, 8, 8, 8,
+    9, 9, 9, 9, 9, 9, 9, 9
+};
+
+typedef struct FreeNode {
+    struct FreeNode* next;
+} FreeNode;
+
+/**
+ * @brief Central pool of one size class, shared by every thread.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    FreeNode* head;
+} CentralList;
+
+#define CENTRAL_LIST_INIT { PTHREAD_MUTEX_INITIALIZER, NULL }
+
+static CentralList central[AURA_SLAB_CLASS_COUNT] = {
+    CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT,
+    CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT, CENTRAL_LIST_INIT
+};
+
+/**
+ * @brief Per-thread free lists and counters.
+ *
+ * `net` counts allocations minus frees made by this thread; it can go negative
+ * for a thread that frees objects allocated elsewhere.
+ */
+typedef struct ThreadCache {
+    FreeNode* lists[AURA_SLAB_CLASS_COUNT];
+    uint32_t counts[AURA_SLAB_CLASS_COUNT];
+    int64_t net[AURA_SLAB_CLASS_COUNT];
+    struct ThreadCache* prev;
+    struct ThreadCache* next;
+    bool registered;
+} ThreadCache;
+
+static AURA_THREAD_LOCAL ThreadCache threadCache;
+
+/** Registry of live thread caches, so statistics can be summed across threads. */
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+static ThreadCache* registry = NULL;
+static int64_t retiredNet[AURA_SLAB_CLASS_COUNT];
+
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t exitKey;
+
+static uint32_t batchSize(int sizeClass) {
+    size_t count = BATCH_BYTES / classSizes[sizeClass];
+    if (count < BATCH_MIN) count = BATCH_MIN;
+    if (count > BATCH_MAX) count = BATCH_MAX;
+    return (uint32_t)count;
+}
+
+/**
+ * Adjusts a per-thread counter. Only the owner writes it, so a relaxed load and
+ * store (plain moves) suffice while still letting `auraSlabStats` read it.
+ */
+static inline void bumpNet(ThreadCache* cache, int sizeClass, int64_t delta) {
+    int64_t current = __atomic_load_n(&cache->net[sizeClass], __ATOMIC_RELAXED);
+    __atomic_store_n(&cache->net[sizeClass], current + delta, __ATOMIC_RELAXED);
+}
+
+// --- CENTRAL POOL ---
+
+/**
+ * Carves a fresh span into objects and pushes them on a central list.
+ * The caller holds the list's lock.
+ *
+ * @return false if the span could not be allocated.
+ */
+static bool growCentral(CentralList* list, int sizeClass) {
+    size_t size = classSizes[sizeClass];
+    size_t count = SPAN_SIZE / size;
+    unsigned char* span = (unsigned char*)malloc(count * size);
+    if (span == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while growing the slab allocator.\n");
+        return false;
+    }
+
+    for (size_t i = count; i-- > 0;) {
+        FreeNode* node = (FreeNode*)(span + i * size);
+        node->next = list->head;
+        list->head = node;
+    }
+    return true;
+}
+
+/**
+ * Moves up to one batch of objects from the central pool into the thread cache.
+ *
+ * @return false if the pool is empty and could not grow.
+ * @complexity O(batch)
+ */
+static bool fetchBatch(ThreadCache* cache, int sizeClass) {
+    CentralList* list = &central[sizeClass];
+    uint32_t wanted = batchSize(sizeClass);
+
+    pthread_mutex_lock(&list->lock);
+    if (list->head == NULL && !growCentral(list, sizeClass)) {
+        pthread_mutex_unlock(&list->lock);
+        return false;
+    }
+
+    FreeNode* first = list->head;
+    FreeNode* last = first;
+    uint32_t taken = 1;
+    while (taken < wanted && last->next != NULL) {
+        last = last->next;
+        taken++;
+    }
+    list->head = last->next;
+    pthread_mutex_unlock(&list->lock);
+
+    last->next = cache->lists[sizeClass];
+    cache->lists[sizeClass] = first;
+    cache->counts[sizeClass] += taken;
+    return true;
+}
+
+/**
+ * Returns `count` objects from the head of a thread list to the central pool.
+ *
+ * @complexity O(count)
+ */
+static void releaseObjects(ThreadCache* cache, int sizeClass, uint32_t count) {
+    if (count == 0) return;
+
+    FreeNode* first = cache->lists[sizeClass];
+    FreeNode* last = first;
+    for (uint32_t i = 1; i < count; i++) last = last->next;
+    cache->lists[sizeClass] = last->next;
+    cache->counts[sizeClass] -= count;
+
+    CentralList* list = &central[sizeClass];
+    pthread_mutex_lock(&list->lock);
+    last->next = list->head;
+    list->head = first;
+    pthread_mutex_unlock(&list->lock);
+}
+
+// --- THREAD CACHES ---
+
+/**
+ * Thread-exit hook: hands the cached objects back and retires the counters.
+ */
+static void retireThreadCache(void* arg) {
+    ThreadCache* cache = (ThreadCache*)arg;
+    for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) {
+        releaseObjects(cache, c, cache->counts[c]);
+    }
+
+    pthread_mutex_lock(&registryLock);
+    for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) {
+        retiredNet[c] += cache->net[c];
+        cache->net[c] = 0;
+    }
+    if (cache->prev != NULL) cache->prev->next = cache->next;
+    else registry = cache->next;
+    if (cache->next != NULL) cache->next->prev = cache->prev;
+    cache->registered = false;
+    pthread_mutex_unlock(&registryLock);
+}
+
+static void createExitKey(void) {
+    pthread_key_create(&exitKey, retireThreadCache);
+}
+
+/**
+ * Returns the calling thread's cache, registering it on first use.
+ */
+static inline ThreadCache* currentCache(void) {
+    ThreadCache* cache = &threadCache;
+    if (cache->registered) return cache;
+
+    pthread_once(&keyOnce, createExitKey);
+    pthread_setspecific(exitKey, cache);
+
+    pthread_mutex_lock(&registryLock);
+    cache->prev = NULL;
+    cache->next = registry;
+    if (registry != NULL) registry->prev = cache;
+    registry = cache;
+    cache->registered = true;
+    pthread_mutex_unlock(&registryLock);
+    return cache;
+}
+
+// --- PUBLIC API ---
+
+/**
+ * Returns the size class serving `size` bytes.
+ *
+ * @param size The request size.
+ * @return The class index, or -1 if `size` exceeds AURA_SLAB_MAX_SIZE.
+ * @complexity O(1)
+ */
+int auraSlabClassOf(size_t size) {
+    if (size > AURA_SLAB_MAX_SIZE) return -1;
+    return classBySixteenths[(size + 15) >> 4];
+}
+
+/**
+ * Returns the object size of a size class.
+ */
+size_t auraSlabClassSize(int sizeClass) {
+    return classSizes[sizeClass];
+}
+
+/**
+ * Allocates one object of a size class.
+ *
+ * @param sizeClass A class index in [0, AURA_SLAB_CLASS_COUNT).
+ * @return Uninitialized memory aligned to 16 bytes, or NULL on failure.
+ * @complexity O(1) amortized.
+ */
+void* auraSlabAllocClass(int sizeClass) {
+    ThreadCache* cache = currentCache();
+    FreeNode* node = cache->lists[sizeClass];
+    if (node == NULL) {
+        if (!fetchBatch(cache, sizeClass)) return NULL;
+        node = cache->lists[sizeClass];
+    }
+
+    cache->lists[sizeClass] = node->next;
+    cache->counts[sizeClass]--;
+    bumpNet(cache, sizeClass, 1);
+    return node;
+}
+
+/**
+ * Returns an object to its size class.
+ *
+ * OPTIMIZATION: A thread list may hold two batches; past that one batch goes
+ * back to the central pool, so a thread that only frees (a consumer) does not
+ * hoard memory and a thread alternating alloc/free never touches the lock.
+ *
+ * @param memory An object obtained from `auraSlabAllocClass(sizeClass)`.
+ * @param sizeClass The class it was allocated from.
+ * @complexity O(1) amortized.
+ */
+void auraSlabFreeClass(void* memory, int sizeClass) {
+    ThreadCache* cache = currentCache();
+    FreeNode* node = (FreeNode*)memory;
+    node->next = cache->lists[sizeClass];
+    cache->lists[sizeClass] = node;
+    cache->counts[sizeClass]++;
+    bumpNet(cache, sizeClass, -1);
+
+    uint32_t batch = batchSize(sizeClass);
+    if (cache->counts[sizeClass] > 2 * batch) releaseObjects(cache, sizeClass, batch);
+}
+
+/**
+ * Allocates `size` bytes from the matching class.
+ */
+void* auraSlabAlloc(size_t size) {
+    int sizeClass = auraSlabClassOf(size);
+    if (sizeClass < 0) return NULL;
+    return auraSlabAllocClass(sizeClass);
+}
+
+/**
+ * Frees memory obtained from `auraSlabAlloc(size)`.
+ */
+void auraSlabFree(void* memory, size_t size) {
+    if (memory == NULL) return;
+    auraSlabFreeClass(memory, auraSlabClassOf(size));
+}
+
+/**
+ * Returns every cached object of the calling thread to the central pools.
+ *
+ * @complexity O(cached objects)
+ */
+void auraSlabFlushThreadCache(void) {
+    ThreadCache* cache = &threadCache;
+    for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) {
+        releaseObjects(cache, c, cache->counts[c]);
+    }
+}
+
+/**
+ * Reports the live objects and bytes of every size class.
+ *
+ * @param stats Receives AURA_SLAB_CLASS_COUNT entries.
+ * @complexity O(threads * classes)
+ */
+void auraSlabStats(AuraSlabClassStats stats[AURA_SLAB_CLASS_COUNT]) {
+    int64_t live[AURA_SLAB_CLASS_COUNT];
+
+    pthread_mutex_lock(&registryLock);
+    for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) live[c] = retiredNet[c];
+    for (ThreadCache* cache = registry; cache != NULL; cache = cache->next) {
+        for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) {
+            live[c] += __atomic_load_n(&cache->net[c], __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&registryLock);
+
+    for (int c = 0; c < AURA_SLAB_CLASS_COUNT; c++) {
+        size_t objects = live[c] > 0 ? (size_t)live[c] : 0;
+        stats[c].objectSize = classSizes[c];
+        stats[c].liveObjects = objects;
+        stats[c].liveBytes = objects * classSizes[c];
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file tensor_pool.c
+ * @brief Implementation of the tensor storage pool.
+ *
+ * One LIFO free list per bucket, linked through the first word of each block,
+ * so the block that was freed last (and is most likely still cached) is
+ * reused first. A single mutex guards the lists: blocks are at least 1 KB and
+ * usually much larger, so the lock is cheap next to touching the payload.
+ */
+
+#include "tensor_pool.h"
+#include <pthread.h>
+
+#define BUCKET_MIN_LOG2 10        // log2(AURA_TENSOR_POOL_MIN_SIZE)
+#define STEPS_PER_DOUBLING 4
+
+typedef struct PoolBlock {
+    struct PoolBlock* next;
+} PoolBlock;
+
+typedef struct {
+    pthread_mutex_t lock;
+    PoolBlock* buckets[AURA_TENSOR_POOL_BUCKETS];
+    bool limitSet;
+    AuraTensorPoolStats stats;
+} TensorPool;
+
+static TensorPool pool = { PTHREAD_MUTEX_INITIALIZER, { NULL }, false, { 0, 0, 0, 0, 0, 0 } };
+
+/**
+ * Returns the bucket serving `size` bytes.
+ *
+ * @return The bucket index, or -1 if `size` exceeds AURA_TENSOR_POOL_MAX_SIZE.
+ * @complexity O(1)
+ */
+int auraTensorPoolBucketOf(size_t size) {
+    if (size <= AURA_TENSOR_POOL_MIN_SIZE) return 0;
+    if (size > AURA_TENSOR_POOL_MAX_SIZE) return -1;
+
+    // 2^e < size <= 2^(e+1); the doubling is split into four equal steps.
+    int e = 63 - __builtin_clzll((unsigned long long)(size - 1));
+    size_t step = (size_t)1 << (e - 2);
+    int s = (int)((size - 1 - ((size_t)1 << e)) / step);
+    return (e - BUCKET_MIN_LOG2) * STEPS_PER_DOUBLING + s + 1;
+}
+
+/**
+ * Returns the block size of a bucket.
+ *
+ * @param bucket A bucket index in [0, AURA_TENSOR_POOL_BUCKETS).
+ */
+size_t auraTensorPoolBucketSize(int bucket) {
+    size_t power = (size_t)1 << (BUCKET_MIN_LOG2 + bucket / STEPS_PER_DOUBLING);
+    return power + (power / STEPS_PER_DOUBLING) * (size_t)(bucket % STEPS_PER_DOUBLING);
+}
+
+/**
+ * Applies `AURA_TENSOR_POOL_MB` (or the default) the first time the limit is
+ * needed. Called with `pool.lock` held.
+ */
+static void ensureLimit(void) {
+    if (pool.limitSet) return;
+    pool.limitSet = true;
+    pool.stats.limit = AURA_TENSOR_POOL_DEFAULT_LIMIT;
+
+    const char* env = getenv("AURA_TENSOR_POOL_MB");
+    if (env != NULL) {
+        long megabytes = strtol(env, NULL, 10);
+        if (megabytes >= 0) pool.stats.limit = (size_t)megabytes << 20;
+    }
+}
+
+/**
+ * Allocates a block of at least the bucket's size.
+ *
+ * @param bucket A bucket index in [0, AURA_TENSOR_POOL_BUCKETS).
+ * @param zeroFill Whether the first `size` bytes must be zero.
+ * @param size Bytes that must be zeroed when `zeroFill` is set.
+ * @return The block, or NULL if out of memory.
+ */
+void* auraTensorPoolAlloc(int bucket, size_t size, bool zeroFill) {
+    pthread_mutex_lock(&pool.lock);
+    PoolBlock* block = pool.buckets[bucket];
+    if (block != NULL) {
+        pool.buckets[bucket] = block->next;
+        pool.stats.hits++;
+        pool.stats.cachedBlocks--;
+        pool.stats.cachedBytes -= auraTensorPoolBucketSize(bucket);
+    } else {
+        pool.stats.misses++;
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    if (block == NULL) {
+        size_t bytes = auraTensorPoolBucketSize(bucket);
+        return zeroFill ? calloc(1, bytes) : malloc(bytes);
+    }
+    if (zeroFill) memset(block, 0, size);
+    return block;
+}
+
+/**
+ * Returns a block to its bucket, or to the system if the pool is full.
+ *
+ * @param block A block from `auraTensorPoolAlloc(bucket, ...)`.
+ * @param bucket Its bucket.
+ */
+void auraTensorPoolFree(void* block, int bucket) {
+    size_t bytes = auraTensorPoolBucketSize(bucket);
+
+    pthread_mutex_lock(&pool.lock);
+    ensureLimit();
+    if (pool.stats.cachedBytes + bytes > pool.stats.limit) {
+        pool.stats.releases++;
+        pthread_mutex_unlock(&pool.lock);
+        free(block);
+        return;
+    }
+    PoolBlock* node = (PoolBlock*)block;
+    node->next = pool.buckets[bucket];
+    pool.buckets[bucket] = node;
+    pool.stats.cachedBlocks++;
+    pool.stats.cachedBytes += bytes;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/**
+ * Unlinks cached blocks, largest buckets first, until at most `target` bytes
+ * remain. Called with `pool.lock` held; returns the blocks as a list.
+ */
+static PoolBlock* detachDownTo(size_t target) {
+    PoolBlock* released = NULL;
+    for (int bucket = AURA_TENSOR_POOL_BUCKETS - 1; bucket >= 0 && pool.stats.cachedBytes > target; bucket--) {
+        size_t bytes = auraTensorPoolBucketSize(bucket);
+        while (pool.buckets[bucket] != NULL && pool.stats.cachedBytes > target) {
+            PoolBlock* block = pool.buckets[bucket];
+            pool.buckets[bucket] = block->next;
+            block->next = released;
+            released = block;
+            pool.stats.cachedBlocks--;
+            pool.stats.cachedBytes -= bytes;
+        }
+    }
+    return released;
+}
+
+/** Frees a list of detached blocks (outside the lock). */
+static void freeBlocks(PoolBlock* list) {
+    while (list != NULL) {
+        PoolBlock* next = list->next;
+        free(list);
+        list = next;
+    }
+}
+
+/**
+ * Changes the cap on cached bytes, releasing blocks until it holds.
+ *
+ * @param bytes The new limit (0 disables caching).
+ * @return The previous limit.
+ */
+size_t auraTensorPoolSetLimit(size_t bytes) {
+    pthread_mutex_lock(&pool.lock);
+    ensureLimit();
+    size_t previous = pool.stats.limit;
+    pool.stats.limit = bytes;
+    PoolBlock* released = detachDownTo(bytes);
+    pthread_mutex_unlock(&pool.lock);
+
+    freeBlocks(released);
+    return previous;
+}
+
+/**
+ * Returns every cached block to the system (the limit is unchanged).
+ */
+void auraTensorPoolTrim(void) {
+    pthread_mutex_lock(&pool.lock);
+    PoolBlock* released = detachDownTo(0);
+    pthread_mutex_unlock(&pool.lock);
+    freeBlocks(released);
+}
+
+/**
+ * Reports the pool's counters.
+ *
+ * @param stats Receives the counters.
+ */
+void auraTensorPoolStats(AuraTensorPoolStats* stats) {
+    pthread_mutex_lock(&pool.lock);
+    ensureLimit();
+    *stats = pool.stats;
+    pthread_mutex_unlock(&pool.lock);
+}
@@ -0,0 +1,687 @@
+/**
+ * @file aura_string.c
+ * @brief Implementation of the inline, flat, rope and slice string representations.
+ *
+ * Short strings are packed into the value to avoid a malloc and a pointer chase;
+ * longer ones are stored in one length-prefixed allocation with a cached hash.
+ * Concatenation builds rope nodes that are flattened lazily on first read, and
+ * substring operations build slices that share the bytes of a flat parent.
+ */
+
+#include "aura_string.h"
+#include "intern.h"
+
+/** Initial capacity of the explicit work stacks used to walk ropes. */
+#define ROPE_STACK_INITIAL 32
+
+/**
+ * Hashes a byte sequence using 32-bit FNV-1a.
+ *
+ * @param chars The bytes to hash.
+ * @param length Number of bytes.
+ * @return The hash value.
+ * @complexity O(N)
+ */
+uint32_t auraHashChars(const char* chars, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)chars[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Allocates a flat heap string of the given length with one owner.
+ *
+ * The characters are left for the caller to fill in (the NUL terminator is
+ * already written); the caller must also set `header.hash`.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param length Number of characters.
+ * @return The new string, or NULL on overflow or allocation failure.
+ * @complexity O(1)
+ */
+static AuraString* allocateFlat(AuraArena* arena, size_t length) {
+    if (length > SIZE_MAX - sizeof(AuraString) - 1) {
+        fprintf(stderr, "[Security] String allocation size overflow.\n");
+        return NULL;
+    }
+
+    AuraString* string = (AuraString*)auraAllocateObjectInArena(arena, sizeof(AuraString) + length + 1, AURA_STRING);
+    if (string == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while allocating a string.\n");
+        return NULL;
+    }
+
+    string->header.kind = AURA_STRING_FLAT;
+    string->header.refs = 1;
+    string->header.length = length;
+    string->chars[length] = '\0';
+    return string;
+}
+
+/**
+ * Creates a string value, inline when short enough, otherwise on the heap.
+ *
+ * Strings containing a NUL byte are never stored inline: the inline layout
+ * relies on NUL padding to recover the length.
+ *
+ * @param chars The characters to copy.
+ * @param length Number of bytes to copy.
+ * @return A AuraValue with type AURA_STRING, or AURA_NULL on allocation failure.
+ * @complexity O(N)
+ */
+AuraValue auraCopyString(const char* chars, size_t length) {
+    return auraCopyStringInArena(NULL, chars, length);
+}
+
+/**
+ * Creates a string value whose heap block (if any) lives in an arena.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param chars The characters to copy.
+ * @param length Number of bytes to copy.
+ * @return A AuraValue with type AURA_STRING, or AURA_NULL on allocation failure.
+ * @complexity O(N)
+ */
+AuraValue auraCopyStringInArena(AuraArena* arena, const char* chars, size_t length) {
+    if (length <= AURA_SSO_MAX && memchr(chars, '\0', length) == NULL) {
+        return auraShortStringToValue(chars, length);
+    }
+
+    AuraString* string = allocateFlat(arena, length);
+    if (string == NULL) return createNULL();
+
+    memcpy(string->chars, chars, length);
+    string->header.hash = auraHashChars(chars, length);
+    string->header.hashed = true;
+    return AURA_OBJ_VAL(string);
+}
+
+/**
+ * Adds a reference to a string value.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return `v`, now carrying one more owner.
+ * @complexity O(1)
+ */
+AuraValue auraStringRetain(AuraValue v) {
+    if (AURA_IS_OBJ(v)) AURA_AS_STRING_HEADER(v)->refs++;
+    return v;
+}
+
+// --- EXPLICIT WORK STACK ---
+
+/**
+ * @brief Growable stack used instead of recursion when walking ropes.
+ *
+ * Starts in caller-provided storage and only touches the heap for deep trees.
+ */
+typedef struct {
+    void** items;
+    size_t count;
+    size_t capacity;
+    void* initial[ROPE_STACK_INITIAL];
+} WorkStack;
+
+static void initWorkStack(WorkStack* stack) {
+    stack->items = stack->initial;
+    stack->count = 0;
+    stack->capacity = ROPE_STACK_INITIAL;
+}
+
+static bool pushWork(WorkStack* stack, void* item) {
+    if (stack->count == stack->capacity) {
+        size_t capacity = stack->capacity * 2;
+        void** items = (void**)malloc(capacity * sizeof(void*));
+        if (items == NULL) return false;
+        memcpy(items, stack->items, stack->count * sizeof(void*));
+        if (stack->items != stack->initial) free(stack->items);
+        stack->items = items;
+        stack->capacity = capacity;
+    }
+    stack->items[stack->count++] = item;
+    return true;
+}
+
+static void freeWorkStack(WorkStack* stack) {
+    if (stack->items != stack->initial) free(stack->items);
+}
+
+// --- RELEASE ---
+
+/**
+ * Drops one reference from a heap string and returns it if it must be freed.
+ */
+static AuraStringHeader* dropReference(AuraValue v) {
+    if (!AURA_IS_OBJ(v)) return NULL;
+    AuraStringHeader* string = AURA_AS_STRING_HEADER(v);
+    return --string->refs == 0 ? string : NULL;
+}
+
+/**
+ * Frees a string whose reference count reached zero.
+ *
+ * Rope operands that die as well are pushed on `stack` instead of being freed
+ * recursively; flat and slice operands are freed on the spot (a slice only
+ * references flat strings, so this nests at most two levels).
+ */
+static void destroyString(AuraStringHeader* string, WorkStack* stack) {
+    // Arena strings are reclaimed with their arena; they own no references.
+    if (string->obj.flags & AURA_OBJ_ARENA) return;
+    if (string->interned) auraEvictInterned((AuraString*)string);
+
+    if (string->kind == AURA_STRING_ROPE) {
+        AuraRope* rope = (AuraRope*)string;
+        AuraStringHeader* children[3];
+        children[0] = dropReference(rope->left);
+        children[1] = dropReference(rope->right);
+        children[2] = NULL;
+        if (rope->flat != NULL && --rope->flat->header.refs == 0) children[2] = &rope->flat->header;
+
+        for (int i = 0; i < 3; i++) {
+            if (children[i] == NULL) continue;
+            if (children[i]->kind == AURA_STRING_ROPE && pushWork(stack, children[i])) continue;
+            // Flat strings have no children, so freeing them cannot recurse. If
+            // the stack cannot grow, a dead rope is leaked rather than crashing.
+            if (children[i]->kind != AURA_STRING_ROPE) destroyString(children[i], stack);
+        }
+    } else if (string->kind == AURA_STRING_SLICE) {
+        AuraSlice* slice = (AuraSlice*)string;
+        if (slice->parent != NULL && --slice->parent->header.refs == 0) destroyString(&slice->parent->header, stack);
+        if (slice->flat != NULL && --slice->flat->header.refs == 0) destroyString(&slice->flat->header, stack);
+    }
+    auraFreeObject(&string->obj);
+}
+
+/**
+ * Releases one reference to a heap string.
+ *
+ * @param string The string object to release.
+ * @complexity O(1) unless this was the last reference, then O(nodes freed).
+ */
+void auraFreeString(AuraStringHeader* string) {
+    if (--string->refs > 0) return;
+
+    WorkStack stack;
+    initWorkStack(&stack);
+    destroyString(string, &stack);
+    while (stack.count > 0) {
+        destroyString((AuraStringHeader*)stack.items[--stack.count], &stack);
+    }
+    freeWorkStack(&stack);
+}
+
+// --- CONCATENATION & FLATTENING ---
+
+/**
+ * Concatenates two strings without copying their bytes.
+ *
+ * @param a Left string value.
+ * @param b Right string value.
+ * @return A new owned AURA_STRING value.
+ * @complexity O(1) (O(AURA_ROPE_MIN_LENGTH) for short results).
+ */
+AuraValue auraConcat(AuraValue a, AuraValue b) {
+    size_t leftLength = auraStringLength(a);
+    size_t rightLength = auraStringLength(b);
+
+    if (leftLength == 0) return auraStringRetain(b);
+    if (rightLength == 0) return auraStringRetain(a);
+
+    if (leftLength > SIZE_MAX - rightLength) {
+        fprintf(stderr, "[Security] String concatenation length overflow.\n");
+        return createNULL();
+    }
+    size_t length = leftLength + rightLength;
+
+    if (length < AURA_ROPE_MIN_LENGTH) {
+        char buffer[AURA_ROPE_MIN_LENGTH];
+        memcpy(buffer, auraStringData(&a), leftLength);
+        memcpy(buffer + leftLength, auraStringData(&b), rightLength);
+        return auraCopyString(buffer, length);
+    }
+
+    AuraRope* rope = (AuraRope*)auraAllocateObject(sizeof(AuraRope), AURA_STRING);
+    if (rope == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory in auraConcat.\n");
+        return createNULL();
+    }
+
+    rope->header.kind = AURA_STRING_ROPE;
+    rope->header.refs = 1;
+    rope->header.length = length;
+    rope->left = auraStringRetain(a);
+    rope->right = auraStringRetain(b);
+    rope->flat = NULL;
+    return AURA_OBJ_VAL(rope);
+}
+
+/**
+ * Returns the rope node behind a value if its bytes still need to be gathered.
+ */
+static AuraRope* pendingRope(const AuraValue* v) {
+    if (!AURA_IS_OBJ(*v)) return NULL;
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(*v);
+    if (header->kind != AURA_STRING_ROPE) return NULL;
+    AuraRope* rope = (AuraRope*)header;
+    return rope->flat == NULL ? rope : NULL;
+}
+
+/**
+ * Copies the bytes of every leaf under `root` into `out`.
+ *
+ * OPTIMIZATION: Every node knows where its bytes land (`offset`), so leaves
+ * are written as soon as they are met and only nodes with two unflattened
+ * rope children push work. Left- and right-leaning chains, the shapes produced
+ * by `s = s + x` and `s = x + s`, are therefore walked in constant stack space.
+ *
+ * @return false if the work stack could not grow.
+ */
+static bool gatherRope(AuraRope* root, char* out) {
+    WorkStack stack;
+    initWorkStack(&stack);
+
+    AuraRope* node = root;
+    size_t offset = 0;
+    bool ok = true;
+
+    while (node != NULL) {
+        size_t leftLength = auraStringLength(node->left);
+        AuraRope* left = pendingRope(&node->left);
+        AuraRope* right = pendingRope(&node->right);
+
+        if (left == NULL) memcpy(out + offset, auraStringData(&node->left), leftLength);
+        if (right == NULL) {
+            memcpy(out + offset + leftLength, auraStringData(&node->right),
+                   auraStringLength(node->right));
+        }
+
+        if (left != NULL && right != NULL) {
+            // Offsets are stored next to the node (two slots per pending right child).
+            if (!pushWork(&stack, right) || !pushWork(&stack, (void*)(uintptr_t)(offset + leftLength))) {
+                ok = false;
+                break;
+            }
+            node = left;
+        } else if (left != NULL) {
+            node = left;
+        } else if (right != NULL) {
+            node = right;
+            offset += leftLength;
+        } else if (stack.count > 0) {
+            offset = (size_t)(uintptr_t)stack.items[--stack.count];
+            node = (AuraRope*)stack.items[--stack.count];
+        } else {
+            node = NULL;
+        }
+    }
+
+    freeWorkStack(&stack);
+    return ok;
+}
+
+/**
+ * Materializes the bytes of a rope.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return false if the flat buffer could not be allocated.
+ * @complexity O(N) the first time, O(1) afterwards.
+ */
+bool auraStringFlatten(AuraValue v) {
+    AuraRope* rope = pendingRope(&v);
+    if (rope == NULL) return true;
+
+    AuraString* flat = allocateFlat(NULL, rope->header.length);
+    if (flat == NULL) return false;
+
+    if (!gatherRope(rope, flat->chars)) {
+        fprintf(stderr, "[Fatal Error] Out of memory while flattening a string.\n");
+        auraFreeObject(&flat->header.obj);
+        return false;
+    }
+    flat->header.hash = auraHashChars(flat->chars, flat->header.length);
+    flat->header.hashed = true;
+
+    // The operands are no longer needed: the rope becomes an indirection to `flat`.
+    AuraValue left = rope->left;
+    AuraValue right = rope->right;
+    rope->flat = flat;
+    rope->header.hash = flat->header.hash;
+    rope->header.hashed = true;
+    rope->left = createUNDEFINED();
+    rope->right = createUNDEFINED();
+    if (AURA_IS_OBJ(left)) auraFreeString(AURA_AS_STRING_HEADER(left));
+    if (AURA_IS_OBJ(right)) auraFreeString(AURA_AS_STRING_HEADER(right));
+    return true;
+}
+
+// --- ACCESSORS ---
+
+/**
+ * Copies the bytes of a slice into its own flat string and releases the parent.
+ *
+ * @return false if the copy could not be allocated.
+ * @complexity O(N)
+ */
+static bool materializeSlice(AuraSlice* slice) {
+    if (slice->parent == NULL) return true;
+
+    AuraString* flat = allocateFlat(NULL, slice->header.length);
+    if (flat == NULL) return false;
+
+    memcpy(flat->chars, slice->chars, slice->header.length);
+    flat->header.hash = auraHashChars(flat->chars, flat->header.length);
+    flat->header.hashed = true;
+
+    AuraString* parent = slice->parent;
+    slice->flat = flat;
+    slice->chars = flat->chars;
+    slice->parent = NULL;
+    if (!slice->header.hashed) {
+        slice->header.hash = flat->header.hash;
+        slice->header.hashed = true;
+    }
+    auraFreeString(&parent->header);
+    return true;
+}
+
+/**
+ * Returns a NUL-terminated view of the characters of a string value.
+ *
+ * @param v Pointer to a value of type AURA_STRING.
+ * @return Pointer to the characters (inside `*v` for inline strings).
+ * @complexity O(1), or O(N) for the first read of a rope or inner slice.
+ */
+const char* auraStringChars(const AuraValue* v) {
+    if (AURA_IS_SSTR(*v)) return AURA_SSO_CHARS(v);
+
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(*v);
+    if (header->kind == AURA_STRING_SLICE) {
+        AuraSlice* slice = (AuraSlice*)header;
+        // A suffix of the parent is terminated by the parent's own NUL.
+        if (slice->parent != NULL &&
+            slice->chars + header->length == slice->parent->chars + slice->parent->header.length) {
+            return slice->chars;
+        }
+        if (!materializeSlice(slice)) return "";
+        return slice->chars;
+    }
+    return auraStringData(v);
+}
+
+/**
+ * Returns the bytes of a string value without guaranteeing a NUL terminator.
+ *
+ * @param v Pointer to a value of type AURA_STRING.
+ * @return Pointer to the first byte.
+ * @complexity O(1), or O(N) for the first read of a rope.
+ */
+const char* auraStringData(const AuraValue* v) {
+    if (AURA_IS_SSTR(*v)) return AURA_SSO_CHARS(v);
+
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(*v);
+    switch (header->kind) {
+        case AURA_STRING_ROPE: {
+            AuraRope* rope = (AuraRope*)header;
+            if (rope->flat == NULL && !auraStringFlatten(*v)) return "";
+            return rope->flat->chars;
+        }
+        case AURA_STRING_SLICE:
+            return ((AuraSlice*)header)->chars;
+        default:
+            return ((AuraString*)header)->chars;
+    }
+}
+
+/**
+ * Returns the length in bytes of a string value.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return The length, without the terminating NUL.
+ * @complexity O(1)
+ */
+size_t auraStringLength(AuraValue v) {
+    if (AURA_IS_SSTR(v)) return AURA_SSO_LENGTH(&v);
+    return AURA_AS_STRING_HEADER(v)->length;
+}
+
+/**
+ * Returns the hash of a string value.
+ *
+ * @param v A value of type AURA_STRING.
+ * @return The FNV-1a hash of the characters.
+ * @complexity O(1) for flat strings, O(N) for the first hash of a rope or slice.
+ */
+uint32_t auraStringHash(AuraValue v) {
+    if (AURA_IS_SSTR(v)) return auraHashChars(AURA_SSO_CHARS(&v), AURA_SSO_LENGTH(&v));
+
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(v);
+    if (!header->hashed) {
+        if (header->kind == AURA_STRING_ROPE) {
+            if (!auraStringFlatten(v)) return 0;
+        } else {
+            header->hash = auraHashChars(auraStringData(&v), header->length);
+            header->hashed = true;
+        }
+    }
+    return header->hash;
+}
+
+/**
+ * Compares two string values by content.
+ *
+ * OPTIMIZATION: Two interned strings compare by pointer only. Otherwise cached
+ * hashes and lengths reject most unequal heap strings before a byte is compared.
+ *
+ * @param a First string value.
+ * @param b Second string value.
+ * @return true if both hold the same bytes.
+ * @complexity O(1) for interned strings or differing hashes, O(N) otherwise.
+ */
+bool auraStringsEqual(AuraValue a, AuraValue b) {
+    size_t length = auraStringLength(a);
+    if (length != auraStringLength(b)) return false;
+
+    if (AURA_IS_OBJ(a) && AURA_IS_OBJ(b)) {
+        AuraStringHeader* sa = AURA_AS_STRING_HEADER(a);
+        AuraStringHeader* sb = AURA_AS_STRING_HEADER(b);
+        if (sa == sb) return true;
+        // Interned strings are unique per content: distinct pointers mean distinct strings.
+        if (sa->interned && sb->interned) return false;
+        if (sa->hashed && sb->hashed && sa->hash != sb->hash) return false;
+    }
+
+    return memcmp(auraStringData(&a), auraStringData(&b), length) == 0;
+}
+
+/**
+ * Returns an owned flat string with the same bytes as a heap string value.
+ *
+ * @param v A heap value of type AURA_STRING (not consumed).
+ * @return A new reference to a flat string, or NULL on allocation failure.
+ * @complexity O(1) for flat strings and flattened ropes, O(N) otherwise.
+ */
+AuraString* auraStringToFlat(AuraValue v) {
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(v);
+    AuraString* flat = NULL;
+
+    switch (header->kind) {
+        case AURA_STRING_ROPE:
+            if (!auraStringFlatten(v)) return NULL;
+            flat = ((AuraRope*)header)->flat;
+            break;
+        case AURA_STRING_SLICE:
+            if (!materializeSlice((AuraSlice*)header)) return NULL;
+            flat = ((AuraSlice*)header)->flat;
+            break;
+        default:
+            flat = (AuraString*)header;
+            break;
+    }
+    flat->header.refs++;
+    return flat;
+}
+
+// --- SLICING ---
+
+/**
+ * Returns the flat string that owns the bytes of a heap string, and the offset
+ * of those bytes inside it.
+ *
+ * @return The flat root, or NULL if a rope could not be flattened.
+ */
+static AuraString* sliceRoot(AuraValue v, size_t* offset) {
+    AuraStringHeader* header = AURA_AS_STRING_HEADER(v);
+    *offset = 0;
+
+    switch (header->kind) {
+        case AURA_STRING_ROPE:
+            if (!auraStringFlatten(v)) return NULL;
+            return ((AuraRope*)header)->flat;
+        case AURA_STRING_SLICE: {
+            // Slices of slices point at the root, so chains never form.
+            AuraSlice* slice = (AuraSlice*)header;
+            AuraString* root = slice->parent != NULL ? slice->parent : slice->flat;
+            *offset = (size_t)(slice->chars - root->chars);
+            return root;
+        }
+        default:
+            return (AuraString*)header;
+    }
+}
+
+/**
+ * Creates the string for `length` bytes of `s` starting at `start` (in range).
+ *
+ * OPTIMIZATION: Short results are copied (inline when possible), and so are
+ * tiny results of a huge parent so they do not pin it (AURA_SLICE_PIN_LIMIT).
+ * Everything else shares the parent's bytes.
+ */
+static AuraValue makeSlice(AuraValue s, size_t start, size_t length) {
+    if (length == auraStringLength(s)) return auraStringRetain(s);
+    if (length < AURA_SLICE_MIN_LENGTH || !AURA_IS_OBJ(s)) {
+        return auraCopyString(auraStringData(&s) + start, length);
+    }
+
+    size_t offset;
+    AuraString* root = sliceRoot(s, &offset);
+    if (root == NULL) return createNULL();
+
+    if (length <= AURA_SLICE_PIN_LIMIT && length * AURA_SLICE_PIN_RATIO < root->header.length) {
+        return auraCopyString(root->chars + offset + start, length);
+    }
+
+    AuraSlice* slice = (AuraSlice*)auraAllocateObject(sizeof(AuraSlice), AURA_STRING);
+    if (slice == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while slicing a string.\n");
+        return createNULL();
+    }
+
+    slice->header.kind = AURA_STRING_SLICE;
+    slice->header.refs = 1;
+    slice->header.length = length;
+    slice->parent = root;
+    slice->chars = root->chars + offset + start;
+    slice->flat = NULL;
+    root->header.refs++;
+    return AURA_OBJ_VAL(slice);
+}
+
+/**
+ * Returns the characters in [start, end) of a string.
+ *
+ * @param s A value of type AURA_STRING.
+ * @param start Index of the first byte.
+ * @param end Index one past the last byte.
+ * @return A new owned AURA_STRING value.
+ * @complexity O(1) for slices, O(end - start) for copies.
+ */
+AuraValue auraSubstring(AuraValue s, size_t start, size_t end) {
+    size_t length = auraStringLength(s);
+    if (start > length) start = length;
+    if (end > length) end = length;
+    if (start > end) {
+        size_t swap = start;
+        start = end;
+        end = swap;
+    }
+    return makeSlice(s, start, end - start);
+}
+
+static bool isAsciiSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/**
+ * Removes leading and trailing ASCII whitespace.
+ *
+ * @param s A value of type AURA_STRING.
+ * @return A new owned AURA_STRING value.
+ * @complexity O(W) where W is the amount of whitespace removed.
+ */
+AuraValue auraStringTrim(AuraValue s) {
+    const char* chars = auraStringData(&s);
+    size_t start = 0;
+    size_t end = auraStringLength(s);
+    while (start < end && isAsciiSpace(chars[start])) start++;
+    while (end > start && isAsciiSpace(chars[end - 1])) end--;
+    return makeSlice(s, start, end - start);
+}
+
+/**
+ * Splits a string around every occurrence of a separator.
+ *
+ * @param s A value of type AURA_STRING.
+ * @param separator The separator bytes.
+ * @param separatorLength Length of the separator.
+ * @param count Receives the number of parts.
+ * @return A malloc'ed array of owned parts, or NULL on allocation failure.
+ * @complexity O(N * separatorLength) for the scan, O(parts) for the slices.
+ */
+AuraValue* auraStringSplit(AuraValue s, const char* separator, size_t separatorLength, size_t* count) {
+    const char* chars = auraStringData(&s);
+    size_t length = auraStringLength(s);
+    *count = 0;
+
+    size_t parts = length;
+    if (separatorLength > 0) {
+        parts = 1;
+        for (size_t i = 0; i + separatorLength <= length;) {
+            if (memcmp(chars + i, separator, separatorLength) == 0) {
+                parts++;
+                i += separatorLength;
+            } else {
+                i++;
+            }
+        }
+    }
+
+    AuraValue* result = (AuraValue*)malloc((parts > 0 ? parts : 1) * sizeof(AuraValue));
+    if (result == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory in auraStringSplit.\n");
+        return NULL;
+    }
+
+    if (separatorLength == 0) {
+        for (size_t i = 0; i < length; i++) result[i] = makeSlice(s, i, 1);
+        *count = length;
+        return result;
+    }
+
+    size_t partStart = 0;
+    size_t n = 0;
+    for (size_t i = 0; i + separatorLength <= length;) {
+        if (memcmp(chars + i, separator, separatorLength) == 0) {
+            result[n++] = makeSlice(s, partStart, i - partStart);
+            i += separatorLength;
+            partStart = i;
+        } else {
+            i++;
+        }
+    }
+    result[n++] = makeSlice(s, partStart, length - partStart);
+    *count = n;
+    return result;
+}
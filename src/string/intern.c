@@ -0,0 +1,251 @@
+/**
+ * @file intern.c
+ * @brief Global string interning table.
+ *
+ * An open-addressing hash set (linear probing) of heap strings keyed by their
+ * cached hash. Entries are weak: the table never keeps a string alive. When
+ * the last reference to an interned string is released, `auraFreeString`
+ * evicts it and its slot turns into a tombstone. Tombstones count toward the load
+ * factor and are discarded whenever the table is rebuilt, and the table also
+ * shrinks when most entries die, so its size tracks the live set under churn.
+ *
+ * The table is process-global and not synchronized; it belongs to the thread
+ * running the interpreter.
+ */
+
+#include "aura_string.h"
+#include "intern.h"
+
+#define TABLE_MIN_CAPACITY 16
+#define TABLE_MAX_LOAD_NUM 3   // Rebuild when (live + tombstones) exceeds 3/4 of capacity.
+#define TABLE_MAX_LOAD_DEN 4
+
+/** Marker stored in slots whose string was evicted. */
+static char tombstoneMarker;
+#define TOMBSTONE ((AuraString*)&tombstoneMarker)
+
+typedef struct {
+    AuraString** entries;
+    size_t capacity;   // Always 0 or a power of two.
+    size_t live;
+    size_t tombstones;
+} InternTable;
+
+static InternTable table = { NULL, 0, 0, 0 };
+
+/**
+ * Finds the slot holding a string with the given contents.
+ *
+ * @return The matching string, or NULL if it is not interned.
+ * @complexity O(1) expected.
+ */
+static AuraString* findInterned(const char* chars, size_t length, uint32_t hash) {
+    if (table.capacity == 0) return NULL;
+
+    size_t mask = table.capacity - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        AuraString* entry = table.entries[index];
+        if (entry == NULL) return NULL;
+        if (entry != TOMBSTONE && entry->header.hash == hash && entry->header.length == length &&
+            memcmp(entry->chars, chars, length) == 0) {
+            return entry;
+        }
+    }
+}
+
+/**
+ * Inserts a string known to be absent, reusing the first tombstone on its path.
+ *
+ * @complexity O(1) expected.
+ */
+static void insertEntry(AuraString* string) {
+    size_t mask = table.capacity - 1;
+    for (size_t index = string->header.hash & mask;; index = (index + 1) & mask) {
+        AuraString* entry = table.entries[index];
+        if (entry == NULL || entry == TOMBSTONE) {
+            if (entry == TOMBSTONE) table.tombstones--;
+            table.entries[index] = string;
+            table.live++;
+            return;
+        }
+    }
+}
+
+/**
+ * Rebuilds the table with room for `live` strings, dropping every tombstone.
+ *
+ * @param live Number of live entries the new table must hold.
+ * @return false if the new slot array could not be allocated.
+ * @complexity O(capacity)
+ */
+static bool rebuildTable(size_t live) {
+    size_t capacity = TABLE_MIN_CAPACITY;
+    while (live * TABLE_MAX_LOAD_DEN >= capacity * TABLE_MAX_LOAD_NUM / 2) capacity *= 2;
+
+    AuraString** entries = (AuraString**)calloc(capacity, sizeof(AuraString*));
+    if (entries == NULL) return false;
+
+    AuraString** old = table.entries;
+    size_t oldCapacity = table.capacity;
+
+    table.entries = entries;
+    table.capacity = capacity;
+    table.live = 0;
+    table.tombstones = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (old[i] != NULL && old[i] != TOMBSTONE) insertEntry(old[i]);
+    }
+    free(old);
+    return true;
+}
+
+/**
+ * Adds a new string to the table, growing or compacting it first if needed.
+ *
+ * @return false if the table could not make room.
+ */
+static bool addInterned(AuraString* string) {
+    if ((table.live + table.tombstones + 1) * TABLE_MAX_LOAD_DEN > table.capacity * TABLE_MAX_LOAD_NUM) {
+        if (!rebuildTable(table.live + 1)) return false;
+    }
+    string->header.interned = true;
+    insertEntry(string);
+    return true;
+}
+
+/**
+ * Returns the interned string for the given characters, creating it if needed.
+ *
+ * @param chars The characters.
+ * @param length Number of bytes.
+ * @return An owned reference to the interned string.
+ * @complexity O(N) to hash the input, O(1) expected table probing.
+ */
+AuraValue auraInternString(const char* chars, size_t length) {
+    AuraValue string = auraCopyString(chars, length);
+    if (!AURA_IS_OBJ(string)) return string;
+    return auraIntern(string);
+}
+
+/**
+ * Interns an existing string value, consuming it.
+ *
+ * @param string A string value owned by the caller.
+ * @return An owned reference to the canonical string.
+ * @complexity O(1) expected.
+ */
+AuraValue auraIntern(AuraValue string) {
+    if (!AURA_IS_OBJ(string)) return string;
+
+    if (AURA_AS_OBJ(string)->flags & AURA_OBJ_ARENA) {
+        // The table must never point into an arena that may be reset.
+        string = auraCopyString(auraStringData(&string), auraStringLength(string));
+        if (!AURA_IS_OBJ(string)) return string;
+    }
+
+    if (AURA_AS_STRING_HEADER(string)->kind != AURA_STRING_FLAT) {
+        // Only flat strings are interned: trade ropes and slices for flat bytes.
+        AuraString* flat = auraStringToFlat(string);
+        if (flat == NULL) return string;
+        freeValue(string);
+        string = AURA_OBJ_VAL(flat);
+    }
+
+    AuraString* candidate = AURA_AS_STRING(string);
+    if (candidate->header.interned) return string;
+
+    AuraString* existing = findInterned(candidate->chars, candidate->header.length, candidate->header.hash);
+    if (existing != NULL) {
+        existing->header.refs++;
+        freeValue(string);
+        return AURA_OBJ_VAL(existing);
+    }
+
+    // Falling back to an ordinary string keeps the program correct if the table cannot grow.
+    addInterned(candidate);
+    return string;
+}
+
+/**
+ * Checks whether a value is an interned heap string.
+ */
+bool auraIsInterned(AuraValue v) {
+    return AURA_IS_STRING(v) && AURA_IS_OBJ(v) && AURA_AS_STRING_HEADER(v)->interned;
+}
+
+/**
+ * Removes a dying interned string from the table.
+ *
+ * OPTIMIZATION: When the live set falls below 1/8 of the capacity the table is
+ * rebuilt smaller, so a burst of short-lived keys does not pin memory forever.
+ *
+ * @param string An interned string whose last reference was released.
+ * @complexity O(1) expected, amortized.
+ */
+void auraEvictInterned(AuraString* string) {
+    string->header.interned = false;
+
+    // The entry may already be gone (auraInternSweep or auraFreeInternTable).
+    size_t mask = table.capacity - 1;
+    for (size_t index = string->header.hash & mask; table.capacity > 0; index = (index + 1) & mask) {
+        AuraString* entry = table.entries[index];
+        if (entry == NULL) break;
+        if (entry == string) {
+            table.entries[index] = TOMBSTONE;
+            table.live--;
+            table.tombstones++;
+            break;
+        }
+    }
+
+    if (table.capacity > TABLE_MIN_CAPACITY && table.live * 8 < table.capacity) {
+        rebuildTable(table.live);
+    }
+}
+
+/**
+ * Drops every table entry whose string a tracing collector found unreachable.
+ *
+ * @param isLive Callback returning true for strings that survive the collection.
+ * @complexity O(capacity)
+ */
+void auraInternSweep(bool (*isLive)(const AuraString* string)) {
+    for (size_t i = 0; i < table.capacity; i++) {
+        AuraString* entry = table.entries[i];
+        if (entry != NULL && entry != TOMBSTONE && !isLive(entry)) {
+            entry->header.interned = false;
+            table.entries[i] = TOMBSTONE;
+            table.live--;
+            table.tombstones++;
+        }
+    }
+}
+
+/**
+ * Returns the current occupancy of the intern table.
+ */
+AuraInternStats auraInternStats(void) {
+    AuraInternStats stats;
+    stats.live = table.live;
+    stats.tombstones = table.tombstones;
+    stats.capacity = table.capacity;
+    return stats;
+}
+
+/**
+ * Releases the storage of the intern table itself (strings are not freed).
+ * Strings still alive lose their interned flag, as in auraInternSweep, so they
+ * are no longer compared by pointer against strings interned afterwards.
+ */
+void auraFreeInternTable(void) {
+    for (size_t i = 0; i < table.capacity; i++) {
+        AuraString* entry = table.entries[i];
+        if (entry != NULL && entry != TOMBSTONE) entry->header.interned = false;
+    }
+    free(table.entries);
+    table.entries = NULL;
+    table.capacity = 0;
+    table.live = 0;
+    table.tombstones = 0;
+}
@@ -0,0 +1,27 @@
+#ifndef minijs_intern_h
+#define minijs_intern_h
+
+/**
+ * @file intern.h
+ * @brief Private interface between the string module and the intern table.
+ */
+
+#include "aura_string.h"
+
+/**
+ * Removes a dying interned string from the table (the caller frees it).
+ *
+ * @param string An interned string whose last reference was just released.
+ */
+void auraEvictInterned(AuraString* string);
+
+/**
+ * Returns an owned flat string with the same bytes as a heap string value,
+ * flattening ropes and materializing slices as needed.
+ *
+ * @param v A heap value of type AURA_STRING (not consumed).
+ * @return A new reference to a flat string, or NULL on allocation failure.
+ */
+AuraString* auraStringToFlat(AuraValue v);
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file cpu.c
+ * @brief CPUID-based feature detection.
+ */
+
+#include "cpu.h"
+#include <stdint.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define AURA_X86 1
+#endif
+
+static AuraCpuFeatures features;
+static AuraSimdLevel maxLevel = AURA_SIMD_SCALAR;
+static AuraSimdLevel level = AURA_SIMD_SCALAR;
+static pthread_once_t detectOnce = PTHREAD_ONCE_INIT;
+
+static const char* levelNames[AURA_SIMD_LEVEL_COUNT] = { "scalar", "sse2", "avx2", "avx512" };
+
+#ifdef AURA_X86
+/**
+ * Reads the OS-enabled register state (XCR0).
+ */
+static uint64_t readXcr0(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+#endif
+
+/**
+ * Fills `features` and the derived tiers. Runs exactly once.
+ */
+static void detect(void) {
+#ifdef AURA_X86
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int maxLeaf = __get_cpuid_max(0, NULL);
+
+    if (maxLeaf >= 1 && __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        features.sse2 = (edx >> 26) & 1;
+        bool osxsave = (ecx >> 27) & 1;
+        uint64_t xcr0 = osxsave ? readXcr0() : 0;
+        bool ymmEnabled = (xcr0 & 0x6) == 0x6;            // XMM and YMM state.
+        bool zmmEnabled = ymmEnabled && (xcr0 & 0xe0) == 0xe0; // Opmask and ZMM state.
+
+        features.avx = ymmEnabled && ((ecx >> 28) & 1);
+        features.fma = features.avx && ((ecx >> 12) & 1);
+        features.f16c = features.avx && ((ecx >> 29) & 1);
+
+        if (maxLeaf >= 7) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            features.avx2 = features.avx && ((ebx >> 5) & 1);
+            features.avx512f = zmmEnabled && ((ebx >> 16) & 1);
+            features.avx512dq = features.avx512f && ((ebx >> 17) & 1);
+            features.avx512bw = features.avx512f && ((ebx >> 30) & 1);
+            features.avx512vl = features.avx512f && ((ebx >> 31) & 1);
+            features.avx512vnni = features.avx512f && ((ecx >> 11) & 1);
+
+            unsigned int subleaves = eax;
+            if (subleaves >= 1) {
+                __cpuid_count(7, 1, eax, ebx, ecx, edx);
+                features.avxvnni = features.avx2 && ((eax >> 4) & 1);
+                features.avx512bf16 = features.avx512f && ((eax >> 5) & 1);
+            }
+        }
+    }
+#endif
+
+    if (features.sse2) maxLevel = AURA_SIMD_SSE2;
+    if (features.avx2 && features.fma) maxLevel = AURA_SIMD_AVX2;
+    if (maxLevel == AURA_SIMD_AVX2 && features.avx512f && features.avx512bw &&
+        features.avx512dq && features.avx512vl) {
+        maxLevel = AURA_SIMD_AVX512;
+    }
+
+    level = maxLevel;
+    const char* cap = getenv("AURA_SIMD");
+    if (cap != NULL) {
+        for (int i = 0; i < AURA_SIMD_LEVEL_COUNT; i++) {
+            if (strcmp(cap, levelNames[i]) == 0 && (AuraSimdLevel)i < level) level = (AuraSimdLevel)i;
+        }
+    }
+}
+
+/**
+ * Returns the features of the running CPU (detected on first call).
+ *
+ * @return Pointer to a process-wide, read-only structure.
+ * @complexity O(1) after the first call.
+ */
+const AuraCpuFeatures* auraCpuFeatures(void) {
+    pthread_once(&detectOnce, detect);
+    return &features;
+}
+
+/**
+ * Returns the widest supported SIMD tier, capped by `AURA_SIMD` if set.
+ */
+AuraSimdLevel auraCpuSimdLevel(void) {
+    pthread_once(&detectOnce, detect);
+    return level;
+}
+
+/**
+ * Returns the widest tier the hardware supports, ignoring `AURA_SIMD`.
+ */
+AuraSimdLevel auraCpuMaxSimdLevel(void) {
+    pthread_once(&detectOnce, detect);
+    return maxLevel;
+}
+
+/**
+ * Returns a short lowercase name for a tier.
+ */
+const char* auraSimdLevelName(AuraSimdLevel simdLevel) {
+    if (simdLevel < 0 || simdLevel >= AURA_SIMD_LEVEL_COUNT) return "unknown";
+    return levelNames[simdLevel];
+}
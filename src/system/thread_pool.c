@@ -0,0 +1,206 @@
+/**
+ * @file thread_pool.c
+ * @brief Worker pool behind `auraParallelFor`.
+ *
+ * One loop runs at a time: a submitter publishes the job under `lock`, bumps
+ * `generation` and wakes the workers, then claims chunks alongside them until
+ * `pending` drops to zero. Chunks are claimed one by one under the lock, which
+ * is cheap because a loop is cut into at most one chunk per thread.
+ */
+
+#include "thread_pool.h"
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;          // Workers wait here for a new generation.
+    pthread_cond_t done;          // The submitter waits here for `pending == 0`.
+    pthread_mutex_t submit;       // Serializes loops started by different threads.
+
+    pthread_t* workers;
+    size_t workerCount;           // Threads besides the caller.
+    unsigned long generation;
+    bool stopping;
+
+    AuraParallelTask task;
+    void* context;
+    size_t count;
+    size_t chunkCount;
+    size_t nextChunk;
+    size_t pending;
+} ThreadPool;
+
+static ThreadPool pool = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, false, NULL, NULL, 0, 0, 0, 0
+};
+static pthread_once_t startOnce = PTHREAD_ONCE_INIT;
+
+/** Set while a thread executes a chunk, so nested loops run inline. */
+static AURA_THREAD_LOCAL bool insideLoop = false;
+
+/**
+ * Number of online CPUs, or `AURA_THREADS` when set to a positive number.
+ */
+static size_t defaultSize(void) {
+    const char* env = getenv("AURA_THREADS");
+    if (env != NULL) {
+        long requested = strtol(env, NULL, 10);
+        if (requested > 0) return requested > AURA_THREAD_POOL_MAX ? AURA_THREAD_POOL_MAX : (size_t)requested;
+    }
+
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long cpus = (long)info.dwNumberOfProcessors;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cpus < 1) return 1;
+    return cpus > AURA_THREAD_POOL_MAX ? AURA_THREAD_POOL_MAX : (size_t)cpus;
+}
+
+/**
+ * Claims and runs chunks of the current job until none is left.
+ * Must be called with `pool.lock` held; returns with it held.
+ */
+static void runChunks(void) {
+    while (pool.nextChunk < pool.chunkCount) {
+        size_t chunk = pool.nextChunk++;
+        AuraParallelTask task = pool.task;
+        void* context = pool.context;
+        size_t begin = chunk * pool.count / pool.chunkCount;
+        size_t end = (chunk + 1) * pool.count / pool.chunkCount;
+        pthread_mutex_unlock(&pool.lock);
+
+        insideLoop = true;
+        task(context, begin, end);
+        insideLoop = false;
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+    }
+}
+
+static void* workerMain(void* unused) {
+    (void)unused;
+    pthread_mutex_lock(&pool.lock);
+    unsigned long seen = pool.generation;
+    for (;;) {
+        while (!pool.stopping && pool.generation == seen) pthread_cond_wait(&pool.wake, &pool.lock);
+        if (pool.stopping) break;
+        seen = pool.generation;
+        runChunks();
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+/**
+ * Starts `threads - 1` workers. Called with no loop in flight.
+ */
+static void startWorkers(size_t threads) {
+    pool.stopping = false;
+    pool.workerCount = 0;
+    if (threads <= 1) return;
+
+    pool.workers = (pthread_t*)malloc(sizeof(pthread_t) * (threads - 1));
+    if (pool.workers == NULL) return;
+    for (size_t i = 0; i < threads - 1; i++) {
+        if (pthread_create(&pool.workers[pool.workerCount], NULL, workerMain, NULL) != 0) {
+            fprintf(stderr, "[Security] Thread pool could only start %zu of %zu workers.\n",
+                    pool.workerCount, threads - 1);
+            break;
+        }
+        pool.workerCount++;
+    }
+}
+
+/**
+ * Stops and joins every worker. Called with no loop in flight.
+ */
+static void stopWorkers(void) {
+    pthread_mutex_lock(&pool.lock);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (size_t i = 0; i < pool.workerCount; i++) pthread_join(pool.workers[i], NULL);
+    free(pool.workers);
+    pool.workers = NULL;
+    pool.workerCount = 0;
+}
+
+static void startDefault(void) {
+    startWorkers(defaultSize());
+}
+
+/**
+ * Returns the number of threads that execute parallel loops.
+ */
+size_t auraThreadPoolSize(void) {
+    pthread_once(&startOnce, startDefault);
+    return pool.workerCount + 1;
+}
+
+/**
+ * Restarts the pool with `threads` threads (0 restores the default size).
+ *
+ * @param threads The requested number of threads.
+ * @return The size actually in effect.
+ */
+size_t auraThreadPoolSetSize(size_t threads) {
+    pthread_once(&startOnce, startDefault);
+    if (threads == 0) threads = defaultSize();
+    if (threads > AURA_THREAD_POOL_MAX) threads = AURA_THREAD_POOL_MAX;
+
+    pthread_mutex_lock(&pool.submit);
+    stopWorkers();
+    startWorkers(threads);
+    pthread_mutex_unlock(&pool.submit);
+    return pool.workerCount + 1;
+}
+
+/**
+ * Runs `task` over [0, count) split across the pool.
+ *
+ * @param count Number of indices.
+ * @param grain Minimum indices per chunk.
+ * @param task The loop body.
+ * @param context Passed through to `task`.
+ * @complexity O(count) work spread over the pool, plus O(threads) scheduling.
+ */
+void auraParallelFor(size_t count, size_t grain, AuraParallelTask task, void* context) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    size_t chunks = count / grain;
+    size_t threads = insideLoop ? 1 : auraThreadPoolSize();
+    if (chunks > threads) chunks = threads;
+    if (chunks < 2) {
+        task(context, 0, count);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.submit);
+    pthread_mutex_lock(&pool.lock);
+    pool.task = task;
+    pool.context = context;
+    pool.count = count;
+    pool.chunkCount = chunks;
+    pool.nextChunk = 0;
+    pool.pending = chunks;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.wake);
+
+    runChunks();
+    while (pool.pending > 0) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.submit);
+}
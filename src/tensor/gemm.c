@@ -0,0 +1,289 @@
+/**
+ * @file gemm.c
+ * @brief Cache-blocked single-precision matrix multiplication.
+ *
+ * Follows the classic Goto/BLIS structure: C is updated in NC-column slabs,
+ * each split into KC-deep slices of A and B. The B slice is packed into
+ * NR-wide panels that stay in L3/L2, the A block into MR-tall panels sized for
+ * L2, and the microkernel of the active kernel table multiplies one A panel by
+ * one B panel with the whole MR x NR tile of C held in vector registers.
+ * Packing also absorbs arbitrary strides and zero-pads ragged edges, so the
+ * microkernel never sees a partial tile.
+ *
+ * Large products are cut along their longer side of C into independent
+ * blocks that the thread pool computes concurrently, each with its own
+ * per-thread packing buffers.
+ */
+
+#include "kernels.h"
+#include "aligned.h"
+#include "thread_pool.h"
+#include <pthread.h>
+
+#define GEMM_KC 256           // Depth of a packed slice (A panel + B panel fit in L1).
+#define GEMM_MC_TARGET 144    // Rows of a packed A block (MC x KC floats ~ L2).
+#define GEMM_NC_TARGET 3072   // Columns of a packed B slice (KC x NC floats ~ L3).
+#define GEMM_MAX_TILE 1024    // Upper bound on MR * NR over all kernel tables.
+#define GEMM_PARALLEL_MIN_WORK ((size_t)1 << 18)  // Multiply-adds per thread worth a hand-off.
+
+/**
+ * @brief Per-thread packing buffers, grown on demand and reused across calls
+ * so a stream of small products does not pay for an allocation each time.
+ */
+typedef struct {
+    float* a;
+    size_t aCapacity;
+    float* b;
+    size_t bCapacity;
+} PackBuffers;
+
+static AURA_THREAD_LOCAL PackBuffers* threadBuffers = NULL;
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t exitKey;
+
+/**
+ * Thread-exit hook: releases the buffers of a finished (e.g. pool) thread.
+ */
+static void freeThreadBuffers(void* arg) {
+    PackBuffers* buffers = (PackBuffers*)arg;
+    auraAlignedFree(buffers->a);
+    auraAlignedFree(buffers->b);
+    free(buffers);
+}
+
+static void createExitKey(void) {
+    pthread_key_create(&exitKey, freeThreadBuffers);
+}
+
+/**
+ * Makes sure `*buffer` holds at least `count` floats.
+ */
+static bool reserve(float** buffer, size_t* capacity, size_t count) {
+    if (*capacity >= count) return true;
+    float* grown = auraAlignedAlloc(count * sizeof(float), AURA_TENSOR_ALIGNMENT);
+    if (grown == NULL) return false;
+    auraAlignedFree(*buffer);
+    *buffer = grown;
+    *capacity = count;
+    return true;
+}
+
+/**
+ * Returns this thread's buffers with room for `aCount` and `bCount` floats.
+ */
+static PackBuffers* packBuffers(size_t aCount, size_t bCount) {
+    if (threadBuffers == NULL) {
+        threadBuffers = (PackBuffers*)calloc(1, sizeof(PackBuffers));
+        if (threadBuffers == NULL) return NULL;
+        pthread_once(&keyOnce, createExitKey);
+        pthread_setspecific(exitKey, threadBuffers);
+    }
+    if (!reserve(&threadBuffers->a, &threadBuffers->aCapacity, aCount) ||
+        !reserve(&threadBuffers->b, &threadBuffers->bCapacity, bCount)) {
+        return NULL;
+    }
+    return threadBuffers;
+}
+
+/**
+ * Packs the mc x kc block of A at `a` into MR-tall panels: panel by panel,
+ * then column by column, MR consecutive rows. Rows past `mc` are zero.
+ */
+static void packA(size_t mr, size_t mc, size_t kc, const float* a, ptrdiff_t rsa, ptrdiff_t csa,
+                  float* dst) {
+    for (size_t ir = 0; ir < mc; ir += mr) {
+        size_t rows = mc - ir < mr ? mc - ir : mr;
+        const float* panel = a + (ptrdiff_t)ir * rsa;
+        for (size_t p = 0; p < kc; p++) {
+            const float* column = panel + (ptrdiff_t)p * csa;
+            size_t i = 0;
+            for (; i < rows; i++) dst[i] = column[(ptrdiff_t)i * rsa];
+            for (; i < mr; i++) dst[i] = 0.0f;
+            dst += mr;
+        }
+    }
+}
+
+/**
+ * Packs the kc x nc block of B at `b` into NR-wide panels: panel by panel,
+ * then row by row, NR consecutive columns. Columns past `nc` are zero.
+ */
+static void packB(size_t nr, size_t nc, size_t kc, const float* b, ptrdiff_t rsb, ptrdiff_t csb,
+                  float* dst) {
+    for (size_t jr = 0; jr < nc; jr += nr) {
+        size_t cols = nc - jr < nr ? nc - jr : nr;
+        const float* panel = b + (ptrdiff_t)jr * csb;
+        for (size_t p = 0; p < kc; p++) {
+            const float* row = panel + (ptrdiff_t)p * rsb;
+            size_t j = 0;
+            if (csb == 1) {
+                memcpy(dst, row, cols * sizeof(float));
+                j = cols;
+            } else {
+                for (; j < cols; j++) dst[j] = row[(ptrdiff_t)j * csb];
+            }
+            for (; j < nr; j++) dst[j] = 0.0f;
+            dst += nr;
+        }
+    }
+}
+
+/**
+ * Number of multiply-adds the microkernel actually performs for an m x n
+ * product, counting the zero padding of partial tiles.
+ */
+static size_t paddedArea(size_t m, size_t n, size_t mr, size_t nr) {
+    return ((m + mr - 1) / mr) * mr * ((n + nr - 1) / nr) * nr;
+}
+
+/**
+ * Single-threaded blocked loop nest: C += A * B with the given kernels.
+ *
+ * @return false, leaving C untouched, if the packing buffers cannot be allocated.
+ */
+static bool gemmBlocked(const AuraKernelTable* kernels, size_t m, size_t n, size_t k,
+                        const float* a, ptrdiff_t rsa, ptrdiff_t csa,
+                        const float* b, ptrdiff_t rsb, ptrdiff_t csb,
+                        float* c, ptrdiff_t rsc, ptrdiff_t csc) {
+    size_t mr = kernels->gemmMr;
+    size_t nr = kernels->gemmNr;
+
+    size_t mc = GEMM_MC_TARGET / mr * mr;
+    if (mc == 0) mc = mr;
+    size_t nc = GEMM_NC_TARGET / nr * nr;
+    if (nc == 0) nc = nr;
+    size_t kc = GEMM_KC;
+
+    size_t ncUsed = n < nc ? (n + nr - 1) / nr * nr : nc;
+    size_t mcUsed = m < mc ? (m + mr - 1) / mr * mr : mc;
+    size_t kcUsed = k < kc ? k : kc;
+    PackBuffers* buffers = packBuffers(kcUsed * mcUsed, kcUsed * ncUsed);
+    if (buffers == NULL) return false;
+    float* packedA = buffers->a;
+    float* packedB = buffers->b;
+
+    float tile[GEMM_MAX_TILE];
+
+    for (size_t jc = 0; jc < n; jc += nc) {
+        size_t ncCur = n - jc < nc ? n - jc : nc;
+        for (size_t pc = 0; pc < k; pc += kc) {
+            size_t kcCur = k - pc < kc ? k - pc : kc;
+            packB(nr, ncCur, kcCur, b + (ptrdiff_t)pc * rsb + (ptrdiff_t)jc * csb, rsb, csb, packedB);
+
+            for (size_t ic = 0; ic < m; ic += mc) {
+                size_t mcCur = m - ic < mc ? m - ic : mc;
+                packA(mr, mcCur, kcCur, a + (ptrdiff_t)ic * rsa + (ptrdiff_t)pc * csa, rsa, csa, packedA);
+
+                for (size_t jr = 0; jr < ncCur; jr += nr) {
+                    size_t cols = ncCur - jr < nr ? ncCur - jr : nr;
+                    const float* panelB = packedB + jr * kcCur;
+                    for (size_t ir = 0; ir < mcCur; ir += mr) {
+                        size_t rows = mcCur - ir < mr ? mcCur - ir : mr;
+                        kernels->gemm(kcCur, packedA + ir * kcCur, panelB, tile);
+
+                        float* out = c + (ptrdiff_t)(ic + ir) * rsc + (ptrdiff_t)(jc + jr) * csc;
+                        for (size_t i = 0; i < rows; i++) {
+                            float* row = out + (ptrdiff_t)i * rsc;
+                            const float* sum = tile + i * nr;
+                            if (csc == 1) {
+                                for (size_t j = 0; j < cols; j++) row[j] += sum[j];
+                            } else {
+                                for (size_t j = 0; j < cols; j++) row[(ptrdiff_t)j * csc] += sum[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief One product split into blocks of `unit` rows (or columns) of C.
+ */
+typedef struct {
+    const AuraKernelTable* kernels;
+    size_t m, n, k;
+    const float* a;
+    ptrdiff_t rsa, csa;
+    const float* b;
+    ptrdiff_t rsb, csb;
+    float* c;
+    ptrdiff_t rsc, csc;
+    bool splitRows;               // Split along m (true) or along n (false).
+    size_t unit;                  // MR or NR, so blocks only end in partial tiles at the edge.
+    bool failed;                  // Set by a task that could not allocate its packing buffers.
+} GemmJob;
+
+static void gemmTask(void* context, size_t begin, size_t end) {
+    GemmJob* job = (GemmJob*)context;
+    size_t first = begin * job->unit;
+    bool ok;
+    if (job->splitRows) {
+        size_t last = end * job->unit < job->m ? end * job->unit : job->m;
+        ok = gemmBlocked(job->kernels, last - first, job->n, job->k,
+                    job->a + (ptrdiff_t)first * job->rsa, job->rsa, job->csa,
+                    job->b, job->rsb, job->csb,
+                    job->c + (ptrdiff_t)first * job->rsc, job->rsc, job->csc);
+    } else {
+        size_t last = end * job->unit < job->n ? end * job->unit : job->n;
+        ok = gemmBlocked(job->kernels, job->m, last - first, job->k,
+                    job->a, job->rsa, job->csa,
+                    job->b + (ptrdiff_t)first * job->csb, job->rsb, job->csb,
+                    job->c + (ptrdiff_t)first * job->csc, job->rsc, job->csc);
+    }
+    if (!ok) __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+}
+
+/**
+ * Accumulates C += A * B for general row/column strides (in floats).
+ *
+ * @param m Rows of A and C.
+ * @param n Columns of B and C.
+ * @param k Columns of A and rows of B.
+ * @return false if packing buffers could not be allocated; C is then partly updated.
+ * @complexity O(m * n * k)
+ */
+bool auraGemm(size_t m, size_t n, size_t k,
+              const float* a, ptrdiff_t rsa, ptrdiff_t csa,
+              const float* b, ptrdiff_t rsb, ptrdiff_t csb,
+              float* c, ptrdiff_t rsc, ptrdiff_t csc) {
+    if (m == 0 || n == 0 || k == 0) return true;
+
+    const AuraKernelTable* kernels = auraActiveKernels();
+    size_t mr = kernels->gemmMr;
+    size_t nr = kernels->gemmNr;
+
+    // OPTIMIZATION: Skinny products (matrix-vector and friends) waste most of
+    // a tile on padding in one orientation. C^T = B^T * A^T swaps the roles of
+    // m and n at no cost, since packing handles any strides.
+    if (paddedArea(n, m, mr, nr) < paddedArea(m, n, mr, nr)) {
+        const float* t = a;
+        a = b;
+        b = t;
+        size_t s = m;
+        m = n;
+        n = s;
+        ptrdiff_t rs = rsa, cs = csa;
+        rsa = csb;
+        csa = rsb;
+        rsb = cs;
+        csb = rs;
+        rs = rsc;
+        rsc = csc;
+        csc = rs;
+    }
+
+    // Every block repacks the operand that is not split, so blocks are kept
+    // large enough to amortize it and the split follows the longer side.
+    GemmJob job = { kernels, m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc, m >= n, m >= n ? mr : nr, false };
+    size_t units = ((job.splitRows ? m : n) + job.unit - 1) / job.unit;
+    size_t workPerUnit = job.unit * (job.splitRows ? n : m) * k;
+    auraParallelFor(units, GEMM_PARALLEL_MIN_WORK / workPerUnit + 1, gemmTask, &job);
+    if (job.failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory for GEMM packing buffers.\n");
+        return false;
+    }
+    return true;
+}
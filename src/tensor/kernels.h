@@ -0,0 +1,187 @@
+#ifndef minijs_kernels_h
+#define minijs_kernels_h
+
+/**
+ * @file kernels.h
+ * @brief Private interface between the tensor operations and their kernels.
+ *
+ * A kernel processes `n` contiguous floats. Each instruction set provides a
+ * complete AuraKernelTable; `auraActiveKernels` returns the one selected for
+ * this machine. Kernels must accept unaligned pointers and any `n`, and `out`
+ * may alias any input.
+ */
+
+#include "tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define AURA_PARALLEL_MIN_ELEMENTS ((size_t)1 << 16)   // Elements per thread worth a hand-off.
+
+typedef void (*AuraBinaryKernel)(float* out, const float* a, const float* b, size_t n);
+typedef void (*AuraScalarKernel)(float* out, const float* a, float s, size_t n);
+typedef void (*AuraFmaKernel)(float* out, const float* a, const float* b, const float* c, size_t n);
+typedef void (*AuraUnaryKernel)(float* out, const float* a, size_t n);
+typedef float (*AuraReduceKernel)(const float* a, size_t n);
+typedef size_t (*AuraArgmaxKernel)(const float* a, size_t n);
+typedef void (*AuraArgmaxUpdateKernel)(float* best, int32_t* index, const float* a, int32_t k, size_t n);
+typedef float (*AuraGatherDotKernel)(const float* values, const uint32_t* index, const float* x, size_t n);
+
+/** `n` consecutive elements of a Vec3 array, one pointer per component. */
+typedef struct { const float* x; const float* y; const float* z; } AuraVec3In;
+typedef struct { float* x; float* y; float* z; } AuraVec3Out;
+
+typedef void (*AuraVec3DotKernel)(float* out, AuraVec3In a, AuraVec3In b, size_t n);
+typedef void (*AuraVec3CrossKernel)(AuraVec3Out out, AuraVec3In a, AuraVec3In b, size_t n);
+typedef void (*AuraVec3LengthKernel)(float* out, AuraVec3In a, size_t n);
+typedef void (*AuraVec3NormalizeKernel)(AuraVec3Out out, AuraVec3In a, size_t n);
+
+/**
+ * GEMM microkernel: multiplies an MR x k packed A panel by a k x NR packed B
+ * panel and stores the MR x NR product (row-major, NR wide) in `tile`.
+ *
+ * Packed A holds, for each p, the MR elements A[0..MR)[p]; packed B holds, for
+ * each p, the NR elements B[p][0..NR). Both are 64-byte aligned.
+ */
+typedef void (*AuraGemmMicrokernel)(size_t k, const float* a, const float* b, float* tile);
+
+/**
+ * @brief Entry points of one instruction set.
+ */
+typedef struct {
+    AuraBinaryKernel binary[AURA_TENSOR_BINARY_OP_COUNT];           // out = a op b
+    AuraScalarKernel binaryScalar[AURA_TENSOR_BINARY_OP_COUNT];     // out = a op s
+    AuraScalarKernel scalarBinary[AURA_TENSOR_BINARY_OP_COUNT];     // out = s op a
+    AuraFmaKernel fma;                                              // out = a * b + c
+    AuraUnaryKernel unary[AURA_TENSOR_UNARY_OP_COUNT];
+    AuraReduceKernel sum;                                           // Pairwise: error grows with log(n).
+    AuraReduceKernel sumSquares;
+    AuraReduceKernel max;                                           // Ignores NaNs; -inf if all are NaN.
+    AuraArgmaxKernel argmax;                                        // First index of the max (0 if all NaN).
+    AuraBinaryKernel maximum;                                       // out = a > b ? a : b
+    AuraArgmaxUpdateKernel argmaxUpdate;                            // Where a > best: best = a, index = k.
+    AuraScalarKernel axpy;                                          // out += a * s
+    AuraGatherDotKernel gatherDot;                                  // Sum of values[j] * x[index[j]].
+    AuraVec3DotKernel vec3Dot;
+    AuraVec3CrossKernel vec3Cross;
+    AuraVec3LengthKernel vec3Length;
+    AuraVec3NormalizeKernel vec3Normalize;                          // Zero vectors stay zero.
+    AuraGemmMicrokernel gemm;
+    size_t gemmMr;                                                  // Rows of a microkernel tile.
+    size_t gemmNr;                                                  // Columns of a microkernel tile.
+} AuraKernelTable;
+
+extern const AuraKernelTable auraKernelsScalar;
+#if defined(__x86_64__) || defined(__i386__)
+extern const AuraKernelTable auraKernelsSse2;
+extern const AuraKernelTable auraKernelsAvx2;
+extern const AuraKernelTable auraKernelsAvx512;
+#endif
+
+/**
+ * Returns the kernel table selected for this machine.
+ */
+const AuraKernelTable* auraActiveKernels(void);
+
+// --- Reduced-precision kernels ---
+
+typedef void (*AuraEncodeHalfKernel)(uint16_t* out, const float* in, size_t n);
+typedef void (*AuraDecodeHalfKernel)(float* out, const uint16_t* in, size_t n);
+typedef float (*AuraMaxAbsKernel)(const float* in, size_t n);
+typedef void (*AuraQuantizeKernel)(int8_t* out, const float* in, float inverseScale, size_t n);
+typedef void (*AuraDequantizeKernel)(float* out, const int8_t* in, float scale, size_t n);
+
+/**
+ * Dot products of one row `a` with the four rows `b + r * ldb` (r = 0..3), all
+ * `n` elements long, where `n` is a multiple of one 64-byte row segment (64
+ * int8 or 32 16-bit elements). `bSums[r]` is the sum of row r of b, which the
+ * VNNI kernels use to undo the bias they add to `a`.
+ */
+typedef void (*AuraDotI8Kernel)(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                                const int32_t* bSums, int32_t* out);
+typedef void (*AuraDotHalfKernel)(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out);
+
+/**
+ * @brief Conversion and dot-product kernels for the reduced-precision dtypes.
+ *
+ * Conversions round to nearest even and give bit-identical results on every
+ * tier (NaNs are quieted, as F16C does); the int8 dot products are exact.
+ */
+typedef struct {
+    AuraEncodeHalfKernel toF16;
+    AuraDecodeHalfKernel fromF16;
+    AuraEncodeHalfKernel toBf16;
+    AuraDecodeHalfKernel fromBf16;
+    AuraMaxAbsKernel maxAbs;
+    AuraQuantizeKernel quantizeI8;                                  // out = clamp(round(in * inverseScale), +-127)
+    AuraDequantizeKernel dequantizeI8;                              // out = in * scale
+    AuraDotI8Kernel dotI8;
+    AuraDotHalfKernel dotF16;
+    AuraDotHalfKernel dotBf16;
+} AuraDTypeKernels;
+
+/**
+ * Fills `kernels` for the active SIMD tier, using the F16C, VNNI and BF16
+ * extensions when the CPU has them.
+ */
+void auraSelectDTypeKernels(AuraDTypeKernels* kernels);
+
+/**
+ * Returns true if `t` holds float32 elements; otherwise prints a diagnostic
+ * naming `op` and returns false.
+ */
+bool auraTensorRequireF32(const AuraTensor* t, const char* op);
+
+// --- Layout helpers shared by the elementwise paths ---
+
+/**
+ * @brief Shape of a tensor or of a lazy expression, without storage.
+ */
+typedef struct {
+    int ndim;
+    size_t shape[AURA_TENSOR_MAX_DIMS];
+} AuraShape;
+
+/**
+ * Computes the broadcast of `count` shapes (NumPy rules) into `out`.
+ *
+ * @return false, after printing a diagnostic naming `op`, if they are incompatible.
+ */
+bool auraBroadcastShapes(const AuraShape* shapes, int count, const char* op, AuraShape* out);
+
+/**
+ * Allocates a tensor of the given shape whose elements (but not padding) are
+ * unspecified, for results written in full; returns NULL on failure.
+ */
+AuraTensor* auraCreateShaped(const AuraShape* shape);
+
+/**
+ * Returns `t` as seen through the shape of `out`: `t` itself when the shapes
+ * match, else `view`, filled with a stride-0 broadcast layout of `t`.
+ */
+const AuraTensor* auraBroadcastLayout(AuraTensor* view, const AuraTensor* t, const AuraTensor* out);
+
+/**
+ * True if the rows of `t` form one flat run (uniform, contiguous, unpadded).
+ */
+bool auraTensorIsFlat(const AuraTensor* t);
+
+/**
+ * Returns `n` elements of row `run` of `t` from column `offset` as a
+ * contiguous array: in place when the row is contiguous, else gathered into
+ * `scratch` (n floats). In flat mode `run` is 0 and `offset` spans all rows.
+ */
+const float* auraTensorSpan(const AuraTensor* t, size_t run, size_t offset, size_t n, float* scratch);
+
+/**
+ * Accumulates C += A * B for general row/column strides (in floats).
+ *
+ * A is m x k, B is k x n and C is m x n; element (i, j) of X lives at
+ * `x[i * rsx + j * csx]`. C must not overlap A or B. Returns false, with C
+ * partly updated, if the packing buffers cannot be allocated.
+ */
+bool auraGemm(size_t m, size_t n, size_t k,
+              const float* a, ptrdiff_t rsa, ptrdiff_t csa,
+              const float* b, ptrdiff_t rsb, ptrdiff_t csb,
+              float* c, ptrdiff_t rsc, ptrdiff_t csc);
+
+#endif
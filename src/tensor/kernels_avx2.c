@@ -0,0 +1,50 @@
+/**
+ * @file kernels_avx2.c
+ * @brief Elementwise tensor kernels for AVX2 + FMA (8 floats per vector).
+ *
+ * Compiled for AVX2 through a target pragma so the rest of the program keeps
+ * the baseline ISA; only called when cpu.c reports AVX2 and FMA.
+ */
+
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC target("avx2,fma")
+#include <immintrin.h>
+
+#define VF __m256
+#define VI __m256i
+#define VW 8
+#define V_LOADU(p)        _mm256_loadu_ps(p)
+#define V_STOREU(p, v)    _mm256_storeu_ps(p, v)
+#define V_SET1(x)         _mm256_set1_ps(x)
+#define V_SET1_I(x)       _mm256_set1_epi32(x)
+#define V_ADD(a, b)       _mm256_add_ps(a, b)
+#define V_SUB(a, b)       _mm256_sub_ps(a, b)
+#define V_MUL(a, b)       _mm256_mul_ps(a, b)
+#define V_DIV(a, b)       _mm256_div_ps(a, b)
+#define V_SQRT(a)         _mm256_sqrt_ps(a)
+#define V_MIN(a, b)       _mm256_min_ps(a, b)
+#define V_MAX(a, b)       _mm256_max_ps(a, b)
+#define V_FMADD(a, b, c)  _mm256_fmadd_ps(a, b, c)
+#define V_ABS(a)          _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a)
+#define V_SIGN(a)         _mm256_and_ps(_mm256_set1_ps(-0.0f), a)
+#define V_XOR(a, b)       _mm256_xor_ps(a, b)
+#define V_CVT_I(a)        _mm256_cvtps_epi32(a)
+#define V_CVT_F(i)        _mm256_cvtepi32_ps(i)
+#define V_ADD_I(a, b)     _mm256_add_epi32(a, b)
+#define V_SLLI_I(a, n)    _mm256_slli_epi32(a, n)
+#define V_CAST_IF(i)      _mm256_castsi256_ps(i)
+#define VM                __m256
+#define V_GT(a, b)        _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define V_SELECT(m, a, b) _mm256_blendv_ps(b, a, m)
+#define V_EQ_BITS(a, b)   _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))
+#define V_GATHER(p, i)    _mm256_i32gather_ps(p, _mm256_loadu_si256((const __m256i*)(i)), 4)
+
+#define GEMM_MR 6
+#define KERNEL_SUFFIX Avx2
+#define KERNEL_TABLE auraKernelsAvx2
+#include "kernels_simd.h"
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file kernels_avx512.c
+ * @brief Elementwise tensor kernels for AVX-512 (16 floats per vector).
+ *
+ * One vector covers a full 64-byte tensor row segment, so aligned rows are
+ * processed without cache-line splits. Only called when cpu.c reports
+ * AVX-512 F/BW/DQ/VL.
+ */
+
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC target("avx512f,avx512bw,avx512dq,avx512vl,avx2,fma")
+#include <immintrin.h>
+
+#define VF __m512
+#define VI __m512i
+#define VW 16
+#define V_LOADU(p)        _mm512_loadu_ps(p)
+#define V_STOREU(p, v)    _mm512_storeu_ps(p, v)
+#define V_SET1(x)         _mm512_set1_ps(x)
+#define V_SET1_I(x)       _mm512_set1_epi32(x)
+#define V_ADD(a, b)       _mm512_add_ps(a, b)
+#define V_SUB(a, b)       _mm512_sub_ps(a, b)
+#define V_MUL(a, b)       _mm512_mul_ps(a, b)
+#define V_DIV(a, b)       _mm512_div_ps(a, b)
+#define V_SQRT(a)         _mm512_sqrt_ps(a)
+#define V_MIN(a, b)       _mm512_min_ps(a, b)
+#define V_MAX(a, b)       _mm512_max_ps(a, b)
+#define V_FMADD(a, b, c)  _mm512_fmadd_ps(a, b, c)
+#define V_ABS(a)          _mm512_andnot_ps(_mm512_set1_ps(-0.0f), a)
+#define V_SIGN(a)         _mm512_and_ps(_mm512_set1_ps(-0.0f), a)
+#define V_XOR(a, b)       _mm512_xor_ps(a, b)
+#define V_CVT_I(a)        _mm512_cvtps_epi32(a)
+#define V_CVT_F(i)        _mm512_cvtepi32_ps(i)
+#define V_ADD_I(a, b)     _mm512_add_epi32(a, b)
+#define V_SLLI_I(a, n)    _mm512_slli_epi32(a, n)
+#define V_CAST_IF(i)      _mm512_castsi512_ps(i)
+#define VM                __mmask16
+#define V_GT(a, b)        _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ)
+#define V_SELECT(m, a, b) _mm512_mask_blend_ps(m, b, a)
+#define V_EQ_BITS(a, b)   _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)
+#define V_GATHER(p, i)    _mm512_i32gather_ps(_mm512_loadu_si512((const void*)(i)), p, 4)
+
+#define GEMM_MR 14
+#define KERNEL_SUFFIX Avx512
+#define KERNEL_TABLE auraKernelsAvx512
+#include "kernels_simd.h"
+
+#endif
@@ -0,0 +1,501 @@
+/**
+ * @file kernels_dtype.c
+ * @brief Conversion and dot-product kernels for float16, bfloat16 and int8.
+ *
+ * The portable versions define the results; the vector versions below them
+ * are compiled for their instruction sets through target pragmas and picked
+ * at runtime by auraSelectDTypeKernels, like the elementwise kernel tiers.
+ * Vector loops leave their tails to the portable versions, which round the
+ * same way, so conversions are bit-identical on every tier.
+ *
+ * The int8 dot products are exact in int32 (the caller bounds the depth).
+ * The VNNI instructions multiply unsigned by signed bytes, so those kernels
+ * flip the sign bit of `a` (adding 128 to every element) and subtract
+ * 128 * sum(b) at the end; the intermediate sums wrap harmlessly.
+ */
+
+#include "kernels.h"
+#include <math.h>
+
+// --- PORTABLE KERNELS ---
+
+static uint32_t floatBits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits) {
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/** binary32 -> binary16, round to nearest even (F16C semantics). */
+static uint16_t floatToHalf(float f) {
+    uint32_t bits = floatBits(f);
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    uint32_t abs = bits & 0x7fffffff;
+
+    if (abs > 0x7f800000) return (uint16_t)(sign | 0x7e00 | ((abs >> 13) & 0x3ff));   // NaN, quieted.
+    if (abs >= 0x47800000) return (uint16_t)(sign | 0x7c00);                          // >= 2^16: infinity.
+    if (abs < 0x38800000) {
+        // Below 2^-14 the result is subnormal: adding 0.5 aligns the bits to
+        // keep at 2^-24 and lets the FPU do the rounding.
+        float magic = bitsFloat(126u << 23);
+        return (uint16_t)(sign | (floatBits(bitsFloat(abs) + magic) - (126u << 23)));
+    }
+    uint32_t odd = (abs >> 13) & 1;
+    abs += 0xc8000fffu + odd;   // Rebias the exponent (-112 << 23) and round.
+    return (uint16_t)(sign | (abs >> 13));
+}
+
+/** binary16 -> binary32 (exact; NaNs quieted). */
+static float halfToFloat(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+
+    if (exponent == 0x1f) {
+        return bitsFloat(sign | 0x7f800000 | (mantissa << 13) | (mantissa != 0 ? 0x400000 : 0));
+    }
+    if (exponent == 0) {
+        float magnitude = (float)mantissa * 5.9604644775390625e-8f;   // mantissa * 2^-24
+        return bitsFloat(sign | floatBits(magnitude));
+    }
+    return bitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+/** binary32 -> bfloat16, round to nearest even (NaNs quieted). */
+static uint16_t floatToBf16(float f) {
+    uint32_t bits = floatBits(f);
+    if ((bits & 0x7fffffff) > 0x7f800000) return (uint16_t)((bits | 0x00400000) >> 16);
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return (uint16_t)(bits >> 16);
+}
+
+static float bf16ToFloat(uint16_t h) {
+    return bitsFloat((uint32_t)h << 16);
+}
+
+static void toF16Scalar(uint16_t* out, const float* in, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = floatToHalf(in[i]);
+}
+
+static void fromF16Scalar(float* out, const uint16_t* in, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = halfToFloat(in[i]);
+}
+
+static void toBf16Scalar(uint16_t* out, const float* in, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = floatToBf16(in[i]);
+}
+
+static void fromBf16Scalar(float* out, const uint16_t* in, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = bf16ToFloat(in[i]);
+}
+
+static float maxAbsScalar(const float* in, size_t n) {
+    float max = 0.0f;
+    for (size_t i = 0; i < n; i++) max = fabsf(in[i]) > max ? fabsf(in[i]) : max;
+    return max;
+}
+
+static void quantizeI8Scalar(int8_t* out, const float* in, float inverseScale, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        long q = lrintf(in[i] * inverseScale);
+        out[i] = (int8_t)(q > 127 ? 127 : q < -127 ? -127 : q);
+    }
+}
+
+static void dequantizeI8Scalar(float* out, const int8_t* in, float scale, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = (float)in[i] * scale;
+}
+
+static void dotI8Scalar(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                        const int32_t* bSums, int32_t* out) {
+    (void)bSums;
+    for (int r = 0; r < 4; r++) {
+        const int8_t* row = b + r * ldb;
+        int32_t sum = 0;
+        for (size_t i = 0; i < n; i++) sum += (int32_t)a[i] * row[i];
+        out[r] = sum;
+    }
+}
+
+static void dotF16Scalar(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    for (int r = 0; r < 4; r++) {
+        const uint16_t* row = b + r * ldb;
+        float sum = 0.0f;
+        for (size_t i = 0; i < n; i++) sum += halfToFloat(a[i]) * halfToFloat(row[i]);
+        out[r] = sum;
+    }
+}
+
+static void dotBf16Scalar(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    for (int r = 0; r < 4; r++) {
+        const uint16_t* row = b + r * ldb;
+        float sum = 0.0f;
+        for (size_t i = 0; i < n; i++) sum += bf16ToFloat(a[i]) * bf16ToFloat(row[i]);
+        out[r] = sum;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+// --- AVX2 (+ F16C) ---
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,f16c")
+
+static int32_t sumI32Avx2(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+    return _mm_cvtsi128_si32(s);
+}
+
+static float sumF32Avx2(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+static void toF16Avx2(uint16_t* out, const float* in, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+    toF16Scalar(out + i, in + i, n - i);
+}
+
+static void fromF16Avx2(float* out, const uint16_t* in, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+    }
+    fromF16Scalar(out + i, in + i, n - i);
+}
+
+static void toBf16Avx2(uint16_t* out, const float* in, size_t n) {
+    const __m256i one = _mm256_set1_epi32(1), bias = _mm256_set1_epi32(0x7fff);
+    const __m256i quiet = _mm256_set1_epi32(0x00400000);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(in + i);
+        __m256i bits = _mm256_castps_si256(v);
+        __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(bias, odd));
+        __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+        __m256i halves = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, _mm256_or_si256(bits, quiet), nan), 16);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(halves, halves), 0x08);
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_castsi256_si128(packed));
+    }
+    toBf16Scalar(out + i, in + i, n - i);
+}
+
+static void fromBf16Avx2(float* out, const uint16_t* in, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+    }
+    fromBf16Scalar(out + i, in + i, n - i);
+}
+
+static float maxAbsAvx2(const float* in, size_t n) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 max0 = _mm256_setzero_ps(), max1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        max0 = _mm256_max_ps(max0, _mm256_andnot_ps(sign, _mm256_loadu_ps(in + i)));
+        max1 = _mm256_max_ps(max1, _mm256_andnot_ps(sign, _mm256_loadu_ps(in + i + 8)));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_max_ps(max0, max1));
+    float max = maxAbsScalar(in + i, n - i);
+    for (int l = 0; l < 8; l++) max = lanes[l] > max ? lanes[l] : max;
+    return max;
+}
+
+static void quantizeI8Avx2(int8_t* out, const float* in, float inverseScale, size_t n) {
+    const __m256 s = _mm256_set1_ps(inverseScale);
+    const __m256i lo = _mm256_set1_epi32(-127), hi = _mm256_set1_epi32(127);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i q[4];
+        for (int v = 0; v < 4; v++) {
+            __m256i x = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8 * v), s));
+            q[v] = _mm256_min_epi32(_mm256_max_epi32(x, lo), hi);
+        }
+        // The packs work per 128-bit lane; the permutation restores element order.
+        __m256i packed = _mm256_packs_epi16(_mm256_packs_epi32(q[0], q[1]), _mm256_packs_epi32(q[2], q[3]));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_permutevar8x32_epi32(packed, order));
+    }
+    quantizeI8Scalar(out + i, in + i, inverseScale, n - i);
+}
+
+static void dequantizeI8Avx2(float* out, const int8_t* in, float scale, size_t n) {
+    const __m256 s = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i q = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(q), s));
+    }
+    dequantizeI8Scalar(out + i, in + i, scale, n - i);
+}
+
+/** Sign-extends to 16 bits and multiplies pairwise into 32-bit sums (exact). */
+static void dotI8Avx2(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                      const int32_t* bSums, int32_t* out) {
+    (void)bSums;
+    __m256i acc[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+    for (size_t i = 0; i < n; i += 16) {
+        __m256i x = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(a + i)));
+        for (int r = 0; r < 4; r++) {
+            __m256i y = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(b + r * ldb + i)));
+            acc[r] = _mm256_add_epi32(acc[r], _mm256_madd_epi16(x, y));
+        }
+    }
+    for (int r = 0; r < 4; r++) out[r] = sumI32Avx2(acc[r]);
+}
+
+static void dotF16Avx2(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    __m256 acc[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+    for (size_t i = 0; i < n; i += 8) {
+        __m256 x = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(a + i)));
+        for (int r = 0; r < 4; r++) {
+            __m256 y = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(b + r * ldb + i)));
+            acc[r] = _mm256_fmadd_ps(x, y, acc[r]);
+        }
+    }
+    for (int r = 0; r < 4; r++) out[r] = sumF32Avx2(acc[r]);
+}
+
+static __m256 loadBf16Avx2(const uint16_t* p) {
+    __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16));
+}
+
+static void dotBf16Avx2(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    __m256 acc[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+    for (size_t i = 0; i < n; i += 8) {
+        __m256 x = loadBf16Avx2(a + i);
+        for (int r = 0; r < 4; r++) acc[r] = _mm256_fmadd_ps(x, loadBf16Avx2(b + r * ldb + i), acc[r]);
+    }
+    for (int r = 0; r < 4; r++) out[r] = sumF32Avx2(acc[r]);
+}
+
+#pragma GCC pop_options
+
+// --- AVX-VNNI (VEX-encoded, 256-bit) ---
+
+#pragma GCC push_options
+#pragma GCC target("avx2,avxvnni")
+
+static void dotI8AvxVnni(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                         const int32_t* bSums, int32_t* out) {
+    const __m256i flip = _mm256_set1_epi8((char)0x80);
+    __m256i acc[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+    for (size_t i = 0; i < n; i += 32) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)), flip);
+        for (int r = 0; r < 4; r++) {
+            acc[r] = _mm256_dpbusd_avx_epi32(acc[r], x, _mm256_loadu_si256((const __m256i*)(b + r * ldb + i)));
+        }
+    }
+    for (int r = 0; r < 4; r++) out[r] = (int32_t)((uint32_t)sumI32Avx2(acc[r]) - 128u * (uint32_t)bSums[r]);
+}
+
+#pragma GCC pop_options
+
+// --- AVX-512 (F + BW) ---
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c")
+
+static void toF16Avx512(uint16_t* out, const float* in, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256((__m256i*)(out + i), _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+    toF16Scalar(out + i, in + i, n - i);
+}
+
+static void fromF16Avx512(float* out, const uint16_t* in, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(in + i))));
+    }
+    fromF16Scalar(out + i, in + i, n - i);
+}
+
+static void toBf16Avx512(uint16_t* out, const float* in, size_t n) {
+    const __m512i one = _mm512_set1_epi32(1), bias = _mm512_set1_epi32(0x7fff);
+    const __m512i quiet = _mm512_set1_epi32(0x00400000);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(in + i);
+        __m512i bits = _mm512_castps_si512(v);
+        __m512i odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+        __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(bias, odd));
+        __mmask16 nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+        __m512i halves = _mm512_srli_epi32(_mm512_mask_or_epi32(rounded, nan, bits, quiet), 16);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm512_cvtepi32_epi16(halves));
+    }
+    toBf16Scalar(out + i, in + i, n - i);
+}
+
+static __m512 loadBf16Avx512(const uint16_t* p) {
+    __m512i wide = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)p));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(wide, 16));
+}
+
+static void fromBf16Avx512(float* out, const uint16_t* in, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, loadBf16Avx512(in + i));
+    fromBf16Scalar(out + i, in + i, n - i);
+}
+
+static float maxAbsAvx512(const float* in, size_t n) {
+    __m512 max0 = _mm512_setzero_ps(), max1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        max0 = _mm512_max_ps(max0, _mm512_abs_ps(_mm512_loadu_ps(in + i)));
+        max1 = _mm512_max_ps(max1, _mm512_abs_ps(_mm512_loadu_ps(in + i + 16)));
+    }
+    float max = _mm512_reduce_max_ps(_mm512_max_ps(max0, max1));
+    float tail = maxAbsScalar(in + i, n - i);
+    return tail > max ? tail : max;
+}
+
+static void quantizeI8Avx512(int8_t* out, const float* in, float inverseScale, size_t n) {
+    const __m512 s = _mm512_set1_ps(inverseScale);
+    const __m512i lo = _mm512_set1_epi32(-127), hi = _mm512_set1_epi32(127);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i q = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(in + i), s));
+        q = _mm512_min_epi32(_mm512_max_epi32(q, lo), hi);
+        _mm_storeu_si128((__m128i*)(out + i), _mm512_cvtepi32_epi8(q));
+    }
+    quantizeI8Scalar(out + i, in + i, inverseScale, n - i);
+}
+
+static void dequantizeI8Avx512(float* out, const int8_t* in, float scale, size_t n) {
+    const __m512 s = _mm512_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i q = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)(in + i)));
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(q), s));
+    }
+    dequantizeI8Scalar(out + i, in + i, scale, n - i);
+}
+
+static void dotI8Avx512(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                        const int32_t* bSums, int32_t* out) {
+    (void)bSums;
+    __m512i acc[4] = { _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512() };
+    for (size_t i = 0; i < n; i += 32) {
+        __m512i x = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(a + i)));
+        for (int r = 0; r < 4; r++) {
+            __m512i y = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(b + r * ldb + i)));
+            acc[r] = _mm512_add_epi32(acc[r], _mm512_madd_epi16(x, y));
+        }
+    }
+    for (int r = 0; r < 4; r++) out[r] = _mm512_reduce_add_epi32(acc[r]);
+}
+
+static void dotF16Avx512(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    __m512 acc[4] = { _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps() };
+    for (size_t i = 0; i < n; i += 16) {
+        __m512 x = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(a + i)));
+        for (int r = 0; r < 4; r++) {
+            __m512 y = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(b + r * ldb + i)));
+            acc[r] = _mm512_fmadd_ps(x, y, acc[r]);
+        }
+    }
+    for (int r = 0; r < 4; r++) out[r] = _mm512_reduce_add_ps(acc[r]);
+}
+
+static void dotBf16Avx512(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    __m512 acc[4] = { _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps() };
+    for (size_t i = 0; i < n; i += 16) {
+        __m512 x = loadBf16Avx512(a + i);
+        for (int r = 0; r < 4; r++) acc[r] = _mm512_fmadd_ps(x, loadBf16Avx512(b + r * ldb + i), acc[r]);
+    }
+    for (int r = 0; r < 4; r++) out[r] = _mm512_reduce_add_ps(acc[r]);
+}
+
+#pragma GCC pop_options
+
+// --- AVX-512 VNNI and BF16 ---
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512vnni")
+
+static void dotI8Avx512Vnni(const int8_t* a, const int8_t* b, size_t ldb, size_t n,
+                            const int32_t* bSums, int32_t* out) {
+    const __m512i flip = _mm512_set1_epi8((char)0x80);
+    __m512i acc[4] = { _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512() };
+    for (size_t i = 0; i < n; i += 64) {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512(a + i), flip);
+        for (int r = 0; r < 4; r++) acc[r] = _mm512_dpbusd_epi32(acc[r], x, _mm512_loadu_si512(b + r * ldb + i));
+    }
+    for (int r = 0; r < 4; r++) {
+        out[r] = (int32_t)((uint32_t)_mm512_reduce_add_epi32(acc[r]) - 128u * (uint32_t)bSums[r]);
+    }
+}
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512bf16")
+
+/** Pairs of bfloat16 products accumulate in float32, 32 elements per instruction. */
+static void dotBf16Avx512Bf16(const uint16_t* a, const uint16_t* b, size_t ldb, size_t n, float* out) {
+    __m512 acc[4] = { _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps() };
+    for (size_t i = 0; i < n; i += 32) {
+        __m512bh x = (__m512bh)_mm512_loadu_si512(a + i);
+        for (int r = 0; r < 4; r++) acc[r] = _mm512_dpbf16_ps(acc[r], x, (__m512bh)_mm512_loadu_si512(b + r * ldb + i));
+    }
+    for (int r = 0; r < 4; r++) out[r] = _mm512_reduce_add_ps(acc[r]);
+}
+
+#pragma GCC pop_options
+
+#endif
+
+/**
+ * Fills `kernels` for the active SIMD tier, using the F16C, VNNI and BF16
+ * extensions when the CPU has them.
+ */
+void auraSelectDTypeKernels(AuraDTypeKernels* kernels) {
+    AuraDTypeKernels portable = {
+        toF16Scalar, fromF16Scalar, toBf16Scalar, fromBf16Scalar, maxAbsScalar,
+        quantizeI8Scalar, dequantizeI8Scalar, dotI8Scalar, dotF16Scalar, dotBf16Scalar
+    };
+    *kernels = portable;
+
+#if defined(__x86_64__) || defined(__i386__)
+    AuraSimdLevel level = auraTensorSimdLevel();
+    const AuraCpuFeatures* features = auraCpuFeatures();
+    if (level >= AURA_SIMD_AVX2 && features->f16c) {
+        AuraDTypeKernels avx2 = {
+            toF16Avx2, fromF16Avx2, toBf16Avx2, fromBf16Avx2, maxAbsAvx2,
+            quantizeI8Avx2, dequantizeI8Avx2, dotI8Avx2, dotF16Avx2, dotBf16Avx2
+        };
+        *kernels = avx2;
+        if (features->avxvnni) kernels->dotI8 = dotI8AvxVnni;
+    }
+    if (level >= AURA_SIMD_AVX512 && features->f16c) {
+        AuraDTypeKernels avx512 = {
+            toF16Avx512, fromF16Avx512, toBf16Avx512, fromBf16Avx512, maxAbsAvx512,
+            quantizeI8Avx512, dequantizeI8Avx512, dotI8Avx512, dotF16Avx512, dotBf16Avx512
+        };
+        *kernels = avx512;
+        if (features->avx512vnni) kernels->dotI8 = dotI8Avx512Vnni;
+        if (features->avx512bf16) kernels->dotBf16 = dotBf16Avx512Bf16;
+    }
+#endif
+}
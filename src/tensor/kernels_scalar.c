@@ -0,0 +1,180 @@
+/**
+ * @file kernels_scalar.c
+ * @brief Portable reference implementation of the elementwise tensor kernels.
+ *
+ * These loops define the expected results of every vector kernel and are used
+ * on machines without a supported vector instruction set.
+ */
+
+#include "kernels.h"
+#include <math.h>
+
+#define DEFINE_BINARY(name, EXPR)                                                   \
+    static void name(float* out, const float* a, const float* b, size_t n) {        \
+        for (size_t i = 0; i < n; i++) { float x = a[i], y = b[i]; out[i] = (EXPR); } \
+    }                                                                               \
+    static void name##Scalar(float* out, const float* a, float s, size_t n) {       \
+        for (size_t i = 0; i < n; i++) { float x = a[i], y = s; out[i] = (EXPR); }   \
+    }                                                                               \
+    static void name##Reversed(float* out, const float* a, float s, size_t n) {     \
+        for (size_t i = 0; i < n; i++) { float x = s, y = a[i]; out[i] = (EXPR); }   \
+    }
+
+DEFINE_BINARY(addScalar, x + y)
+DEFINE_BINARY(subScalar, x - y)
+DEFINE_BINARY(mulScalar, x * y)
+DEFINE_BINARY(divScalar, x / y)
+
+static void fmaScalar(float* out, const float* a, const float* b, const float* c, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = fmaf(a[i], b[i], c[i]);
+}
+
+static void reluScalar(float* out, const float* a, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = a[i] > 0.0f ? a[i] : 0.0f;
+}
+
+static void sigmoidScalar(float* out, const float* a, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = 1.0f / (1.0f + expf(-a[i]));
+}
+
+static void tanhScalar(float* out, const float* a, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = tanhf(a[i]);
+}
+
+static void expScalar(float* out, const float* a, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = expf(a[i]);
+}
+
+// --- Reductions ---
+
+#define SUM_LEAF 128
+
+static float sumScalar(const float* a, size_t n) {
+    if (n > SUM_LEAF) return sumScalar(a, n / 2) + sumScalar(a + n / 2, n - n / 2);
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) sum += a[i];
+    return sum;
+}
+
+static float sumSquaresScalar(const float* a, size_t n) {
+    if (n > SUM_LEAF) return sumSquaresScalar(a, n / 2) + sumSquaresScalar(a + n / 2, n - n / 2);
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) sum = fmaf(a[i], a[i], sum);
+    return sum;
+}
+
+static float maxScalar(const float* a, size_t n) {
+    float max = -INFINITY;
+    for (size_t i = 0; i < n; i++) max = a[i] > max ? a[i] : max;
+    return max;
+}
+
+static size_t argmaxScalar(const float* a, size_t n) {
+    size_t index = 0;
+    float max = -INFINITY;
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] > max) {
+            max = a[i];
+            index = i;
+        }
+    }
+    return index;
+}
+
+static void maximumScalar(float* out, const float* a, const float* b, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = a[i] > b[i] ? a[i] : b[i];
+}
+
+static void argmaxUpdateScalar(float* best, int32_t* index, const float* a, int32_t k, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] > best[i]) {
+            best[i] = a[i];
+            index[i] = k;
+        }
+    }
+}
+
+// --- Sparse products ---
+
+static void axpyScalar(float* out, const float* a, float s, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = fmaf(a[i], s, out[i]);
+}
+
+static float gatherDotScalar(const float* values, const uint32_t* index, const float* x, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) sum = fmaf(values[i], x[index[i]], sum);
+    return sum;
+}
+
+// --- Vec3 arrays ---
+
+static float dot3Scalar(float ax, float ay, float az, float bx, float by, float bz) {
+    return fmaf(ax, bx, fmaf(ay, by, az * bz));
+}
+
+static void vec3DotScalar(float* out, AuraVec3In a, AuraVec3In b, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = dot3Scalar(a.x[i], a.y[i], a.z[i], b.x[i], b.y[i], b.z[i]);
+}
+
+static void vec3CrossScalar(AuraVec3Out out, AuraVec3In a, AuraVec3In b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float ax = a.x[i], ay = a.y[i], az = a.z[i];
+        float bx = b.x[i], by = b.y[i], bz = b.z[i];
+        out.x[i] = ay * bz - az * by;
+        out.y[i] = az * bx - ax * bz;
+        out.z[i] = ax * by - ay * bx;
+    }
+}
+
+static void vec3LengthScalar(float* out, AuraVec3In a, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = sqrtf(dot3Scalar(a.x[i], a.y[i], a.z[i], a.x[i], a.y[i], a.z[i]));
+}
+
+static void vec3NormalizeScalar(AuraVec3Out out, AuraVec3In a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float x = a.x[i], y = a.y[i], z = a.z[i];
+        float length = sqrtf(dot3Scalar(x, y, z, x, y, z));
+        float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+        out.x[i] = x * inverse;
+        out.y[i] = y * inverse;
+        out.z[i] = z * inverse;
+    }
+}
+
+#define GEMM_MR 4
+#define GEMM_NR 8
+
+static void gemmMicrokernelScalar(size_t k, const float* a, const float* b, float* tile) {
+    float acc[GEMM_MR * GEMM_NR] = { 0 };
+    for (size_t p = 0; p < k; p++) {
+        for (int i = 0; i < GEMM_MR; i++) {
+            for (int j = 0; j < GEMM_NR; j++) acc[i * GEMM_NR + j] += a[i] * b[j];
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+    memcpy(tile, acc, sizeof(acc));
+}
+
+const AuraKernelTable auraKernelsScalar = {
+    { addScalar, subScalar, mulScalar, divScalar },
+    { addScalarScalar, subScalarScalar, mulScalarScalar, divScalarScalar },
+    { addScalarReversed, subScalarReversed, mulScalarReversed, divScalarReversed },
+    fmaScalar,
+    { reluScalar, sigmoidScalar, tanhScalar, expScalar },
+    sumScalar,
+    sumSquaresScalar,
+    maxScalar,
+    argmaxScalar,
+    maximumScalar,
+    argmaxUpdateScalar,
+    axpyScalar,
+    gatherDotScalar,
+    vec3DotScalar,
+    vec3CrossScalar,
+    vec3LengthScalar,
+    vec3NormalizeScalar,
+    gemmMicrokernelScalar,
+    GEMM_MR,
+    GEMM_NR
+};
@@ -0,0 +1,478 @@
+/**
+ * @file kernels_simd.h
+ * @brief Elementwise kernels written once for every vector instruction set.
+ *
+ * This file is included (not compiled on its own) by kernels_sse2.c,
+ * kernels_avx2.c and kernels_avx512.c, each of which first defines the vector
+ * type and the primitive operations below for its instruction set:
+ *
+ *   VF, VI, VW            float vector, int32 vector, lanes per vector
+ *   V_LOADU, V_STOREU     unaligned load/store of VW floats
+ *   V_SET1, V_SET1_I      broadcast a float / an int32
+ *   V_ADD, V_SUB, V_MUL, V_DIV, V_MIN, V_MAX, V_FMADD(a, b, c) = a * b + c
+ *   V_SQRT                square root
+ *   V_ABS, V_SIGN         clear / isolate the sign bits
+ *   V_XOR                 bitwise xor of two float vectors
+ *   V_CVT_I, V_CVT_F      float -> int32 (round to nearest) and back
+ *   V_ADD_I, V_SLLI_I, V_CAST_IF  int32 add, shift left, reinterpret as float
+ *   VM, V_GT(a, b)        comparison mask type, lanes where a > b (false for NaN)
+ *   V_SELECT(m, a, b)     lanes of `a` where `m` is set, of `b` elsewhere
+ *   V_EQ_BITS(a, b)       nonzero if any lane of `a` equals the same lane of `b`
+ *   V_GATHER(p, i)        p[i[0]], ..., p[i[VW - 1]] for VW uint32 indices below 2^31
+ *   GEMM_MR               rows of the GEMM microkernel tile (columns are 2 * VW)
+ *   KERNEL_SUFFIX         appended to every function name
+ *   KERNEL_TABLE          name of the AuraKernelTable to define
+ *
+ * The remainder of a loop (n % VW elements) goes through a zero-padded stack
+ * buffer so that every element is computed by the same vector code.
+ */
+
+#include <math.h>
+
+#define KERNEL_PASTE_(name, suffix) name##suffix
+#define KERNEL_PASTE(name, suffix) KERNEL_PASTE_(name, suffix)
+#define KN(name) KERNEL_PASTE(name, KERNEL_SUFFIX)
+
+/**
+ * Vector exp(x): range reduction x = n*ln2 + r, a degree-6 polynomial for
+ * e^r on |r| <= ln2/2 (Cephes expf coefficients), then scaling by 2^n built
+ * directly in the exponent bits. Inputs are clamped to [-87, 88] so 2^n is
+ * always a normal float.
+ */
+static inline VF KN(expVector)(VF x) {
+    x = V_MIN(x, V_SET1(88.0f));
+    x = V_MAX(x, V_SET1(-87.0f));
+
+    VI n = V_CVT_I(V_MUL(x, V_SET1(1.44269504088896341f)));
+    VF fn = V_CVT_F(n);
+    // ln2 split in a high part exact in float and a low correction.
+    VF r = V_SUB(x, V_MUL(fn, V_SET1(0.693359375f)));
+    r = V_ADD(r, V_MUL(fn, V_SET1(2.12194440e-4f)));
+
+    VF p = V_SET1(1.9875691500e-4f);
+    p = V_FMADD(p, r, V_SET1(1.3981999507e-3f));
+    p = V_FMADD(p, r, V_SET1(8.3334519073e-3f));
+    p = V_FMADD(p, r, V_SET1(4.1665795894e-2f));
+    p = V_FMADD(p, r, V_SET1(1.6666665459e-1f));
+    p = V_FMADD(p, r, V_SET1(5.0000001201e-1f));
+    p = V_FMADD(p, V_MUL(r, r), V_ADD(r, V_SET1(1.0f)));
+
+    VF scale = V_CAST_IF(V_SLLI_I(V_ADD_I(n, V_SET1_I(127)), 23));
+    return V_MUL(p, scale);
+}
+
+static inline VF KN(sigmoidVector)(VF x) {
+    VF one = V_SET1(1.0f);
+    return V_DIV(one, V_ADD(one, KN(expVector)(V_SUB(V_SET1(0.0f), x))));
+}
+
+/** tanh(x) = sign(x) * (1 - 2 / (e^(2|x|) + 1)), which cannot overflow. */
+static inline VF KN(tanhVector)(VF x) {
+    VF one = V_SET1(1.0f);
+    VF e = KN(expVector)(V_ADD(V_ABS(x), V_ABS(x)));
+    VF t = V_SUB(one, V_DIV(V_SET1(2.0f), V_ADD(e, one)));
+    return V_XOR(t, V_SIGN(x));
+}
+
+static inline VF KN(reluVector)(VF x) {
+    // Operand order makes NaN map to 0, like the scalar reference.
+    return V_MAX(x, V_SET1(0.0f));
+}
+
+#define V_OP_ADD(x, y) V_ADD(x, y)
+#define V_OP_SUB(x, y) V_SUB(x, y)
+#define V_OP_MUL(x, y) V_MUL(x, y)
+#define V_OP_DIV(x, y) V_DIV(x, y)
+
+/** Copies the last `rest` (< VW) elements of `src` into a zero-padded vector buffer. */
+#define LOAD_TAIL(buffer, src, rest) \
+    float buffer[VW] = { 0 };        \
+    memcpy(buffer, src, (rest) * sizeof(float))
+
+#define DEFINE_BINARY(name, OP)                                                           \
+    static void KN(name)(float* out, const float* a, const float* b, size_t n) {          \
+        size_t i = 0;                                                                     \
+        for (; i + VW <= n; i += VW) V_STOREU(out + i, OP(V_LOADU(a + i), V_LOADU(b + i))); \
+        if (i < n) {                                                                      \
+            LOAD_TAIL(ta, a + i, n - i);                                                  \
+            LOAD_TAIL(tb, b + i, n - i);                                                  \
+            V_STOREU(ta, OP(V_LOADU(ta), V_LOADU(tb)));                                   \
+            memcpy(out + i, ta, (n - i) * sizeof(float));                                 \
+        }                                                                                 \
+    }                                                                                     \
+    static void KN(name##Scalar)(float* out, const float* a, float s, size_t n) {         \
+        VF vs = V_SET1(s);                                                                \
+        size_t i = 0;                                                                     \
+        for (; i + VW <= n; i += VW) V_STOREU(out + i, OP(V_LOADU(a + i), vs));           \
+        if (i < n) {                                                                      \
+            LOAD_TAIL(ta, a + i, n - i);                                                  \
+            V_STOREU(ta, OP(V_LOADU(ta), vs));                                            \
+            memcpy(out + i, ta, (n - i) * sizeof(float));                                 \
+        }                                                                                 \
+    }                                                                                     \
+    static void KN(name##Reversed)(float* out, const float* a, float s, size_t n) {       \
+        VF vs = V_SET1(s);                                                                \
+        size_t i = 0;                                                                     \
+        for (; i + VW <= n; i += VW) V_STOREU(out + i, OP(vs, V_LOADU(a + i)));           \
+        if (i < n) {                                                                      \
+            LOAD_TAIL(ta, a + i, n - i);                                                  \
+            V_STOREU(ta, OP(vs, V_LOADU(ta)));                                            \
+            memcpy(out + i, ta, (n - i) * sizeof(float));                                 \
+        }                                                                                 \
+    }
+
+#define DEFINE_UNARY(name, FN)                                                            \
+    static void KN(name)(float* out, const float* a, size_t n) {                          \
+        size_t i = 0;                                                                     \
+        for (; i + VW <= n; i += VW) V_STOREU(out + i, FN(V_LOADU(a + i)));               \
+        if (i < n) {                                                                      \
+            LOAD_TAIL(ta, a + i, n - i);                                                  \
+            V_STOREU(ta, FN(V_LOADU(ta)));                                                \
+            memcpy(out + i, ta, (n - i) * sizeof(float));                                 \
+        }                                                                                 \
+    }
+
+DEFINE_BINARY(add, V_OP_ADD)
+DEFINE_BINARY(sub, V_OP_SUB)
+DEFINE_BINARY(mul, V_OP_MUL)
+DEFINE_BINARY(div, V_OP_DIV)
+
+DEFINE_UNARY(relu, KN(reluVector))
+DEFINE_UNARY(sigmoid, KN(sigmoidVector))
+DEFINE_UNARY(tanh, KN(tanhVector))
+DEFINE_UNARY(exp, KN(expVector))
+
+static void KN(fma)(float* out, const float* a, const float* b, const float* c, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        V_STOREU(out + i, V_FMADD(V_LOADU(a + i), V_LOADU(b + i), V_LOADU(c + i)));
+    }
+    if (i < n) {
+        LOAD_TAIL(ta, a + i, n - i);
+        LOAD_TAIL(tb, b + i, n - i);
+        LOAD_TAIL(tc, c + i, n - i);
+        V_STOREU(ta, V_FMADD(V_LOADU(ta), V_LOADU(tb), V_LOADU(tc)));
+        memcpy(out + i, ta, (n - i) * sizeof(float));
+    }
+}
+
+// --- Reductions ---
+
+#define SUM_LEAF (64 * VW)   // Elements summed in one sweep before pairwise splitting.
+
+/** Adds the lanes of `v` pairwise, in a fixed order. */
+static inline float KN(horizontalSum)(VF v) {
+    float lanes[VW];
+    V_STOREU(lanes, v);
+    for (int width = VW / 2; width > 0; width /= 2) {
+        for (int i = 0; i < width; i++) lanes[i] += lanes[i + width];
+    }
+    return lanes[0];
+}
+
+#define V_STEP_SUM(x, acc) V_ADD(x, acc)
+#define V_STEP_SQUARE(x, acc) V_FMADD(x, x, acc)
+
+/**
+ * Sums with four independent vector accumulators, so consecutive additions do
+ * not wait on each other, over at most SUM_LEAF elements; longer arrays are
+ * halved recursively (pairwise summation), which keeps the rounding error
+ * growing with log(n) instead of n.
+ */
+#define DEFINE_SUM(name, STEP)                                                            \
+    static float KN(name##Leaf)(const float* a, size_t n) {                               \
+        VF acc0 = V_SET1(0.0f), acc1 = acc0, acc2 = acc0, acc3 = acc0;                    \
+        size_t i = 0;                                                                     \
+        for (; i + 4 * VW <= n; i += 4 * VW) {                                            \
+            acc0 = STEP(V_LOADU(a + i), acc0);                                            \
+            acc1 = STEP(V_LOADU(a + i + VW), acc1);                                       \
+            acc2 = STEP(V_LOADU(a + i + 2 * VW), acc2);                                   \
+            acc3 = STEP(V_LOADU(a + i + 3 * VW), acc3);                                   \
+        }                                                                                 \
+        for (; i + VW <= n; i += VW) acc0 = STEP(V_LOADU(a + i), acc0);                   \
+        if (i < n) {                                                                      \
+            LOAD_TAIL(ta, a + i, n - i);                                                  \
+            acc1 = STEP(V_LOADU(ta), acc1);                                               \
+        }                                                                                 \
+        return KN(horizontalSum)(V_ADD(V_ADD(acc0, acc1), V_ADD(acc2, acc3)));            \
+    }                                                                                     \
+    static float KN(name)(const float* a, size_t n) {                                     \
+        if (n <= SUM_LEAF) return KN(name##Leaf)(a, n);                                   \
+        size_t half = (n / 2) & ~(size_t)(VW - 1);                                        \
+        return KN(name)(a, half) + KN(name)(a + half, n - half);                          \
+    }
+
+DEFINE_SUM(sum, V_STEP_SUM)
+DEFINE_SUM(sumSquares, V_STEP_SQUARE)
+
+/**
+ * Largest element, ignoring NaNs (V_MAX returns its second operand when the
+ * first is NaN); -inf if every element is NaN.
+ */
+static float KN(max)(const float* a, size_t n) {
+    VF acc0 = V_SET1(-INFINITY), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    size_t i = 0;
+    for (; i + 4 * VW <= n; i += 4 * VW) {
+        acc0 = V_MAX(V_LOADU(a + i), acc0);
+        acc1 = V_MAX(V_LOADU(a + i + VW), acc1);
+        acc2 = V_MAX(V_LOADU(a + i + 2 * VW), acc2);
+        acc3 = V_MAX(V_LOADU(a + i + 3 * VW), acc3);
+    }
+    for (; i + VW <= n; i += VW) acc0 = V_MAX(V_LOADU(a + i), acc0);
+    if (i < n) {
+        float tail[VW];
+        for (int j = 0; j < VW; j++) tail[j] = -INFINITY;
+        memcpy(tail, a + i, (n - i) * sizeof(float));
+        acc1 = V_MAX(V_LOADU(tail), acc1);
+    }
+
+    float lanes[VW];
+    V_STOREU(lanes, V_MAX(V_MAX(acc0, acc1), V_MAX(acc2, acc3)));
+    float max = lanes[0];
+    for (int j = 1; j < VW; j++) max = lanes[j] > max ? lanes[j] : max;
+    return max;
+}
+
+/**
+ * Index of the first largest element (0 if every element is NaN): the
+ * maximum first, then a vector scan for the first block holding it.
+ */
+static size_t KN(argmax)(const float* a, size_t n) {
+    float max = KN(max)(a, n);
+    VF target = V_SET1(max);
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        if (V_EQ_BITS(V_LOADU(a + i), target)) break;
+    }
+    for (; i < n; i++) {
+        if (a[i] == max) return i;
+    }
+    return 0;
+}
+
+static void KN(maximum)(float* out, const float* a, const float* b, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) V_STOREU(out + i, V_MAX(V_LOADU(a + i), V_LOADU(b + i)));
+    if (i < n) {
+        LOAD_TAIL(ta, a + i, n - i);
+        LOAD_TAIL(tb, b + i, n - i);
+        V_STOREU(ta, V_MAX(V_LOADU(ta), V_LOADU(tb)));
+        memcpy(out + i, ta, (n - i) * sizeof(float));
+    }
+}
+
+/** The indices are int32 bit patterns, which the selects move unchanged. */
+static void KN(argmaxUpdate)(float* best, int32_t* index, const float* a, int32_t k, size_t n) {
+    VF vk = V_CAST_IF(V_SET1_I(k));
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        VF x = V_LOADU(a + i);
+        VF b = V_LOADU(best + i);
+        VM greater = V_GT(x, b);
+        V_STOREU(best + i, V_SELECT(greater, x, b));
+        V_STOREU((float*)(index + i), V_SELECT(greater, vk, V_LOADU((const float*)(index + i))));
+    }
+    if (i < n) {
+        LOAD_TAIL(ta, a + i, n - i);
+        LOAD_TAIL(tb, best + i, n - i);
+        LOAD_TAIL(ti, index + i, n - i);
+        VF x = V_LOADU(ta);
+        VF b = V_LOADU(tb);
+        VM greater = V_GT(x, b);
+        V_STOREU(tb, V_SELECT(greater, x, b));
+        V_STOREU(ti, V_SELECT(greater, vk, V_LOADU(ti)));
+        memcpy(best + i, tb, (n - i) * sizeof(float));
+        memcpy(index + i, ti, (n - i) * sizeof(int32_t));
+    }
+}
+
+// --- Sparse products ---
+
+/** out += a * s */
+static void KN(axpy)(float* out, const float* a, float s, size_t n) {
+    VF vs = V_SET1(s);
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) V_STOREU(out + i, V_FMADD(V_LOADU(a + i), vs, V_LOADU(out + i)));
+    if (i < n) {
+        LOAD_TAIL(ta, a + i, n - i);
+        LOAD_TAIL(to, out + i, n - i);
+        V_STOREU(to, V_FMADD(V_LOADU(ta), vs, V_LOADU(to)));
+        memcpy(out + i, to, (n - i) * sizeof(float));
+    }
+}
+
+/**
+ * Sum of values[j] * x[index[j]]. The tail is scalar rather than padded: a
+ * padded lane would read x[0], and 0 * inf there would poison the sum.
+ */
+static float KN(gatherDot)(const float* values, const uint32_t* index, const float* x, size_t n) {
+    VF acc0 = V_SET1(0.0f), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 2 * VW <= n; i += 2 * VW) {
+        acc0 = V_FMADD(V_LOADU(values + i), V_GATHER(x, index + i), acc0);
+        acc1 = V_FMADD(V_LOADU(values + i + VW), V_GATHER(x, index + i + VW), acc1);
+    }
+    for (; i + VW <= n; i += VW) acc0 = V_FMADD(V_LOADU(values + i), V_GATHER(x, index + i), acc0);
+    float sum = KN(horizontalSum)(V_ADD(acc0, acc1));
+    for (; i < n; i++) sum += values[i] * x[index[i]];
+    return sum;
+}
+
+// --- Vec3 arrays ---
+
+/** Copies the last `rest` (< VW) elements of each component into zero-padded `buffer` (3 * VW floats). */
+static inline AuraVec3In KN(vec3Tail)(float* buffer, AuraVec3In a, size_t i, size_t rest) {
+    memset(buffer, 0, 3 * VW * sizeof(float));
+    memcpy(buffer, a.x + i, rest * sizeof(float));
+    memcpy(buffer + VW, a.y + i, rest * sizeof(float));
+    memcpy(buffer + 2 * VW, a.z + i, rest * sizeof(float));
+    AuraVec3In tail = { buffer, buffer + VW, buffer + 2 * VW };
+    return tail;
+}
+
+static inline VF KN(dot3)(VF ax, VF ay, VF az, VF bx, VF by, VF bz) {
+    return V_FMADD(ax, bx, V_FMADD(ay, by, V_MUL(az, bz)));
+}
+
+static void KN(vec3Dot)(float* out, AuraVec3In a, AuraVec3In b, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        V_STOREU(out + i, KN(dot3)(V_LOADU(a.x + i), V_LOADU(a.y + i), V_LOADU(a.z + i),
+                                   V_LOADU(b.x + i), V_LOADU(b.y + i), V_LOADU(b.z + i)));
+    }
+    if (i < n) {
+        float bufferA[3 * VW], bufferB[3 * VW], result[VW];
+        AuraVec3In ta = KN(vec3Tail)(bufferA, a, i, n - i);
+        AuraVec3In tb = KN(vec3Tail)(bufferB, b, i, n - i);
+        V_STOREU(result, KN(dot3)(V_LOADU(ta.x), V_LOADU(ta.y), V_LOADU(ta.z),
+                                  V_LOADU(tb.x), V_LOADU(tb.y), V_LOADU(tb.z)));
+        memcpy(out + i, result, (n - i) * sizeof(float));
+    }
+}
+
+/** Cross products of VW element pairs, stored to `ox`, `oy` and `oz`. */
+static inline void KN(cross3)(float* ox, float* oy, float* oz, AuraVec3In a, AuraVec3In b) {
+    VF ax = V_LOADU(a.x), ay = V_LOADU(a.y), az = V_LOADU(a.z);
+    VF bx = V_LOADU(b.x), by = V_LOADU(b.y), bz = V_LOADU(b.z);
+    V_STOREU(ox, V_SUB(V_MUL(ay, bz), V_MUL(az, by)));
+    V_STOREU(oy, V_SUB(V_MUL(az, bx), V_MUL(ax, bz)));
+    V_STOREU(oz, V_SUB(V_MUL(ax, by), V_MUL(ay, bx)));
+}
+
+static void KN(vec3Cross)(AuraVec3Out out, AuraVec3In a, AuraVec3In b, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        AuraVec3In ai = { a.x + i, a.y + i, a.z + i };
+        AuraVec3In bi = { b.x + i, b.y + i, b.z + i };
+        KN(cross3)(out.x + i, out.y + i, out.z + i, ai, bi);
+    }
+    if (i < n) {
+        float bufferA[3 * VW], bufferB[3 * VW], result[3 * VW];
+        AuraVec3In ta = KN(vec3Tail)(bufferA, a, i, n - i);
+        AuraVec3In tb = KN(vec3Tail)(bufferB, b, i, n - i);
+        KN(cross3)(result, result + VW, result + 2 * VW, ta, tb);
+        memcpy(out.x + i, result, (n - i) * sizeof(float));
+        memcpy(out.y + i, result + VW, (n - i) * sizeof(float));
+        memcpy(out.z + i, result + 2 * VW, (n - i) * sizeof(float));
+    }
+}
+
+static void KN(vec3Length)(float* out, AuraVec3In a, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        VF x = V_LOADU(a.x + i), y = V_LOADU(a.y + i), z = V_LOADU(a.z + i);
+        V_STOREU(out + i, V_SQRT(KN(dot3)(x, y, z, x, y, z)));
+    }
+    if (i < n) {
+        float buffer[3 * VW], result[VW];
+        AuraVec3In ta = KN(vec3Tail)(buffer, a, i, n - i);
+        VF x = V_LOADU(ta.x), y = V_LOADU(ta.y), z = V_LOADU(ta.z);
+        V_STOREU(result, V_SQRT(KN(dot3)(x, y, z, x, y, z)));
+        memcpy(out + i, result, (n - i) * sizeof(float));
+    }
+}
+
+/** Scales VW vectors to unit length with an exact division; zero vectors stay zero. */
+static inline void KN(normalize3)(float* ox, float* oy, float* oz, AuraVec3In a) {
+    VF x = V_LOADU(a.x), y = V_LOADU(a.y), z = V_LOADU(a.z);
+    VF length = V_SQRT(KN(dot3)(x, y, z, x, y, z));
+    VF zero = V_SET1(0.0f);
+    VF inverse = V_SELECT(V_GT(length, zero), V_DIV(V_SET1(1.0f), length), zero);
+    V_STOREU(ox, V_MUL(x, inverse));
+    V_STOREU(oy, V_MUL(y, inverse));
+    V_STOREU(oz, V_MUL(z, inverse));
+}
+
+static void KN(vec3Normalize)(AuraVec3Out out, AuraVec3In a, size_t n) {
+    size_t i = 0;
+    for (; i + VW <= n; i += VW) {
+        AuraVec3In ai = { a.x + i, a.y + i, a.z + i };
+        KN(normalize3)(out.x + i, out.y + i, out.z + i, ai);
+    }
+    if (i < n) {
+        float buffer[3 * VW], result[3 * VW];
+        AuraVec3In ta = KN(vec3Tail)(buffer, a, i, n - i);
+        KN(normalize3)(result, result + VW, result + 2 * VW, ta);
+        memcpy(out.x + i, result, (n - i) * sizeof(float));
+        memcpy(out.y + i, result + VW, (n - i) * sizeof(float));
+        memcpy(out.z + i, result + 2 * VW, (n - i) * sizeof(float));
+    }
+}
+
+#define GEMM_NR (2 * VW)
+
+/**
+ * GEMM microkernel: GEMM_MR x 2 vector accumulators stay in registers for the
+ * whole k loop, and every step costs two B loads, GEMM_MR broadcasts of A and
+ * 2 * GEMM_MR FMAs. GEMM_MR is chosen per ISA to use most vector registers.
+ */
+static void KN(gemmMicrokernel)(size_t k, const float* a, const float* b, float* tile) {
+    VF acc[GEMM_MR][2];
+#pragma GCC unroll 16
+    for (int i = 0; i < GEMM_MR; i++) {
+        acc[i][0] = V_SET1(0.0f);
+        acc[i][1] = V_SET1(0.0f);
+    }
+
+    for (size_t p = 0; p < k; p++) {
+        VF b0 = V_LOADU(b);
+        VF b1 = V_LOADU(b + VW);
+#pragma GCC unroll 16
+        for (int i = 0; i < GEMM_MR; i++) {
+            VF ai = V_SET1(a[i]);
+            acc[i][0] = V_FMADD(ai, b0, acc[i][0]);
+            acc[i][1] = V_FMADD(ai, b1, acc[i][1]);
+        }
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+#pragma GCC unroll 16
+    for (int i = 0; i < GEMM_MR; i++) {
+        V_STOREU(tile + i * GEMM_NR, acc[i][0]);
+        V_STOREU(tile + i * GEMM_NR + VW, acc[i][1]);
+    }
+}
+
+const AuraKernelTable KERNEL_TABLE = {
+    { KN(add), KN(sub), KN(mul), KN(div) },
+    { KN(addScalar), KN(subScalar), KN(mulScalar), KN(divScalar) },
+    { KN(addReversed), KN(subReversed), KN(mulReversed), KN(divReversed) },
+    KN(fma),
+    { KN(relu), KN(sigmoid), KN(tanh), KN(exp) },
+    KN(sum),
+    KN(sumSquares),
+    KN(max),
+    KN(argmax),
+    KN(maximum),
+    KN(argmaxUpdate),
+    KN(axpy),
+    KN(gatherDot),
+    KN(vec3Dot),
+    KN(vec3Cross),
+    KN(vec3Length),
+    KN(vec3Normalize),
+    KN(gemmMicrokernel),
+    GEMM_MR,
+    GEMM_NR
+};
@@ -0,0 +1,50 @@
+/**
+ * @file kernels_sse2.c
+ * @brief Elementwise tensor kernels for SSE2 (4 floats per vector).
+ *
+ * SSE2 is part of the x86-64 baseline, so this table is always usable there.
+ * SSE2 has no fused multiply-add; `a * b + c` rounds twice.
+ */
+
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC target("sse2")
+#include <emmintrin.h>
+
+#define VF __m128
+#define VI __m128i
+#define VW 4
+#define V_LOADU(p)        _mm_loadu_ps(p)
+#define V_STOREU(p, v)    _mm_storeu_ps(p, v)
+#define V_SET1(x)         _mm_set1_ps(x)
+#define V_SET1_I(x)       _mm_set1_epi32(x)
+#define V_ADD(a, b)       _mm_add_ps(a, b)
+#define V_SUB(a, b)       _mm_sub_ps(a, b)
+#define V_MUL(a, b)       _mm_mul_ps(a, b)
+#define V_DIV(a, b)       _mm_div_ps(a, b)
+#define V_SQRT(a)         _mm_sqrt_ps(a)
+#define V_MIN(a, b)       _mm_min_ps(a, b)
+#define V_MAX(a, b)       _mm_max_ps(a, b)
+#define V_FMADD(a, b, c)  _mm_add_ps(_mm_mul_ps(a, b), c)
+#define V_ABS(a)          _mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+#define V_SIGN(a)         _mm_and_ps(_mm_set1_ps(-0.0f), a)
+#define V_XOR(a, b)       _mm_xor_ps(a, b)
+#define V_CVT_I(a)        _mm_cvtps_epi32(a)
+#define V_CVT_F(i)        _mm_cvtepi32_ps(i)
+#define V_ADD_I(a, b)     _mm_add_epi32(a, b)
+#define V_SLLI_I(a, n)    _mm_slli_epi32(a, n)
+#define V_CAST_IF(i)      _mm_castsi128_ps(i)
+#define VM                __m128
+#define V_GT(a, b)        _mm_cmpgt_ps(a, b)
+#define V_SELECT(m, a, b) _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#define V_EQ_BITS(a, b)   _mm_movemask_ps(_mm_cmpeq_ps(a, b))
+#define V_GATHER(p, i)    _mm_set_ps((p)[(i)[3]], (p)[(i)[2]], (p)[(i)[1]], (p)[(i)[0]])
+
+#define GEMM_MR 4
+#define KERNEL_SUFFIX Sse2
+#define KERNEL_TABLE auraKernelsSse2
+#include "kernels_simd.h"
+
+#endif
@@ -0,0 +1,454 @@
+/**
+ * @file sparse_tensor.c
+ * @brief Construction of sparse tensors and sparse x dense products.
+ *
+ * Construction counts the non-zeros first, so the CSR arrays are allocated
+ * once at their exact size together with the header. Products walk the CSR
+ * (or CSC) arrays sequentially and leave the arithmetic to the gather-dot and
+ * axpy kernels of the active SIMD tier.
+ */
+
+#include "sparse_tensor.h"
+#include "kernels.h"
+#include "thread_pool.h"
+#include <limits.h>
+
+/**
+ * Allocates a sparse tensor with room for `nnz` elements; its CSR arrays are
+ * zero-filled and the CSC form is absent.
+ */
+static AuraSparseTensor* allocateSparse(size_t rows, size_t cols, size_t nnz) {
+    if (rows == 0 || cols == 0 || rows > INT_MAX || cols > INT_MAX) {
+        fprintf(stderr, "[Security] Invalid sparse tensor shape %zux%zu.\n", rows, cols);
+        return NULL;
+    }
+    size_t header = (sizeof(AuraSparseTensor) + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    size_t offsets = (rows + 1) * sizeof(size_t);
+    if (nnz > (SIZE_MAX - header - offsets) / (sizeof(float) + sizeof(uint32_t))) {
+        fprintf(stderr, "[Security] Sparse tensor size overflow detected.\n");
+        return NULL;
+    }
+
+    AuraSparseTensor* s = (AuraSparseTensor*)auraAllocateObject(
+        header + offsets + nnz * (sizeof(float) + sizeof(uint32_t)), AURA_SPARSE_TENSOR);
+    if (s == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while creating a sparse tensor.\n");
+        return NULL;
+    }
+    s->rows = rows;
+    s->cols = cols;
+    s->nnz = nnz;
+    s->rowStart = (size_t*)((char*)s + header);
+    s->values = (float*)(s->rowStart + rows + 1);
+    s->colIndex = (uint32_t*)(s->values + nnz);
+    return s;
+}
+
+/**
+ * Rows processed per thread pool chunk when a row costs about `perRow` operations.
+ */
+static size_t rowGrain(size_t perRow) {
+    return AURA_PARALLEL_MIN_ELEMENTS / (perRow + 1) + 1;
+}
+
+// --- CONSTRUCTION ---
+
+typedef struct {
+    const AuraTensor* in;
+    AuraSparseTensor* out;
+    size_t* counts;               // Non-zeros per row (first pass).
+} DenseJob;
+
+/**
+ * Thread pool task: counts the non-zeros of rows [begin, end).
+ */
+static void countTask(void* context, size_t begin, size_t end) {
+    const DenseJob* job = (const DenseJob*)context;
+    const AuraTensor* in = job->in;
+    for (size_t r = begin; r < end; r++) {
+        const float* row = auraTensorRowPointer(in, r);
+        size_t count = 0;
+        for (size_t c = 0; c < in->cols; c++) count += row[c * in->colStride] != 0.0f;
+        job->counts[r] = count;
+    }
+}
+
+/**
+ * Thread pool task: copies the non-zeros of rows [begin, end).
+ */
+static void fillTask(void* context, size_t begin, size_t end) {
+    const DenseJob* job = (const DenseJob*)context;
+    const AuraTensor* in = job->in;
+    AuraSparseTensor* out = job->out;
+    for (size_t r = begin; r < end; r++) {
+        const float* row = auraTensorRowPointer(in, r);
+        size_t j = out->rowStart[r];
+        for (size_t c = 0; c < in->cols; c++) {
+            float x = row[c * in->colStride];
+            if (x == 0.0f) continue;
+            out->values[j] = x;
+            out->colIndex[j] = (uint32_t)c;
+            j++;
+        }
+    }
+}
+
+/**
+ * Builds a sparse tensor from the non-zero elements of a dense one.
+ *
+ * @param t A value of type AURA_TENSOR (2-D, float32).
+ * @return A new sparse tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraSparseFromDense(AuraValue t) {
+    if (!AURA_IS_TENSOR(t) || AURA_AS_TENSOR(t)->ndim != 2) {
+        fprintf(stderr, "[Security] Sparse conversion expects a 2-D tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* in = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(in, "sparse conversion")) return createNULL();
+
+    DenseJob job = { in, NULL, (size_t*)malloc(in->rows * sizeof(size_t)) };
+    if (job.counts == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while creating a sparse tensor.\n");
+        return createNULL();
+    }
+    auraParallelFor(in->rows, rowGrain(in->cols), countTask, &job);
+    size_t nnz = 0;
+    for (size_t r = 0; r < in->rows; r++) nnz += job.counts[r];
+
+    job.out = allocateSparse(in->rows, in->cols, nnz);
+    if (job.out != NULL) {
+        for (size_t r = 0; r < in->rows; r++) job.out->rowStart[r + 1] = job.out->rowStart[r] + job.counts[r];
+        auraParallelFor(in->rows, rowGrain(in->cols), fillTask, &job);
+    }
+    free(job.counts);
+    return job.out == NULL ? createNULL() : AURA_OBJ_VAL(job.out);
+}
+
+/**
+ * Builds a sparse tensor from coordinate triplets, adding duplicates.
+ *
+ * @return A new sparse tensor, or AURA_NULL if a coordinate is out of range.
+ * @complexity O(count + rows + cols)
+ */
+AuraValue auraSparseFromTriplets(size_t rows, size_t cols, const uint32_t* rowIndex, const uint32_t* colIndex,
+                                 const float* values, size_t count) {
+    if (rows == 0 || cols == 0 || rows > INT_MAX || cols > INT_MAX) {
+        fprintf(stderr, "[Security] Invalid sparse tensor shape %zux%zu.\n", rows, cols);
+        return createNULL();
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (rowIndex[i] >= rows || colIndex[i] >= cols) {
+            fprintf(stderr, "[Security] Sparse triplet %zu at (%u, %u) is outside %zux%zu.\n",
+                    i, rowIndex[i], colIndex[i], rows, cols);
+            return createNULL();
+        }
+    }
+
+    // OPTIMIZATION: Two stable counting sorts, by column and then by row, put
+    // the triplets in CSR order in linear time.
+    size_t* byColumn = (size_t*)malloc((count + 1) * sizeof(size_t));
+    size_t* byRow = (size_t*)malloc((count + 1) * sizeof(size_t));
+    size_t* starts = (size_t*)calloc((rows > cols ? rows : cols) + 1, sizeof(size_t));
+    if (byColumn == NULL || byRow == NULL || starts == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while creating a sparse tensor.\n");
+        free(byColumn);
+        free(byRow);
+        free(starts);
+        return createNULL();
+    }
+    for (size_t i = 0; i < count; i++) starts[colIndex[i] + 1]++;
+    for (size_t c = 0; c < cols; c++) starts[c + 1] += starts[c];
+    for (size_t i = 0; i < count; i++) byColumn[starts[colIndex[i]]++] = i;
+
+    memset(starts, 0, (rows + 1) * sizeof(size_t));
+    for (size_t i = 0; i < count; i++) starts[rowIndex[i] + 1]++;
+    for (size_t r = 0; r < rows; r++) starts[r + 1] += starts[r];
+    for (size_t j = 0; j < count; j++) {
+        size_t i = byColumn[j];
+        byRow[starts[rowIndex[i]]++] = i;
+    }
+
+    // Duplicates are now adjacent.
+    size_t nnz = 0;
+    for (size_t j = 0; j < count; j++) {
+        if (j == 0 || rowIndex[byRow[j]] != rowIndex[byRow[j - 1]] || colIndex[byRow[j]] != colIndex[byRow[j - 1]]) nnz++;
+    }
+
+    AuraSparseTensor* out = allocateSparse(rows, cols, nnz);
+    if (out != NULL) {
+        size_t k = 0;
+        for (size_t j = 0; j < count; j++) {
+            size_t i = byRow[j];
+            if (k > 0 && j > 0 && rowIndex[i] == rowIndex[byRow[j - 1]] && colIndex[i] == colIndex[byRow[j - 1]]) {
+                out->values[k - 1] += values[i];
+                continue;
+            }
+            out->values[k] = values[i];
+            out->colIndex[k] = colIndex[i];
+            out->rowStart[rowIndex[i] + 1]++;
+            k++;
+        }
+        for (size_t r = 0; r < rows; r++) out->rowStart[r + 1] += out->rowStart[r];
+    }
+    free(byColumn);
+    free(byRow);
+    free(starts);
+    return out == NULL ? createNULL() : AURA_OBJ_VAL(out);
+}
+
+/**
+ * Expands a sparse tensor into a new dense tensor.
+ *
+ * @param s A value of type AURA_SPARSE_TENSOR.
+ * @return The dense tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraSparseToDense(AuraValue s) {
+    if (!AURA_IS_SPARSE(s)) {
+        fprintf(stderr, "[Security] Sparse expansion expects a sparse tensor.\n");
+        return createNULL();
+    }
+    AuraSparseTensor* in = AURA_AS_SPARSE(s);
+    AuraValue result = createTENSOR((int)in->rows, (int)in->cols);
+    if (AURA_IS_NULL(result)) return createNULL();
+
+    AuraTensor* out = AURA_AS_TENSOR(result);
+    for (size_t r = 0; r < in->rows; r++) {
+        float* row = AURA_TENSOR_ROW(out, r);
+        for (size_t j = in->rowStart[r]; j < in->rowStart[r + 1]; j++) row[in->colIndex[j]] = in->values[j];
+    }
+    return result;
+}
+
+/**
+ * Adds the CSC form to a sparse tensor if it does not have it yet.
+ *
+ * @param s A value of type AURA_SPARSE_TENSOR.
+ * @return true on success.
+ * @complexity O(nnz + cols)
+ */
+bool auraSparseBuildCsc(AuraValue s) {
+    if (!AURA_IS_SPARSE(s)) {
+        fprintf(stderr, "[Security] Sparse CSC expects a sparse tensor.\n");
+        return false;
+    }
+    AuraSparseTensor* sparse = AURA_AS_SPARSE(s);
+    if (sparse->colStart != NULL) return true;
+
+    size_t* colStart = (size_t*)calloc(1, (sparse->cols + 1) * sizeof(size_t) +
+                                          sparse->nnz * (sizeof(float) + sizeof(uint32_t)));
+    if (colStart == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while building a sparse CSC form.\n");
+        return false;
+    }
+    float* values = (float*)(colStart + sparse->cols + 1);
+    uint32_t* rowIndex = (uint32_t*)(values + sparse->nnz);
+
+    // Counting sort by column; walking the rows in order keeps each column's
+    // rows ascending. colStart[c] serves as the cursor of column c and ends
+    // up at the start of column c + 1, hence the final shift.
+    for (size_t j = 0; j < sparse->nnz; j++) colStart[sparse->colIndex[j] + 1]++;
+    for (size_t c = 0; c < sparse->cols; c++) colStart[c + 1] += colStart[c];
+    for (size_t r = 0; r < sparse->rows; r++) {
+        for (size_t j = sparse->rowStart[r]; j < sparse->rowStart[r + 1]; j++) {
+            size_t at = colStart[sparse->colIndex[j]]++;
+            values[at] = sparse->values[j];
+            rowIndex[at] = (uint32_t)r;
+        }
+    }
+    memmove(colStart + 1, colStart, sparse->cols * sizeof(size_t));
+    colStart[0] = 0;
+
+    sparse->colStart = colStart;
+    sparse->cscValues = values;
+    sparse->rowIndex = rowIndex;
+    return true;
+}
+
+// --- PRODUCTS ---
+
+typedef struct {
+    const AuraKernelTable* kernels;
+    const AuraSparseTensor* sparse;
+    const AuraTensor* dense;      // The dense operand (rows contiguous for the gathered paths).
+    const float* vector;          // SpMV: the contiguous input vector.
+    AuraTensor* out;
+    bool failed;                  // Set by a task that could not allocate its scratch row.
+} ProductJob;
+
+/**
+ * Thread pool task: y[r] for rows [begin, end) of a SpMV.
+ */
+static void matvecTask(void* context, size_t begin, size_t end) {
+    const ProductJob* job = (const ProductJob*)context;
+    const AuraSparseTensor* s = job->sparse;
+    for (size_t r = begin; r < end; r++) {
+        size_t first = s->rowStart[r];
+        job->out->data[r] = job->kernels->gatherDot(s->values + first, s->colIndex + first, job->vector,
+                                                    s->rowStart[r + 1] - first);
+    }
+}
+
+/**
+ * Computes the sparse matrix-vector product `s x v`.
+ *
+ * @param s A value of type AURA_SPARSE_TENSOR.
+ * @param v A 1-D float32 tensor of `s->cols` elements.
+ * @return A new 1-D tensor, or AURA_NULL on invalid operands.
+ * @complexity O(nnz + rows)
+ */
+AuraValue auraSparseMatvec(AuraValue s, AuraValue v) {
+    if (!AURA_IS_SPARSE(s) || !AURA_IS_TENSOR(v) || AURA_AS_TENSOR(v)->ndim != 1) {
+        fprintf(stderr, "[Security] Sparse matvec expects a sparse tensor and a 1-D tensor.\n");
+        return createNULL();
+    }
+    AuraSparseTensor* sparse = AURA_AS_SPARSE(s);
+    AuraTensor* vector = AURA_AS_TENSOR(v);
+    if (!auraTensorRequireF32(vector, "sparse matvec")) return createNULL();
+    if (vector->cols != sparse->cols) {
+        fprintf(stderr, "[Security] Tensor shape mismatch in sparse matvec: %zux%zu vs %zu.\n",
+                sparse->rows, sparse->cols, vector->cols);
+        return createNULL();
+    }
+
+    float* scratch = NULL;
+    if (!AURA_TENSOR_ROWS_CONTIGUOUS(vector)) {
+        scratch = (float*)malloc(vector->cols * sizeof(float));
+        if (scratch == NULL) {
+            fprintf(stderr, "[Fatal Error] Out of memory in sparse matvec.\n");
+            return createNULL();
+        }
+    }
+    int shape[1] = { (int)sparse->rows };
+    AuraValue result = createTENSORNDUninitialized(1, shape);
+    if (!AURA_IS_NULL(result)) {
+        ProductJob job = { auraActiveKernels(), sparse, vector, auraTensorSpan(vector, 0, 0, vector->cols, scratch),
+                           AURA_AS_TENSOR(result), false };
+        auraParallelFor(sparse->rows, rowGrain(sparse->nnz / sparse->rows), matvecTask, &job);
+    }
+    free(scratch);
+    return result;
+}
+
+/**
+ * Thread pool task: rows [begin, end) of `s x b`.
+ */
+static void sparseDenseTask(void* context, size_t begin, size_t end) {
+    const ProductJob* job = (const ProductJob*)context;
+    const AuraSparseTensor* s = job->sparse;
+    size_t n = job->dense->cols;
+    for (size_t r = begin; r < end; r++) {
+        float* dst = AURA_TENSOR_ROW(job->out, r);
+        for (size_t j = s->rowStart[r]; j < s->rowStart[r + 1]; j++) {
+            job->kernels->axpy(dst, AURA_TENSOR_ROW(job->dense, s->colIndex[j]), s->values[j], n);
+        }
+    }
+}
+
+/**
+ * Computes the product of a sparse and a dense matrix.
+ *
+ * @param s An m x k value of type AURA_SPARSE_TENSOR.
+ * @param b A k x n float32 tensor.
+ * @return A new m x n tensor, or AURA_NULL on invalid operands.
+ * @complexity O(nnz * n + m * n)
+ */
+AuraValue auraSparseMatmul(AuraValue s, AuraValue b) {
+    if (!AURA_IS_SPARSE(s) || !AURA_IS_TENSOR(b) || AURA_AS_TENSOR(b)->ndim != 2) {
+        fprintf(stderr, "[Security] Sparse matmul expects a sparse tensor and a 2-D tensor.\n");
+        return createNULL();
+    }
+    AuraSparseTensor* sparse = AURA_AS_SPARSE(s);
+    AuraTensor* tb = AURA_AS_TENSOR(b);
+    if (!auraTensorRequireF32(tb, "sparse matmul")) return createNULL();
+    if (tb->rows != sparse->cols) {
+        fprintf(stderr, "[Security] Tensor shape mismatch in sparse matmul: %zux%zu vs %zux%zu.\n",
+                sparse->rows, sparse->cols, tb->rows, tb->cols);
+        return createNULL();
+    }
+
+    // The kernels stream rows of b, so a transposed view is densified first.
+    AuraValue dense = AURA_TENSOR_ROWS_CONTIGUOUS(tb) ? auraTensorRetain(b) : auraTensorContiguous(b);
+    AuraValue result = createTENSOR((int)sparse->rows, (int)tb->cols);
+    if (!AURA_IS_NULL(dense) && !AURA_IS_NULL(result)) {
+        ProductJob job = { auraActiveKernels(), sparse, AURA_AS_TENSOR(dense), NULL, AURA_AS_TENSOR(result), false };
+        auraParallelFor(sparse->rows, rowGrain(sparse->nnz / sparse->rows * tb->cols), sparseDenseTask, &job);
+    } else {
+        freeValue(result);
+        result = createNULL();
+    }
+    freeValue(dense);
+    return result;
+}
+
+/**
+ * Thread pool task: rows [begin, end) of `a x s`.
+ */
+static void denseSparseTask(void* context, size_t begin, size_t end) {
+    ProductJob* job = (ProductJob*)context;
+    const AuraSparseTensor* s = job->sparse;
+    const AuraTensor* a = job->dense;
+
+    float* scratch = NULL;
+    if (!AURA_TENSOR_ROWS_CONTIGUOUS(a)) {
+        scratch = (float*)malloc(a->cols * sizeof(float));
+        if (scratch == NULL) {
+            __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    for (size_t r = begin; r < end; r++) {
+        const float* row = auraTensorSpan(a, r, 0, a->cols, scratch);
+        float* dst = AURA_TENSOR_ROW(job->out, r);
+        if (s->colStart != NULL) {
+            for (size_t c = 0; c < s->cols; c++) {
+                size_t first = s->colStart[c];
+                dst[c] = job->kernels->gatherDot(s->cscValues + first, s->rowIndex + first, row,
+                                                 s->colStart[c + 1] - first);
+            }
+        } else {
+            for (size_t k = 0; k < s->rows; k++) {
+                for (size_t j = s->rowStart[k]; j < s->rowStart[k + 1]; j++) {
+                    dst[s->colIndex[j]] += row[k] * s->values[j];
+                }
+            }
+        }
+    }
+    free(scratch);
+}
+
+/**
+ * Computes the product of a dense and a sparse matrix.
+ *
+ * @param a An m x k float32 tensor.
+ * @param s A k x n value of type AURA_SPARSE_TENSOR.
+ * @return A new m x n tensor, or AURA_NULL on invalid operands or allocation failure.
+ * @complexity O(m * (nnz + n))
+ */
+AuraValue auraTensorMatmulSparse(AuraValue a, AuraValue s) {
+    if (!AURA_IS_TENSOR(a) || AURA_AS_TENSOR(a)->ndim != 2 || !AURA_IS_SPARSE(s)) {
+        fprintf(stderr, "[Security] Sparse matmul expects a 2-D tensor and a sparse tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* ta = AURA_AS_TENSOR(a);
+    AuraSparseTensor* sparse = AURA_AS_SPARSE(s);
+    if (!auraTensorRequireF32(ta, "sparse matmul")) return createNULL();
+    if (ta->cols != sparse->rows) {
+        fprintf(stderr, "[Security] Tensor shape mismatch in sparse matmul: %zux%zu vs %zux%zu.\n",
+                ta->rows, ta->cols, sparse->rows, sparse->cols);
+        return createNULL();
+    }
+
+    AuraValue result = createTENSOR((int)ta->rows, (int)sparse->cols);
+    if (AURA_IS_NULL(result)) return createNULL();
+    ProductJob job = { auraActiveKernels(), sparse, ta, NULL, AURA_AS_TENSOR(result), false };
+    auraParallelFor(ta->rows, rowGrain(sparse->nnz + sparse->cols), denseSparseTask, &job);
+    if (job.failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory in sparse matmul.\n");
+        freeValue(result);
+        return createNULL();
+    }
+    return result;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file tensor_dtype.c
+ * @brief Conversions between tensor element types and reduced-precision
+ * matrix products.
+ *
+ * Both work row by row on dense storage, where every row is padded with zeros
+ * to 64 bytes, so the dot-product kernels always see whole vectors and need
+ * no tail handling. Large inputs are split by rows over the thread pool.
+ */
+
+#include "kernels.h"
+#include "thread_pool.h"
+#include <limits.h>
+
+#define DOT_BLOCK_BYTES ((size_t)128 << 10)   // Rows of B revisited per A row (~ L2).
+
+/**
+ * Largest depth for which an int8 dot product cannot overflow int32
+ * (127 * 127 * k < 2^31).
+ */
+#define I8_MAX_DEPTH ((size_t)INT32_MAX / (127 * 127))
+
+/**
+ * Prints a diagnostic and returns false unless `t` holds float32 elements.
+ *
+ * @param t The tensor.
+ * @param op Name of the operation, for the diagnostic.
+ */
+bool auraTensorRequireF32(const AuraTensor* t, const char* op) {
+    if (t->dtype == AURA_DTYPE_F32) return true;
+    fprintf(stderr, "[Security] Tensor %s expects f32 tensors, got %s (see auraTensorConvert).\n",
+            op, auraDTypeName((AuraDType)t->dtype));
+    return false;
+}
+
+// --- CONVERSION ---
+
+typedef struct {
+    AuraDTypeKernels kernels;
+    const AuraTensor* in;
+    AuraTensor* out;
+    bool failed;                  // Set by a task that could not allocate its scratch row.
+} ConvertJob;
+
+/**
+ * Decodes `n` elements of row `row` of `t` into float32: in place for a
+ * contiguous float32 row, else into `scratch`.
+ */
+static const float* decodeRow(const AuraDTypeKernels* k, const AuraTensor* t, size_t row, size_t n, float* scratch) {
+    switch ((AuraDType)t->dtype) {
+    case AURA_DTYPE_F16:
+        k->fromF16(scratch, (const uint16_t*)auraTensorRowStorage(t, row), n);
+        return scratch;
+    case AURA_DTYPE_BF16:
+        k->fromBf16(scratch, (const uint16_t*)auraTensorRowStorage(t, row), n);
+        return scratch;
+    case AURA_DTYPE_I8:
+        k->dequantizeI8(scratch, (const int8_t*)auraTensorRowStorage(t, row), t->scales[row], n);
+        return scratch;
+    default:
+        return auraTensorSpan(t, row, 0, n, scratch);
+    }
+}
+
+/**
+ * Encodes `n` float32 values into row `row` of the dense tensor `t`.
+ */
+static void encodeRow(const AuraDTypeKernels* k, AuraTensor* t, size_t row, const float* values, size_t n) {
+    void* dst = auraTensorRowStorage(t, row);
+    switch ((AuraDType)t->dtype) {
+    case AURA_DTYPE_F16:
+        k->toF16((uint16_t*)dst, values, n);
+        break;
+    case AURA_DTYPE_BF16:
+        k->toBf16((uint16_t*)dst, values, n);
+        break;
+    case AURA_DTYPE_I8: {
+        // Symmetric quantization: the largest magnitude of the row maps to 127.
+        float max = k->maxAbs(values, n);
+        t->scales[row] = max / 127.0f;
+        k->quantizeI8((int8_t*)dst, values, max > 0.0f ? 127.0f / max : 0.0f, n);
+        int32_t sum = 0;
+        for (size_t i = 0; i < n; i++) sum += ((const int8_t*)dst)[i];
+        t->rowSums[row] = sum;
+        break;
+    }
+    default:
+        if (dst != values) memcpy(dst, values, n * sizeof(float));
+        break;
+    }
+}
+
+/**
+ * Thread pool task: converts rows [begin, end).
+ */
+static void convertTask(void* context, size_t begin, size_t end) {
+    ConvertJob* job = (ConvertJob*)context;
+    size_t cols = job->in->cols;
+
+    // Decoding straight into a float32 result saves a copy, and the scratch row.
+    bool direct = job->out->dtype == AURA_DTYPE_F32;
+    float* scratch = NULL;
+    if (!direct) {
+        scratch = (float*)malloc(cols * sizeof(float));
+        if (scratch == NULL) {
+            __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    for (size_t r = begin; r < end; r++) {
+        float* target = direct ? AURA_TENSOR_ROW(job->out, r) : scratch;
+        const float* values = decodeRow(&job->kernels, job->in, r, cols, target);
+        encodeRow(&job->kernels, job->out, r, values, cols);
+    }
+    free(scratch);
+}
+
+/**
+ * Converts a tensor to another element type.
+ *
+ * @param t A value of type AURA_TENSOR.
+ * @param dtype The element type of the result.
+ * @return `t` itself (retained) if it already has that type, else a new
+ *         dense tensor; AURA_NULL on invalid arguments or allocation failure.
+ * @complexity O(elements)
+ */
+AuraValue auraTensorConvert(AuraValue t, AuraDType dtype) {
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor convert expects a tensor.\n");
+        return createNULL();
+    }
+    if (dtype < 0 || dtype >= AURA_DTYPE_COUNT) {
+        fprintf(stderr, "[Security] Invalid tensor dtype %d.\n", (int)dtype);
+        return createNULL();
+    }
+    AuraTensor* in = AURA_AS_TENSOR(t);
+    if (in->dtype == dtype) return auraTensorRetain(t);
+
+    int shape[AURA_TENSOR_MAX_DIMS];
+    for (int d = 0; d < in->ndim; d++) shape[d] = (int)in->shape[d];
+    AuraValue result = createTENSORNDTyped(dtype, in->ndim, shape);
+    if (AURA_IS_NULL(result)) return createNULL();
+
+    ConvertJob job;
+    auraSelectDTypeKernels(&job.kernels);
+    job.in = in;
+    job.out = AURA_AS_TENSOR(result);
+    job.failed = false;
+    auraParallelFor(in->rows, AURA_PARALLEL_MIN_ELEMENTS / in->cols + 1, convertTask, &job);
+    if (job.failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory while converting tensor rows.\n");
+        freeValue(result);
+        return createNULL();
+    }
+    return result;
+}
+
+// --- REDUCED-PRECISION MATRIX PRODUCT ---
+
+typedef struct {
+    AuraDTypeKernels kernels;
+    const AuraTensor* a;
+    const AuraTensor* b;
+    AuraTensor* out;
+    size_t depth;                 // Padded row length shared by a and b.
+    size_t blockRows;             // Rows of b per cache block (a multiple of 4).
+} DotJob;
+
+/**
+ * Computes out[i][j0..j0+count) from four dot products, `count` <= 4.
+ */
+static void dotFour(const DotJob* job, size_t i, size_t j0, size_t count) {
+    const AuraTensor* a = job->a;
+    const AuraTensor* b = job->b;
+    float* dst = AURA_TENSOR_ROW(job->out, i) + j0;
+
+    // A partial group (the last one) is shifted back to end at the last row of
+    // b, so the kernel always reads four valid rows. With fewer than four rows
+    // in total, each row is computed alone as four copies of itself.
+    size_t groups = b->rows >= 4 ? 1 : count;
+    for (size_t g = 0; g < groups; g++) {
+        size_t first = b->rows < 4 ? j0 + g : count == 4 ? j0 : j0 + count - 4;
+        size_t ldb = b->rows < 4 ? 0 : b->stride;
+        size_t skip = b->rows < 4 ? 0 : j0 - first;
+        size_t produced = b->rows < 4 ? 1 : count;
+        float* target = dst + g;
+
+        if (a->dtype == AURA_DTYPE_I8) {
+            int32_t sums[4], dots[4];
+            for (int r = 0; r < 4; r++) sums[r] = b->rowSums[first + r * (ldb != 0)];
+            job->kernels.dotI8((const int8_t*)auraTensorRowStorage(a, i),
+                               (const int8_t*)auraTensorRowStorage(b, first), ldb, job->depth, sums, dots);
+            for (size_t c = 0; c < produced; c++) {
+                target[c] = (float)dots[skip + c] * (a->scales[i] * b->scales[first + skip + c]);
+            }
+        } else {
+            AuraDotHalfKernel dot = a->dtype == AURA_DTYPE_BF16 ? job->kernels.dotBf16 : job->kernels.dotF16;
+            float dots[4];
+            dot((const uint16_t*)auraTensorRowStorage(a, i),
+                (const uint16_t*)auraTensorRowStorage(b, first), ldb, job->depth, dots);
+            for (size_t c = 0; c < produced; c++) target[c] = dots[skip + c];
+        }
+    }
+}
+
+/**
+ * Thread pool task: rows [begin, end) of the product.
+ */
+static void dotTask(void* context, size_t begin, size_t end) {
+    const DotJob* job = (const DotJob*)context;
+    size_t n = job->b->rows;
+
+    // OPTIMIZATION: Sweep all rows of A against one block of B at a time, so
+    // the block stays in cache while it is reused.
+    for (size_t j0 = 0; j0 < n; j0 += job->blockRows) {
+        size_t j1 = j0 + job->blockRows < n ? j0 + job->blockRows : n;
+        for (size_t i = begin; i < end; i++) {
+            for (size_t j = j0; j < j1; j += 4) dotFour(job, i, j, j1 - j < 4 ? j1 - j : 4);
+        }
+    }
+}
+
+/**
+ * Computes the matrix product `a x b^T`.
+ *
+ * @param a Left operand (2-D m x k tensor).
+ * @param b Right operand (2-D n x k tensor).
+ * @return A new m x n float32 tensor, or AURA_NULL on invalid operands or allocation failure.
+ * @complexity O(m * n * k)
+ */
+AuraValue auraTensorMatmulTransposed(AuraValue a, AuraValue b) {
+    if (!AURA_IS_TENSOR(a) || !AURA_IS_TENSOR(b)) {
+        fprintf(stderr, "[Security] Tensor matmul expects two tensors.\n");
+        return createNULL();
+    }
+    AuraTensor* ta = AURA_AS_TENSOR(a);
+    AuraTensor* tb = AURA_AS_TENSOR(b);
+    if (ta->ndim != 2 || tb->ndim != 2) {
+        fprintf(stderr, "[Security] Tensor matmul expects 2-D tensors.\n");
+        return createNULL();
+    }
+    if (ta->cols != tb->cols) {
+        fprintf(stderr, "[Security] Tensor shape mismatch in matmul: %zux%zu vs (%zux%zu)^T.\n",
+                ta->rows, ta->cols, tb->rows, tb->cols);
+        return createNULL();
+    }
+
+    // Float32 products go to the GEMM, which reads b^T through swapped strides.
+    if (ta->dtype == AURA_DTYPE_F32 && tb->dtype == AURA_DTYPE_F32) {
+        AuraValue result = createTENSOR((int)ta->rows, (int)tb->rows);
+        if (AURA_IS_NULL(result)) return createNULL();
+        AuraTensor* out = AURA_AS_TENSOR(result);
+        if (!auraGemm(ta->rows, tb->rows, ta->cols,
+                      ta->data, (ptrdiff_t)ta->stride, (ptrdiff_t)ta->colStride,
+                      tb->data, (ptrdiff_t)tb->colStride, (ptrdiff_t)tb->stride,
+                      out->data, (ptrdiff_t)out->stride, 1)) {
+            freeValue(result);
+            return createNULL();
+        }
+        return result;
+    }
+
+    // Mixed operands meet at the reduced type: a float32 `a` (activations) is
+    // converted, or quantized, to the type of `b` (weights) first.
+    AuraDType dtype = tb->dtype == AURA_DTYPE_F32 ? (AuraDType)ta->dtype : (AuraDType)tb->dtype;
+    if (ta->dtype != AURA_DTYPE_F32 && tb->dtype != AURA_DTYPE_F32 && ta->dtype != tb->dtype) {
+        fprintf(stderr, "[Security] Tensor matmul of %s by %s is not supported.\n",
+                auraDTypeName((AuraDType)ta->dtype), auraDTypeName((AuraDType)tb->dtype));
+        return createNULL();
+    }
+    if (dtype == AURA_DTYPE_I8 && ta->cols > I8_MAX_DEPTH) {
+        fprintf(stderr, "[Security] Tensor int8 matmul depth %zu exceeds %zu.\n", ta->cols, I8_MAX_DEPTH);
+        return createNULL();
+    }
+
+    int shape[2] = { (int)ta->rows, (int)tb->rows };
+    AuraValue ca = auraTensorConvert(a, dtype);
+    AuraValue cb = auraTensorConvert(b, dtype);
+    AuraValue result = createTENSORNDUninitialized(2, shape);
+    if (!AURA_IS_NULL(ca) && !AURA_IS_NULL(cb) && !AURA_IS_NULL(result)) {
+        DotJob job;
+        auraSelectDTypeKernels(&job.kernels);
+        job.a = AURA_AS_TENSOR(ca);
+        job.b = AURA_AS_TENSOR(cb);
+        job.out = AURA_AS_TENSOR(result);
+        job.depth = job.b->stride;
+        size_t rowBytes = job.depth * auraDTypeSize(dtype);
+        job.blockRows = (DOT_BLOCK_BYTES / rowBytes + 3) & ~(size_t)3;
+        if (job.blockRows == 0) job.blockRows = 4;   // One row is larger than a block.
+        auraParallelFor(job.a->rows, AURA_PARALLEL_MIN_ELEMENTS / (job.b->rows * job.depth) + 1, dotTask, &job);
+    } else {
+        freeValue(result);
+        result = createNULL();
+    }
+    freeValue(ca);
+    freeValue(cb);
+    return result;
+}
@@ -0,0 +1,450 @@
+/**
+ * @file tensor_expr.c
+ * @brief Lazy elementwise expressions, evaluated in one fused pass.
+ *
+ * Nodes are appended to an array, so operands always precede their users and
+ * array order is a valid evaluation order. Shapes are checked as nodes are
+ * recorded; nothing is computed until `auraTensorExprEvaluate`.
+ *
+ * Evaluation binds every tensor input directly to the layout of the result
+ * (broadcasting composes, so this equals broadcasting step by step), then
+ * walks the result in blocks of EXPR_BLOCK floats. Within a block every node
+ * the root depends on runs once, through the active kernel table, into its
+ * own slot of a per-thread scratch area; only the root writes to the result.
+ */
+
+#include "kernels.h"
+#include "aligned.h"
+#include "thread_pool.h"
+
+#define EXPR_BLOCK 512            // Floats per node and block: 2 KB slots, dozens of nodes fit in L2.
+#define EXPR_INITIAL_NODES 16
+
+typedef enum {
+    NODE_INPUT,                   // A tensor.
+    NODE_CONSTANT,                // A number, broadcast everywhere.
+    NODE_BINARY,
+    NODE_FMA,
+    NODE_UNARY
+} NodeKind;
+
+typedef struct {
+    NodeKind kind;
+    int op;
+    AuraExprNode args[3];
+    float constant;
+    AuraValue tensor;             // NODE_INPUT: one reference held by the expression.
+    AuraShape shape;              // Rank 0 for constants.
+} ExprNode;
+
+struct AuraTensorExpr {
+    ExprNode* nodes;
+    int count;
+    int capacity;
+};
+
+// --- RECORDING ---
+
+/**
+ * Creates an empty expression.
+ *
+ * @return The expression, or NULL if out of memory.
+ */
+AuraTensorExpr* auraTensorExprCreate(void) {
+    AuraTensorExpr* expr = (AuraTensorExpr*)calloc(1, sizeof(AuraTensorExpr));
+    if (expr == NULL) fprintf(stderr, "[Fatal Error] Out of memory while creating a tensor expression.\n");
+    return expr;
+}
+
+/**
+ * Frees an expression and drops its references to its input tensors.
+ *
+ * @param expr The expression (NULL is ignored).
+ */
+void auraTensorExprFree(AuraTensorExpr* expr) {
+    if (expr == NULL) return;
+    for (int i = 0; i < expr->count; i++) {
+        if (expr->nodes[i].kind == NODE_INPUT) freeValue(expr->nodes[i].tensor);
+    }
+    free(expr->nodes);
+    free(expr);
+}
+
+/**
+ * Appends a node, growing the array geometrically.
+ *
+ * @return The new node's index, or -1 if out of memory.
+ */
+static AuraExprNode addNode(AuraTensorExpr* expr, const ExprNode* node) {
+    if (expr->count == expr->capacity) {
+        int capacity = expr->capacity == 0 ? EXPR_INITIAL_NODES : expr->capacity * 2;
+        ExprNode* nodes = (ExprNode*)realloc(expr->nodes, sizeof(ExprNode) * capacity);
+        if (nodes == NULL) {
+            fprintf(stderr, "[Fatal Error] Out of memory while recording a tensor expression.\n");
+            return -1;
+        }
+        expr->nodes = nodes;
+        expr->capacity = capacity;
+    }
+    expr->nodes[expr->count] = *node;
+    return expr->count++;
+}
+
+/**
+ * Checks that `count` operands are nodes of `expr`. Negative operands come
+ * from an earlier error that was already reported, so they fail silently.
+ */
+static bool validOperands(const AuraTensorExpr* expr, const AuraExprNode* args, int count) {
+    if (expr == NULL) return false;
+    for (int i = 0; i < count; i++) {
+        if (args[i] < 0) return false;
+        if (args[i] >= expr->count) {
+            fprintf(stderr, "[Security] Unknown tensor expression node %d.\n", args[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Records an operation on `count` operands, with the broadcast of their shapes.
+ */
+static AuraExprNode addOperation(AuraTensorExpr* expr, NodeKind kind, int op, const char* name,
+                                 const AuraExprNode* args, int count) {
+    if (!validOperands(expr, args, count)) return -1;
+
+    ExprNode node = { 0 };
+    node.kind = kind;
+    node.op = op;
+    AuraShape shapes[3];
+    for (int i = 0; i < count; i++) {
+        node.args[i] = args[i];
+        shapes[i] = expr->nodes[args[i]].shape;
+    }
+    if (!auraBroadcastShapes(shapes, count, name, &node.shape)) return -1;
+    return addNode(expr, &node);
+}
+
+/**
+ * Adds an input: a tensor (retained until the expression is freed) or a number.
+ *
+ * @param expr The expression.
+ * @param v A tensor or a number.
+ * @return The node, or a negative value if `v` is neither (or is not float32).
+ * @complexity O(1) amortized
+ */
+AuraExprNode auraTensorExprInput(AuraTensorExpr* expr, AuraValue v) {
+    if (expr == NULL) return -1;
+
+    ExprNode node = { 0 };
+    if (AURA_IS_TENSOR(v)) {
+        const AuraTensor* t = AURA_AS_TENSOR(v);
+        if (!auraTensorRequireF32(t, "expression")) return -1;
+        node.kind = NODE_INPUT;
+        node.tensor = v;
+        node.shape.ndim = t->ndim;
+        memcpy(node.shape.shape, t->shape, sizeof(size_t) * t->ndim);
+    } else if (AURA_IS_NUMERIC(v)) {
+        node.kind = NODE_CONSTANT;
+        node.constant = (float)auraToNumber(v);
+    } else {
+        fprintf(stderr, "[Security] Tensor expression input must be a tensor or a number.\n");
+        return -1;
+    }
+
+    AuraExprNode index = addNode(expr, &node);
+    if (index >= 0 && node.kind == NODE_INPUT) auraTensorRetain(v);
+    return index;
+}
+
+/**
+ * Records `a op b`.
+ *
+ * @return The node, or a negative value on invalid or incompatible operands.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprBinary(AuraTensorExpr* expr, AuraTensorBinaryOp op, AuraExprNode a, AuraExprNode b) {
+    static const char* names[AURA_TENSOR_BINARY_OP_COUNT] = { "add", "sub", "mul", "div" };
+    if (op < 0 || op >= AURA_TENSOR_BINARY_OP_COUNT) return -1;
+    AuraExprNode args[2] = { a, b };
+    return addOperation(expr, NODE_BINARY, op, names[op], args, 2);
+}
+
+/**
+ * Records `a * b + c`.
+ *
+ * @return The node, or a negative value on invalid or incompatible operands.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprFma(AuraTensorExpr* expr, AuraExprNode a, AuraExprNode b, AuraExprNode c) {
+    AuraExprNode args[3] = { a, b, c };
+    return addOperation(expr, NODE_FMA, 0, "fma", args, 3);
+}
+
+/**
+ * Records an activation of `a`.
+ *
+ * @return The node, or a negative value on an invalid operand.
+ * @complexity O(ndim) amortized
+ */
+AuraExprNode auraTensorExprUnary(AuraTensorExpr* expr, AuraTensorUnaryOp op, AuraExprNode a) {
+    if (op < 0 || op >= AURA_TENSOR_UNARY_OP_COUNT) return -1;
+    return addOperation(expr, NODE_UNARY, op, "activation", &a, 1);
+}
+
+// --- EVALUATION ---
+
+/** Number of operands of a node. */
+static int arityOf(const ExprNode* node) {
+    switch (node->kind) {
+    case NODE_BINARY: return 2;
+    case NODE_FMA:    return 3;
+    case NODE_UNARY:  return 1;
+    default:          return 0;
+    }
+}
+
+/**
+ * @brief One node the root depends on, with operands renumbered to steps.
+ */
+typedef struct {
+    const ExprNode* node;
+    int args[3];
+    const AuraTensor* input;      // NODE_INPUT: the tensor, bound to the result's layout.
+    AuraTensor view;              // Storage for a broadcast layout of `input`.
+} ExprStep;
+
+/**
+ * @brief The value of a step over the current block: `n` floats, or one
+ * number for the whole block (constants and inputs broadcast along the row).
+ */
+typedef struct {
+    const float* data;
+    float scalar;
+    bool uniform;
+} BlockValue;
+
+typedef struct {
+    const AuraKernelTable* kernels;
+    AuraTensor* out;
+    ExprStep* steps;              // In evaluation order; the root is last.
+    int stepCount;
+    size_t runs;
+    size_t length;
+    bool failed;                  // Set by a task that could not allocate its scratch blocks.
+} FusedJob;
+
+/**
+ * Returns a block value as `n` floats, splatting a uniform one into `buffer`.
+ */
+static const float* expand(const BlockValue* v, size_t n, float* buffer) {
+    if (!v->uniform) return v->data;
+    for (size_t i = 0; i < n; i++) buffer[i] = v->scalar;
+    return buffer;
+}
+
+/**
+ * Evaluates every step on `n` elements starting at `offset` in run `run`.
+ * `scratch` holds (stepCount + 2) * EXPR_BLOCK floats: one slot per step and
+ * two for splatting uniform FMA operands.
+ */
+static void runBlock(const FusedJob* job, size_t run, size_t offset, size_t n,
+                     float* scratch, BlockValue* values) {
+    const AuraKernelTable* k = job->kernels;
+    float* result = AURA_TENSOR_ROW(job->out, run) + offset;
+    float* splat = scratch + (size_t)job->stepCount * EXPR_BLOCK;
+
+    for (int i = 0; i < job->stepCount; i++) {
+        const ExprStep* step = &job->steps[i];
+        BlockValue* v = &values[i];
+        float* dst = i == job->stepCount - 1 ? result : scratch + (size_t)i * EXPR_BLOCK;
+        const BlockValue* x = &values[step->args[0]];
+        const BlockValue* y = &values[step->args[1]];
+        const BlockValue* z = &values[step->args[2]];
+        int op = step->node->op;
+        v->uniform = false;
+        v->data = dst;
+
+        switch (step->node->kind) {
+        case NODE_CONSTANT:
+            v->uniform = true;
+            v->scalar = step->node->constant;
+            break;
+        case NODE_INPUT:
+            if (step->input->colStride == 0) {
+                v->uniform = true;
+                v->scalar = auraTensorRowPointer(step->input, run)[0];
+            } else {
+                v->data = auraTensorSpan(step->input, run, offset, n, dst);
+            }
+            break;
+        case NODE_BINARY:
+            // OPTIMIZATION: Uniform operands stay scalars and use the
+            // tensor-scalar kernels, exactly as the eager operations do.
+            if (x->uniform && y->uniform) {
+                v->uniform = true;
+                k->binary[op](&v->scalar, &x->scalar, &y->scalar, 1);
+            } else if (y->uniform) {
+                k->binaryScalar[op](dst, x->data, y->scalar, n);
+            } else if (x->uniform) {
+                k->scalarBinary[op](dst, y->data, x->scalar, n);
+            } else {
+                k->binary[op](dst, x->data, y->data, n);
+            }
+            break;
+        case NODE_FMA:
+            if (x->uniform && y->uniform && z->uniform) {
+                v->uniform = true;
+                k->fma(&v->scalar, &x->scalar, &y->scalar, &z->scalar, 1);
+            } else {
+                // At most two operands are uniform here, so two splat buffers suffice.
+                const float* xs = expand(x, n, splat);
+                const float* ys = expand(y, n, x->uniform ? splat + EXPR_BLOCK : splat);
+                const float* zs = expand(z, n, splat + EXPR_BLOCK);
+                k->fma(dst, xs, ys, zs, n);
+            }
+            break;
+        case NODE_UNARY:
+            if (x->uniform) {
+                v->uniform = true;
+                k->unary[op](&v->scalar, &x->scalar, 1);
+            } else {
+                k->unary[op](dst, x->data, n);
+            }
+            break;
+        }
+    }
+
+    const BlockValue* root = &values[job->stepCount - 1];
+    if (root->uniform) {
+        for (size_t i = 0; i < n; i++) result[i] = root->scalar;
+    } else if (root->data != result) {
+        memcpy(result, root->data, n * sizeof(float));
+    }
+}
+
+/**
+ * Thread pool task: indices are rows, or EXPR_BLOCK-float blocks of a single run.
+ */
+static void fusedTask(void* context, size_t begin, size_t end) {
+    FusedJob* job = (FusedJob*)context;
+    float* scratch = auraAlignedAlloc(((size_t)job->stepCount + 2) * EXPR_BLOCK * sizeof(float),
+                                      AURA_TENSOR_ALIGNMENT);
+    BlockValue* values = (BlockValue*)malloc(sizeof(BlockValue) * job->stepCount);
+    if (scratch == NULL || values == NULL) {
+        auraAlignedFree(scratch);
+        free(values);
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if (job->runs == 1) {
+        size_t last = end * EXPR_BLOCK < job->length ? end * EXPR_BLOCK : job->length;
+        for (size_t offset = begin * EXPR_BLOCK; offset < last; offset += EXPR_BLOCK) {
+            runBlock(job, 0, offset, last - offset < EXPR_BLOCK ? last - offset : EXPR_BLOCK, scratch, values);
+        }
+    } else {
+        for (size_t r = begin; r < end; r++) {
+            for (size_t offset = 0; offset < job->length; offset += EXPR_BLOCK) {
+                size_t n = job->length - offset < EXPR_BLOCK ? job->length - offset : EXPR_BLOCK;
+                runBlock(job, r, offset, n, scratch, values);
+            }
+        }
+    }
+    auraAlignedFree(scratch);
+    free(values);
+}
+
+/**
+ * Lists the nodes `root` depends on in evaluation order, renumbering their
+ * operands to step indices.
+ *
+ * @return The steps (root last), or NULL if out of memory.
+ */
+static ExprStep* collectSteps(const AuraTensorExpr* expr, AuraExprNode root, int* stepCount) {
+    int* stepOf = (int*)malloc(sizeof(int) * ((size_t)root + 1));
+    if (stepOf == NULL) return NULL;
+
+    // Operands precede their users, so one backward sweep marks every dependency.
+    for (int i = 0; i <= root; i++) stepOf[i] = -1;
+    stepOf[root] = 0;
+    for (int i = root; i >= 0; i--) {
+        if (stepOf[i] < 0) continue;
+        const ExprNode* node = &expr->nodes[i];
+        for (int a = 0; a < arityOf(node); a++) stepOf[node->args[a]] = 0;
+    }
+
+    int count = 0;
+    for (int i = 0; i <= root; i++) {
+        if (stepOf[i] >= 0) stepOf[i] = count++;
+    }
+
+    ExprStep* steps = (ExprStep*)calloc((size_t)count, sizeof(ExprStep));
+    if (steps != NULL) {
+        for (int i = 0; i <= root; i++) {
+            if (stepOf[i] < 0) continue;
+            ExprStep* step = &steps[stepOf[i]];
+            step->node = &expr->nodes[i];
+            for (int a = 0; a < arityOf(step->node); a++) step->args[a] = stepOf[step->node->args[a]];
+        }
+    }
+    free(stepOf);
+    *stepCount = count;
+    return steps;
+}
+
+/**
+ * Computes the value of a node as a new tensor.
+ *
+ * @param expr The expression.
+ * @param root The node to materialize.
+ * @return A new tensor, or AURA_NULL on an invalid node or allocation failure.
+ * @complexity O(elements * nodes), in a single pass over memory.
+ */
+AuraValue auraTensorExprEvaluate(const AuraTensorExpr* expr, AuraExprNode root) {
+    if (!validOperands(expr, &root, 1)) return createNULL();
+    if (expr->nodes[root].shape.ndim == 0) {
+        fprintf(stderr, "[Security] Tensor expression has no tensor input.\n");
+        return createNULL();
+    }
+
+    FusedJob job = { 0 };
+    job.steps = collectSteps(expr, root, &job.stepCount);
+    if (job.steps == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while evaluating a tensor expression.\n");
+        return createNULL();
+    }
+    job.out = auraCreateShaped(&expr->nodes[root].shape);
+    if (job.out == NULL) {
+        free(job.steps);
+        return createNULL();
+    }
+
+    bool flat = auraTensorIsFlat(job.out);
+    for (int i = 0; i < job.stepCount; i++) {
+        ExprStep* step = &job.steps[i];
+        if (step->node->kind != NODE_INPUT) continue;
+        step->input = auraBroadcastLayout(&step->view, AURA_AS_TENSOR(step->node->tensor), job.out);
+        flat = flat && auraTensorIsFlat(step->input);
+    }
+
+    job.kernels = auraActiveKernels();
+    if (flat) {
+        job.runs = 1;
+        job.length = job.out->rows * job.out->cols;
+        size_t blocks = (job.length + EXPR_BLOCK - 1) / EXPR_BLOCK;
+        auraParallelFor(blocks, AURA_PARALLEL_MIN_ELEMENTS / EXPR_BLOCK, fusedTask, &job);
+    } else {
+        job.runs = job.out->rows;
+        job.length = job.out->cols;
+        auraParallelFor(job.runs, AURA_PARALLEL_MIN_ELEMENTS / job.length + 1, fusedTask, &job);
+    }
+
+    free(job.steps);
+    if (job.failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory while evaluating a tensor expression.\n");
+        freeValue(AURA_OBJ_VAL(job.out));
+        return createNULL();
+    }
+    return AURA_OBJ_VAL(job.out);
+}
@@ -0,0 +1,389 @@
+/**
+ * @file tensor_file.c
+ * @brief Writer and memory-mapped reader of the tensor file format.
+ *
+ * The open file and every tensor loaded from it share one reference count on
+ * the mapping; whichever is released last unmaps it. The directory is
+ * validated once on open, so loading a tensor only fills in a header.
+ */
+
+#include "tensor_file.h"
+#include "tensor.h"
+#include <limits.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define FILE_MAGIC "AURATENS"
+#define FILE_VERSION 1
+#define FILE_BYTE_ORDER 0x01020304u
+#define HEADER_SIZE 64
+#define ENTRY_SIZE 192
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;           // Reads back as FILE_BYTE_ORDER only on a host of the writer's endianness.
+    uint64_t count;
+    uint64_t fileSize;
+    uint8_t reserved[HEADER_SIZE - 32];
+} FileHeader;
+
+typedef struct {
+    char name[AURA_TENSOR_FILE_NAME_MAX + 1];
+    uint32_t dtype;               // AuraDType.
+    uint32_t ndim;
+    uint64_t shape[AURA_TENSOR_MAX_DIMS];
+    uint64_t offset;              // From the start of the file, a multiple of AURA_TENSOR_ALIGNMENT.
+    uint64_t bytes;               // Payload size, row padding included.
+    uint8_t reserved[ENTRY_SIZE - 64 - 8 - 64 - 16];
+} FileEntry;
+
+struct AuraTensorFile {
+    uint8_t* base;                // The mapping.
+    size_t size;
+    uint32_t refs;                // The open file plus every tensor loaded from it.
+    size_t count;
+    const FileEntry* entries;
+#ifdef _WIN32
+    HANDLE handle;
+    HANDLE mapping;
+#endif
+};
+
+/**
+ * Elements of a stored row: the last dimension padded to 64 bytes.
+ */
+static uint64_t rowElements(uint32_t dtype, uint64_t cols) {
+    uint64_t multiple = AURA_TENSOR_ALIGNMENT / auraDTypeSize((AuraDType)dtype);
+    return (cols + multiple - 1) & ~(multiple - 1);
+}
+
+/**
+ * Size of a tensor payload as stored: leading dimensions times the padded
+ * last dimension, in bytes, plus one float scale and one int32 sum per row
+ * for int8. Returns 0 on overflow.
+ */
+static uint64_t payloadBytes(uint32_t dtype, uint32_t ndim, const uint64_t* shape) {
+    uint64_t rows = 1;
+    for (int d = (int)ndim - 2; d >= 0; d--) {
+        if (shape[d] != 0 && rows > UINT64_MAX / shape[d]) return 0;
+        rows *= shape[d];
+    }
+    uint64_t rowBytes = rowElements(dtype, shape[ndim - 1]) * auraDTypeSize((AuraDType)dtype);
+    if (dtype == AURA_DTYPE_I8) rowBytes += sizeof(float) + sizeof(int32_t);
+    return rows > UINT64_MAX / rowBytes ? 0 : rows * rowBytes;
+}
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + AURA_TENSOR_ALIGNMENT - 1) & ~(uint64_t)(AURA_TENSOR_ALIGNMENT - 1);
+}
+
+// --- WRITER ---
+
+/**
+ * Checks the names and tensors handed to the writer.
+ */
+static bool validInputs(const char* const* names, const AuraValue* tensors, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        size_t length = names[i] == NULL ? 0 : strlen(names[i]);
+        if (length == 0 || length > AURA_TENSOR_FILE_NAME_MAX) {
+            fprintf(stderr, "[Security] Tensor file names must have 1 to %d bytes.\n", AURA_TENSOR_FILE_NAME_MAX);
+            return false;
+        }
+        if (!AURA_IS_TENSOR(tensors[i])) {
+            fprintf(stderr, "[Security] Tensor file entry '%s' is not a tensor.\n", names[i]);
+            return false;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (strcmp(names[i], names[j]) == 0) {
+                fprintf(stderr, "[Security] Duplicate tensor file entry '%s'.\n", names[i]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Writes a tensor's rows in padded dense layout, gathering strided views.
+ * Other dtypes than float32 are always dense and written as they are.
+ */
+static bool writePayload(FILE* out, const AuraTensor* t, float* row) {
+    size_t stride = (size_t)rowElements(t->dtype, t->cols);
+    if (t->dtype != AURA_DTYPE_F32) {
+        size_t rowBytes = stride * auraDTypeSize((AuraDType)t->dtype);
+        for (size_t r = 0; r < t->rows; r++) {
+            if (fwrite(auraTensorRowStorage(t, r), 1, rowBytes, out) != rowBytes) return false;
+        }
+        return t->scales == NULL ||
+               (fwrite(t->scales, sizeof(float), t->rows, out) == t->rows &&
+                fwrite(t->rowSums, sizeof(int32_t), t->rows, out) == t->rows);
+    }
+
+    memset(row + t->cols, 0, (stride - t->cols) * sizeof(float));
+    for (size_t r = 0; r < t->rows; r++) {
+        const float* src = auraTensorRowPointer(t, r);
+        for (size_t c = 0; c < t->cols; c++) row[c] = src[c * t->colStride];
+        if (fwrite(row, sizeof(float), stride, out) != stride) return false;
+    }
+    return true;
+}
+
+/**
+ * Writes tensors to a file, replacing it.
+ *
+ * @param path The file to create.
+ * @param names One unique name per tensor.
+ * @param tensors The tensors.
+ * @param count Number of tensors.
+ * @return true on success.
+ * @complexity O(total elements)
+ */
+bool auraTensorFileWrite(const char* path, const char* const* names, const AuraValue* tensors, size_t count) {
+    if (!validInputs(names, tensors, count)) return false;
+
+    FileEntry* entries = (FileEntry*)calloc(count == 0 ? 1 : count, sizeof(FileEntry));
+    if (entries == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while writing tensor file %s.\n", path);
+        return false;
+    }
+
+    // Lay out the payloads after the directory, each on an aligned offset.
+    uint64_t offset = alignUp(HEADER_SIZE + (uint64_t)count * ENTRY_SIZE);
+    size_t widest = 0;
+    for (size_t i = 0; i < count; i++) {
+        const AuraTensor* t = AURA_AS_TENSOR(tensors[i]);
+        FileEntry* entry = &entries[i];
+        strcpy(entry->name, names[i]);
+        entry->dtype = t->dtype;
+        entry->ndim = t->ndim;
+        for (int d = 0; d < t->ndim; d++) entry->shape[d] = t->shape[d];
+        entry->offset = offset;
+        entry->bytes = payloadBytes(entry->dtype, entry->ndim, entry->shape);
+        offset = alignUp(offset + entry->bytes);
+        if (t->cols > widest) widest = t->cols;
+    }
+
+    FileHeader header = { { 0 }, FILE_VERSION, FILE_BYTE_ORDER, count, offset, { 0 } };
+    memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+
+    size_t rowFloats = (widest + AURA_TENSOR_ROW_FLOATS - 1) & ~(AURA_TENSOR_ROW_FLOATS - 1);
+    float* row = (float*)calloc(rowFloats == 0 ? 1 : rowFloats, sizeof(float));
+    FILE* out = fopen(path, "wb");
+    bool ok = row != NULL && out != NULL &&
+              fwrite(&header, sizeof(header), 1, out) == 1 &&
+              (count == 0 || fwrite(entries, sizeof(FileEntry), count, out) == count);
+
+    static const uint8_t zeros[AURA_TENSOR_ALIGNMENT] = { 0 };
+    uint64_t written = HEADER_SIZE + (uint64_t)count * ENTRY_SIZE;
+    for (size_t i = 0; ok && i < count; i++) {
+        const AuraTensor* t = AURA_AS_TENSOR(tensors[i]);
+        size_t gap = (size_t)(entries[i].offset - written);
+        ok = fwrite(zeros, 1, gap, out) == gap &&
+             writePayload(out, t, row);
+        written = entries[i].offset + entries[i].bytes;
+    }
+    size_t tail = (size_t)(offset - written);
+    ok = ok && fwrite(zeros, 1, tail, out) == tail;
+
+    if (out != NULL && fclose(out) != 0) ok = false;
+    if (!ok) fprintf(stderr, "[Security] Could not write tensor file %s.\n", path);
+    free(row);
+    free(entries);
+    return ok;
+}
+
+// --- READER ---
+
+/**
+ * Unmaps the file once its last reference is gone.
+ */
+static void releaseFile(void* owner) {
+    AuraTensorFile* file = (AuraTensorFile*)owner;
+    if (--file->refs > 0) return;
+#ifdef _WIN32
+    UnmapViewOfFile(file->base);
+    CloseHandle(file->mapping);
+    CloseHandle(file->handle);
+#else
+    munmap(file->base, file->size);
+#endif
+    free(file);
+}
+
+/**
+ * Maps `path` read-only into `file->base` / `file->size`.
+ */
+static bool mapFile(AuraTensorFile* file, const char* path) {
+#ifdef _WIN32
+    file->handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->handle == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->handle, &size) || size.QuadPart < HEADER_SIZE) {
+        CloseHandle(file->handle);
+        return false;
+    }
+    file->mapping = CreateFileMappingA(file->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    file->base = file->mapping == NULL ? NULL : (uint8_t*)MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (file->base == NULL) {
+        if (file->mapping != NULL) CloseHandle(file->mapping);
+        CloseHandle(file->handle);
+        return false;
+    }
+    file->size = (size_t)size.QuadPart;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+    void* base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // The mapping keeps the file open.
+    if (base == MAP_FAILED) return false;
+    file->base = (uint8_t*)base;
+    file->size = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+/**
+ * Validates one directory entry against the mapped file.
+ */
+static bool validEntry(const AuraTensorFile* file, const FileEntry* entry) {
+    if (memchr(entry->name, '\0', sizeof(entry->name)) == NULL || entry->name[0] == '\0') return false;
+    if (entry->dtype >= AURA_DTYPE_COUNT) return false;
+    if (entry->ndim < 1 || entry->ndim > AURA_TENSOR_MAX_DIMS) return false;
+    for (uint32_t d = 0; d < entry->ndim; d++) {
+        if (entry->shape[d] == 0 || entry->shape[d] > INT_MAX) return false;
+    }
+    uint64_t bytes = payloadBytes(entry->dtype, entry->ndim, entry->shape);
+    return bytes != 0 && bytes == entry->bytes &&
+           entry->offset % AURA_TENSOR_ALIGNMENT == 0 &&
+           entry->offset >= HEADER_SIZE + file->count * ENTRY_SIZE &&
+           entry->offset <= file->size && bytes <= file->size - entry->offset;
+}
+
+/**
+ * Maps a tensor file read-only and validates its directory.
+ *
+ * @param path The file.
+ * @return The open file, or NULL if it cannot be mapped or is malformed.
+ * @complexity O(tensors)
+ */
+AuraTensorFile* auraTensorFileOpen(const char* path) {
+    AuraTensorFile* file = (AuraTensorFile*)calloc(1, sizeof(AuraTensorFile));
+    if (file == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while opening tensor file %s.\n", path);
+        return NULL;
+    }
+    if (!mapFile(file, path)) {
+        fprintf(stderr, "[Security] Could not map tensor file %s.\n", path);
+        free(file);
+        return NULL;
+    }
+    file->refs = 1;
+
+    const FileHeader* header = (const FileHeader*)file->base;
+    bool valid = memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == FILE_VERSION && header->byteOrder == FILE_BYTE_ORDER &&
+                 header->fileSize == file->size &&
+                 header->count <= (file->size - HEADER_SIZE) / ENTRY_SIZE;
+    if (valid) {
+        file->count = (size_t)header->count;
+        file->entries = (const FileEntry*)(file->base + HEADER_SIZE);
+        for (size_t i = 0; valid && i < file->count; i++) valid = validEntry(file, &file->entries[i]);
+    }
+    if (!valid) {
+        fprintf(stderr, "[Security] Malformed tensor file %s.\n", path);
+        releaseFile(file);
+        return NULL;
+    }
+    return file;
+}
+
+/**
+ * Closes a file. Tensors loaded from it remain valid.
+ *
+ * @param file The file (NULL is ignored).
+ */
+void auraTensorFileClose(AuraTensorFile* file) {
+    if (file != NULL) releaseFile(file);
+}
+
+/**
+ * Returns the number of tensors in a file.
+ */
+size_t auraTensorFileCount(const AuraTensorFile* file) {
+    return file->count;
+}
+
+/**
+ * Returns the name of the tensor at `index`, or NULL if out of range.
+ */
+const char* auraTensorFileName(const AuraTensorFile* file, size_t index) {
+    return index < file->count ? file->entries[index].name : NULL;
+}
+
+/**
+ * Returns a tensor of the file as a read-only value backed by the mapping.
+ *
+ * @param file The file.
+ * @param name The tensor's name.
+ * @return A new tensor value, or AURA_NULL if no tensor has that name.
+ * @complexity O(tensors)
+ */
+AuraValue auraTensorFileLoad(AuraTensorFile* file, const char* name) {
+    const FileEntry* entry = NULL;
+    for (size_t i = 0; i < file->count && entry == NULL; i++) {
+        if (strcmp(file->entries[i].name, name) == 0) entry = &file->entries[i];
+    }
+    if (entry == NULL) {
+        fprintf(stderr, "[Security] Tensor file has no tensor named '%s'.\n", name);
+        return createNULL();
+    }
+
+    AuraTensor* tensor = (AuraTensor*)auraAllocateObject(sizeof(AuraTensor), AURA_TENSOR);
+    if (tensor == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while loading tensor '%s'.\n", name);
+        return createNULL();
+    }
+
+    // Same layout as createTENSORND: packed leading dimensions, padded rows.
+    int last = (int)entry->ndim - 1;
+    size_t step = (size_t)rowElements(entry->dtype, entry->shape[last]);
+    tensor->ndim = (uint8_t)entry->ndim;
+    tensor->dtype = (uint8_t)entry->dtype;
+    tensor->shape[last] = (size_t)entry->shape[last];
+    tensor->strides[last] = 1;
+    for (int d = last - 1; d >= 0; d--) {
+        tensor->shape[d] = (size_t)entry->shape[d];
+        tensor->strides[d] = step;
+        step *= tensor->shape[d];
+    }
+    auraTensorUpdateLayout(tensor);
+
+    tensor->refs = 1;
+    tensor->readOnly = true;
+    tensor->data = (float*)(file->base + entry->offset);
+    if (entry->dtype == AURA_DTYPE_I8) {
+        tensor->scales = (float*)(file->base + entry->offset + entry->bytes -
+                                  tensor->rows * (sizeof(float) + sizeof(int32_t)));
+        tensor->rowSums = (int32_t*)(tensor->scales + tensor->rows);
+    }
+    tensor->releaseStorage = releaseFile;
+    tensor->storageOwner = file;
+    file->refs++;
+    return AURA_OBJ_VAL(tensor);
+}
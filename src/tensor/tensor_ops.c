@@ -0,0 +1,512 @@
+/**
+ * @file tensor_ops.c
+ * @brief Elementwise tensor operations and kernel dispatch.
+ *
+ * Validates the operands, allocates the result and walks the rows, leaving
+ * the inner loops to the kernel table selected for this CPU. Tensors whose
+ * rows are not padded (cols == stride) are processed as a single run.
+ *
+ * Operations on at least AURA_PARALLEL_MIN_ELEMENTS elements per thread are
+ * spread over the thread pool: by rows for padded tensors, by cache-line
+ * aligned blocks of the single run otherwise.
+ */
+
+#include "kernels.h"
+#include "thread_pool.h"
+#include <limits.h>
+#include <pthread.h>
+
+#define AURA_PARALLEL_BLOCK AURA_TENSOR_ROW_FLOATS              // One cache line of floats.
+
+static const AuraKernelTable* activeKernels = NULL;
+static AuraSimdLevel activeLevel = AURA_SIMD_SCALAR;
+static pthread_once_t selectOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * Returns the kernel table implementing a tier (NULL if not compiled in).
+ */
+static const AuraKernelTable* kernelsFor(AuraSimdLevel level) {
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+    case AURA_SIMD_SSE2:   return &auraKernelsSse2;
+    case AURA_SIMD_AVX2:   return &auraKernelsAvx2;
+    case AURA_SIMD_AVX512: return &auraKernelsAvx512;
+#endif
+    default:               return &auraKernelsScalar;
+    }
+}
+
+static void selectDefaultKernels(void) {
+    activeLevel = auraCpuSimdLevel();
+    activeKernels = kernelsFor(activeLevel);
+}
+
+/**
+ * Returns the kernel table selected for this machine.
+ */
+const AuraKernelTable* auraActiveKernels(void) {
+    pthread_once(&selectOnce, selectDefaultKernels);
+    return activeKernels;
+}
+
+/**
+ * Returns the SIMD tier used by the tensor kernels.
+ */
+AuraSimdLevel auraTensorSimdLevel(void) {
+    pthread_once(&selectOnce, selectDefaultKernels);
+    return activeLevel;
+}
+
+/**
+ * Forces the tensor kernels to a SIMD tier (clamped to what the CPU supports).
+ *
+ * @param level The requested tier.
+ * @return The tier actually selected.
+ */
+AuraSimdLevel auraTensorSetSimdLevel(AuraSimdLevel level) {
+    pthread_once(&selectOnce, selectDefaultKernels);
+    if (level > auraCpuMaxSimdLevel()) level = auraCpuMaxSimdLevel();
+    if (level < AURA_SIMD_SCALAR) level = AURA_SIMD_SCALAR;
+    activeLevel = level;
+    activeKernels = kernelsFor(level);
+    return level;
+}
+
+// --- HELPERS ---
+
+/**
+ * Writes a shape as "2x3x4" into `buffer` (truncated to `size` bytes).
+ */
+static void formatShape(const AuraShape* s, char* buffer, size_t size) {
+    size_t used = 0;
+    buffer[0] = '\0';
+    for (int d = 0; d < s->ndim && used < size; d++) {
+        int written = snprintf(buffer + used, size - used, d == 0 ? "%zu" : "x%zu", s->shape[d]);
+        if (written < 0) break;
+        used += (size_t)written;
+    }
+}
+
+/** The shape of a tensor. */
+static AuraShape shapeOf(const AuraTensor* t) {
+    AuraShape s;
+    s.ndim = t->ndim;
+    memcpy(s.shape, t->shape, sizeof(size_t) * t->ndim);
+    return s;
+}
+
+/**
+ * Computes the shape that `count` shapes broadcast to, printing a diagnostic
+ * naming `op` if they are incompatible.
+ *
+ * Shapes are aligned at their last dimension; missing leading dimensions
+ * count as 1, and each dimension must either agree or be 1 in all but one
+ * operand (NumPy rules).
+ */
+bool auraBroadcastShapes(const AuraShape* shapes, int count, const char* op, AuraShape* out) {
+    out->ndim = 0;
+    for (int i = 0; i < count; i++) {
+        if (shapes[i].ndim > out->ndim) out->ndim = shapes[i].ndim;
+    }
+
+    for (int d = 0; d < out->ndim; d++) {
+        out->shape[d] = 1;
+        for (int i = 0; i < count; i++) {
+            int source = d - (out->ndim - shapes[i].ndim);
+            if (source < 0 || shapes[i].shape[source] == 1) continue;
+            if (out->shape[d] != 1 && out->shape[d] != shapes[i].shape[source]) {
+                char first[128], second[128];
+                formatShape(&shapes[0], first, sizeof(first));
+                formatShape(&shapes[i == 0 ? 1 : i], second, sizeof(second));
+                fprintf(stderr, "[Security] Tensor shape mismatch in %s: %s vs %s.\n", op, first, second);
+                return false;
+            }
+            out->shape[d] = shapes[i].shape[source];
+        }
+    }
+    return true;
+}
+
+/**
+ * Computes the shape that `count` tensors broadcast to (see auraBroadcastShapes).
+ */
+static bool broadcastTensors(const AuraTensor* const* operands, int count, const char* op, AuraShape* out) {
+    AuraShape shapes[3];
+    for (int i = 0; i < count; i++) shapes[i] = shapeOf(operands[i]);
+    return auraBroadcastShapes(shapes, count, op, out);
+}
+
+/**
+ * Allocates a tensor of the given shape for a result that is written in full.
+ */
+AuraTensor* auraCreateShaped(const AuraShape* shape) {
+    int dims[AURA_TENSOR_MAX_DIMS];
+    for (int d = 0; d < shape->ndim; d++) {
+        if (shape->shape[d] > INT_MAX) {
+            fprintf(stderr, "[Security] Tensor size overflow detected.\n");
+            return NULL;
+        }
+        dims[d] = (int)shape->shape[d];
+    }
+    AuraValue result = createTENSORNDUninitialized(shape->ndim, dims);
+    return AURA_IS_NULL(result) ? NULL : AURA_AS_TENSOR(result);
+}
+
+/**
+ * Allocates a tensor with the shape of `t` for a result that is written in full.
+ */
+static AuraTensor* createLike(const AuraTensor* t) {
+    AuraShape shape = shapeOf(t);
+    return auraCreateShaped(&shape);
+}
+
+/**
+ * @brief Kernel call shapes shared by every elementwise operation.
+ */
+typedef enum {
+    JOB_BINARY,                   // out = a op b
+    JOB_BINARY_SCALAR,            // out = a op scalar
+    JOB_SCALAR_BINARY,            // out = scalar op a
+    JOB_FMA,                      // out = a * b + c
+    JOB_UNARY                     // out = op(a)
+} ElementwiseKind;
+
+/**
+ * @brief One elementwise operation, ready to be run over any span of rows.
+ */
+typedef struct {
+    const AuraKernelTable* kernels;
+    ElementwiseKind kind;
+    int op;
+    AuraTensor* out;
+    const AuraTensor* a;          // The tensor operand for the scalar kinds.
+    const AuraTensor* b;
+    const AuraTensor* c;
+    float scalar;
+    size_t runs;
+    size_t length;
+    bool gather;                  // Some operand has strided rows (a transposed view).
+    bool failed;                  // Set by a task that could not allocate its scratch rows.
+    AuraTensor views[3];          // Broadcast layouts of operands whose shape differs from `out`.
+} ElementwiseJob;
+
+/**
+ * Returns `t` laid out with the shape of `out`: `t` itself when the shapes
+ * match, else a broadcast layout written to `view` that repeats size-1 and
+ * missing dimensions with stride 0.
+ */
+const AuraTensor* auraBroadcastLayout(AuraTensor* view, const AuraTensor* t, const AuraTensor* out) {
+    if (t->ndim == out->ndim && memcmp(t->shape, out->shape, sizeof(size_t) * t->ndim) == 0) return t;
+
+    view->ndim = out->ndim;
+    view->data = t->data;
+    view->base = NULL;
+    for (int d = 0; d < out->ndim; d++) {
+        int source = d - (out->ndim - t->ndim);
+        view->shape[d] = out->shape[d];
+        view->strides[d] = source < 0 || t->shape[source] != out->shape[d] ? 0 : t->strides[source];
+    }
+    auraTensorUpdateLayout(view);
+    return view;
+}
+
+/** True if the tensor's rows are uniform, contiguous and unpadded, i.e. one flat run. */
+bool auraTensorIsFlat(const AuraTensor* t) {
+    return t == NULL || (t->uniformRows && AURA_TENSOR_ROWS_CONTIGUOUS(t) && (t->rows == 1 || t->stride == t->cols));
+}
+
+/**
+ * Number of floats a kernel call covers, and how many calls are needed: one
+ * call over everything when every operand is a flat run, one call per row
+ * otherwise.
+ */
+static void planRuns(ElementwiseJob* job) {
+    const AuraTensor* operands[3] = { job->a, job->b, job->c };
+    bool flat = auraTensorIsFlat(job->out);
+    job->gather = false;
+    for (int i = 0; i < 3; i++) {
+        flat = flat && auraTensorIsFlat(operands[i]);
+        if (operands[i] != NULL && !AURA_TENSOR_ROWS_CONTIGUOUS(operands[i])) job->gather = true;
+    }
+
+    if (flat) {
+        job->runs = 1;
+        job->length = job->out->rows * job->out->cols;
+    } else {
+        job->runs = job->out->rows;
+        job->length = job->out->cols;
+    }
+}
+
+/**
+ * Returns `n` elements of run `run` of `t` from `offset` as a contiguous
+ * array: in place when the row is contiguous, else gathered into `scratch`.
+ */
+const float* auraTensorSpan(const AuraTensor* t, size_t run, size_t offset, size_t n, float* scratch) {
+    if (t == NULL) return NULL;
+    const float* src = auraTensorRowPointer(t, run) + offset * t->colStride;
+    if (AURA_TENSOR_ROWS_CONTIGUOUS(t)) return src;
+
+    for (size_t i = 0; i < n; i++) scratch[i] = src[i * t->colStride];
+    return scratch;
+}
+
+/**
+ * Runs the job's kernel on `n` elements starting at `offset` in run `run`.
+ * `scratch` holds 3 * n floats when the job gathers, and is unused otherwise.
+ */
+static void runSpan(const ElementwiseJob* job, size_t run, size_t offset, size_t n, float* scratch) {
+    float* dst = AURA_TENSOR_ROW(job->out, run) + offset;
+
+    // OPTIMIZATION: An operand broadcast along the row (stride 0) is a single
+    // number for the whole span, so the scalar kernels apply without a gather.
+    if (job->kind == JOB_BINARY && job->b->colStride == 0) {
+        float s = auraTensorRowPointer(job->b, run)[0];
+        job->kernels->binaryScalar[job->op](dst, auraTensorSpan(job->a, run, offset, n, scratch), s, n);
+        return;
+    }
+    if (job->kind == JOB_BINARY && job->a->colStride == 0) {
+        float s = auraTensorRowPointer(job->a, run)[0];
+        job->kernels->scalarBinary[job->op](dst, auraTensorSpan(job->b, run, offset, n, scratch), s, n);
+        return;
+    }
+
+    const float* x = auraTensorSpan(job->a, run, offset, n, scratch);
+    const float* y = auraTensorSpan(job->b, run, offset, n, scratch + n);
+    const float* z = auraTensorSpan(job->c, run, offset, n, scratch + 2 * n);
+    switch (job->kind) {
+    case JOB_BINARY:
+        job->kernels->binary[job->op](dst, x, y, n);
+        break;
+    case JOB_BINARY_SCALAR:
+        job->kernels->binaryScalar[job->op](dst, x, job->scalar, n);
+        break;
+    case JOB_SCALAR_BINARY:
+        job->kernels->scalarBinary[job->op](dst, x, job->scalar, n);
+        break;
+    case JOB_FMA:
+        job->kernels->fma(dst, x, y, z, n);
+        break;
+    case JOB_UNARY:
+        job->kernels->unary[job->op](dst, x, n);
+        break;
+    }
+}
+
+/**
+ * Thread pool task: indices are rows, or AURA_PARALLEL_BLOCK-float blocks
+ * of a single run.
+ */
+static void elementwiseTask(void* context, size_t begin, size_t end) {
+    ElementwiseJob* job = (ElementwiseJob*)context;
+    if (job->runs == 1) {
+        size_t first = begin * AURA_PARALLEL_BLOCK;
+        size_t last = end * AURA_PARALLEL_BLOCK;
+        if (last > job->length) last = job->length;
+        runSpan(job, 0, first, last - first, NULL);
+        return;
+    }
+
+    float* scratch = NULL;
+    if (job->gather) {
+        scratch = (float*)malloc(3 * job->length * sizeof(float));
+        if (scratch == NULL) {
+            __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    for (size_t r = begin; r < end; r++) runSpan(job, r, 0, job->length, scratch);
+    free(scratch);
+}
+
+/**
+ * Runs an elementwise job over the whole output, in parallel when it is large.
+ *
+ * @return The output tensor, or AURA_NULL (with `out` freed) if a task ran out of memory.
+ */
+static AuraValue runElementwise(ElementwiseJob* job) {
+    job->kernels = auraActiveKernels();
+    planRuns(job);
+    if (job->runs == 1) {
+        size_t blocks = (job->length + AURA_PARALLEL_BLOCK - 1) / AURA_PARALLEL_BLOCK;
+        auraParallelFor(blocks, AURA_PARALLEL_MIN_ELEMENTS / AURA_PARALLEL_BLOCK, elementwiseTask, job);
+    } else {
+        auraParallelFor(job->runs, AURA_PARALLEL_MIN_ELEMENTS / job->length + 1, elementwiseTask, job);
+    }
+    if (job->failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory while gathering strided tensor rows.\n");
+        freeValue(AURA_OBJ_VAL(job->out));
+        return createNULL();
+    }
+    return AURA_OBJ_VAL(job->out);
+}
+
+// --- ELEMENTWISE OPERATIONS ---
+
+/**
+ * Applies a binary operation elementwise, broadcasting numbers and size-1 dimensions.
+ *
+ * @param op The operation.
+ * @param a Left operand (tensor or number).
+ * @param b Right operand (tensor or number).
+ * @return A new tensor, or AURA_NULL on invalid operands.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorBinary(AuraTensorBinaryOp op, AuraValue a, AuraValue b) {
+    static const char* names[AURA_TENSOR_BINARY_OP_COUNT] = { "add", "sub", "mul", "div" };
+
+    if (op < 0 || op >= AURA_TENSOR_BINARY_OP_COUNT) return createNULL();
+
+    if ((AURA_IS_TENSOR(a) && !auraTensorRequireF32(AURA_AS_TENSOR(a), names[op])) ||
+        (AURA_IS_TENSOR(b) && !auraTensorRequireF32(AURA_AS_TENSOR(b), names[op]))) {
+        return createNULL();
+    }
+
+    AuraTensor* out;
+    if (AURA_IS_TENSOR(a) && AURA_IS_TENSOR(b)) {
+        const AuraTensor* operands[2] = { AURA_AS_TENSOR(a), AURA_AS_TENSOR(b) };
+        AuraShape shape;
+        if (!broadcastTensors(operands, 2, names[op], &shape)) return createNULL();
+        out = auraCreateShaped(&shape);
+    } else if (AURA_IS_TENSOR(a) && AURA_IS_NUMERIC(b)) {
+        out = createLike(AURA_AS_TENSOR(a));
+    } else if (AURA_IS_NUMERIC(a) && AURA_IS_TENSOR(b)) {
+        out = createLike(AURA_AS_TENSOR(b));
+    } else {
+        fprintf(stderr, "[Security] Tensor %s expects a tensor and a tensor or number.\n", names[op]);
+        return createNULL();
+    }
+    if (out == NULL) return createNULL();
+
+    ElementwiseJob job = { 0 };
+    job.op = op;
+    job.out = out;
+    if (AURA_IS_TENSOR(a) && AURA_IS_TENSOR(b)) {
+        job.kind = JOB_BINARY;
+        job.a = auraBroadcastLayout(&job.views[0], AURA_AS_TENSOR(a), out);
+        job.b = auraBroadcastLayout(&job.views[1], AURA_AS_TENSOR(b), out);
+    } else if (AURA_IS_TENSOR(a)) {
+        job.kind = JOB_BINARY_SCALAR;
+        job.a = AURA_AS_TENSOR(a);
+        job.scalar = (float)auraToNumber(b);
+    } else {
+        job.kind = JOB_SCALAR_BINARY;
+        job.a = AURA_AS_TENSOR(b);
+        job.scalar = (float)auraToNumber(a);
+    }
+    return runElementwise(&job);
+}
+
+AuraValue auraTensorAdd(AuraValue a, AuraValue b) { return auraTensorBinary(AURA_TENSOR_ADD, a, b); }
+AuraValue auraTensorSub(AuraValue a, AuraValue b) { return auraTensorBinary(AURA_TENSOR_SUB, a, b); }
+AuraValue auraTensorMul(AuraValue a, AuraValue b) { return auraTensorBinary(AURA_TENSOR_MUL, a, b); }
+AuraValue auraTensorDiv(AuraValue a, AuraValue b) { return auraTensorBinary(AURA_TENSOR_DIV, a, b); }
+
+/**
+ * Computes `a * b + c` elementwise.
+ *
+ * @param a First factor.
+ * @param b Second factor.
+ * @param c Addend.
+ * @return A new tensor, or AURA_NULL on invalid operands.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorFma(AuraValue a, AuraValue b, AuraValue c) {
+    if (!AURA_IS_TENSOR(a) || !AURA_IS_TENSOR(b) || !AURA_IS_TENSOR(c)) {
+        fprintf(stderr, "[Security] Tensor fma expects three tensors.\n");
+        return createNULL();
+    }
+    const AuraTensor* operands[3] = { AURA_AS_TENSOR(a), AURA_AS_TENSOR(b), AURA_AS_TENSOR(c) };
+    for (int i = 0; i < 3; i++) {
+        if (!auraTensorRequireF32(operands[i], "fma")) return createNULL();
+    }
+    AuraShape shape;
+    if (!broadcastTensors(operands, 3, "fma", &shape)) return createNULL();
+
+    AuraTensor* out = auraCreateShaped(&shape);
+    if (out == NULL) return createNULL();
+
+    ElementwiseJob job = { 0 };
+    job.kind = JOB_FMA;
+    job.out = out;
+    job.a = auraBroadcastLayout(&job.views[0], operands[0], out);
+    job.b = auraBroadcastLayout(&job.views[1], operands[1], out);
+    job.c = auraBroadcastLayout(&job.views[2], operands[2], out);
+    return runElementwise(&job);
+}
+
+/**
+ * Applies an activation elementwise.
+ *
+ * @param op The activation.
+ * @param a The input tensor.
+ * @return A new tensor, or AURA_NULL if `a` is not a tensor.
+ * @complexity O(rows * cols)
+ */
+AuraValue auraTensorUnary(AuraTensorUnaryOp op, AuraValue a) {
+    if (op < 0 || op >= AURA_TENSOR_UNARY_OP_COUNT) return createNULL();
+    if (!AURA_IS_TENSOR(a)) {
+        fprintf(stderr, "[Security] Tensor activation expects a tensor.\n");
+        return createNULL();
+    }
+
+    AuraTensor* in = AURA_AS_TENSOR(a);
+    if (!auraTensorRequireF32(in, "activation")) return createNULL();
+    AuraTensor* out = createLike(in);
+    if (out == NULL) return createNULL();
+
+    ElementwiseJob job = { 0 };
+    job.kind = JOB_UNARY;
+    job.op = op;
+    job.out = out;
+    job.a = in;
+    return runElementwise(&job);
+}
+
+AuraValue auraTensorRelu(AuraValue a) { return auraTensorUnary(AURA_TENSOR_RELU, a); }
+AuraValue auraTensorSigmoid(AuraValue a) { return auraTensorUnary(AURA_TENSOR_SIGMOID, a); }
+AuraValue auraTensorTanh(AuraValue a) { return auraTensorUnary(AURA_TENSOR_TANH, a); }
+AuraValue auraTensorExp(AuraValue a) { return auraTensorUnary(AURA_TENSOR_EXP, a); }
+
+// --- LINEAR ALGEBRA ---
+
+/**
+ * Computes the matrix product `a x b`.
+ *
+ * @param a Left operand (m x k tensor).
+ * @param b Right operand (k x n tensor).
+ * @return A new m x n tensor, or AURA_NULL on invalid operands or allocation failure.
+ * @complexity O(m * n * k)
+ */
+AuraValue auraTensorMatmul(AuraValue a, AuraValue b) {
+    if (!AURA_IS_TENSOR(a) || !AURA_IS_TENSOR(b)) {
+        fprintf(stderr, "[Security] Tensor matmul expects two tensors.\n");
+        return createNULL();
+    }
+    AuraTensor* ta = AURA_AS_TENSOR(a);
+    AuraTensor* tb = AURA_AS_TENSOR(b);
+    if (ta->ndim != 2 || tb->ndim != 2) {
+        fprintf(stderr, "[Security] Tensor matmul expects 2-D tensors.\n");
+        return createNULL();
+    }
+    if (!auraTensorRequireF32(ta, "matmul") || !auraTensorRequireF32(tb, "matmul")) return createNULL();
+    if (ta->cols != tb->rows) {
+        fprintf(stderr, "[Security] Tensor shape mismatch in matmul: %zux%zu vs %zux%zu.\n",
+                ta->rows, ta->cols, tb->rows, tb->cols);
+        return createNULL();
+    }
+
+    AuraValue result = createTENSOR((int)ta->rows, (int)tb->cols);
+    if (AURA_IS_NULL(result)) return createNULL();
+    AuraTensor* out = AURA_AS_TENSOR(result);
+
+    // Packing reads any strides, so views (e.g. transposes) need no copy.
+    if (!auraGemm(ta->rows, tb->cols, ta->cols,
+                  ta->data, (ptrdiff_t)ta->stride, (ptrdiff_t)ta->colStride,
+                  tb->data, (ptrdiff_t)tb->stride, (ptrdiff_t)tb->colStride,
+                  out->data, (ptrdiff_t)out->stride, 1)) {
+        freeValue(result);
+        return createNULL();
+    }
+    return result;
+}
@@ -0,0 +1,406 @@
+/**
+ * @file tensor_reduce.c
+ * @brief Sums, means, maxima, argmaxima and norms of tensors.
+ *
+ * Reductions come in two shapes. Along the last axis (and over everything)
+ * each row, or each fixed-size chunk of a flat tensor, is one "run" reduced by
+ * a single kernel call into one partial result; a full reduction then reduces
+ * the partials with the same kernel. Along any other axis the rows that meet
+ * in one result are combined elementwise, a block of columns at a time, so
+ * the accumulators stay in L1 while the rows stream past.
+ *
+ * The chunk sizes and the pairing of partial sums are fixed, never derived
+ * from the thread count, so results do not depend on how the work is split.
+ */
+
+#include "kernels.h"
+#include "thread_pool.h"
+#include <math.h>
+
+#define FLAT_CHUNK ((size_t)1 << 14)   // Elements per partial result of a flat tensor.
+#define COLUMN_BLOCK 512               // Columns reduced together along an outer axis.
+#define PAIRWISE_ROWS 8                // Rows added in sequence before pairing partial sums.
+
+static const char* const reduceNames[AURA_TENSOR_REDUCE_OP_COUNT] = {
+    "sum", "mean", "max", "argmax", "norm"
+};
+
+// --- RUNS (last axis and full reductions) ---
+
+typedef struct {
+    const AuraKernelTable* kernels;
+    AuraTensorReduceOp op;
+    const AuraTensor* in;
+    bool flat;                    // Runs are FLAT_CHUNK slices of one contiguous run.
+    size_t length;                // Elements per run (the last run of a flat tensor may be shorter).
+    size_t total;                 // Elements of the tensor.
+    float* values;                // One partial result per run.
+    size_t* indices;              // ARGMAX: position of values[run] within its run.
+    bool failed;                  // Set by a task that could not allocate its scratch run.
+} RunJob;
+
+/**
+ * Thread pool task: reduces runs [begin, end).
+ */
+static void runTask(void* context, size_t begin, size_t end) {
+    RunJob* job = (RunJob*)context;
+    const AuraKernelTable* k = job->kernels;
+
+    float* scratch = NULL;
+    if (!AURA_TENSOR_ROWS_CONTIGUOUS(job->in)) {
+        scratch = (float*)malloc(job->length * sizeof(float));
+        if (scratch == NULL) {
+            __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    for (size_t r = begin; r < end; r++) {
+        size_t n = job->length;
+        const float* run;
+        if (job->flat) {
+            size_t offset = r * job->length;
+            if (job->total - offset < n) n = job->total - offset;
+            run = auraTensorSpan(job->in, 0, offset, n, scratch);
+        } else {
+            run = auraTensorSpan(job->in, r, 0, n, scratch);
+        }
+
+        switch (job->op) {
+        case AURA_TENSOR_MAX:
+            job->values[r] = k->max(run, n);
+            break;
+        case AURA_TENSOR_ARGMAX:
+            job->indices[r] = k->argmax(run, n);
+            job->values[r] = run[job->indices[r]];
+            break;
+        case AURA_TENSOR_NORM:
+            job->values[r] = k->sumSquares(run, n);
+            break;
+        default:
+            job->values[r] = k->sum(run, n);
+            break;
+        }
+    }
+    free(scratch);
+}
+
+/**
+ * Reduces every run of `job` in parallel. Returns the number of runs, or 0 if
+ * the partial results or a task's scratch could not be allocated.
+ */
+static size_t reduceRuns(RunJob* job) {
+    size_t runs = job->flat ? (job->total + FLAT_CHUNK - 1) / FLAT_CHUNK : job->in->rows;
+    job->values = (float*)malloc(runs * sizeof(float));
+    job->indices = job->op == AURA_TENSOR_ARGMAX ? (size_t*)malloc(runs * sizeof(size_t)) : NULL;
+    if (job->values == NULL || (job->op == AURA_TENSOR_ARGMAX && job->indices == NULL)) {
+        fprintf(stderr, "[Fatal Error] Out of memory while reducing a tensor.\n");
+        free(job->values);
+        free(job->indices);
+        return 0;
+    }
+    auraParallelFor(runs, AURA_PARALLEL_MIN_ELEMENTS / job->length + 1, runTask, job);
+    if (job->failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory while reducing a tensor.\n");
+        free(job->values);
+        free(job->indices);
+        return 0;
+    }
+    return runs;
+}
+
+/**
+ * Reduces every element of `in` to a number.
+ */
+static AuraValue reduceAll(const AuraKernelTable* k, AuraTensorReduceOp op, const AuraTensor* in) {
+    RunJob job = { k, op, in, auraTensorIsFlat(in), in->cols, in->rows * in->cols, NULL, NULL, false };
+    if (job.flat) job.length = FLAT_CHUNK;
+    size_t runs = reduceRuns(&job);
+    if (runs == 0) return createNULL();
+
+    double result;
+    switch (op) {
+    case AURA_TENSOR_MAX:
+        result = k->max(job.values, runs);
+        break;
+    case AURA_TENSOR_ARGMAX: {
+        // Runs are consecutive in row-major order, so the first run holding
+        // the maximum holds its first occurrence.
+        size_t run = k->argmax(job.values, runs);
+        result = (double)(run * job.length + job.indices[run]);
+        break;
+    }
+    case AURA_TENSOR_NORM:
+        result = sqrtf(k->sum(job.values, runs));
+        break;
+    case AURA_TENSOR_MEAN:
+        result = k->sum(job.values, runs) / (float)job.total;
+        break;
+    default:
+        result = k->sum(job.values, runs);
+        break;
+    }
+    free(job.values);
+    free(job.indices);
+    return createNUMBER(result);
+}
+
+/**
+ * Reduces each row of `in` into the matching element of `out`.
+ */
+static bool reduceLastAxis(const AuraKernelTable* k, AuraTensorReduceOp op, const AuraTensor* in, AuraTensor* out) {
+    RunJob job = { k, op, in, false, in->cols, in->rows * in->cols, NULL, NULL, false };
+    if (reduceRuns(&job) == 0) return false;
+
+    for (size_t o = 0; o < out->rows; o++) {
+        float* dst = AURA_TENSOR_ROW(out, o);
+        const float* values = job.values + o * out->cols;
+        for (size_t c = 0; c < out->cols; c++) {
+            switch (op) {
+            case AURA_TENSOR_MEAN:
+                dst[c] = values[c] / (float)in->cols;
+                break;
+            case AURA_TENSOR_NORM:
+                dst[c] = sqrtf(values[c]);
+                break;
+            case AURA_TENSOR_ARGMAX:
+                dst[c] = (float)job.indices[o * out->cols + c];
+                break;
+            default:
+                dst[c] = values[c];
+                break;
+            }
+        }
+    }
+    free(job.values);
+    free(job.indices);
+    return true;
+}
+
+// --- OUTER AXES ---
+
+typedef struct {
+    const AuraKernelTable* kernels;
+    AuraTensorReduceOp op;
+    AuraTensor slice;             // Layout of the input without the reduced axis, at index 0 of it.
+    size_t step;                  // Stride of the reduced axis.
+    size_t count;                 // Length of the reduced axis.
+    size_t levels;                // Accumulators needed by the pairwise recursion.
+    size_t blocks;                // Column blocks per output row.
+    AuraTensor* out;
+    bool failed;                  // Set by a task that could not allocate its accumulators.
+} AxisJob;
+
+typedef struct {
+    const AxisJob* job;
+    size_t row;                   // Output row.
+    size_t column;                // First column of the block.
+    size_t n;                     // Columns in the block.
+    float* gather;                // COLUMN_BLOCK floats for strided rows.
+} AxisBlock;
+
+/**
+ * Returns the block's columns of input row `k` along the reduced axis.
+ */
+static const float* axisRow(const AxisBlock* block, size_t k) {
+    const AuraTensor* slice = &block->job->slice;
+    const float* src = auraTensorRowPointer(slice, block->row) + k * block->job->step +
+                       block->column * slice->colStride;
+    if (AURA_TENSOR_ROWS_CONTIGUOUS(slice)) return src;
+
+    for (size_t c = 0; c < block->n; c++) block->gather[c] = src[c * slice->colStride];
+    return block->gather;
+}
+
+/**
+ * Sums (or sums the squares of) rows [lo, hi) into `acc`, pairwise: halves
+ * are summed separately into `acc` and the next accumulator, `acc + n`, whose
+ * successors serve the deeper levels.
+ */
+static void sumRows(const AxisBlock* block, size_t lo, size_t hi, float* acc) {
+    const AuraKernelTable* k = block->job->kernels;
+    bool squares = block->job->op == AURA_TENSOR_NORM;
+    size_t n = block->n;
+
+    if (hi - lo > PAIRWISE_ROWS) {
+        size_t mid = lo + (hi - lo) / 2;
+        sumRows(block, lo, mid, acc);
+        sumRows(block, mid, hi, acc + n);
+        k->binary[AURA_TENSOR_ADD](acc, acc, acc + n, n);
+        return;
+    }
+
+    const float* row = axisRow(block, lo);
+    if (squares) {
+        k->binary[AURA_TENSOR_MUL](acc, row, row, n);
+    } else {
+        memcpy(acc, row, n * sizeof(float));
+    }
+    for (size_t r = lo + 1; r < hi; r++) {
+        row = axisRow(block, r);
+        if (squares) {
+            k->fma(acc, row, row, acc, n);
+        } else {
+            k->binary[AURA_TENSOR_ADD](acc, acc, row, n);
+        }
+    }
+}
+
+/**
+ * Reduces one column block of one output row into the output.
+ */
+static void reduceBlock(const AxisBlock* block, float* acc, int32_t* indices) {
+    const AxisJob* job = block->job;
+    const AuraKernelTable* k = job->kernels;
+    size_t n = block->n;
+    float* dst = AURA_TENSOR_ROW(job->out, block->row) + block->column;
+
+    switch (job->op) {
+    case AURA_TENSOR_MAX:
+    case AURA_TENSOR_ARGMAX:
+        for (size_t c = 0; c < n; c++) {
+            acc[c] = -INFINITY;
+            indices[c] = 0;
+        }
+        for (size_t r = 0; r < job->count; r++) {
+            if (job->op == AURA_TENSOR_MAX) {
+                k->maximum(acc, axisRow(block, r), acc, n);
+            } else {
+                k->argmaxUpdate(acc, indices, axisRow(block, r), (int32_t)r, n);
+            }
+        }
+        if (job->op == AURA_TENSOR_MAX) {
+            memcpy(dst, acc, n * sizeof(float));
+        } else {
+            for (size_t c = 0; c < n; c++) dst[c] = (float)indices[c];
+        }
+        break;
+    case AURA_TENSOR_MEAN:
+        sumRows(block, 0, job->count, acc);
+        k->binaryScalar[AURA_TENSOR_DIV](dst, acc, (float)job->count, n);
+        break;
+    case AURA_TENSOR_NORM:
+        sumRows(block, 0, job->count, acc);
+        for (size_t c = 0; c < n; c++) dst[c] = sqrtf(acc[c]);
+        break;
+    default:
+        sumRows(block, 0, job->count, acc);
+        memcpy(dst, acc, n * sizeof(float));
+        break;
+    }
+}
+
+/**
+ * Thread pool task: blocks [begin, end), numbered row by row.
+ */
+static void axisTask(void* context, size_t begin, size_t end) {
+    AxisJob* job = (AxisJob*)context;
+    size_t floats = (job->levels + 1) * COLUMN_BLOCK;
+    float* scratch = (float*)malloc(floats * sizeof(float) + COLUMN_BLOCK * sizeof(int32_t));
+    if (scratch == NULL) {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (size_t i = begin; i < end; i++) {
+        AxisBlock block;
+        block.job = job;
+        block.row = i / job->blocks;
+        block.column = (i % job->blocks) * COLUMN_BLOCK;
+        block.n = job->out->cols - block.column < COLUMN_BLOCK ? job->out->cols - block.column : COLUMN_BLOCK;
+        block.gather = scratch + job->levels * COLUMN_BLOCK;
+        reduceBlock(&block, scratch, (int32_t*)(scratch + floats));
+    }
+    free(scratch);
+}
+
+/**
+ * Reduces axis `axis` (not the last) of `in` into `out`. Returns false if a
+ * task ran out of memory.
+ */
+static bool reduceOuterAxis(const AuraKernelTable* k, AuraTensorReduceOp op, const AuraTensor* in,
+                            int axis, AuraTensor* out) {
+    AxisJob job;
+    job.kernels = k;
+    job.op = op;
+    job.step = in->strides[axis];
+    job.count = in->shape[axis];
+    job.out = out;
+    job.failed = false;
+
+    memset(&job.slice, 0, sizeof(job.slice));
+    job.slice.ndim = (uint8_t)(in->ndim - 1);
+    job.slice.data = in->data;
+    for (int d = 0, s = 0; d < in->ndim; d++) {
+        if (d == axis) continue;
+        job.slice.shape[s] = in->shape[d];
+        job.slice.strides[s] = in->strides[d];
+        s++;
+    }
+    auraTensorUpdateLayout(&job.slice);
+
+    job.levels = 1;
+    for (size_t r = job.count; r > PAIRWISE_ROWS; r = (r + 1) / 2) job.levels++;
+    job.blocks = (out->cols + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+    auraParallelFor(out->rows * job.blocks, AURA_PARALLEL_MIN_ELEMENTS / (job.count * COLUMN_BLOCK) + 1,
+                    axisTask, &job);
+    if (job.failed) {
+        fprintf(stderr, "[Fatal Error] Out of memory while reducing a tensor.\n");
+        return false;
+    }
+    return true;
+}
+
+// --- ENTRY POINTS ---
+
+/**
+ * Reduces a tensor along one axis, or entirely.
+ *
+ * @param op The reduction.
+ * @param t A value of type AURA_TENSOR (float32).
+ * @param axis The dimension to reduce, or AURA_TENSOR_ALL_AXES.
+ * @return A new tensor without that dimension, a number for full reductions,
+ *         or AURA_NULL on invalid arguments.
+ * @complexity O(elements)
+ */
+AuraValue auraTensorReduce(AuraTensorReduceOp op, AuraValue t, int axis) {
+    if (op < 0 || op >= AURA_TENSOR_REDUCE_OP_COUNT) {
+        fprintf(stderr, "[Security] Invalid tensor reduction %d.\n", (int)op);
+        return createNULL();
+    }
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor %s expects a tensor.\n", reduceNames[op]);
+        return createNULL();
+    }
+    AuraTensor* in = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(in, reduceNames[op])) return createNULL();
+    if (axis != AURA_TENSOR_ALL_AXES && (axis < 0 || axis >= in->ndim)) {
+        fprintf(stderr, "[Security] Tensor %s axis %d out of range for %d dimensions.\n",
+                reduceNames[op], axis, in->ndim);
+        return createNULL();
+    }
+
+    const AuraKernelTable* k = auraActiveKernels();
+    if (axis == AURA_TENSOR_ALL_AXES || in->ndim == 1) return reduceAll(k, op, in);
+
+    AuraShape shape;
+    shape.ndim = in->ndim - 1;
+    for (int d = 0, s = 0; d < in->ndim; d++) {
+        if (d != axis) shape.shape[s++] = in->shape[d];
+    }
+    AuraTensor* out = auraCreateShaped(&shape);
+    if (out == NULL) return createNULL();
+
+    bool ok = axis == in->ndim - 1 ? reduceLastAxis(k, op, in, out) : reduceOuterAxis(k, op, in, axis, out);
+    if (!ok) {
+        freeValue(AURA_OBJ_VAL(out));
+        return createNULL();
+    }
+    return AURA_OBJ_VAL(out);
+}
+
+AuraValue auraTensorSum(AuraValue t, int axis) { return auraTensorReduce(AURA_TENSOR_SUM, t, axis); }
+AuraValue auraTensorMean(AuraValue t, int axis) { return auraTensorReduce(AURA_TENSOR_MEAN, t, axis); }
+AuraValue auraTensorMax(AuraValue t, int axis) { return auraTensorReduce(AURA_TENSOR_MAX, t, axis); }
+AuraValue auraTensorArgmax(AuraValue t, int axis) { return auraTensorReduce(AURA_TENSOR_ARGMAX, t, axis); }
+AuraValue auraTensorNorm(AuraValue t, int axis) { return auraTensorReduce(AURA_TENSOR_NORM, t, axis); }
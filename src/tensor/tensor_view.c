@@ -0,0 +1,200 @@
+/**
+ * @file tensor_view.c
+ * @brief Zero-copy tensor views (transpose, slicing) and densification.
+ *
+ * A view is a bare AuraTensor header whose `data` and strides describe a
+ * window into another tensor's storage. It references the owner of that
+ * storage directly (never an intermediate view), so a chain of views costs
+ * one reference and one pointer chase, like string slices.
+ */
+
+#include "kernels.h"
+
+/** Side of the square tiles used when densifying a transposed view. */
+#define TRANSPOSE_TILE 32
+
+/**
+ * Allocates a view of `source`'s storage with the given layout.
+ */
+static AuraValue makeView(AuraTensor* source, int ndim, const size_t* shape, const size_t* strides, float* data) {
+    AuraTensor* owner = source->base != NULL ? source->base : source;
+
+    AuraTensor* view = (AuraTensor*)auraAllocateObject(sizeof(AuraTensor), AURA_TENSOR);
+    if (view == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while creating a tensor view.\n");
+        return createNULL();
+    }
+
+    view->ndim = (uint8_t)ndim;
+    view->refs = 1;
+    view->data = data;
+    view->base = owner;
+    view->readOnly = owner->readOnly;
+    memcpy(view->shape, shape, sizeof(size_t) * ndim);
+    memcpy(view->strides, strides, sizeof(size_t) * ndim);
+    auraTensorUpdateLayout(view);
+    owner->refs++;
+    return AURA_OBJ_VAL(view);
+}
+
+/**
+ * Adds a reference to a tensor value.
+ *
+ * @param v A value of type AURA_TENSOR.
+ * @return `v`, now carrying one more owner.
+ * @complexity O(1)
+ */
+AuraValue auraTensorRetain(AuraValue v) {
+    if (AURA_IS_TENSOR(v)) AURA_AS_TENSOR(v)->refs++;
+    return v;
+}
+
+/**
+ * Returns the transpose of a tensor (its last two dimensions swapped) without
+ * copying it.
+ *
+ * @param t A value of type AURA_TENSOR.
+ * @return A view sharing `t`'s storage (`t` itself, retained, for 1-D
+ *         tensors), or AURA_NULL.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorTranspose(AuraValue t) {
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor transpose expects a tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* tensor = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(tensor, "transpose")) return createNULL();
+    if (tensor->ndim < 2) return auraTensorRetain(t);
+
+    size_t shape[AURA_TENSOR_MAX_DIMS];
+    size_t strides[AURA_TENSOR_MAX_DIMS];
+    memcpy(shape, tensor->shape, sizeof(shape));
+    memcpy(strides, tensor->strides, sizeof(strides));
+    int last = tensor->ndim - 1;
+    shape[last] = tensor->shape[last - 1];
+    shape[last - 1] = tensor->shape[last];
+    strides[last] = tensor->strides[last - 1];
+    strides[last - 1] = tensor->strides[last];
+    return makeView(tensor, tensor->ndim, shape, strides, tensor->data);
+}
+
+/**
+ * Returns indices [start, end) of one dimension of a tensor without copying.
+ *
+ * @param t A value of type AURA_TENSOR.
+ * @param axis The dimension to slice.
+ * @param start First index kept.
+ * @param end One past the last index kept.
+ * @return A view sharing `t`'s storage (or `t` itself, retained, when the
+ *         range covers the dimension), or AURA_NULL if the range is empty or
+ *         out of bounds.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorSliceAxis(AuraValue t, int axis, size_t start, size_t end) {
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor slice expects a tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* tensor = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(tensor, "slice")) return createNULL();
+    if (axis < 0 || axis >= tensor->ndim || start >= end || end > tensor->shape[axis]) {
+        fprintf(stderr, "[Security] Tensor slice [%zu:%zu] on axis %d out of bounds.\n", start, end, axis);
+        return createNULL();
+    }
+    if (start == 0 && end == tensor->shape[axis]) return auraTensorRetain(t);
+
+    size_t shape[AURA_TENSOR_MAX_DIMS];
+    memcpy(shape, tensor->shape, sizeof(shape));
+    shape[axis] = end - start;
+    return makeView(tensor, tensor->ndim, shape, tensor->strides, tensor->data + start * tensor->strides[axis]);
+}
+
+/**
+ * Returns rows [rowStart, rowEnd) and columns [colStart, colEnd) of a tensor
+ * (of every matrix in the batch for N-D tensors) without copying them.
+ *
+ * @param t A value of type AURA_TENSOR.
+ * @return A view sharing `t`'s storage (or `t` itself, retained, when the
+ *         range covers it), or AURA_NULL if the range is empty or out of bounds.
+ * @complexity O(ndim)
+ */
+AuraValue auraTensorSlice(AuraValue t, size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd) {
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor slice expects a tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* tensor = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(tensor, "slice")) return createNULL();
+    int last = tensor->ndim - 1;
+    size_t rows = last > 0 ? tensor->shape[last - 1] : 1;
+    if (rowStart >= rowEnd || rowEnd > rows || colStart >= colEnd || colEnd > tensor->cols) {
+        fprintf(stderr, "[Security] Tensor slice [%zu:%zu, %zu:%zu] out of bounds for %zux%zu.\n",
+                rowStart, rowEnd, colStart, colEnd, rows, tensor->cols);
+        return createNULL();
+    }
+
+    if (rowStart == 0 && colStart == 0 && rowEnd == rows && colEnd == tensor->cols) {
+        return auraTensorRetain(t);
+    }
+
+    size_t shape[AURA_TENSOR_MAX_DIMS];
+    memcpy(shape, tensor->shape, sizeof(shape));
+    shape[last] = colEnd - colStart;
+    float* data = tensor->data + colStart * tensor->strides[last];
+    if (last > 0) {
+        shape[last - 1] = rowEnd - rowStart;
+        data += rowStart * tensor->strides[last - 1];
+    }
+    return makeView(tensor, tensor->ndim, shape, tensor->strides, data);
+}
+
+/**
+ * Returns a tensor with its own aligned, row-contiguous storage holding the
+ * elements of `t`.
+ *
+ * @param t A value of type AURA_TENSOR.
+ * @return `t` itself (retained) if it already owns its storage, otherwise a
+ *         new dense copy; AURA_NULL if `t` is not a tensor.
+ * @complexity O(1) or O(elements)
+ */
+AuraValue auraTensorContiguous(AuraValue t) {
+    if (!AURA_IS_TENSOR(t)) {
+        fprintf(stderr, "[Security] Tensor contiguous expects a tensor.\n");
+        return createNULL();
+    }
+    AuraTensor* in = AURA_AS_TENSOR(t);
+    if (in->base == NULL) return auraTensorRetain(t);
+
+    int shape[AURA_TENSOR_MAX_DIMS];
+    for (int d = 0; d < in->ndim; d++) shape[d] = (int)in->shape[d];
+    AuraValue result = createTENSORNDUninitialized(in->ndim, shape);
+    if (AURA_IS_NULL(result)) return createNULL();
+    AuraTensor* out = AURA_AS_TENSOR(result);
+
+    if (in->ndim == 2 && !AURA_TENSOR_ROWS_CONTIGUOUS(in)) {
+        // OPTIMIZATION: Walk square tiles so both the strided reads and the
+        // contiguous writes stay within a few cache lines per tile.
+        for (size_t r0 = 0; r0 < in->rows; r0 += TRANSPOSE_TILE) {
+            size_t r1 = r0 + TRANSPOSE_TILE < in->rows ? r0 + TRANSPOSE_TILE : in->rows;
+            for (size_t c0 = 0; c0 < in->cols; c0 += TRANSPOSE_TILE) {
+                size_t c1 = c0 + TRANSPOSE_TILE < in->cols ? c0 + TRANSPOSE_TILE : in->cols;
+                for (size_t r = r0; r < r1; r++) {
+                    for (size_t c = c0; c < c1; c++) AURA_TENSOR_AT(out, r, c) = AURA_TENSOR_AT(in, r, c);
+                }
+            }
+        }
+        return result;
+    }
+
+    for (size_t r = 0; r < in->rows; r++) {
+        const float* src = auraTensorRowPointer(in, r);
+        float* dst = AURA_TENSOR_ROW(out, r);
+        if (AURA_TENSOR_ROWS_CONTIGUOUS(in)) {
+            memcpy(dst, src, in->cols * sizeof(float));
+        } else {
+            for (size_t c = 0; c < in->cols; c++) dst[c] = src[c * in->colStride];
+        }
+    }
+    return result;
+}
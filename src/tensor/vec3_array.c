@@ -0,0 +1,366 @@
+/**
+ * @file vec3_array.c
+ * @brief Storage of Vec3 arrays and their batched operations.
+ *
+ * Every operation is one pass over the component arrays. The elementwise ones
+ * (add, sub, scale) reuse the binary tensor kernels once per component; dot,
+ * cross, length and normalize have kernels of their own that keep all three
+ * components of VW elements in registers.
+ */
+
+#include "vec3_array.h"
+#include "kernels.h"
+#include "thread_pool.h"
+#include <limits.h>
+
+#define BLOCK 1024                                      // Elements per kernel call.
+#define PARALLEL_GRAIN (AURA_PARALLEL_MIN_ELEMENTS / 4) // Elements per thread pool chunk.
+
+/**
+ * Allocates a zero-filled Vec3 array: the header, then the x, y and z arrays,
+ * each aligned to a cache line.
+ */
+static AuraVec3Array* allocateArray(size_t length) {
+    if (length == 0 || length > INT_MAX) {
+        fprintf(stderr, "[Security] Invalid Vec3Array length %zu.\n", length);
+        return NULL;
+    }
+    size_t capacity = (length + AURA_TENSOR_ROW_FLOATS - 1) & ~(AURA_TENSOR_ROW_FLOATS - 1);
+    size_t header = sizeof(AuraVec3Array) + AURA_TENSOR_ALIGNMENT - 1;
+    if (capacity > (SIZE_MAX - header) / (3 * sizeof(float))) {
+        fprintf(stderr, "[Security] Vec3Array size overflow detected.\n");
+        return NULL;
+    }
+
+    AuraVec3Array* array = (AuraVec3Array*)auraAllocateObject(header + 3 * capacity * sizeof(float),
+                                                               AURA_VEC3_ARRAY);
+    if (array == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory while creating a Vec3Array.\n");
+        return NULL;
+    }
+    uintptr_t payload = (uintptr_t)array + sizeof(AuraVec3Array);
+    payload = (payload + AURA_TENSOR_ALIGNMENT - 1) & ~(uintptr_t)(AURA_TENSOR_ALIGNMENT - 1);
+    array->length = length;
+    array->capacity = capacity;
+    array->x = (float*)payload;
+    array->y = array->x + capacity;
+    array->z = array->y + capacity;
+    return array;
+}
+
+// --- CONSTRUCTION ---
+
+/**
+ * Creates a Vec3 array of `length` zero vectors.
+ *
+ * @param length Number of vectors (1..INT_MAX).
+ * @return A new AURA_VEC3_ARRAY value, or AURA_NULL on invalid arguments.
+ * @complexity O(length)
+ */
+AuraValue auraVec3ArrayCreate(size_t length) {
+    AuraVec3Array* array = allocateArray(length);
+    return array == NULL ? createNULL() : AURA_OBJ_VAL(array);
+}
+
+/**
+ * Creates a Vec3 array from the rows of an n x 3 tensor.
+ *
+ * @param t A 2-D float32 tensor with 3 columns.
+ * @return A new Vec3 array, or AURA_NULL on invalid arguments.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayFromTensor(AuraValue t) {
+    if (!AURA_IS_TENSOR(t) || AURA_AS_TENSOR(t)->ndim != 2 || AURA_AS_TENSOR(t)->cols != 3) {
+        fprintf(stderr, "[Security] Vec3Array conversion expects an n x 3 tensor.\n");
+        return createNULL();
+    }
+    const AuraTensor* in = AURA_AS_TENSOR(t);
+    if (!auraTensorRequireF32(in, "Vec3Array conversion")) return createNULL();
+
+    AuraVec3Array* array = allocateArray(in->rows);
+    if (array == NULL) return createNULL();
+    for (size_t i = 0; i < in->rows; i++) {
+        array->x[i] = AURA_TENSOR_AT(in, i, 0);
+        array->y[i] = AURA_TENSOR_AT(in, i, 1);
+        array->z[i] = AURA_TENSOR_AT(in, i, 2);
+    }
+    return AURA_OBJ_VAL(array);
+}
+
+/**
+ * Copies a Vec3 array into a new n x 3 tensor.
+ *
+ * @param a A value of type AURA_VEC3_ARRAY.
+ * @return The tensor, or AURA_NULL on invalid arguments.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayToTensor(AuraValue a) {
+    if (!AURA_IS_VEC3_ARRAY(a)) {
+        fprintf(stderr, "[Security] Tensor conversion expects a Vec3Array.\n");
+        return createNULL();
+    }
+    const AuraVec3Array* array = AURA_AS_VEC3_ARRAY(a);
+    int shape[2] = { (int)array->length, 3 };
+    AuraValue result = createTENSORNDUninitialized(2, shape);
+    if (AURA_IS_NULL(result)) return result;
+
+    AuraTensor* out = AURA_AS_TENSOR(result);
+    for (size_t i = 0; i < array->length; i++) {
+        float* row = AURA_TENSOR_ROW(out, i);
+        row[0] = array->x[i];
+        row[1] = array->y[i];
+        row[2] = array->z[i];
+    }
+    return result;
+}
+
+/**
+ * Returns element `index` of a Vec3 array as a Vec3 value.
+ *
+ * @return The vector, or AURA_NULL if `index` is out of range.
+ * @complexity O(1)
+ */
+AuraValue auraVec3ArrayGet(AuraValue a, size_t index) {
+    if (!AURA_IS_VEC3_ARRAY(a) || index >= AURA_AS_VEC3_ARRAY(a)->length) {
+        fprintf(stderr, "[Security] Vec3Array index %zu out of range.\n", index);
+        return createNULL();
+    }
+    const AuraVec3Array* array = AURA_AS_VEC3_ARRAY(a);
+    return createVEC3(array->x[index], array->y[index], array->z[index]);
+}
+
+/**
+ * Stores a Vec3 value into element `index` of a Vec3 array.
+ *
+ * @return true on success.
+ * @complexity O(1)
+ */
+bool auraVec3ArraySet(AuraValue a, size_t index, AuraValue v) {
+    if (!AURA_IS_VEC3_ARRAY(a) || !AURA_IS_VEC3(v)) {
+        fprintf(stderr, "[Security] Vec3Array store expects a Vec3Array and a Vec3.\n");
+        return false;
+    }
+    AuraVec3Array* array = AURA_AS_VEC3_ARRAY(a);
+    if (index >= array->length) {
+        fprintf(stderr, "[Security] Vec3Array index %zu out of range (length %zu).\n", index, array->length);
+        return false;
+    }
+    AuraVec3 vec = auraAsVec3(v);
+    array->x[index] = vec.x;
+    array->y[index] = vec.y;
+    array->z[index] = vec.z;
+    return true;
+}
+
+// --- BATCHED OPERATIONS ---
+
+typedef enum {
+    OP_ADD,
+    OP_SUB,
+    OP_SCALE,
+    OP_DOT,
+    OP_CROSS,
+    OP_LENGTH,
+    OP_NORMALIZE
+} Vec3Op;
+
+typedef struct {
+    const AuraKernelTable* kernels;
+    Vec3Op op;
+    AuraVec3In a;
+    AuraVec3In b;                 // The second array, unless `broadcast` is set.
+    bool broadcast;               // The second operand is the single vector `constant`.
+    AuraVec3 constant;
+    float scale;
+    AuraVec3Out out;              // Vec3 results.
+    float* scalars;               // Dot and length results.
+} Vec3Job;
+
+static AuraVec3In offsetIn(AuraVec3In a, size_t i) {
+    AuraVec3In shifted = { a.x + i, a.y + i, a.z + i };
+    return shifted;
+}
+
+static AuraVec3Out offsetOut(AuraVec3Out a, size_t i) {
+    AuraVec3Out shifted = { a.x + i, a.y + i, a.z + i };
+    return shifted;
+}
+
+/**
+ * Thread pool task: elements [begin, end) of a batched operation, BLOCK at a
+ * time. A broadcast operand is expanded once into a block of copies, so the
+ * kernels only ever see arrays.
+ */
+static void vec3Task(void* context, size_t begin, size_t end) {
+    const Vec3Job* job = (const Vec3Job*)context;
+    const AuraKernelTable* kernels = job->kernels;
+    float constant[3][BLOCK];
+    if (job->broadcast) {
+        for (size_t i = 0; i < BLOCK; i++) {
+            constant[0][i] = job->constant.x;
+            constant[1][i] = job->constant.y;
+            constant[2][i] = job->constant.z;
+        }
+    }
+
+    for (size_t i = begin; i < end; i += BLOCK) {
+        size_t n = end - i < BLOCK ? end - i : BLOCK;
+        AuraVec3In a = offsetIn(job->a, i);
+        AuraVec3In b = job->broadcast ? (AuraVec3In){ constant[0], constant[1], constant[2] } : offsetIn(job->b, i);
+        AuraVec3Out out = offsetOut(job->out, i);
+        switch (job->op) {
+        case OP_ADD:
+        case OP_SUB: {
+            AuraBinaryKernel kernel = kernels->binary[job->op == OP_ADD ? AURA_TENSOR_ADD : AURA_TENSOR_SUB];
+            kernel(out.x, a.x, b.x, n);
+            kernel(out.y, a.y, b.y, n);
+            kernel(out.z, a.z, b.z, n);
+            break;
+        }
+        case OP_SCALE:
+            kernels->binaryScalar[AURA_TENSOR_MUL](out.x, a.x, job->scale, n);
+            kernels->binaryScalar[AURA_TENSOR_MUL](out.y, a.y, job->scale, n);
+            kernels->binaryScalar[AURA_TENSOR_MUL](out.z, a.z, job->scale, n);
+            break;
+        case OP_DOT:
+            kernels->vec3Dot(job->scalars + i, a, b, n);
+            break;
+        case OP_CROSS:
+            kernels->vec3Cross(out, a, b, n);
+            break;
+        case OP_LENGTH:
+            kernels->vec3Length(job->scalars + i, a, n);
+            break;
+        case OP_NORMALIZE:
+            kernels->vec3Normalize(out, a, n);
+            break;
+        }
+    }
+}
+
+static AuraVec3In arrayIn(const AuraVec3Array* array) {
+    AuraVec3In in = { array->x, array->y, array->z };
+    return in;
+}
+
+/**
+ * Validates the operands of a batched operation, allocates its result (a Vec3
+ * array, or a 1-D tensor for dot and length) and runs it.
+ *
+ * @param name Operation name for diagnostics.
+ * @param b Second operand: a Vec3 array of the same length or a Vec3, or
+ *          AURA_UNDEFINED for unary operations.
+ */
+static AuraValue runVec3Op(Vec3Op op, const char* name, AuraValue a, AuraValue b, float scale) {
+    bool binary = op == OP_ADD || op == OP_SUB || op == OP_DOT || op == OP_CROSS;
+    if (!AURA_IS_VEC3_ARRAY(a) ||
+        (binary && !AURA_IS_VEC3_ARRAY(b) && !AURA_IS_VEC3(b))) {
+        fprintf(stderr, binary ? "[Security] Vec3Array %s expects a Vec3Array and a Vec3Array or Vec3.\n"
+                               : "[Security] Vec3Array %s expects a Vec3Array.\n", name);
+        return createNULL();
+    }
+    const AuraVec3Array* array = AURA_AS_VEC3_ARRAY(a);
+    Vec3Job job;
+    memset(&job, 0, sizeof(job));
+    job.kernels = auraActiveKernels();
+    job.op = op;
+    job.a = arrayIn(array);
+    job.scale = scale;
+    if (binary && AURA_IS_VEC3_ARRAY(b)) {
+        if (AURA_AS_VEC3_ARRAY(b)->length != array->length) {
+            fprintf(stderr, "[Security] Vec3Array length mismatch in %s: %zu vs %zu.\n", name, array->length,
+                    AURA_AS_VEC3_ARRAY(b)->length);
+            return createNULL();
+        }
+        job.b = arrayIn(AURA_AS_VEC3_ARRAY(b));
+    } else if (binary) {
+        job.broadcast = true;
+        job.constant = auraAsVec3(b);
+    }
+
+    AuraValue result;
+    if (op == OP_DOT || op == OP_LENGTH) {
+        int shape[1] = { (int)array->length };
+        result = createTENSORNDUninitialized(1, shape);
+        if (AURA_IS_NULL(result)) return result;
+        job.scalars = AURA_AS_TENSOR(result)->data;
+    } else {
+        AuraVec3Array* out = allocateArray(array->length);
+        if (out == NULL) return createNULL();
+        AuraVec3Out components = { out->x, out->y, out->z };
+        job.out = components;
+        result = AURA_OBJ_VAL(out);
+    }
+    auraParallelFor(array->length, PARALLEL_GRAIN, vec3Task, &job);
+    return result;
+}
+
+/**
+ * Adds `b` (a Vec3 array or a Vec3) to every element of `a`.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayAdd(AuraValue a, AuraValue b) {
+    return runVec3Op(OP_ADD, "add", a, b, 0.0f);
+}
+
+/**
+ * Subtracts `b` (a Vec3 array or a Vec3) from every element of `a`.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArraySub(AuraValue a, AuraValue b) {
+    return runVec3Op(OP_SUB, "sub", a, b, 0.0f);
+}
+
+/**
+ * Multiplies every element of `a` by `s`.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayScale(AuraValue a, float s) {
+    return runVec3Op(OP_SCALE, "scale", a, createUNDEFINED(), s);
+}
+
+/**
+ * Dot product of each element of `a` with `b` (a Vec3 array or a Vec3).
+ *
+ * @return A new 1-D tensor, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayDot(AuraValue a, AuraValue b) {
+    return runVec3Op(OP_DOT, "dot", a, b, 0.0f);
+}
+
+/**
+ * Cross product of each element of `a` with `b` (a Vec3 array or a Vec3).
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayCross(AuraValue a, AuraValue b) {
+    return runVec3Op(OP_CROSS, "cross", a, b, 0.0f);
+}
+
+/**
+ * Euclidean length of each element of `a`.
+ *
+ * @return A new 1-D tensor, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayLength(AuraValue a) {
+    return runVec3Op(OP_LENGTH, "length", a, createUNDEFINED(), 0.0f);
+}
+
+/**
+ * Scales each element of `a` to unit length; zero vectors stay zero.
+ *
+ * @return A new Vec3 array, or AURA_NULL on invalid operands.
+ * @complexity O(n)
+ */
+AuraValue auraVec3ArrayNormalize(AuraValue a) {
+    return runVec3Op(OP_NORMALIZE, "normalize", a, createUNDEFINED(), 0.0f);
+}
@@ -7,10 +7,87 @@
  */
 
 #include "value.h"
+#include "aura_string.h"
+#include "bigint.h"
+#include "slab.h"
+#include "tensor_pool.h"
 #include <stdint.h>
+#include <math.h>
 
 // --- AUXILIARY CREATION FUNCTIONS ---
 
+/**
+ * Allocates a heap object of the given size and stamps its type header.
+ *
+ * OPTIMIZATION: Objects of up to AURA_SLAB_MAX_SIZE bytes come from the
+ * thread-caching slab allocator, whose fast path is a thread-local list pop.
+ * The size class is recorded in the header so `auraFreeObject` can return the
+ * object without a lookup.
+ *
+ * @param size Total size of the object structure in bytes.
+ * @param type The AuraType stored in the object header.
+ * @return Pointer to the zero-initialized object, or NULL if allocation fails.
+ * @complexity O(size) due to zero-initialization.
+ */
+AuraObj* auraAllocateObject(size_t size, AuraType type) {
+    AuraObj* obj;
+#ifdef AURA_SLAB
+    int sizeClass = auraSlabClassOf(size);
+    if (sizeClass >= 0) {
+        obj = (AuraObj*)auraSlabAllocClass(sizeClass);
+        if (obj == NULL) return NULL;
+        memset(obj, 0, size);
+        obj->sizeClass = (uint8_t)(sizeClass + 1);
+    } else
+#endif
+    {
+        obj = (AuraObj*)calloc(1, size);
+        if (obj == NULL) return NULL;
+    }
+    obj->type = (uint8_t)type;
+    return obj;
+}
+
+/**
+ * Allocates a heap object inside an arena, or on the heap if `arena` is NULL.
+ *
+ * Arena objects are flagged with AURA_OBJ_ARENA so that releasing them is a
+ * no-op; their memory comes back when the arena is reset.
+ *
+ * @param arena The arena to allocate from, or NULL.
+ * @param size Total size of the object structure in bytes.
+ * @param type The AuraType stored in the object header.
+ * @return Pointer to the zero-initialized object, or NULL if allocation fails.
+ * @complexity O(size) for the zero-initialization, O(1) for the allocation itself.
+ */
+AuraObj* auraAllocateObjectInArena(AuraArena* arena, size_t size, AuraType type) {
+    if (arena == NULL) return auraAllocateObject(size, type);
+
+    AuraObj* obj = (AuraObj*)auraArenaAlloc(arena, size);
+    if (obj == NULL) return NULL;
+    memset(obj, 0, size);
+    obj->type = (uint8_t)type;
+    obj->flags = AURA_OBJ_ARENA;
+    return obj;
+}
+
+/**
+ * Returns the memory of a heap object to its allocator.
+ *
+ * @param obj The object (arena objects are ignored).
+ * @complexity O(1)
+ */
+void auraFreeObject(AuraObj* obj) {
+    if (obj->flags & AURA_OBJ_ARENA) return;
+#ifdef AURA_SLAB
+    if (obj->sizeClass != 0) {
+        auraSlabFreeClass(obj, obj->sizeClass - 1);
+        return;
+    }
+#endif
+    free(obj);
+}
+
 /**
  * Creates a AuraValue representing 'undefined'.
  *
@@ -18,9 +95,7 @@
  * @complexity O(1)
  */
 AuraValue createUNDEFINED() {
-    AuraValue v;
-    v.type = AURA_UNDEFINED;
-    return v;
+    return AURA_UNDEFINED_VAL;
 }
 
 /**
@@ -30,9 +105,7 @@ AuraValue createUNDEFINED() {
  * @complexity O(1)
  */
 AuraValue createNULL() {
-    AuraValue v;
-    v.type = AURA_NULL;
-    return v;
+    return AURA_NULL_VAL;
 }
 
 /**
@@ -43,64 +116,83 @@ AuraValue createNULL() {
  * @complexity O(1)
  */
 AuraValue createBOOLEAN(int val) {
-    AuraValue v;
-    v.type = AURA_BOOLEAN;
-   v.as.boolean = val;
-    return v;
+    return AURA_BOOL_VAL(val);
 }
 
 /**
  * Creates a AuraValue representing a number.
  *
+ * Under NaN-boxing the double is stored as-is (NaNs are canonicalized).
+ *
  * @param val The double precision floating point value.
  * @return A AuraValue with type AURA_NUMBER.
  * @complexity O(1)
  */
 AuraValue createNUMBER(double val) {
-    AuraValue v;
-    v.type = AURA_NUMBER;
-    v.as.number = val;
-    return v;
+    return AURA_NUMBER_VAL(val);
+}
+
+/**
+ * Creates a AuraValue representing a small integer.
+ *
+ * The value reports AURA_NUMBER as its type but stays in integer form, so that
+ * indices, counters and bitwise operations avoid int<->double conversions.
+ *
+ * @param val The 32-bit integer value.
+ * @return A AuraValue with type AURA_NUMBER (small int representation).
+ * @complexity O(1)
+ */
+AuraValue createINT(int32_t val) {
+    return AURA_INT_VAL(val);
 }
 
 /**
  * Creates a AuraValue representing a string.
  *
- * Duplicates the input string using `strdup` and performs robust error checking.
+ * Copies the input string. Short strings are stored inline in the value without
+ * any allocation; longer ones get a single length-prefixed heap block (see aura_string.h).
  *
  * @param val The C-string to wrap.
  * @return A AuraValue with type AURA_STRING.
  * @complexity O(N) where N is the length of the string.
  */
 AuraValue createSTRING(char* val) {
-    AuraValue v;
     if (val == NULL) {
         return createNULL();
     }
 
-    v.type = AURA_STRING;
-    v.as.string = strdup(val);
-    
-    if (v.as.string == NULL) {
-        fprintf(stderr, "[Fatal Error] Out of memory in createSTRING.\n");
+    return auraCopyString(val, strlen(val));
+}
+
+/**
+ * Creates a string whose heap block (if any) is carved out of an arena.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param val The C-string to wrap.
+ * @return A AuraValue with type AURA_STRING.
+ * @complexity O(N) where N is the length of the string.
+ */
+AuraValue createSTRINGInArena(AuraArena* arena, char* val) {
+    if (val == NULL) {
         return createNULL();
     }
 
-    return v;
+    return auraCopyStringInArena(arena, val, strlen(val));
 }
 
 /**
  * Creates a AuraValue representing a BigInt.
  *
+ * BigInts have arbitrary precision (see bigint.h); this is the constructor for
+ * values known to fit in 64 bits. It only allocates outside the inline range
+ * [AURA_SBIG_MIN, AURA_SBIG_MAX].
+ *
  * @param val The long long integer value.
  * @return A AuraValue with type AURA_BIGINT.
  * @complexity O(1)
  */
 AuraValue createBIGINT(long long val) {
-    AuraValue v;
-    v.type = AURA_BIGINT;
-    v.as.bigint = val;
-    return v;
+    return auraBigIntFromInt64(val);
 }
 
 /**
@@ -113,18 +205,40 @@ AuraValue createBIGINT(long long val) {
  * @complexity O(1)
  */
 AuraValue createVEC3(float x, float y, float z) {
-    AuraValue v;
-    v.type = AURA_VEC3;
-    v.as.vec3.x = x;
-    v.as.vec3.y = y;
-    v.as.vec3.z = z;
+    AuraVec3 vec = { x, y, z, 0.0f };
+    return createVEC3FromRaw(vec);
+}
+
+/**
+ * Creates a Vec3 value from a vector computed by the native operations.
+ *
+ * Under NaN-boxing the 16-byte vector does not fit into the value and is boxed.
+ *
+ * @param vec The vector (`w` must be 0).
+ * @return A AuraValue with type AURA_VEC3.
+ * @complexity O(1)
+ */
+AuraValue createVEC3FromRaw(AuraVec3 vec) {
+#ifdef AURA_NAN_BOXING
+    AuraVec3Box* box = (AuraVec3Box*)auraAllocateObject(sizeof(AuraVec3Box), AURA_VEC3);
+    if (box == NULL) {
+        fprintf(stderr, "[Fatal Error] Out of memory in createVEC3.\n");
+        return createNULL();
+    }
+    box->vec = vec;
+    return AURA_OBJ_VAL(box);
+#else
+    AuraValue v = auraMakeValue(AURA_TAG_VEC3);
+    v.as.vec3 = vec;
     return v;
+#endif
 }
 
 /**
  * Creates a AuraValue representing a Tensor.
  *
  * Allocates a contiguous memory block for both the tensor metadata and its data payload.
+ * The payload is 64-byte aligned and rows are padded to whole cache lines (see AuraTensor).
  * Includes rigorous security checks against integer overflows during size calculation.
  *
  * @param rows Number of rows.
@@ -133,40 +247,325 @@ AuraValue createVEC3(float x, float y, float z) {
  * @complexity O(rows * cols) due to `calloc` zero-initialization.
  */
 AuraValue createTENSOR(int rows, int cols) {
-    if (rows <= 0 || cols <= 0) {
-        fprintf(stderr, "[Security] Invalid tensor dimensions.\n");
+    return createTENSORInArena(NULL, rows, cols);
+}
+
+/**
+ * Creates a zero-filled tensor with `ndim` dimensions.
+ *
+ * @param ndim Number of dimensions (1..AURA_TENSOR_MAX_DIMS).
+ * @param shape Size of each dimension, outermost first.
+ * @return A AuraValue with type AURA_TENSOR, or AURA_NULL on failure.
+ * @complexity O(elements) due to zero-initialization.
+ */
+AuraValue createTENSORND(int ndim, const int* shape) {
+    return createTENSORNDInArena(NULL, ndim, shape);
+}
+
+/**
+ * Allocates the single block holding a tensor header and payload.
+ *
+ * OPTIMIZATION: Heap tensors too large for the slab come from the tensor pool,
+ * which recycles the storage of freed tensors. Unless `zeroFill` is set only
+ * the header of a pooled block is cleared.
+ */
+static AuraTensor* allocateTensor(AuraArena* arena, size_t size, bool zeroFill) {
+#ifdef AURA_TENSOR_POOL
+    int bucket = arena == NULL && size > AURA_SLAB_MAX_SIZE ? auraTensorPoolBucketOf(size) : -1;
+    if (bucket >= 0) {
+        AuraTensor* tensor = (AuraTensor*)auraTensorPoolAlloc(bucket, size, zeroFill);
+        if (tensor == NULL) return NULL;
+        if (!zeroFill) memset(tensor, 0, sizeof(AuraTensor));
+        tensor->obj.type = AURA_TENSOR;
+        tensor->poolBucket = (uint8_t)(bucket + 1);
+        return tensor;
+    }
+#else
+    (void)zeroFill;
+#endif
+    return (AuraTensor*)auraAllocateObjectInArena(arena, size, AURA_TENSOR);
+}
+
+static AuraValue createTensor(AuraArena* arena, AuraDType dtype, int ndim, const int* shape, bool zeroFill);
+
+/**
+ * Creates an N-D tensor whose elements are left unspecified.
+ *
+ * For results that are about to be overwritten in full: only the row padding
+ * is guaranteed to be zero, which skips a pass over recycled storage.
+ *
+ * @param ndim Number of dimensions (1..AURA_TENSOR_MAX_DIMS).
+ * @param shape Size of each dimension, outermost first.
+ * @return A AuraValue with type AURA_TENSOR, or AURA_NULL on failure.
+ * @complexity O(rows) for the padding, O(1) otherwise.
+ */
+AuraValue createTENSORNDUninitialized(int ndim, const int* shape) {
+    return createTensor(NULL, AURA_DTYPE_F32, ndim, shape, false);
+}
+
+/**
+ * Creates a tensor whose storage is carved out of an arena.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @return A AuraValue with type AURA_TENSOR, or AURA_NULL on failure.
+ * @complexity O(rows * cols) for the zero-initialization.
+ */
+AuraValue createTENSORInArena(AuraArena* arena, int rows, int cols) {
+    int shape[2] = { rows, cols };
+    return createTENSORNDInArena(arena, 2, shape);
+}
+
+/**
+ * Derives the cached matrix view (`rows`, `cols`, `stride`, `colStride`,
+ * `uniformRows`) of a tensor from its shape and strides.
+ *
+ * Rows are uniform when every leading dimension steps by the size of the
+ * dimensions inside it, i.e. they collapse into one dimension of stride
+ * `stride`. Dimensions of size 1 never break this, whatever their stride.
+ *
+ * @param tensor The tensor whose `ndim`, `shape` and `strides` are set.
+ * @complexity O(ndim)
+ */
+void auraTensorUpdateLayout(AuraTensor* tensor) {
+    int last = tensor->ndim - 1;
+    tensor->cols = tensor->shape[last];
+    tensor->colStride = tensor->strides[last];
+    tensor->rows = 1;
+    tensor->uniformRows = true;
+
+    // The innermost leading dimension that actually steps sets the row stride.
+    bool found = false;
+    size_t expected = 0;
+    for (int d = last - 1; d >= 0; d--) {
+        tensor->rows *= tensor->shape[d];
+        if (tensor->shape[d] == 1) continue;
+        if (!found) {
+            found = true;
+            tensor->stride = tensor->strides[d];
+            expected = tensor->strides[d] * tensor->shape[d];
+        } else {
+            if (tensor->strides[d] != expected) tensor->uniformRows = false;
+            expected = tensor->strides[d] * tensor->shape[d];
+        }
+    }
+    if (!found) tensor->stride = last > 0 ? tensor->strides[last - 1] : tensor->shape[last];
+}
+
+/**
+ * Creates a zero-filled N-D tensor whose storage is carved out of an arena.
+ *
+ * @param arena The arena to allocate from, or NULL for the heap.
+ * @param ndim Number of dimensions (1..AURA_TENSOR_MAX_DIMS).
+ * @param shape Size of each dimension, outermost first.
+ * @return A AuraValue with type AURA_TENSOR, or AURA_NULL on failure.
+ * @complexity O(elements) for the zero-initialization.
+ */
+AuraValue createTENSORNDInArena(AuraArena* arena, int ndim, const int* shape) {
+    return createTensor(arena, AURA_DTYPE_F32, ndim, shape, true);
+}
+
+/**
+ * Creates a zero-filled N-D tensor with elements of the given type.
+ *
+ * @param dtype The element type.
+ * @param ndim Number of dimensions (1..AURA_TENSOR_MAX_DIMS).
+ * @param shape Size of each dimension, outermost first.
+ * @return A AuraValue with type AURA_TENSOR, or AURA_NULL on failure.
+ * @complexity O(elements) for the zero-initialization.
+ */
+AuraValue createTENSORNDTyped(AuraDType dtype, int ndim, const int* shape) {
+    if (dtype < 0 || dtype >= AURA_DTYPE_COUNT) {
+        fprintf(stderr, "[Security] Invalid tensor dtype %d.\n", (int)dtype);
         return createNULL();
     }
+    return createTensor(NULL, dtype, ndim, shape, true);
+}
 
-    if (cols > 0 && (size_t)rows > SIZE_MAX / (size_t)cols) {
-         fprintf(stderr, "[Security] Tensor size overflow detected.\n");
-         return createNULL();
+/**
+ * Creates an N-D tensor, zero-filled or with only its padding cleared.
+ *
+ * Only the last dimension is padded to whole cache lines, so the payload is
+ * `product(leading dimensions) * padded(last dimension)` elements, followed
+ * for int8 tensors by one float scale and one int32 sum per row.
+ */
+static AuraValue createTensor(AuraArena* arena, AuraDType dtype, int ndim, const int* shape, bool zeroFill) {
+    if (ndim < 1 || ndim > AURA_TENSOR_MAX_DIMS) {
+        fprintf(stderr, "[Security] Invalid tensor rank %d.\n", ndim);
+        return createNULL();
+    }
+    for (int d = 0; d < ndim; d++) {
+        if (shape[d] <= 0) {
+            fprintf(stderr, "[Security] Invalid tensor dimensions.\n");
+            return createNULL();
+        }
     }
-    size_t total_elements = (size_t)rows * (size_t)cols;
 
-    if (total_elements > SIZE_MAX / sizeof(float)) {
+    // Round each row up to whole cache lines (cols <= INT_MAX, so this cannot overflow).
+    size_t elementSize = auraDTypeSize(dtype);
+    size_t rowElements = AURA_TENSOR_ALIGNMENT / elementSize;
+    size_t cols = (size_t)shape[ndim - 1];
+    size_t stride = (cols + rowElements - 1) & ~(rowElements - 1);
+
+    size_t total_elements = stride;
+    size_t rows = 1;
+    for (int d = ndim - 2; d >= 0; d--) {
+        if ((size_t)shape[d] > SIZE_MAX / total_elements) {
+            fprintf(stderr, "[Security] Tensor size overflow detected.\n");
+            return createNULL();
+        }
+        total_elements *= (size_t)shape[d];
+        rows *= (size_t)shape[d];
+    }
+
+    if (total_elements > SIZE_MAX / elementSize) {
         fprintf(stderr, "[Security] Tensor allocation size overflow (multiplication).\n");
         return createNULL();
     }
+    size_t payloadBytes = total_elements * elementSize;
+    size_t scaleBytes = dtype == AURA_DTYPE_I8 ? rows * (sizeof(float) + sizeof(int32_t)) : 0;
 
-    if (SIZE_MAX - sizeof(AuraTensor) < total_elements * sizeof(float)) {
+    // Worst-case slack needed to move the payload up to the next aligned address.
+    size_t header = sizeof(AuraTensor) + AURA_TENSOR_ALIGNMENT - 1;
+    if (SIZE_MAX - header - scaleBytes < payloadBytes) {
         fprintf(stderr, "[Security] Tensor allocation size overflow (addition).\n");
         return createNULL();
     }
 
-    AuraValue v;
-    v.type = AURA_TENSOR;
-    
-    v.as.tensor = (AuraTensor*)calloc(1, sizeof(AuraTensor) + (sizeof(float) * total_elements));
+    AuraTensor* tensor = allocateTensor(arena, header + payloadBytes + scaleBytes, zeroFill);
 
-    if (v.as.tensor == NULL) {
+    if (tensor == NULL) {
         fprintf(stderr, "[Fatal Error] Out of memory in createTENSOR.\n");
         return createNULL();
     }
-    
-    v.as.tensor->rows = (size_t)rows;
-    v.as.tensor->cols = (size_t)cols;
-    return v;
+
+    uintptr_t payload = (uintptr_t)tensor + sizeof(AuraTensor);
+    payload = (payload + AURA_TENSOR_ALIGNMENT - 1) & ~(uintptr_t)(AURA_TENSOR_ALIGNMENT - 1);
+
+    tensor->ndim = (uint8_t)ndim;
+    tensor->dtype = (uint8_t)dtype;
+    tensor->refs = 1;
+    tensor->data = (float*)payload;
+    tensor->scales = scaleBytes != 0 ? (float*)(payload + payloadBytes) : NULL;
+    tensor->rowSums = scaleBytes != 0 ? (int32_t*)(tensor->scales + rows) : NULL;
+    tensor->base = NULL;
+
+    if (!zeroFill && stride > cols) {
+        for (size_t r = 0; r < rows; r++) {
+            memset((char*)payload + (r * stride + cols) * elementSize, 0, (stride - cols) * elementSize);
+        }
+    }
+
+    size_t step = stride;
+    tensor->shape[ndim - 1] = cols;
+    tensor->strides[ndim - 1] = 1;
+    for (int d = ndim - 2; d >= 0; d--) {
+        tensor->shape[d] = (size_t)shape[d];
+        tensor->strides[d] = step;
+        step *= (size_t)shape[d];
+    }
+    auraTensorUpdateLayout(tensor);
+    return AURA_OBJ_VAL(tensor);
+}
+
+// --- INSPECTION ---
+
+/**
+ * Returns the language-level type of a value, independent of its representation.
+ *
+ * @param v The value to inspect.
+ * @return The AuraType of the value.
+ * @complexity O(1)
+ */
+AuraType auraTypeOf(AuraValue v) {
+    switch (AURA_TAG(v)) {
+    case AURA_TAG_OBJ:       return AURA_OBJ_TYPE(v);
+    case AURA_TAG_UNDEFINED: return AURA_UNDEFINED;
+    case AURA_TAG_NULL:      return AURA_NULL;
+    case AURA_TAG_BOOL:      return AURA_BOOLEAN;
+    case AURA_TAG_INT:       return AURA_NUMBER;
+    case AURA_TAG_SSTR:      return AURA_STRING;
+    case AURA_TAG_SBIG:      return AURA_BIGINT;
+    case AURA_TAG_NUMBER:    return AURA_NUMBER;
+    case AURA_TAG_VEC3:      return AURA_VEC3;
+    }
+    return AURA_UNDEFINED;
+}
+
+/**
+ * Extracts the low 64 bits of a BigInt as a signed integer, like
+ * `BigInt.asIntN(64, v)`: values outside the int64 range wrap around.
+ *
+ * @param v A value of type AURA_BIGINT.
+ * @return The wrapped integer.
+ * @complexity O(1)
+ */
+long long auraAsBigInt(AuraValue v) {
+    if (AURA_IS_SBIG(v)) return (long long)AURA_AS_SBIG(v);
+    const AuraBigInt* bigint = AURA_AS_BIGINT(v);
+    uint64_t low = bigint->length == 0 ? 0 : bigint->limbs[0];
+    return (long long)(bigint->negative ? 0 - low : low);
+}
+
+/**
+ * Converts a numeric value to a 32-bit integer using the JS `ToInt32` rules.
+ *
+ * Small ints are returned as-is. Doubles are truncated toward zero and wrapped
+ * modulo 2^32; NaN and infinities map to 0. Non-numeric values yield 0.
+ *
+ * @param v The value to convert.
+ * @return The wrapped 32-bit integer.
+ * @complexity O(1)
+ */
+int32_t auraToInt32(AuraValue v) {
+    if (AURA_IS_INT(v)) return AURA_AS_INT(v);
+    if (!AURA_IS_NUMBER(v)) return 0;
+
+    double num = AURA_AS_NUMBER(v);
+    if (num >= INT32_MIN && num <= INT32_MAX) return (int32_t)num;
+    if (!isfinite(num)) return 0;
+
+    double wrapped = fmod(trunc(num), 4294967296.0);
+    if (wrapped < 0) wrapped += 4294967296.0;
+    return (int32_t)(uint32_t)wrapped;
+}
+
+/**
+ * Strict equality (`===`) between two values.
+ *
+ * Numbers compare by value regardless of representation, strings by content and
+ * every other heap object by identity.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return true if the values are strictly equal.
+ * @complexity O(1), or O(N) for strings of length N.
+ */
+bool auraValuesEqual(AuraValue a, AuraValue b) {
+    if (AURA_IS_NUMERIC(a) && AURA_IS_NUMERIC(b)) return auraNumbersEqual(a, b);
+
+    AuraType type = auraTypeOf(a);
+    if (type != auraTypeOf(b)) return false;
+
+    switch (type) {
+    case AURA_UNDEFINED:
+    case AURA_NULL:
+        return true;
+    case AURA_BOOLEAN:
+        return AURA_AS_BOOL(a) == AURA_AS_BOOL(b);
+    case AURA_STRING:
+        return auraStringsEqual(a, b);
+    case AURA_BIGINT:
+        return auraBigIntCompare(a, b) == 0;
+    case AURA_VEC3: {
+        AuraVec3 va = auraAsVec3(a);
+        AuraVec3 vb = auraAsVec3(b);
+        return va.x == vb.x && va.y == vb.y && va.z == vb.z;
+    }
+    default:
+        return AURA_AS_OBJ(a) == AURA_AS_OBJ(b);
+    }
 }
 
 /**
@@ -177,7 +576,7 @@ AuraValue createTENSOR(int rows, int cols) {
  * @param v The value to print.
  */
 void printValue(AuraValue v) {
-    switch (v.type)
+    switch (auraTypeOf(v))
     {
     case AURA_UNDEFINED:
         printf("undefined");
@@ -186,22 +585,42 @@ void printValue(AuraValue v) {
         printf("null");
         break;
     case AURA_BOOLEAN:
-        printf(v.as.boolean ? "true" : "false");
+        printf(AURA_AS_BOOL(v) ? "true" : "false");
         break;
     case AURA_NUMBER:
-        printf("%g", v.as.number);
+        if (AURA_IS_INT(v)) {
+            printf("%d", (int)AURA_AS_INT(v));
+        } else {
+            printf("%g", AURA_AS_NUMBER(v));
+        }
         break;
     case AURA_STRING:
-        printf("'%s'", v.as.string);
+        printf("'%.*s'", (int)auraStringLength(v), auraStringData(&v));
         break;
     case AURA_BIGINT:
-        printf("%lldn", v.as.bigint);
+    {
+        AuraValue digits = auraBigIntToString(v);
+        printf("%.*sn", (int)auraStringLength(digits), auraStringData(&digits));
+        freeValue(digits);
         break;
-    case AURA_VEC3:
-        printf("Vec3(%g, %g, %g)", v.as.vec3.x, v.as.vec3.y, v.as.vec3.z);
+    }
+    case AURA_VEC3: {
+        AuraVec3 vec = auraAsVec3(v);
+        printf("Vec3(%g, %g, %g)", vec.x, vec.y, vec.z);
         break;
+    }
     case AURA_TENSOR:
-        printf("Tensor[%zux%zu]", v.as.tensor->rows, v.as.tensor->cols);
+        printf("Tensor[");
+        for (int d = 0; d < AURA_AS_TENSOR(v)->ndim; d++) printf("%s%zu", d == 0 ? "" : "x", AURA_AS_TENSOR(v)->shape[d]);
+        if (AURA_AS_TENSOR(v)->dtype != AURA_DTYPE_F32) printf(" %s", auraDTypeName((AuraDType)AURA_AS_TENSOR(v)->dtype));
+        printf("]");
+        break;
+    case AURA_SPARSE_TENSOR:
+        printf("SparseTensor[%zux%zu, %zu nonzeros]", AURA_AS_SPARSE(v)->rows, AURA_AS_SPARSE(v)->cols,
+               AURA_AS_SPARSE(v)->nnz);
+        break;
+    case AURA_VEC3_ARRAY:
+        printf("Vec3Array[%zu]", AURA_AS_VEC3_ARRAY(v)->length);
         break;
     case AURA_OBJECT:
         printf("[Object]");
@@ -219,19 +638,71 @@ void printValue(AuraValue v) {
     printf("\n");
 }
 
+/**
+ * Releases one reference to a tensor.
+ *
+ * A view holds a reference to the tensor owning its storage, so the owner's
+ * payload stays valid until its value and every view of it are released.
+ * Views always reference an owner directly, never another view.
+ *
+ * @param tensor The tensor to release.
+ * @complexity O(1)
+ */
+void auraFreeTensor(AuraTensor* tensor) {
+    if (tensor->obj.flags & AURA_OBJ_ARENA) return;
+    if (--tensor->refs > 0) return;
+
+    AuraTensor* base = tensor->base;
+    if (tensor->releaseStorage != NULL) tensor->releaseStorage(tensor->storageOwner);
+#ifdef AURA_TENSOR_POOL
+    if (tensor->poolBucket != 0) {
+        auraTensorPoolFree(tensor, tensor->poolBucket - 1);
+    } else
+#endif
+    {
+        auraFreeObject(&tensor->obj);
+    }
+    if (base != NULL) auraFreeTensor(base);
+}
+
+/**
+ * Frees a sparse tensor: its CSC form, if built, then the header and CSR form.
+ *
+ * @param sparse The tensor to free.
+ * @complexity O(1)
+ */
+void auraFreeSparseTensor(AuraSparseTensor* sparse) {
+    free(sparse->colStart);
+    auraFreeObject(&sparse->obj);
+}
+
 /**
  * Frees the memory allocated for a AuraValue.
  *
- * Handles manual garbage collection for dynamic types like String and Tensor.
- * Safe to call on primitive types (no-op).
+ * Handles manual garbage collection for heap objects like String and Tensor.
+ * Every heap layout is a single allocation; strings and tensors are reference
+ * counted and only freed once their last owner releases them. Safe to call on immediate values
+ * (including inline strings), where it is a no-op.
  *
  * @param v The value to free.
  */
 void freeValue(AuraValue v) {
-    if (v.type == AURA_STRING) {
-        free(v.as.string);
-    }
-    if (v.type == AURA_TENSOR) {
-        free(v.as.tensor);
+    if (!AURA_IS_OBJ(v)) return;
+
+    AuraObj* obj = AURA_AS_OBJ(v);
+    switch (obj->type) {
+    case AURA_STRING:
+    case AURA_SYMBOL:
+        auraFreeString((AuraStringHeader*)obj);
+        break;
+    case AURA_TENSOR:
+        auraFreeTensor((AuraTensor*)obj);
+        break;
+    case AURA_SPARSE_TENSOR:
+        auraFreeSparseTensor((AuraSparseTensor*)obj);
+        break;
+    default:
+        auraFreeObject(obj);
+        break;
     }
-}
\ No newline at end of file
+}
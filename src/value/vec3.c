@@ -0,0 +1,108 @@
+/**
+ * @file vec3.c
+ * @brief Value API of the native Vec3 operations.
+ *
+ * Each function checks its operands, runs the inline SSE operation of vec3.h
+ * and wraps the result. Under NaN-boxing wrapping a Vec3 result allocates its
+ * box (from the slab); numeric results never allocate.
+ */
+
+#include "vec3.h"
+
+/**
+ * Returns true if `a` and `b` are Vec3 values; otherwise prints a diagnostic
+ * naming `op` and returns false.
+ */
+static bool requireVec3(const char* op, AuraValue a, AuraValue b) {
+    if (AURA_IS_VEC3(a) && AURA_IS_VEC3(b)) return true;
+    fprintf(stderr, "[Security] Vec3 %s expects Vec3 operands.\n", op);
+    return false;
+}
+
+/**
+ * Adds two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Add(AuraValue a, AuraValue b) {
+    if (!requireVec3("add", a, b)) return createNULL();
+    return createVEC3FromRaw(auraVec3AddRaw(auraAsVec3(a), auraAsVec3(b)));
+}
+
+/**
+ * Subtracts two Vec3 values (a - b).
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Sub(AuraValue a, AuraValue b) {
+    if (!requireVec3("sub", a, b)) return createNULL();
+    return createVEC3FromRaw(auraVec3SubRaw(auraAsVec3(a), auraAsVec3(b)));
+}
+
+/**
+ * Multiplies a Vec3 by a scalar.
+ *
+ * @return A new Vec3, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Scale(AuraValue a, float s) {
+    if (!requireVec3("scale", a, a)) return createNULL();
+    return createVEC3FromRaw(auraVec3ScaleRaw(auraAsVec3(a), s));
+}
+
+/**
+ * Dot product of two Vec3 values.
+ *
+ * @return A number, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Dot(AuraValue a, AuraValue b) {
+    if (!requireVec3("dot", a, b)) return createNULL();
+    return createNUMBER(auraVec3DotRaw(auraAsVec3(a), auraAsVec3(b)));
+}
+
+/**
+ * Cross product a x b of two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Cross(AuraValue a, AuraValue b) {
+    if (!requireVec3("cross", a, b)) return createNULL();
+    return createVEC3FromRaw(auraVec3CrossRaw(auraAsVec3(a), auraAsVec3(b)));
+}
+
+/**
+ * Euclidean length of a Vec3.
+ *
+ * @return A number, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Length(AuraValue a) {
+    if (!requireVec3("length", a, a)) return createNULL();
+    return createNUMBER(auraVec3LengthRaw(auraAsVec3(a)));
+}
+
+/**
+ * Scales a Vec3 to unit length; a zero vector stays zero.
+ *
+ * @return A new Vec3, or AURA_NULL if `a` is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Normalize(AuraValue a) {
+    if (!requireVec3("normalize", a, a)) return createNULL();
+    return createVEC3FromRaw(auraVec3NormalizeRaw(auraAsVec3(a)));
+}
+
+/**
+ * Linear interpolation a + (b - a) * t between two Vec3 values.
+ *
+ * @return A new Vec3, or AURA_NULL if an operand is not a Vec3.
+ * @complexity O(1)
+ */
+AuraValue auraVec3Lerp(AuraValue a, AuraValue b, float t) {
+    if (!requireVec3("lerp", a, b)) return createNULL();
+    return createVEC3FromRaw(auraVec3LerpRaw(auraAsVec3(a), auraAsVec3(b), t));
+}
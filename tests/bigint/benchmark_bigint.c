@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../include/bigint.h"
+#include "../../include/aura_string.h"
+
+/**
+ * @file benchmark_bigint.c
+ * @brief Performance benchmark for BigInt arithmetic.
+ *
+ * Three classic workloads:
+ * - factorial: a growing BigInt times a small one (linear products).
+ * - fib: additions of two growing BigInts.
+ * - modpow: square-and-multiply with a 2048-bit modulus (balanced products
+ *   and long divisions, as in RSA).
+ * plus a hash-like loop on values that fit in a machine word, which should
+ * never allocate, balanced products of growing size, and decimal parsing and
+ * printing of growing length (x10 digits: x100 time if quadratic). Each step quadruples the size: the
+ * time grows x16 with the schoolbook method, x9 with Karatsuba and x7.7 with
+ * Toom-3.
+ */
+
+/** Replaces *acc with op(*acc, b), freeing the previous value. */
+static void update(AuraValue* acc, AuraValue (*op)(AuraValue, AuraValue), AuraValue b) {
+    AuraValue next = op(*acc, b);
+    freeValue(*acc);
+    *acc = next;
+}
+
+/**
+ * @brief Computes n! by multiplying 1..n into an accumulator.
+ *
+ * @return Elapsed seconds.
+ */
+double benchmarkFactorial(int n) {
+    clock_t start = clock();
+    AuraValue acc = createBIGINT(1);
+    for (int i = 2; i <= n; i++) {
+        AuraValue factor = createBIGINT(i);
+        update(&acc, auraBigIntMul, factor);
+        freeValue(factor);
+    }
+    clock_t end = clock();
+    freeValue(acc);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Computes fib(n) iteratively.
+ *
+ * @return Elapsed seconds.
+ */
+double benchmarkFib(int n) {
+    clock_t start = clock();
+    AuraValue a = createBIGINT(0);
+    AuraValue b = createBIGINT(1);
+    for (int i = 0; i < n; i++) {
+        AuraValue next = auraBigIntAdd(a, b);
+        freeValue(a);
+        a = b;
+        b = next;
+    }
+    clock_t end = clock();
+    freeValue(a);
+    freeValue(b);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Runs acc = (acc * 31 + i) % (10^9 + 7) for `n` iterations: small
+ * BigInts only, as with IDs or nanosecond timestamps.
+ *
+ * @return Elapsed seconds.
+ */
+double benchmarkSmall(int n) {
+    AuraValue modulus = createBIGINT(1000000007);
+    AuraValue factor = createBIGINT(31);
+    clock_t start = clock();
+    AuraValue acc = createBIGINT(0);
+    for (int i = 0; i < n; i++) {
+        AuraValue step = createBIGINT(i);
+        update(&acc, auraBigIntMul, factor);
+        update(&acc, auraBigIntAdd, step);
+        update(&acc, auraBigIntRem, modulus);
+        freeValue(step);
+    }
+    clock_t end = clock();
+    freeValue(acc);
+    freeValue(modulus);
+    freeValue(factor);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/** Creates a BigInt of `limbs` pseudo-random limbs. */
+static AuraValue randomBigInt(size_t limbs, uint64_t seed) {
+    uint64_t* buffer = (uint64_t*)malloc(limbs * sizeof(uint64_t));
+    for (size_t i = 0; i < limbs; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        buffer[i] = seed ^ (seed >> 29);
+    }
+    buffer[limbs - 1] |= (uint64_t)1 << 63;
+    AuraValue v = auraBigIntFromLimbs(buffer, limbs, false);
+    free(buffer);
+    return v;
+}
+
+/**
+ * @brief Computes base^exponent mod m for 2048-bit operands, `rounds` times.
+ *
+ * @return Elapsed seconds.
+ */
+double benchmarkModpow(int rounds) {
+    AuraValue modulus = randomBigInt(32, 1);
+    AuraValue base = randomBigInt(31, 2);
+    AuraValue exponent = randomBigInt(32, 3);
+    const AuraBigInt* bits = AURA_AS_BIGINT(exponent);
+
+    clock_t start = clock();
+    for (int round = 0; round < rounds; round++) {
+        AuraValue result = createBIGINT(1);
+        for (size_t i = bits->length; i-- > 0;) {
+            for (int bit = 63; bit >= 0; bit--) {
+                update(&result, auraBigIntMul, result);
+                update(&result, auraBigIntRem, modulus);
+                if ((bits->limbs[i] >> bit) & 1) {
+                    update(&result, auraBigIntMul, base);
+                    update(&result, auraBigIntRem, modulus);
+                }
+            }
+        }
+        freeValue(result);
+    }
+    clock_t end = clock();
+
+    freeValue(modulus);
+    freeValue(base);
+    freeValue(exponent);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Multiplies two random `limbs`-limb BigInts `repeat` times.
+ *
+ * @return Elapsed seconds per product.
+ */
+double benchmarkProduct(size_t limbs, int repeat) {
+    AuraValue a = randomBigInt(limbs, 4);
+    AuraValue b = randomBigInt(limbs, 5);
+
+    clock_t start = clock();
+    for (int i = 0; i < repeat; i++) {
+        freeValue(auraBigIntMul(a, b));
+    }
+    clock_t end = clock();
+
+    freeValue(a);
+    freeValue(b);
+    return (double)(end - start) / CLOCKS_PER_SEC / repeat;
+}
+
+/**
+ * @brief Parses and prints a `digits`-digit decimal number.
+ *
+ * @param parse Receives the parsing time in seconds.
+ * @param print Receives the printing time in seconds.
+ */
+void benchmarkDecimal(size_t digits, double* parse, double* print) {
+    char* text = (char*)malloc(digits + 1);
+    uint64_t seed = 6;
+    for (size_t i = 0; i < digits; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        text[i] = (char)('0' + (seed >> 33) % 10);
+    }
+    text[0] = '7';
+    text[digits] = '\0';
+
+    clock_t start = clock();
+    AuraValue v = auraBigIntFromString(text, digits);
+    clock_t parsed = clock();
+    AuraValue s = auraBigIntToString(v);
+    clock_t printed = clock();
+    if (strcmp(auraStringChars(&s), text) != 0) printf("Decimal round trip mismatch at %zu digits!\n", digits);
+
+    *parse = (double)(parsed - start) / CLOCKS_PER_SEC;
+    *print = (double)(printed - parsed) / CLOCKS_PER_SEC;
+    freeValue(s);
+    freeValue(v);
+    free(text);
+}
+
+/**
+ * @brief Main entry point for the benchmark.
+ *
+ * @return 0 on success.
+ */
+int main(void) {
+    printf("Starting BigInt benchmark...\n");
+
+    double factorial = benchmarkFactorial(20000);
+    double fib = benchmarkFib(100000);
+    double modpow = benchmarkModpow(20);
+    double small = benchmarkSmall(10000000);
+
+    printf("\n--------------------------------\n");
+    printf("BENCHMARK COMPLETE\n");
+    printf("factorial(20000):          %.4f s\n", factorial);
+    printf("fib(100000):               %.4f s\n", fib);
+    printf("modpow 2048-bit (x20):     %.4f s\n", modpow);
+    printf("small hash (1e7 steps):    %.4f s (%.1f Mops/s)\n", small, 3e7 / small / 1e6);
+    printf("Balanced products:\n");
+    for (size_t limbs = 16; limbs <= 16384; limbs *= 4) {
+        int repeat = limbs <= 256 ? 2000 : limbs <= 1024 ? 100 : 5;
+        printf("  %6zu x %6zu limbs: %10.2f us\n", limbs, limbs, benchmarkProduct(limbs, repeat) * 1e6);
+    }
+    printf("Decimal conversion (parse / print):\n");
+    for (size_t digits = 10000; digits <= 1000000; digits *= 10) {
+        double parse, print;
+        benchmarkDecimal(digits, &parse, &print);
+        printf("  %8zu digits: %10.2f ms / %10.2f ms\n", digits, parse * 1e3, print * 1e3);
+    }
+    printf("--------------------------------\n");
+    return 0;
+}
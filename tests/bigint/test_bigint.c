@@ -0,0 +1,426 @@
+#include "../../tests/unity/unity.h"
+#include "value.h"
+#include "aura_string.h"
+#include "bigint.h"
+#include <string.h>
+
+/**
+ * @file test_bigint.c
+ * @brief Unit tests for the arbitrary-precision BigInt arithmetic.
+ *
+ * Large products are checked through identities that exercise different
+ * algorithms on each side (distributivity across size thresholds, residues
+ * modulo a small prime, q * b + r == a), so a bug in one multiplication or
+ * division path cannot hide behind the same bug on the other side. Decimal
+ * conversion is checked against powers of ten built by repeated products.
+ *
+ * Compiled twice by the Makefile, like the value suite, once per value layout.
+ */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- HELPERS ---
+
+static uint64_t rngState = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t nextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+/** Creates a BigInt of exactly `limbs` random limbs. */
+static AuraValue randomBigInt(size_t limbs, bool negative) {
+    uint64_t* buffer = (uint64_t*)malloc(limbs * sizeof(uint64_t));
+    for (size_t i = 0; i < limbs; i++) buffer[i] = nextRandom();
+    buffer[limbs - 1] |= 1;
+    AuraValue v = auraBigIntFromLimbs(buffer, limbs, negative);
+    free(buffer);
+    return v;
+}
+
+/** Asserts that `v` formats as `expected`, then frees it. */
+static void assertBigIntString(const char* expected, AuraValue v) {
+    TEST_ASSERT_EQUAL_INT(AURA_BIGINT, auraTypeOf(v));
+    AuraValue s = auraBigIntToString(v);
+    TEST_ASSERT_EQUAL_STRING(expected, auraStringChars(&s));
+    freeValue(s);
+    freeValue(v);
+}
+
+/** Asserts that two BigInts are equal, then frees both. */
+static void assertBigIntsEqual(AuraValue expected, AuraValue actual) {
+    TEST_ASSERT_EQUAL_INT(AURA_BIGINT, auraTypeOf(actual));
+    TEST_ASSERT_EQUAL_INT(0, auraBigIntCompare(expected, actual));
+    TEST_ASSERT_TRUE(auraValuesEqual(expected, actual));
+    freeValue(expected);
+    freeValue(actual);
+}
+
+/** Returns a mod m for a small positive m, as an int64. */
+static int64_t residue(AuraValue a, int64_t m) {
+    AuraValue modulus = createBIGINT(m);
+    AuraValue r = auraBigIntRem(a, modulus);
+    int64_t out = -1;
+    TEST_ASSERT_TRUE(auraBigIntToInt64(r, &out));
+    freeValue(r);
+    freeValue(modulus);
+    return out < 0 ? out + m : out;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Tests small values, signs and carries across the 64-bit boundary.
+ */
+void test_small_arithmetic(void) {
+    AuraValue a = createBIGINT(-7);
+    AuraValue b = createBIGINT(2);
+    assertBigIntString("-5", auraBigIntAdd(a, b));
+    assertBigIntString("-9", auraBigIntSub(a, b));
+    assertBigIntString("-14", auraBigIntMul(a, b));
+    assertBigIntString("-3", auraBigIntDiv(a, b));
+    assertBigIntString("-1", auraBigIntRem(a, b));
+    assertBigIntString("7", auraBigIntNegate(a));
+    AuraValue negated = auraBigIntNegate(a);
+    assertBigIntString("0", auraBigIntAdd(a, negated));
+    freeValue(negated);
+    freeValue(a);
+    freeValue(b);
+
+    AuraValue max = createBIGINT(INT64_MAX);
+    AuraValue min = createBIGINT(INT64_MIN);
+    assertBigIntString("18446744073709551614", auraBigIntAdd(max, max));
+    assertBigIntString("-18446744073709551616", auraBigIntAdd(min, min));
+    assertBigIntString("85070591730234615847396907784232501249", auraBigIntMul(max, max));
+
+    int64_t out = 0;
+    TEST_ASSERT_TRUE(auraBigIntToInt64(min, &out));
+    TEST_ASSERT_EQUAL_INT64(INT64_MIN, out);
+    AuraValue one = createBIGINT(1);
+    AuraValue beyond = auraBigIntAdd(max, one);
+    TEST_ASSERT_FALSE(auraBigIntToInt64(beyond, &out));
+    TEST_ASSERT_EQUAL_INT64(INT64_MIN, auraAsBigInt(beyond));
+    freeValue(beyond);
+    freeValue(one);
+    freeValue(max);
+    freeValue(min);
+}
+
+/**
+ * @brief Tests that small results stay inline and that overflow promotes to (and back from) the heap.
+ */
+void test_small_values_stay_inline(void) {
+    AuraValue a = createBIGINT(1700000000);
+    AuraValue b = createBIGINT(-3);
+    AuraValue results[] = {
+        a, b, auraBigIntAdd(a, b), auraBigIntSub(b, a), auraBigIntMul(a, b),
+        auraBigIntDiv(a, b), auraBigIntRem(a, b), auraBigIntNegate(b), auraBigIntNegate(createBIGINT(0))
+    };
+    for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+        TEST_ASSERT_TRUE(AURA_IS_SBIG(results[i]));
+        TEST_ASSERT_FALSE(AURA_IS_OBJ(results[i]));
+    }
+    TEST_ASSERT_EQUAL_INT64(-5100000000LL, auraAsBigInt(results[4]));
+
+    // One past the inline range is boxed; stepping back inside unboxes again.
+    AuraValue max = createBIGINT(AURA_SBIG_MAX);
+    AuraValue one = createBIGINT(1);
+    AuraValue beyond = auraBigIntAdd(max, one);
+    TEST_ASSERT_TRUE(AURA_IS_OBJ(beyond));
+    TEST_ASSERT_EQUAL_INT(AURA_BIGINT, auraTypeOf(beyond));
+    AuraValue back = auraBigIntSub(beyond, one);
+    TEST_ASSERT_TRUE(AURA_IS_SBIG(back));
+    TEST_ASSERT_TRUE(auraValuesEqual(max, back));
+
+    // A product that overflows int64 promotes, and dividing it back demotes.
+    AuraValue square = auraBigIntMul(a, a);
+    AuraValue big = auraBigIntMul(square, square);
+    TEST_ASSERT_TRUE(AURA_IS_OBJ(big));
+    AuraValue quotient = auraBigIntDiv(big, square);
+    TEST_ASSERT_EQUAL(AURA_IS_SBIG(square), AURA_IS_SBIG(quotient));
+    TEST_ASSERT_TRUE(auraValuesEqual(square, quotient));
+    AuraValue zero = auraBigIntSub(big, big);
+    TEST_ASSERT_TRUE(AURA_IS_SBIG(zero));
+    assertBigIntString("0", zero);
+
+    for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) freeValue(results[i]);
+    freeValue(max); freeValue(one); freeValue(beyond); freeValue(back);
+    freeValue(square); freeValue(big); freeValue(quotient);
+}
+
+/**
+ * @brief Tests that values past 2^63 no longer wrap.
+ */
+void test_no_overflow_past_int64(void) {
+    AuraValue high = createBIGINT(9876543210LL);
+    AuraValue scale = createBIGINT(1000000000LL);
+    AuraValue low = createBIGINT(987654321LL);
+    AuraValue product = auraBigIntMul(high, scale);
+    AuraValue literal = auraBigIntAdd(product, low);
+    AuraValue digits = auraBigIntToString(literal);
+    TEST_ASSERT_EQUAL_STRING("9876543210987654321", auraStringChars(&digits));
+
+    AuraValue square = auraBigIntMul(literal, literal);
+    assertBigIntString("97546105798506325256774881877", auraBigIntDiv(square, scale));
+    freeValue(digits);
+    freeValue(square);
+    freeValue(literal);
+    freeValue(product);
+    freeValue(high); freeValue(scale); freeValue(low);
+}
+
+/**
+ * @brief Tests 50! through repeated small products.
+ */
+void test_factorial(void) {
+    AuraValue acc = createBIGINT(1);
+    for (int i = 2; i <= 50; i++) {
+        AuraValue factor = createBIGINT(i);
+        AuraValue next = auraBigIntMul(acc, factor);
+        freeValue(factor);
+        freeValue(acc);
+        acc = next;
+    }
+    assertBigIntString("30414093201713378043612608166064768844377641568960512000000000000", acc);
+}
+
+/**
+ * @brief Tests a * (b + c) == a * b + a * c on sizes around every multiplication threshold.
+ */
+void test_mul_distributes_across_algorithms(void) {
+    size_t sizes[][3] = {
+        { 3, 5, 2 }, { 31, 31, 30 }, { 32, 33, 7 }, { 40, 45, 60 }, { 100, 100, 99 },
+        { 99, 100, 101 }, { 200, 210, 190 }, { 400, 390, 405 }, { 20, 700, 650 }, { 650, 300, 1 }
+    };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        AuraValue a = randomBigInt(sizes[i][0], false);
+        AuraValue b = randomBigInt(sizes[i][1], i % 2 == 1);
+        AuraValue c = randomBigInt(sizes[i][2], false);
+
+        AuraValue sum = auraBigIntAdd(b, c);
+        AuraValue left = auraBigIntMul(a, sum);
+        AuraValue ab = auraBigIntMul(a, b);
+        AuraValue ac = auraBigIntMul(a, c);
+        assertBigIntsEqual(left, auraBigIntAdd(ab, ac));
+
+        // Residues modulo a prime are computed by single-limb division only.
+        const int64_t p = 1000000007;
+        AuraValue ab2 = auraBigIntMul(b, a);
+        int64_t expected = residue(a, p) * residue(b, p) % p;
+        TEST_ASSERT_EQUAL_INT64(expected, residue(ab, p));
+        TEST_ASSERT_EQUAL_INT(0, auraBigIntCompare(ab, ab2));
+
+        freeValue(a); freeValue(b); freeValue(c);
+        freeValue(sum); freeValue(ab); freeValue(ac); freeValue(ab2);
+    }
+}
+
+/**
+ * @brief Tests that squaring up to 3^20000 (Toom-3 sized operands) gives the right digits.
+ */
+void test_power_of_three(void) {
+    AuraValue result = createBIGINT(1);
+    AuraValue base = createBIGINT(3);
+    for (unsigned e = 20000; e != 0; e >>= 1) {
+        if (e & 1) {
+            AuraValue next = auraBigIntMul(result, base);
+            freeValue(result);
+            result = next;
+        }
+        AuraValue square = auraBigIntMul(base, base);
+        freeValue(base);
+        base = square;
+    }
+    freeValue(base);
+
+    TEST_ASSERT_EQUAL_INT64(883496652, residue(result, 1000000007));
+    AuraValue s = auraBigIntToString(result);
+    TEST_ASSERT_EQUAL_size_t(9543, auraStringLength(s));
+    TEST_ASSERT_EQUAL_MEMORY("26613034272174197919", auraStringChars(&s), 20);
+    TEST_ASSERT_EQUAL_STRING("08807535253104400001", auraStringChars(&s) + 9543 - 20);
+    freeValue(s);
+    freeValue(result);
+}
+
+/**
+ * @brief Tests q * b + r == a and |r| < |b| for every sign combination and many sizes.
+ */
+void test_division_identity(void) {
+    size_t sizes[][2] = { { 1, 1 }, { 5, 1 }, { 2, 2 }, { 10, 3 }, { 40, 39 }, { 300, 17 }, { 500, 250 }, { 3, 7 } };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (int signs = 0; signs < 4; signs++) {
+            AuraValue a = randomBigInt(sizes[i][0], signs & 1);
+            AuraValue b = randomBigInt(sizes[i][1], signs & 2);
+            AuraValue q = auraBigIntDiv(a, b);
+            AuraValue r = auraBigIntRem(a, b);
+
+            AuraValue qb = auraBigIntMul(q, b);
+            AuraValue rebuilt = auraBigIntAdd(qb, r);
+            TEST_ASSERT_EQUAL_INT(0, auraBigIntCompare(a, rebuilt));
+
+            // The remainder takes the sign of the dividend and is smaller than the divisor.
+            AuraValue zero = createBIGINT(0);
+            AuraValue absR = auraBigIntCompare(r, zero) < 0 ? auraBigIntNegate(r) : auraBigIntAdd(r, zero);
+            AuraValue absB = auraBigIntCompare(b, zero) < 0 ? auraBigIntNegate(b) : auraBigIntAdd(b, zero);
+            TEST_ASSERT_TRUE(auraBigIntCompare(absR, absB) < 0);
+            if (auraBigIntCompare(r, zero) != 0) {
+                TEST_ASSERT_EQUAL_INT(auraBigIntCompare(a, zero), auraBigIntCompare(r, zero));
+            }
+
+            freeValue(a); freeValue(b); freeValue(q); freeValue(r); freeValue(qb);
+            freeValue(rebuilt); freeValue(zero); freeValue(absR); freeValue(absB);
+        }
+    }
+}
+
+/**
+ * @brief Tests exact division of a product by one of its factors.
+ */
+void test_division_of_products(void) {
+    AuraValue a = randomBigInt(180, true);
+    AuraValue b = randomBigInt(170, false);
+    AuraValue product = auraBigIntMul(a, b);
+    AuraValue quotient = auraBigIntDiv(product, b);
+    TEST_ASSERT_EQUAL_INT(0, auraBigIntCompare(a, quotient));
+    assertBigIntString("0", auraBigIntRem(product, a));
+    freeValue(quotient);
+    freeValue(product);
+    freeValue(a);
+    freeValue(b);
+}
+
+/**
+ * @brief Tests parsing of literal text: signs, the `n` suffix, leading zeros and malformed input.
+ */
+void test_parse_literals(void) {
+    assertBigIntString("0", auraBigIntFromString("0", 1));
+    assertBigIntString("0", auraBigIntFromString("-000n", 5));
+    assertBigIntString("123", auraBigIntFromString("123n", 4));
+    assertBigIntString("-42", auraBigIntFromString("-0042", 5));
+    assertBigIntString("9876543210987654321", auraBigIntFromString("9876543210987654321n", 20));
+    assertBigIntString("-18446744073709551616", auraBigIntFromString("-18446744073709551616", 21));
+
+    // Parsed values take the same canonical form as computed ones.
+    AuraValue tiny = auraBigIntFromString("-1234n", 6);
+    TEST_ASSERT_TRUE(AURA_IS_SBIG(tiny));
+    freeValue(tiny);
+    AuraValue expected = createBIGINT(-999999999999999999LL);
+    AuraValue parsed = auraBigIntFromString("-999999999999999999n", 20);
+    TEST_ASSERT_EQUAL(AURA_IS_SBIG(expected), AURA_IS_SBIG(parsed));
+    assertBigIntsEqual(expected, parsed);
+
+    const char* invalid[] = { "", "-", "n", "-n", "12a", "1.5n", "+1", "1nn" };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        AuraValue rejected = auraBigIntFromString(invalid[i], strlen(invalid[i]));
+        TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    }
+}
+
+/**
+ * @brief Tests 10^e and 10^e - 1 against repeated products, up to sizes that
+ * divide through cached reciprocals.
+ */
+void test_decimal_powers_of_ten(void) {
+    size_t exponents[] = { 18, 19, 38, 570, 571, 1139, 12345, 100000 };
+    size_t maxDigits = 100001;
+    char* text = (char*)malloc(maxDigits + 1);
+    AuraValue one = createBIGINT(1);
+
+    for (size_t i = 0; i < sizeof(exponents) / sizeof(exponents[0]); i++) {
+        size_t e = exponents[i];
+        AuraValue power = createBIGINT(1);
+        AuraValue base = createBIGINT(10);
+        for (size_t bits = e; bits != 0; bits >>= 1) {
+            if (bits & 1) {
+                AuraValue next = auraBigIntMul(power, base);
+                freeValue(power);
+                power = next;
+            }
+            AuraValue square = auraBigIntMul(base, base);
+            freeValue(base);
+            base = square;
+        }
+        freeValue(base);
+
+        text[0] = '1';
+        memset(text + 1, '0', e);
+        text[e + 1] = '\0';
+        AuraValue parsed = auraBigIntFromString(text, e + 1);
+        TEST_ASSERT_EQUAL_INT(0, auraBigIntCompare(power, parsed));
+        AuraValue printed = auraBigIntToString(power);
+        TEST_ASSERT_EQUAL_STRING(text, auraStringChars(&printed));
+
+        memset(text, '9', e);
+        text[e] = '\0';
+        assertBigIntString(text, auraBigIntSub(power, one));
+
+        freeValue(printed);
+        freeValue(parsed);
+        freeValue(power);
+    }
+    freeValue(one);
+    free(text);
+}
+
+/**
+ * @brief Tests that random digit strings of many lengths survive a parse and print round trip.
+ */
+void test_decimal_round_trip(void) {
+    size_t lengths[] = { 1, 20, 100, 569, 570, 571, 2000, 11400, 11401, 30001, 120000 };
+    char* text = (char*)malloc(120000 + 3);
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        size_t length = lengths[i];
+        text[0] = '-';
+        for (size_t j = 1; j <= length; j++) text[j] = (char)('0' + nextRandom() % 10);
+        text[1] = (char)('1' + nextRandom() % 9);
+        text[length + 1] = 'n';
+
+        AuraValue v = auraBigIntFromString(text, length + 2);
+        text[length + 1] = '\0';
+        assertBigIntString(text, v);
+    }
+    free(text);
+}
+
+/**
+ * @brief Tests that invalid operands and division by zero return null.
+ */
+void test_invalid_operands(void) {
+    AuraValue a = createBIGINT(5);
+    AuraValue zero = createBIGINT(0);
+    AuraValue rejected = auraBigIntDiv(a, zero);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraBigIntRem(a, zero);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraBigIntAdd(a, createNUMBER(1.0));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraBigIntToString(createINT(3));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    freeValue(a);
+    freeValue(zero);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_small_arithmetic);
+    RUN_TEST(test_small_values_stay_inline);
+    RUN_TEST(test_no_overflow_past_int64);
+    RUN_TEST(test_factorial);
+    RUN_TEST(test_mul_distributes_across_algorithms);
+    RUN_TEST(test_power_of_three);
+    RUN_TEST(test_division_identity);
+    RUN_TEST(test_division_of_products);
+    RUN_TEST(test_parse_literals);
+    RUN_TEST(test_decimal_powers_of_ten);
+    RUN_TEST(test_decimal_round_trip);
+    RUN_TEST(test_invalid_operands);
+
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../include/aura_string.h"
+#include "../../include/slab.h"
+#include "../../include/tensor_pool.h"
+
+/**
+ * @file benchmark_memory.c
+ * @brief Performance benchmark for value allocation strategies.
+ *
+ * Simulates a request that creates many short-lived heap strings and then
+ * discards them, once with individual `freeValue` calls and once with an arena
+ * reset per request. A second part compares raw small-object churn through
+ * `malloc`/`free` against the thread-caching slab allocator, and a third
+ * recreates same-shaped tensors as a numeric loop would, with the tensor pool
+ * disabled, enabled, and enabled without zero-fill.
+ */
+
+static char* TEXT = "request-scoped value that is too long to be inline";
+
+/**
+ * @brief Allocates and frees every value individually.
+ *
+ * @param requests Number of simulated requests.
+ * @param values Values created per request.
+ * @return Elapsed seconds.
+ */
+double benchmarkHeap(int requests, int values) {
+    AuraValue* live = (AuraValue*)malloc(sizeof(AuraValue) * values);
+
+    clock_t start = clock();
+    for (int r = 0; r < requests; r++) {
+        for (int i = 0; i < values; i++) live[i] = createSTRING(TEXT);
+        for (int i = 0; i < values; i++) freeValue(live[i]);
+    }
+    clock_t end = clock();
+
+    free(live);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Allocates every value in an arena and resets it after each request.
+ *
+ * @param requests Number of simulated requests.
+ * @param values Values created per request.
+ * @return Elapsed seconds.
+ */
+double benchmarkArena(int requests, int values) {
+    AuraArena* arena = auraArenaCreate(0);
+    volatile size_t sink = 0;
+
+    clock_t start = clock();
+    for (int r = 0; r < requests; r++) {
+        for (int i = 0; i < values; i++) {
+            AuraValue v = createSTRINGInArena(arena, TEXT);
+            sink += AURA_IS_OBJ(v);
+        }
+        auraArenaReset(arena);
+    }
+    clock_t end = clock();
+
+    auraArenaDestroy(arena);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Allocates and frees small objects in waves with malloc/free.
+ *
+ * @param rounds Number of waves.
+ * @param objects Objects alive per wave.
+ * @return Elapsed seconds.
+ */
+double benchmarkMallocObjects(int rounds, int objects) {
+    void** live = (void**)malloc(sizeof(void*) * objects);
+
+    clock_t start = clock();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < objects; i++) live[i] = malloc(16 + (i % 8) * 16);
+        for (int i = 0; i < objects; i++) free(live[i]);
+    }
+    clock_t end = clock();
+
+    free(live);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Same workload as benchmarkMallocObjects, served by the slab allocator.
+ */
+double benchmarkSlabObjects(int rounds, int objects) {
+    void** live = (void**)malloc(sizeof(void*) * objects);
+
+    clock_t start = clock();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < objects; i++) live[i] = auraSlabAlloc(16 + (i % 8) * 16);
+        for (int i = 0; i < objects; i++) auraSlabFree(live[i], 16 + (i % 8) * 16);
+    }
+    clock_t end = clock();
+
+    free(live);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Creates and frees a rows x cols tensor per iteration, touching every
+ * element as a loop body would.
+ *
+ * @param iterations Number of tensors created.
+ * @param poolLimit Limit applied to the tensor pool (0 disables it).
+ * @param zeroFill Whether to request zero-filled tensors.
+ * @return Elapsed seconds.
+ */
+double benchmarkTensorChurn(int iterations, int rows, int cols, size_t poolLimit, bool zeroFill) {
+    size_t previous = auraTensorPoolSetLimit(poolLimit);
+    int shape[2] = { rows, cols };
+
+    clock_t start = clock();
+    for (int i = 0; i < iterations; i++) {
+        AuraValue v = zeroFill ? createTENSOR(rows, cols) : createTENSORNDUninitialized(2, shape);
+        AuraTensor* t = AURA_AS_TENSOR(v);
+        for (size_t r = 0; r < t->rows; r++) {
+            for (size_t c = 0; c < t->cols; c++) AURA_TENSOR_AT(t, r, c) = (float)i;
+        }
+        freeValue(v);
+    }
+    clock_t end = clock();
+
+    auraTensorPoolSetLimit(previous);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Main entry point for the benchmark.
+ *
+ * @return 0 on success.
+ */
+int main(void) {
+    int requests = 2000;
+    int values = 1000;
+    double total = (double)requests * values;
+
+    printf("Starting allocation benchmark...\n");
+
+    double heap = benchmarkHeap(requests, values);
+    double arena = benchmarkArena(requests, values);
+    double mallocObjects = benchmarkMallocObjects(requests, values);
+    double slabObjects = benchmarkSlabObjects(requests, values);
+
+    int tensors = 2000;
+    double tensorCalloc = benchmarkTensorChurn(tensors, 1024, 1024, 0, true);
+    double tensorPool = benchmarkTensorChurn(tensors, 1024, 1024, AURA_TENSOR_POOL_DEFAULT_LIMIT, true);
+    double tensorPoolRaw = benchmarkTensorChurn(tensors, 1024, 1024, AURA_TENSOR_POOL_DEFAULT_LIMIT, false);
+    AuraTensorPoolStats pool;
+    auraTensorPoolStats(&pool);
+
+    printf("\n--------------------------------\n");
+    printf("BENCHMARK COMPLETE\n");
+    printf("malloc/free: %.0f values in %.4f s (%.1f M values/s)\n", total, heap, total / heap / 1e6);
+    printf("Arena:       %.0f values in %.4f s (%.1f M values/s)\n", total, arena, total / arena / 1e6);
+    printf("malloc 16-128 B: %.0f objects in %.4f s (%.1f M objects/s)\n", total, mallocObjects, total / mallocObjects / 1e6);
+    printf("Slab   16-128 B: %.0f objects in %.4f s (%.1f M objects/s)\n", total, slabObjects, total / slabObjects / 1e6);
+    printf("1024x1024 tensors, no pool:        %d in %.4f s (%.0f tensors/s)\n", tensors, tensorCalloc, tensors / tensorCalloc);
+    printf("1024x1024 tensors, pool:           %d in %.4f s (%.0f tensors/s)\n", tensors, tensorPool, tensors / tensorPool);
+    printf("1024x1024 tensors, pool, no zero:  %d in %.4f s (%.0f tensors/s)\n", tensors, tensorPoolRaw, tensors / tensorPoolRaw);
+    printf("Tensor pool: %zu hits, %zu misses, %zu released over the limit\n", pool.hits, pool.misses, pool.releases);
+    printf("--------------------------------\n");
+    return 0;
+}
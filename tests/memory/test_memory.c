@@ -0,0 +1,361 @@
+#include "../../tests/unity/unity.h"
+#include "arena.h"
+#include "slab.h"
+#include "tensor_pool.h"
+#include "aura_string.h"
+#include <stdint.h>
+#include <pthread.h>
+
+/**
+ * @file test_memory.c
+ * @brief Unit tests for the Aura memory allocators.
+ */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Tests that arena allocations are aligned, distinct and contiguous.
+ */
+void test_arena_bump_allocation(void) {
+    AuraArena* arena = auraArenaCreate(1024);
+    TEST_ASSERT_NOT_NULL(arena);
+
+    char* a = (char*)auraArenaAlloc(arena, 1);
+    char* b = (char*)auraArenaAlloc(arena, 24);
+    char* c = (char*)auraArenaAlloc(arena, 16);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)a % AURA_ARENA_ALIGNMENT);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)b % AURA_ARENA_ALIGNMENT);
+    TEST_ASSERT_EQUAL_PTR(a + AURA_ARENA_ALIGNMENT, b);
+    TEST_ASSERT_EQUAL_PTR(b + 32, c);
+    TEST_ASSERT_EQUAL_size_t(41, arena->bytesUsed);
+    TEST_ASSERT_EQUAL_size_t(1024, arena->bytesReserved);
+
+    auraArenaDestroy(arena);
+}
+
+/**
+ * @brief Tests chunk growth, dedicated large blocks and reuse after reset.
+ */
+void test_arena_growth_and_reset(void) {
+    AuraArena* arena = auraArenaCreate(1024);
+
+    for (int i = 0; i < 100; i++) {
+        char* block = (char*)auraArenaAlloc(arena, 100);
+        TEST_ASSERT_NOT_NULL(block);
+        memset(block, i, 100);
+    }
+    char* large = (char*)auraArenaAlloc(arena, 5000);
+    TEST_ASSERT_NOT_NULL(large);
+    memset(large, 0xab, 5000);
+    TEST_ASSERT_TRUE(arena->bytesReserved >= 100 * 100 + 5000);
+
+    auraArenaReset(arena);
+    TEST_ASSERT_EQUAL_size_t(0, arena->bytesUsed);
+    TEST_ASSERT_EQUAL_size_t(1024, arena->bytesReserved);
+
+    // The kept chunk is reused from its start.
+    char* first = (char*)auraArenaAlloc(arena, 8);
+    TEST_ASSERT_EQUAL_size_t(1024, arena->bytesReserved);
+    TEST_ASSERT_NOT_NULL(first);
+
+    auraArenaDestroy(arena);
+}
+
+/**
+ * @brief Tests that values created in an arena work and ignore freeValue.
+ */
+void test_arena_values(void) {
+    AuraArena* arena = auraArenaCreate(0);
+
+    AuraValue s = createSTRINGInArena(arena, "a string long enough to need a heap block");
+    TEST_ASSERT_TRUE(AURA_IS_STRING(s));
+    TEST_ASSERT_TRUE(AURA_IS_OBJ(s));
+    TEST_ASSERT_TRUE(AURA_AS_OBJ(s)->flags & AURA_OBJ_ARENA);
+    TEST_ASSERT_EQUAL_STRING("a string long enough to need a heap block", auraStringChars(&s));
+
+    AuraValue heap = createSTRING("a string long enough to need a heap block");
+    TEST_ASSERT_TRUE(auraStringsEqual(s, heap));
+    TEST_ASSERT_EQUAL_UINT32(auraStringHash(heap), auraStringHash(s));
+
+    AuraValue t = createTENSORInArena(arena, 4, 8);
+    TEST_ASSERT_TRUE(AURA_IS_TENSOR(t));
+    TEST_ASSERT_EQUAL_size_t(8, AURA_AS_TENSOR(t)->cols);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_TENSOR_AT(AURA_AS_TENSOR(t), 3, 7));
+
+    // Releasing arena values is a no-op; the arena reclaims them.
+    freeValue(s);
+    freeValue(t);
+    TEST_ASSERT_EQUAL_STRING("a string long enough to need a heap block", auraStringChars(&s));
+
+    freeValue(heap);
+    auraArenaDestroy(arena);
+}
+
+/**
+ * @brief Tests that interning an arena string yields a heap copy.
+ */
+void test_arena_strings_are_not_interned_in_place(void) {
+    AuraArena* arena = auraArenaCreate(0);
+
+    AuraValue s = createSTRINGInArena(arena, "interned key that lives in an arena");
+    AuraValue interned = auraIntern(s);
+    TEST_ASSERT_TRUE(auraIsInterned(interned));
+    TEST_ASSERT_FALSE(AURA_AS_OBJ(interned)->flags & AURA_OBJ_ARENA);
+    TEST_ASSERT_TRUE(auraStringsEqual(s, interned));
+
+    auraArenaDestroy(arena);
+    TEST_ASSERT_EQUAL_STRING("interned key that lives in an arena", auraStringChars(&interned));
+    freeValue(interned);
+}
+
+/**
+ * @brief Tests the mapping from request sizes to size classes.
+ */
+void test_slab_size_classes(void) {
+    TEST_ASSERT_EQUAL_INT(0, auraSlabClassOf(1));
+    TEST_ASSERT_EQUAL_INT(0, auraSlabClassOf(16));
+    TEST_ASSERT_EQUAL_INT(1, auraSlabClassOf(17));
+    TEST_ASSERT_EQUAL_INT(-1, auraSlabClassOf(AURA_SLAB_MAX_SIZE + 1));
+
+    // Every size fits its class, and the class below it is too small.
+    for (size_t size = 1; size <= AURA_SLAB_MAX_SIZE; size++) {
+        int sizeClass = auraSlabClassOf(size);
+        TEST_ASSERT_TRUE(auraSlabClassSize(sizeClass) >= size);
+        if (sizeClass > 0) TEST_ASSERT_TRUE(auraSlabClassSize(sizeClass - 1) < size);
+    }
+    TEST_ASSERT_EQUAL_size_t(AURA_SLAB_MAX_SIZE, auraSlabClassSize(AURA_SLAB_CLASS_COUNT - 1));
+}
+
+/**
+ * @brief Returns the live object count of one size class.
+ */
+static size_t liveObjects(int sizeClass) {
+    AuraSlabClassStats stats[AURA_SLAB_CLASS_COUNT];
+    auraSlabStats(stats);
+    return stats[sizeClass].liveObjects;
+}
+
+/**
+ * @brief Tests reuse of freed objects and the live counters.
+ */
+void test_slab_alloc_free_and_stats(void) {
+    int sizeClass = auraSlabClassOf(200);
+    size_t before = liveObjects(sizeClass);
+
+    void* objects[1000];
+    for (int i = 0; i < 1000; i++) {
+        objects[i] = auraSlabAlloc(200);
+        TEST_ASSERT_NOT_NULL(objects[i]);
+        TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)objects[i] % 16);
+        memset(objects[i], i & 0xff, 200);
+    }
+    TEST_ASSERT_EQUAL_size_t(before + 1000, liveObjects(sizeClass));
+
+    AuraSlabClassStats stats[AURA_SLAB_CLASS_COUNT];
+    auraSlabStats(stats);
+    TEST_ASSERT_EQUAL_size_t(stats[sizeClass].liveObjects * 256, stats[sizeClass].liveBytes);
+
+    for (int i = 0; i < 1000; i++) auraSlabFree(objects[i], 200);
+    TEST_ASSERT_EQUAL_size_t(before, liveObjects(sizeClass));
+
+    // The most recently freed object is handed out first.
+    void* reused = auraSlabAlloc(200);
+    TEST_ASSERT_EQUAL_PTR(objects[999], reused);
+    auraSlabFree(reused, 200);
+}
+
+/**
+ * @brief Tests that small heap values are served by the slab allocator.
+ */
+void test_slab_backs_small_values(void) {
+    AuraValue s = createSTRING("a heap string served from a size class");
+#ifdef AURA_SLAB
+    TEST_ASSERT_NOT_EQUAL(0, AURA_AS_OBJ(s)->sizeClass);
+#endif
+    AuraValue t = createTENSOR(64, 64);
+    TEST_ASSERT_EQUAL_UINT8(0, AURA_AS_OBJ(t)->sizeClass);
+    freeValue(s);
+    freeValue(t);
+}
+
+#define WORKER_COUNT 4
+#define WORKER_OBJECTS 20000
+
+typedef struct {
+    void** objects;
+    int sizeClass;
+} WorkerArgs;
+
+static void* allocateWorker(void* arg) {
+    WorkerArgs* args = (WorkerArgs*)arg;
+    for (int i = 0; i < WORKER_OBJECTS; i++) {
+        args->objects[i] = auraSlabAllocClass(args->sizeClass);
+        *(int*)args->objects[i] = i;
+    }
+    return NULL;
+}
+
+static void* freeWorker(void* arg) {
+    WorkerArgs* args = (WorkerArgs*)arg;
+    for (int i = 0; i < WORKER_OBJECTS; i++) {
+        if (*(int*)args->objects[i] != i) return arg;
+        auraSlabFreeClass(args->objects[i], args->sizeClass);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Tests objects allocated on some threads and freed on others.
+ */
+void test_slab_cross_thread_free(void) {
+    int sizeClass = auraSlabClassOf(48);
+    size_t before = liveObjects(sizeClass);
+
+    static void* objects[WORKER_COUNT][WORKER_OBJECTS];
+    WorkerArgs args[WORKER_COUNT];
+    pthread_t threads[WORKER_COUNT];
+
+    for (int t = 0; t < WORKER_COUNT; t++) {
+        args[t].objects = objects[t];
+        args[t].sizeClass = sizeClass;
+        pthread_create(&threads[t], NULL, allocateWorker, &args[t]);
+    }
+    for (int t = 0; t < WORKER_COUNT; t++) pthread_join(threads[t], NULL);
+    TEST_ASSERT_EQUAL_size_t(before + WORKER_COUNT * WORKER_OBJECTS, liveObjects(sizeClass));
+
+    // Free each batch on a different thread than the one that allocated it.
+    for (int t = 0; t < WORKER_COUNT; t++) {
+        pthread_create(&threads[t], NULL, freeWorker, &args[(t + 1) % WORKER_COUNT]);
+    }
+    for (int t = 0; t < WORKER_COUNT; t++) {
+        void* failed = NULL;
+        pthread_join(threads[t], &failed);
+        TEST_ASSERT_NULL(failed);
+    }
+    TEST_ASSERT_EQUAL_size_t(before, liveObjects(sizeClass));
+}
+
+/**
+ * @brief Tests that pool buckets cover every size with at most 25% slack.
+ */
+void test_tensor_pool_buckets(void) {
+    TEST_ASSERT_EQUAL_INT(0, auraTensorPoolBucketOf(1));
+    TEST_ASSERT_EQUAL_INT(0, auraTensorPoolBucketOf(AURA_TENSOR_POOL_MIN_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, auraTensorPoolBucketOf(AURA_TENSOR_POOL_MIN_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(AURA_TENSOR_POOL_BUCKETS - 1, auraTensorPoolBucketOf(AURA_TENSOR_POOL_MAX_SIZE));
+    TEST_ASSERT_EQUAL_INT(-1, auraTensorPoolBucketOf(AURA_TENSOR_POOL_MAX_SIZE + 1));
+
+    for (int b = 1; b < AURA_TENSOR_POOL_BUCKETS; b++) {
+        size_t size = auraTensorPoolBucketSize(b);
+        size_t previous = auraTensorPoolBucketSize(b - 1);
+        TEST_ASSERT_TRUE(size > previous);
+        TEST_ASSERT_TRUE(size - previous <= size / 4);
+        TEST_ASSERT_EQUAL_INT(b, auraTensorPoolBucketOf(size));
+        TEST_ASSERT_EQUAL_INT(b, auraTensorPoolBucketOf(previous + 1));
+    }
+}
+
+/**
+ * @brief Tests that freed tensors are recycled, zeroed, and counted.
+ */
+void test_tensor_pool_recycles_tensors(void) {
+    auraTensorPoolTrim();
+    AuraTensorPoolStats before, after;
+    auraTensorPoolStats(&before);
+
+    AuraValue first = createTENSOR(100, 100);
+    AuraTensor* t = AURA_AS_TENSOR(first);
+    for (size_t i = 0; i < t->rows * t->stride; i++) t->data[i] = 1.0f;   // Padding too.
+    float* storage = t->data;
+    freeValue(first);
+
+    // A zero-filled tensor of the same shape reuses the block, cleared.
+    AuraValue second = createTENSOR(100, 100);
+    t = AURA_AS_TENSOR(second);
+    for (size_t i = 0; i < t->rows * t->stride; i++) TEST_ASSERT_EQUAL_FLOAT(0.0f, t->data[i]);
+    for (size_t i = 0; i < t->rows * t->stride; i++) t->data[i] = 1.0f;
+    freeValue(second);
+
+    // An uninitialized one only clears its padding.
+    int shape[] = { 100, 100 };
+    AuraValue third = createTENSORNDUninitialized(2, shape);
+    t = AURA_AS_TENSOR(third);
+    TEST_ASSERT_EQUAL_UINT32(1, t->refs);
+    TEST_ASSERT_NULL(t->base);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)t->data % AURA_TENSOR_ALIGNMENT);
+    for (size_t r = 0; r < t->rows; r++) {
+        for (size_t c = t->cols; c < t->stride; c++) TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_TENSOR_AT(t, r, c));
+    }
+
+    auraTensorPoolStats(&after);
+#ifdef AURA_TENSOR_POOL
+    TEST_ASSERT_EQUAL_PTR(storage, t->data);
+    TEST_ASSERT_EQUAL_size_t(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_size_t(before.hits + 2, after.hits);
+#else
+    (void)storage;
+    TEST_ASSERT_EQUAL_size_t(before.hits, after.hits);
+#endif
+    freeValue(third);
+    auraTensorPoolTrim();
+}
+
+/**
+ * @brief Tests that the pool never caches more than its limit.
+ */
+void test_tensor_pool_limit(void) {
+    auraTensorPoolTrim();
+    AuraValue tensors[8];
+    for (int i = 0; i < 8; i++) tensors[i] = createTENSOR(64, 64);   // ~16.6 KB each.
+
+    size_t previous = auraTensorPoolSetLimit(3 * 20 * 1024);
+    AuraTensorPoolStats before, after;
+    auraTensorPoolStats(&before);
+    for (int i = 0; i < 8; i++) freeValue(tensors[i]);
+    auraTensorPoolStats(&after);
+
+    TEST_ASSERT_TRUE(after.cachedBytes <= after.limit);
+#ifdef AURA_TENSOR_POOL
+    TEST_ASSERT_EQUAL_size_t(3, after.cachedBlocks);
+    TEST_ASSERT_EQUAL_size_t(before.releases + 5, after.releases);
+#endif
+
+    // Lowering the limit releases cached blocks right away.
+    auraTensorPoolSetLimit(0);
+    auraTensorPoolStats(&after);
+    TEST_ASSERT_EQUAL_size_t(0, after.cachedBlocks);
+    TEST_ASSERT_EQUAL_size_t(0, after.cachedBytes);
+
+    AuraValue t = createTENSOR(64, 64);
+    freeValue(t);
+    auraTensorPoolStats(&after);
+    TEST_ASSERT_EQUAL_size_t(0, after.cachedBlocks);
+
+    auraTensorPoolSetLimit(previous);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_arena_bump_allocation);
+    RUN_TEST(test_arena_growth_and_reset);
+    RUN_TEST(test_arena_values);
+    RUN_TEST(test_arena_strings_are_not_interned_in_place);
+    RUN_TEST(test_slab_size_classes);
+    RUN_TEST(test_slab_alloc_free_and_stats);
+    RUN_TEST(test_slab_backs_small_values);
+    RUN_TEST(test_slab_cross_thread_free);
+    RUN_TEST(test_tensor_pool_buckets);
+    RUN_TEST(test_tensor_pool_recycles_tensors);
+    RUN_TEST(test_tensor_pool_limit);
+
+    auraFreeInternTable();
+
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "../../include/aura_string.h"
+
+/**
+ * @file benchmark_string.c
+ * @brief Performance benchmark for string building.
+ *
+ * Compares the classic `s = s + piece` loop implemented with eager copies
+ * against rope-based concatenation (`auraConcat`) followed by a single flatten.
+ * The eager version is quadratic, so it runs on a much smaller input; compare
+ * the reported MB/s rather than the raw times.
+ */
+
+static const char* PIECE = "token=42; ";
+
+/**
+ * @brief Builds the string by copying the whole accumulator on every append.
+ *
+ * @param pieces Number of appends.
+ * @return Elapsed seconds.
+ */
+double benchmarkEagerCopy(int pieces) {
+    size_t pieceLength = strlen(PIECE);
+    AuraValue s = createSTRING("");
+
+    clock_t start = clock();
+    for (int i = 0; i < pieces; i++) {
+        size_t length = auraStringLength(s);
+        char* buffer = (char*)malloc(length + pieceLength);
+        memcpy(buffer, auraStringChars(&s), length);
+        memcpy(buffer + length, PIECE, pieceLength);
+        AuraValue next = auraCopyString(buffer, length + pieceLength);
+        free(buffer);
+        freeValue(s);
+        s = next;
+    }
+    clock_t end = clock();
+
+    freeValue(s);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Builds the string with rope concatenation and flattens it once.
+ *
+ * @param pieces Number of appends.
+ * @return Elapsed seconds.
+ */
+double benchmarkRope(int pieces) {
+    AuraValue piece = createSTRING((char*)PIECE);
+    AuraValue s = createSTRING("");
+
+    clock_t start = clock();
+    for (int i = 0; i < pieces; i++) {
+        AuraValue next = auraConcat(s, piece);
+        freeValue(s);
+        s = next;
+    }
+    auraStringFlatten(s);
+    clock_t end = clock();
+
+    freeValue(s);
+    freeValue(piece);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Main entry point for the benchmark.
+ *
+ * @return 0 on success.
+ */
+int main(void) {
+    int eagerPieces = 10000;
+    int ropePieces = 2000000;
+    double pieceMB = strlen(PIECE) / 1024.0 / 1024.0;
+
+    printf("Starting string building benchmark...\n");
+
+    double eager = benchmarkEagerCopy(eagerPieces);
+    double rope = benchmarkRope(ropePieces);
+
+    printf("\n--------------------------------\n");
+    printf("BENCHMARK COMPLETE\n");
+    printf("Eager copy: %8d appends in %.4f s (%.2f MB/s)\n", eagerPieces, eager, eagerPieces * pieceMB / eager);
+    printf("Rope:       %8d appends in %.4f s (%.2f MB/s)\n", ropePieces, rope, ropePieces * pieceMB / rope);
+    printf("--------------------------------\n");
+    return 0;
+}
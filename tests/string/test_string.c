@@ -0,0 +1,568 @@
+#include "../../tests/unity/unity.h"
+#include "aura_string.h"
+
+/**
+ * @file test_string.c
+ * @brief Unit tests for the Aura string representations.
+ *
+ * Like the value suite, this file is built for both value layouts, so the
+ * inline capacity is always expressed through AURA_SSO_MAX.
+ */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Tests that short strings are stored inline and need no heap block.
+ */
+void test_short_strings_are_inline(void) {
+    AuraValue s = createSTRING("ok");
+    TEST_ASSERT_TRUE(AURA_IS_STRING(s));
+    TEST_ASSERT_EQUAL_INT(AURA_STRING, auraTypeOf(s));
+#if AURA_SSO_MAX >= 2
+    TEST_ASSERT_TRUE(AURA_IS_SSTR(s));
+    TEST_ASSERT_FALSE(AURA_IS_OBJ(s));
+#endif
+    TEST_ASSERT_EQUAL_STRING("ok", auraStringChars(&s));
+    TEST_ASSERT_EQUAL_size_t(2, auraStringLength(s));
+    freeValue(s);
+}
+
+/**
+ * @brief Tests the boundary between the inline and heap layouts.
+ */
+void test_inline_capacity_boundary(void) {
+    char buffer[64];
+    memset(buffer, 'a', sizeof(buffer));
+
+    buffer[AURA_SSO_MAX] = '\0';
+    AuraValue fits = createSTRING(buffer);
+    TEST_ASSERT_EQUAL_size_t(AURA_SSO_MAX, auraStringLength(fits));
+    TEST_ASSERT_EQUAL_STRING(buffer, auraStringChars(&fits));
+    TEST_ASSERT_FALSE(AURA_IS_OBJ(fits));
+
+    buffer[AURA_SSO_MAX] = 'a';
+    buffer[AURA_SSO_MAX + 1] = '\0';
+    AuraValue spills = createSTRING(buffer);
+    TEST_ASSERT_TRUE(AURA_IS_OBJ(spills));
+    TEST_ASSERT_EQUAL_size_t(AURA_SSO_MAX + 1, auraStringLength(spills));
+    TEST_ASSERT_EQUAL_STRING(buffer, auraStringChars(&spills));
+
+    freeValue(fits);
+    freeValue(spills);
+}
+
+/**
+ * @brief Tests the empty string.
+ */
+void test_empty_string(void) {
+    AuraValue s = createSTRING("");
+    TEST_ASSERT_TRUE(AURA_IS_STRING(s));
+    TEST_ASSERT_EQUAL_size_t(0, auraStringLength(s));
+    TEST_ASSERT_EQUAL_STRING("", auraStringChars(&s));
+}
+
+/**
+ * @brief Tests that heap strings cache their length and hash.
+ */
+void test_heap_string_metadata(void) {
+    const char* text = "a considerably longer string value";
+    AuraValue s = createSTRING((char*)text);
+
+    TEST_ASSERT_TRUE(AURA_IS_OBJ(s));
+    TEST_ASSERT_EQUAL_size_t(strlen(text), AURA_AS_STRING(s)->header.length);
+    TEST_ASSERT_EQUAL_UINT32(auraHashChars(text, strlen(text)), auraStringHash(s));
+    freeValue(s);
+}
+
+/**
+ * @brief Tests that the hash does not depend on the physical layout.
+ */
+void test_hash_is_layout_independent(void) {
+    AuraValue s = createSTRING("ab");
+    TEST_ASSERT_EQUAL_UINT32(auraHashChars("ab", 2), auraStringHash(s));
+}
+
+/**
+ * @brief Tests content equality across layouts and lengths.
+ */
+void test_string_equality(void) {
+    AuraValue a = createSTRING("property_name_long");
+    AuraValue b = createSTRING("property_name_long");
+    AuraValue c = createSTRING("property_name_lonG");
+    AuraValue d = createSTRING("x");
+
+    TEST_ASSERT_TRUE(auraStringsEqual(a, b));
+    TEST_ASSERT_FALSE(auraStringsEqual(a, c));
+    TEST_ASSERT_FALSE(auraStringsEqual(a, d));
+    TEST_ASSERT_TRUE(auraValuesEqual(d, createSTRING("x")));
+
+    freeValue(a);
+    freeValue(b);
+    freeValue(c);
+}
+
+/**
+ * @brief Tests that strings with embedded NUL bytes keep their full length.
+ */
+void test_embedded_nul(void) {
+    AuraValue s = auraCopyString("a\0b", 3);
+    TEST_ASSERT_EQUAL_size_t(3, auraStringLength(s));
+    TEST_ASSERT_EQUAL_MEMORY("a\0b", auraStringChars(&s), 3);
+    freeValue(s);
+}
+
+/**
+ * @brief Tests that interning equal contents yields the same object.
+ */
+void test_intern_returns_unique_object(void) {
+    const char* key = "interned_property_key";
+    AuraValue a = auraInternString(key, strlen(key));
+    AuraValue b = auraIntern(createSTRING((char*)key));
+
+    TEST_ASSERT_TRUE(auraIsInterned(a));
+    TEST_ASSERT_EQUAL_PTR(AURA_AS_OBJ(a), AURA_AS_OBJ(b));
+    TEST_ASSERT_EQUAL_UINT32(2, AURA_AS_STRING(a)->header.refs);
+    TEST_ASSERT_TRUE(auraStringsEqual(a, b));
+
+    AuraValue other = auraInternString("interned_property_kez", 21);
+    TEST_ASSERT_FALSE(auraStringsEqual(a, other));
+
+    freeValue(a);
+    freeValue(b);
+    freeValue(other);
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+}
+
+/**
+ * @brief Tests that the entry survives until its last owner releases it.
+ */
+void test_intern_entry_is_weak(void) {
+    const char* key = "weakly_held_string";
+    AuraValue a = auraInternString(key, strlen(key));
+    AuraValue b = auraInternString(key, strlen(key));
+    TEST_ASSERT_EQUAL_size_t(1, auraInternStats().live);
+
+    freeValue(a);
+    TEST_ASSERT_EQUAL_size_t(1, auraInternStats().live);
+    TEST_ASSERT_EQUAL_STRING(key, auraStringChars(&b));
+
+    freeValue(b);
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+}
+
+/**
+ * @brief Tests that short strings bypass the table entirely.
+ */
+void test_intern_short_strings_stay_inline(void) {
+    AuraValue s = auraInternString("id", 2);
+    TEST_ASSERT_FALSE(AURA_IS_OBJ(s));
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+}
+
+/**
+ * @brief Tests that heavy churn does not grow the table without bound.
+ */
+void test_intern_churn_is_bounded(void) {
+    char buffer[64];
+    AuraValue keep[8];
+
+    for (int i = 0; i < 8; i++) {
+        int length = snprintf(buffer, sizeof(buffer), "long_lived_key_%d", i);
+        keep[i] = auraInternString(buffer, (size_t)length);
+    }
+
+    for (int round = 0; round < 100; round++) {
+        AuraValue batch[100];
+        for (int i = 0; i < 100; i++) {
+            int length = snprintf(buffer, sizeof(buffer), "transient_key_%d_%d", round, i);
+            batch[i] = auraInternString(buffer, (size_t)length);
+        }
+        for (int i = 0; i < 100; i++) freeValue(batch[i]);
+    }
+
+    AuraInternStats stats = auraInternStats();
+    TEST_ASSERT_EQUAL_size_t(8, stats.live);
+    TEST_ASSERT_TRUE(stats.capacity <= 512);
+
+    for (int i = 0; i < 8; i++) freeValue(keep[i]);
+}
+
+static bool keepNothing(const AuraString* string) {
+    (void)string;
+    return false;
+}
+
+/**
+ * @brief Tests the tracing-collector hook that drops unreachable entries.
+ */
+void test_intern_sweep(void) {
+    AuraValue s = auraInternString("collected_by_gc_later", 21);
+    TEST_ASSERT_EQUAL_size_t(1, auraInternStats().live);
+
+    auraInternSweep(keepNothing);
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+
+    AuraValue fresh = auraInternString("collected_by_gc_later", 21);
+    TEST_ASSERT_TRUE(AURA_AS_OBJ(fresh) != AURA_AS_OBJ(s));
+
+    freeValue(s);
+    freeValue(fresh);
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+}
+
+/**
+ * @brief Tests that strings outliving the table still compare by content.
+ */
+void test_intern_table_free_keeps_equality(void) {
+    const char* key = "survives_the_intern_table_being_released";
+    AuraValue a = auraInternString(key, strlen(key));
+    auraFreeInternTable();
+    TEST_ASSERT_FALSE(auraIsInterned(a));
+
+    AuraValue b = auraInternString(key, strlen(key));
+    TEST_ASSERT_TRUE(AURA_AS_OBJ(a) != AURA_AS_OBJ(b));
+    TEST_ASSERT_TRUE(auraStringsEqual(a, b));
+
+    freeValue(a);
+    freeValue(b);
+    TEST_ASSERT_EQUAL_size_t(0, auraInternStats().live);
+}
+
+/**
+ * @brief Tests that long concatenations produce a rope with the right contents.
+ */
+void test_concat_builds_rope(void) {
+    AuraValue left = createSTRING("the quick brown fox ");
+    AuraValue right = createSTRING("jumps over the lazy dog");
+    AuraValue joined = auraConcat(left, right);
+
+    TEST_ASSERT_TRUE(AURA_IS_ROPE(joined));
+    TEST_ASSERT_EQUAL_INT(AURA_STRING, auraTypeOf(joined));
+    TEST_ASSERT_EQUAL_size_t(43, auraStringLength(joined));
+    TEST_ASSERT_EQUAL_STRING("the quick brown fox jumps over the lazy dog", auraStringChars(&joined));
+
+    // The operands remain owned by the caller and stay valid.
+    TEST_ASSERT_EQUAL_STRING("jumps over the lazy dog", auraStringChars(&right));
+
+    freeValue(left);
+    freeValue(right);
+    TEST_ASSERT_EQUAL_STRING("the quick brown fox jumps over the lazy dog", auraStringChars(&joined));
+    freeValue(joined);
+}
+
+/**
+ * @brief Tests that short concatenations are copied flat and empty operands are shared.
+ */
+void test_concat_short_and_empty(void) {
+    AuraValue a = createSTRING("ab");
+    AuraValue b = createSTRING("cd");
+    AuraValue joined = auraConcat(a, b);
+    TEST_ASSERT_FALSE(AURA_IS_ROPE(joined));
+    TEST_ASSERT_EQUAL_STRING("abcd", auraStringChars(&joined));
+    freeValue(joined);
+
+    AuraValue longer = createSTRING("long enough to live on the heap");
+    AuraValue same = auraConcat(longer, createSTRING(""));
+    TEST_ASSERT_EQUAL_PTR(AURA_AS_OBJ(longer), AURA_AS_OBJ(same));
+    freeValue(same);
+    freeValue(longer);
+}
+
+/**
+ * @brief Tests that the rope hash and equality match the flat equivalent.
+ */
+void test_rope_hash_and_equality(void) {
+    AuraValue a = createSTRING("0123456789abcdefghij");
+    AuraValue b = createSTRING("klmnopqrstuvwxyz");
+    AuraValue rope = auraConcat(a, b);
+    AuraValue flat = createSTRING("0123456789abcdefghijklmnopqrstuvwxyz");
+
+    TEST_ASSERT_TRUE(auraStringsEqual(rope, flat));
+    TEST_ASSERT_EQUAL_UINT32(auraStringHash(flat), auraStringHash(rope));
+
+    AuraValue interned = auraIntern(rope);
+    TEST_ASSERT_TRUE(auraIsInterned(interned));
+    TEST_ASSERT_EQUAL_STRING("0123456789abcdefghijklmnopqrstuvwxyz", auraStringChars(&interned));
+
+    freeValue(interned);
+    freeValue(flat);
+    freeValue(a);
+    freeValue(b);
+}
+
+/**
+ * @brief Builds a string with `s = s + piece` (or `piece + s`) and checks the result.
+ *
+ * The chain is deep enough that recursive flattening or freeing would blow the stack.
+ */
+static void buildAndCheckChain(bool append) {
+    const int pieces = 200000;
+    AuraValue piece = createSTRING("0123456789");
+    AuraValue s = createSTRING("");
+
+    for (int i = 0; i < pieces; i++) {
+        AuraValue next = append ? auraConcat(s, piece) : auraConcat(piece, s);
+        freeValue(s);
+        s = next;
+    }
+
+    TEST_ASSERT_EQUAL_size_t((size_t)pieces * 10, auraStringLength(s));
+    const char* chars = auraStringChars(&s);
+    TEST_ASSERT_EQUAL_MEMORY("01234567890123456789", chars, 20);
+    TEST_ASSERT_EQUAL_MEMORY("0123456789", chars + (size_t)pieces * 10 - 10, 10);
+    TEST_ASSERT_EQUAL_INT('\0', chars[(size_t)pieces * 10]);
+
+    freeValue(s);
+    freeValue(piece);
+}
+
+void test_deep_append_chain(void) {
+    buildAndCheckChain(true);
+}
+
+void test_deep_prepend_chain(void) {
+    buildAndCheckChain(false);
+}
+
+/**
+ * @brief Tests that freeing an unflattened deep rope does not recurse.
+ */
+void test_free_unflattened_deep_rope(void) {
+    AuraValue piece = createSTRING("a fairly long piece of text!");
+    AuraValue s = auraStringRetain(piece);
+    for (int i = 0; i < 200000; i++) {
+        AuraValue next = auraConcat(s, piece);
+        freeValue(s);
+        s = next;
+    }
+    freeValue(s);
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_STRING_HEADER(piece)->refs);
+    freeValue(piece);
+}
+
+/**
+ * @brief Tests a balanced rope whose nodes have two rope children.
+ */
+void test_balanced_rope(void) {
+    AuraValue level[64];
+    char buffer[64];
+    int count = 64;
+
+    for (int i = 0; i < count; i++) {
+        snprintf(buffer, sizeof(buffer), "leaf-%02d-padding-to-force-heap", i);
+        level[i] = createSTRING(buffer);
+    }
+    while (count > 1) {
+        for (int i = 0; i < count / 2; i++) {
+            AuraValue joined = auraConcat(level[2 * i], level[2 * i + 1]);
+            freeValue(level[2 * i]);
+            freeValue(level[2 * i + 1]);
+            level[i] = joined;
+        }
+        count /= 2;
+    }
+
+    const char* chars = auraStringChars(&level[0]);
+    TEST_ASSERT_EQUAL_size_t(64 * 29, auraStringLength(level[0]));
+    TEST_ASSERT_EQUAL_MEMORY("leaf-00-padding-to-force-heapleaf-01", chars, 36);
+    TEST_ASSERT_EQUAL_MEMORY("leaf-63-padding-to-force-heap", chars + 63 * 29, 29);
+    freeValue(level[0]);
+}
+
+/**
+ * @brief Tests that a long substring shares the parent's bytes.
+ */
+void test_substring_is_zero_copy(void) {
+    const char* text = "The quick brown fox jumps over the lazy dog, twice over.";
+    AuraValue parent = createSTRING((char*)text);
+    const char* parentChars = auraStringChars(&parent);
+
+    AuraValue slice = auraSubstring(parent, 4, 44);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(slice));
+    TEST_ASSERT_EQUAL_size_t(40, auraStringLength(slice));
+    TEST_ASSERT_EQUAL_PTR(parentChars + 4, auraStringData(&slice));
+    TEST_ASSERT_EQUAL_UINT32(2, AURA_AS_STRING_HEADER(parent)->refs);
+
+    AuraValue copy = auraCopyString(text + 4, 40);
+    TEST_ASSERT_TRUE(auraStringsEqual(slice, copy));
+    TEST_ASSERT_EQUAL_UINT32(auraStringHash(copy), auraStringHash(slice));
+
+    // Reading a NUL-terminated view copies the bytes once and unpins the parent.
+    TEST_ASSERT_EQUAL_MEMORY(text + 4, auraStringChars(&slice), 40);
+    TEST_ASSERT_EQUAL_INT('\0', auraStringChars(&slice)[40]);
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_STRING_HEADER(parent)->refs);
+
+    freeValue(copy);
+    freeValue(slice);
+    freeValue(parent);
+}
+
+/**
+ * @brief Tests that a suffix slice reuses the parent's terminator.
+ */
+void test_suffix_slice_stays_shared(void) {
+    const char* text = "header: a value long enough to be worth sharing";
+    AuraValue parent = createSTRING((char*)text);
+
+    AuraValue suffix = auraSubstring(parent, 8, 1000);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(suffix));
+    TEST_ASSERT_EQUAL_STRING(text + 8, auraStringChars(&suffix));
+    TEST_ASSERT_EQUAL_PTR(auraStringChars(&parent) + 8, auraStringChars(&suffix));
+
+    // The whole string is returned as is, and reversed bounds are swapped.
+    AuraValue whole = auraSubstring(parent, 0, strlen(text));
+    TEST_ASSERT_EQUAL_PTR(AURA_AS_OBJ(parent), AURA_AS_OBJ(whole));
+    AuraValue swapped = auraSubstring(parent, 40, 0);
+    TEST_ASSERT_EQUAL_MEMORY(text, auraStringData(&swapped), 40);
+
+    freeValue(swapped);
+    freeValue(whole);
+    freeValue(suffix);
+    freeValue(parent);
+}
+
+/**
+ * @brief Tests the copy-out heuristics for short and pinning slices.
+ */
+void test_slice_copy_heuristics(void) {
+    size_t length = AURA_SLICE_PIN_LIMIT * AURA_SLICE_PIN_RATIO * 2;
+    char* big = (char*)malloc(length);
+    memset(big, 'x', length);
+    AuraValue parent = auraCopyString(big, length);
+
+    AuraValue tiny = auraSubstring(parent, 10, 10 + AURA_SLICE_MIN_LENGTH - 1);
+    TEST_ASSERT_FALSE(AURA_IS_SLICE(tiny));
+
+    AuraValue pinning = auraSubstring(parent, 10, 10 + AURA_SLICE_PIN_LIMIT);
+    TEST_ASSERT_FALSE(AURA_IS_SLICE(pinning));
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_STRING_HEADER(parent)->refs);
+
+    AuraValue large = auraSubstring(parent, 10, length - 10);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(large));
+
+    freeValue(tiny);
+    freeValue(pinning);
+    freeValue(large);
+    freeValue(parent);
+    free(big);
+}
+
+/**
+ * @brief Tests that slices of slices and of ropes reference the flat root.
+ */
+void test_slice_of_slice_and_rope(void) {
+    AuraValue a = createSTRING("0123456789abcdefghijklmnopqrstuvwxyz");
+    AuraValue b = createSTRING("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+    AuraValue rope = auraConcat(a, b);
+
+    AuraValue outer = auraSubstring(rope, 2, 70);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(outer));
+    AuraValue inner = auraSubstring(outer, 8, 48);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(inner));
+    TEST_ASSERT_EQUAL_PTR(((AuraSlice*)AURA_AS_OBJ(outer))->parent,
+                          ((AuraSlice*)AURA_AS_OBJ(inner))->parent);
+    TEST_ASSERT_EQUAL_MEMORY("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMN", auraStringData(&inner), 40);
+
+    // Slices outlive every other owner of their bytes.
+    freeValue(rope);
+    freeValue(a);
+    freeValue(b);
+    freeValue(outer);
+    TEST_ASSERT_EQUAL_MEMORY("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMN", auraStringData(&inner), 40);
+
+    AuraValue interned = auraIntern(auraStringRetain(inner));
+    TEST_ASSERT_TRUE(auraIsInterned(interned));
+    TEST_ASSERT_TRUE(auraStringsEqual(interned, inner));
+
+    freeValue(interned);
+    freeValue(inner);
+}
+
+/**
+ * @brief Tests trimming of ASCII whitespace.
+ */
+void test_string_trim(void) {
+    AuraValue padded = createSTRING(" \t  a line with surrounding whitespace in it \r\n");
+    AuraValue trimmed = auraStringTrim(padded);
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(trimmed));
+    TEST_ASSERT_EQUAL_size_t(40, auraStringLength(trimmed));
+    TEST_ASSERT_EQUAL_MEMORY("a line with surrounding whitespace in it", auraStringData(&trimmed), 40);
+
+    AuraValue blank = createSTRING("   \n   ");
+    AuraValue empty = auraStringTrim(blank);
+    TEST_ASSERT_EQUAL_size_t(0, auraStringLength(empty));
+
+    freeValue(empty);
+    freeValue(blank);
+    freeValue(trimmed);
+    freeValue(padded);
+}
+
+/**
+ * @brief Tests splitting around a separator and into single characters.
+ */
+void test_string_split(void) {
+    AuraValue csv = createSTRING("id,this field is long enough to be a slice,,x");
+    size_t count = 0;
+    AuraValue* parts = auraStringSplit(csv, ",", 1, &count);
+
+    TEST_ASSERT_EQUAL_size_t(4, count);
+    TEST_ASSERT_EQUAL_STRING("id", auraStringChars(&parts[0]));
+    TEST_ASSERT_TRUE(AURA_IS_SLICE(parts[1]));
+    TEST_ASSERT_EQUAL_MEMORY("this field is long enough to be a slice", auraStringData(&parts[1]), 39);
+    TEST_ASSERT_EQUAL_size_t(0, auraStringLength(parts[2]));
+    TEST_ASSERT_EQUAL_STRING("x", auraStringChars(&parts[3]));
+    for (size_t i = 0; i < count; i++) freeValue(parts[i]);
+    free(parts);
+
+    AuraValue word = createSTRING("abc");
+    parts = auraStringSplit(word, "", 0, &count);
+    TEST_ASSERT_EQUAL_size_t(3, count);
+    TEST_ASSERT_EQUAL_STRING("c", auraStringChars(&parts[2]));
+    for (size_t i = 0; i < count; i++) freeValue(parts[i]);
+    free(parts);
+
+    freeValue(word);
+    freeValue(csv);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_short_strings_are_inline);
+    RUN_TEST(test_inline_capacity_boundary);
+    RUN_TEST(test_empty_string);
+    RUN_TEST(test_heap_string_metadata);
+    RUN_TEST(test_hash_is_layout_independent);
+    RUN_TEST(test_string_equality);
+    RUN_TEST(test_embedded_nul);
+    RUN_TEST(test_intern_returns_unique_object);
+    RUN_TEST(test_intern_entry_is_weak);
+    RUN_TEST(test_intern_short_strings_stay_inline);
+    RUN_TEST(test_intern_churn_is_bounded);
+    RUN_TEST(test_intern_sweep);
+    RUN_TEST(test_intern_table_free_keeps_equality);
+    RUN_TEST(test_concat_builds_rope);
+    RUN_TEST(test_concat_short_and_empty);
+    RUN_TEST(test_rope_hash_and_equality);
+    RUN_TEST(test_deep_append_chain);
+    RUN_TEST(test_deep_prepend_chain);
+    RUN_TEST(test_free_unflattened_deep_rope);
+    RUN_TEST(test_balanced_rope);
+    RUN_TEST(test_substring_is_zero_copy);
+    RUN_TEST(test_suffix_slice_stays_shared);
+    RUN_TEST(test_slice_copy_heuristics);
+    RUN_TEST(test_slice_of_slice_and_rope);
+    RUN_TEST(test_string_trim);
+    RUN_TEST(test_string_split);
+
+    auraFreeInternTable();
+
+    return UNITY_END();
+}
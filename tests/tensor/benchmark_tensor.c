@@ -0,0 +1,412 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../include/sparse_tensor.h"
+#include "../../include/tensor.h"
+#include "../../include/thread_pool.h"
+#include "../../include/vec3.h"
+#include "../../include/vec3_array.h"
+
+/**
+ * @file benchmark_tensor.c
+ * @brief Performance benchmark for tensor matrix multiplication.
+ *
+ * Reports GEMM throughput in GFLOP/s (2 * m * n * k floating-point operations
+ * per product) for square shapes and for skinny shapes typical of inference
+ * (matrix-vector, small batch), on every SIMD tier the CPU supports, then
+ * the speedup of GEMM and of an elementwise operation as the thread pool
+ * grows, and finally `relu(a * b + c)` as three eager operations versus one
+ * fused expression, and Vec3 arrays against one Vec3 value per element.
+ * Times are wall-clock, since CPU time adds up across threads.
+ */
+
+static const int SHAPES[][3] = {
+    {128, 128, 128}, {256, 256, 256}, {512, 512, 512}, {1024, 1024, 1024},
+    {1024, 1024, 1}, {1024, 1024, 16}, {16, 1024, 1024}, {4096, 64, 64}
+};
+#define SHAPE_COUNT (sizeof(SHAPES) / sizeof(SHAPES[0]))
+
+/** Monotonic wall-clock time in seconds. */
+static double wallSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static AuraValue filledTensor(int rows, int cols) {
+    AuraValue v = createTENSOR(rows, cols);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    for (size_t r = 0; r < t->rows; r++) {
+        for (size_t c = 0; c < t->cols; c++) AURA_TENSOR_AT(t, r, c) = (float)((r * 7 + c * 3) % 11) * 0.1f;
+    }
+    return v;
+}
+
+/**
+ * @brief Multiplies an m x k by a k x n tensor until at least ~0.2 s elapsed.
+ *
+ * @return Throughput in GFLOP/s.
+ */
+double benchmarkMatmul(int m, int k, int n) {
+    AuraValue a = filledTensor(m, k);
+    AuraValue b = filledTensor(k, n);
+    double flops = 2.0 * m * n * k;
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        freeValue(auraTensorMatmul(a, b));
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    freeValue(a);
+    freeValue(b);
+    return flops * iterations / seconds / 1e9;
+}
+
+/**
+ * @brief Adds two rows x cols tensors until at least ~0.2 s elapsed.
+ *
+ * @return Throughput in G elements/s.
+ */
+double benchmarkAdd(int rows, int cols) {
+    AuraValue a = filledTensor(rows, cols);
+    AuraValue b = filledTensor(rows, cols);
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        freeValue(auraTensorAdd(a, b));
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    freeValue(a);
+    freeValue(b);
+    return (double)rows * cols * iterations / seconds / 1e9;
+}
+
+/**
+ * @brief Computes relu(a * b + c) on rows x cols tensors until at least
+ * ~0.2 s elapsed, either eagerly (three passes, two temporaries) or as one
+ * fused expression.
+ *
+ * @return Throughput in G elements/s.
+ */
+double benchmarkChain(int rows, int cols, bool fused) {
+    AuraValue a = filledTensor(rows, cols);
+    AuraValue b = filledTensor(rows, cols);
+    AuraValue c = filledTensor(rows, cols);
+
+    AuraTensorExpr* expr = auraTensorExprCreate();
+    AuraExprNode product = auraTensorExprBinary(expr, AURA_TENSOR_MUL, auraTensorExprInput(expr, a),
+                                                auraTensorExprInput(expr, b));
+    AuraExprNode root = auraTensorExprUnary(expr, AURA_TENSOR_RELU,
+        auraTensorExprBinary(expr, AURA_TENSOR_ADD, product, auraTensorExprInput(expr, c)));
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        if (fused) {
+            freeValue(auraTensorExprEvaluate(expr, root));
+        } else {
+            AuraValue ab = auraTensorMul(a, b);
+            AuraValue sum = auraTensorAdd(ab, c);
+            freeValue(auraTensorRelu(sum));
+            freeValue(ab);
+            freeValue(sum);
+        }
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    auraTensorExprFree(expr);
+    freeValue(a);
+    freeValue(b);
+    freeValue(c);
+    return (double)rows * cols * iterations / seconds / 1e9;
+}
+
+/**
+ * @brief Measures a linear layer `x * w^T` with weights stored as `dtype`
+ * (activations stay float32 and are converted on the fly).
+ *
+ * @return GFLOP/s.
+ */
+double benchmarkLinear(int batch, int inputs, int outputs, AuraDType dtype) {
+    AuraValue x = filledTensor(batch, inputs);
+    AuraValue w32 = filledTensor(outputs, inputs);
+    AuraValue w = auraTensorConvert(w32, dtype);
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        freeValue(auraTensorMatmulTransposed(x, w));
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.3);
+
+    freeValue(x);
+    freeValue(w32);
+    freeValue(w);
+    return 2.0 * batch * inputs * outputs * iterations / seconds / 1e9;
+}
+
+/**
+ * @brief Runs one reduction of a rows x cols tensor until at least ~0.2 s
+ * elapsed.
+ *
+ * @return Throughput in G elements/s.
+ */
+double benchmarkReduce(int rows, int cols, AuraTensorReduceOp op, int axis) {
+    AuraValue a = filledTensor(rows, cols);
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        freeValue(auraTensorReduce(op, a, axis));
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    freeValue(a);
+    return (double)rows * cols * iterations / seconds / 1e9;
+}
+
+/**
+ * @brief Multiplies an n x n matrix with one non-zero in `every` elements by a
+ * vector (batch 1) or an n x batch matrix until at least ~0.2 s elapsed,
+ * either dense or as a sparse tensor.
+ *
+ * @return Useful (non-zero) GFLOP/s.
+ */
+double benchmarkSparse(int n, int every, int batch, bool sparse) {
+    AuraValue a = createTENSOR(n, n);
+    AuraTensor* t = AURA_AS_TENSOR(a);
+    size_t nonzeros = 0;
+    for (int r = 0; r < n; r++) {
+        for (int c = r % every; c < n; c += every) {
+            AURA_TENSOR_AT(t, r, c) = 0.5f;
+            nonzeros++;
+        }
+    }
+    AuraValue s = auraSparseFromDense(a);
+    int vectorShape[] = { n };
+    AuraValue x = batch == 1 ? createTENSORND(1, vectorShape) : filledTensor(n, batch);
+    AuraValue column = batch == 1 ? filledTensor(n, 1) : x;
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        if (sparse) {
+            freeValue(batch == 1 ? auraSparseMatvec(s, x) : auraSparseMatmul(s, x));
+        } else {
+            freeValue(auraTensorMatmul(a, column));
+        }
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    if (batch == 1) freeValue(column);
+    freeValue(x);
+    freeValue(s);
+    freeValue(a);
+    return 2.0 * nonzeros * batch * iterations / seconds / 1e9;
+}
+
+typedef enum { VEC3_ADD, VEC3_DOT, VEC3_CROSS, VEC3_NORMALIZE, VEC3_OP_COUNT } Vec3BenchOp;
+
+/** One operation on two Vec3 values through the value API, as a script would run it per element. */
+static AuraValue vec3ValueOp(Vec3BenchOp op, AuraValue a, AuraValue b) {
+    switch (op) {
+    case VEC3_ADD:   return auraVec3Add(a, b);
+    case VEC3_DOT:   return auraVec3Dot(a, b);
+    case VEC3_CROSS: return auraVec3Cross(a, b);
+    default:         return auraVec3Normalize(a);
+    }
+}
+
+/**
+ * @brief Runs one Vec3 operation over `n` element pairs until at least
+ * ~0.2 s elapsed, either on two Vec3 arrays or one Vec3 value at a time.
+ *
+ * @return Throughput in M elements/s.
+ */
+double benchmarkVec3(int n, Vec3BenchOp op, bool batched) {
+    AuraValue a = auraVec3ArrayCreate((size_t)n);
+    AuraValue b = auraVec3ArrayCreate((size_t)n);
+    AuraValue* boxedA = (AuraValue*)malloc((size_t)n * sizeof(AuraValue));
+    AuraValue* boxedB = (AuraValue*)malloc((size_t)n * sizeof(AuraValue));
+    for (int i = 0; i < n; i++) {
+        AuraVec3Array* va = AURA_AS_VEC3_ARRAY(a);
+        AuraVec3Array* vb = AURA_AS_VEC3_ARRAY(b);
+        va->x[i] = (float)(i % 7); va->y[i] = (float)(i % 5) - 2.0f; va->z[i] = 0.5f;
+        vb->x[i] = 1.0f; vb->y[i] = (float)(i % 3); vb->z[i] = -(float)(i % 11);
+        boxedA[i] = createVEC3(va->x[i], va->y[i], va->z[i]);
+        boxedB[i] = createVEC3(vb->x[i], vb->y[i], vb->z[i]);
+    }
+
+    int iterations = 0;
+    double start = wallSeconds();
+    double seconds;
+    do {
+        if (batched) {
+            AuraValue result = op == VEC3_ADD ? auraVec3ArrayAdd(a, b)
+                             : op == VEC3_DOT ? auraVec3ArrayDot(a, b)
+                             : op == VEC3_CROSS ? auraVec3ArrayCross(a, b) : auraVec3ArrayNormalize(a);
+            freeValue(result);
+        } else {
+            for (int i = 0; i < n; i++) freeValue(vec3ValueOp(op, boxedA[i], boxedB[i]));
+        }
+        iterations++;
+        seconds = wallSeconds() - start;
+    } while (seconds < 0.2);
+
+    for (int i = 0; i < n; i++) {
+        freeValue(boxedA[i]);
+        freeValue(boxedB[i]);
+    }
+    free(boxedA);
+    free(boxedB);
+    freeValue(a);
+    freeValue(b);
+    return (double)n * iterations / seconds / 1e6;
+}
+
+/**
+ * @brief Main entry point for the benchmark.
+ *
+ * @return 0 on success.
+ */
+int main(void) {
+    printf("Starting tensor benchmark...\n");
+    printf("\n--------------------------------\n");
+    printf("GEMM GFLOP/s (m x k x n)\n");
+    printf("%-18s", "shape");
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        printf("%10s", auraSimdLevelName((AuraSimdLevel)level));
+    }
+    printf("\n");
+
+    for (size_t s = 0; s < SHAPE_COUNT; s++) {
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%dx%d", SHAPES[s][0], SHAPES[s][1], SHAPES[s][2]);
+        printf("%-18s", label);
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            printf("%10.2f", benchmarkMatmul(SHAPES[s][0], SHAPES[s][1], SHAPES[s][2]));
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+
+    size_t maxThreads = auraThreadPoolSize();
+    printf("\nScaling on %s, up to %zu threads (AURA_THREADS overrides)\n",
+           auraSimdLevelName(auraTensorSimdLevel()), maxThreads);
+    printf("%-8s%16s%10s%20s%10s\n", "threads", "GEMM 1024 GF/s", "speedup", "add 2048^2 Gelem/s", "speedup");
+    double gemmBase = 0.0, addBase = 0.0;
+    // Powers of two, then the full pool.
+    for (size_t threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        auraThreadPoolSetSize(threads);
+        double gemm = benchmarkMatmul(1024, 1024, 1024);
+        double add = benchmarkAdd(2048, 2048);
+        if (threads == 1) {
+            gemmBase = gemm;
+            addBase = add;
+        }
+        printf("%-8zu%16.2f%9.2fx%20.2f%9.2fx\n", threads, gemm, gemm / gemmBase, add, add / addBase);
+        fflush(stdout);
+        if (threads == maxThreads) break;
+    }
+    auraThreadPoolSetSize(0);
+
+    printf("\nrelu(a * b + c), G elements/s\n");
+    printf("%-12s%10s%10s%10s\n", "size", "eager", "fused", "speedup");
+    static const int CHAIN_SIDES[] = { 256, 1024, 2048 };
+    for (size_t s = 0; s < sizeof(CHAIN_SIDES) / sizeof(CHAIN_SIDES[0]); s++) {
+        int side = CHAIN_SIDES[s];
+        double eager = benchmarkChain(side, side, false);
+        double fused = benchmarkChain(side, side, true);
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%d", side, side);
+        printf("%-12s%10.2f%10.2f%9.2fx\n", label, eager, fused, fused / eager);
+        fflush(stdout);
+    }
+
+    printf("\nReductions of a 2048x2048 tensor, G elements/s\n");
+    static const char* const REDUCE_NAMES[] = { "sum", "mean", "max", "argmax", "norm" };
+    static const char* const AXIS_NAMES[] = { "all", "columns", "rows" };
+    printf("%-10s", "op");
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        for (int axis = AURA_TENSOR_ALL_AXES; axis <= 1; axis++) {
+            char label[32];
+            snprintf(label, sizeof(label), "%s/%s", auraSimdLevelName((AuraSimdLevel)level), AXIS_NAMES[axis + 1]);
+            printf("%14s", label);
+        }
+    }
+    printf("\n");
+    for (int op = 0; op < AURA_TENSOR_REDUCE_OP_COUNT; op++) {
+        printf("%-10s", REDUCE_NAMES[op]);
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            for (int axis = AURA_TENSOR_ALL_AXES; axis <= 1; axis++) {
+                printf("%14.2f", benchmarkReduce(2048, 2048, (AuraTensorReduceOp)op, axis));
+                fflush(stdout);
+            }
+        }
+        printf("\n");
+    }
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+
+    printf("\nSparse (5%% non-zeros) vs dense 4096x4096, useful GFLOP/s\n");
+    printf("%-12s%10s%10s%10s\n", "batch", "dense", "sparse", "speedup");
+    static const int SPARSE_BATCHES[] = { 1, 64 };
+    for (size_t b = 0; b < sizeof(SPARSE_BATCHES) / sizeof(SPARSE_BATCHES[0]); b++) {
+        double denseRate = benchmarkSparse(4096, 20, SPARSE_BATCHES[b], false);
+        double sparseRate = benchmarkSparse(4096, 20, SPARSE_BATCHES[b], true);
+        printf("%-12d%10.2f%10.2f%9.2fx\n", SPARSE_BATCHES[b], denseRate, sparseRate, sparseRate / denseRate);
+        fflush(stdout);
+    }
+
+    printf("\nVec3 operations on 100000 elements, M elements/s\n");
+    static const char* const VEC3_NAMES[] = { "add", "dot", "cross", "normalize" };
+    printf("%-12s%10s", "op", "values");
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        printf("%10s", auraSimdLevelName((AuraSimdLevel)level));
+    }
+    printf("\n");
+    for (int op = 0; op < VEC3_OP_COUNT; op++) {
+        printf("%-12s%10.1f", VEC3_NAMES[op], benchmarkVec3(100000, (Vec3BenchOp)op, false));
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            printf("%10.1f", benchmarkVec3(100000, (Vec3BenchOp)op, true));
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+
+    printf("\nLinear layer x * w^T, GFLOP/s by weight dtype (4096 -> 4096)\n");
+    printf("%-8s", "batch");
+    for (int dtype = AURA_DTYPE_F32; dtype < AURA_DTYPE_COUNT; dtype++) printf("%10s", auraDTypeName((AuraDType)dtype));
+    printf("\n");
+    static const int BATCHES[] = { 1, 16, 128 };
+    for (size_t b = 0; b < sizeof(BATCHES) / sizeof(BATCHES[0]); b++) {
+        printf("%-8d", BATCHES[b]);
+        for (int dtype = AURA_DTYPE_F32; dtype < AURA_DTYPE_COUNT; dtype++) {
+            printf("%10.2f", benchmarkLinear(BATCHES[b], 4096, 4096, (AuraDType)dtype));
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    printf("--------------------------------\n");
+    return 0;
+}
@@ -0,0 +1,1472 @@
+#include "../../tests/unity/unity.h"
+#include "tensor.h"
+#include "sparse_tensor.h"
+#include "tensor_file.h"
+#include "vec3_array.h"
+#include "thread_pool.h"
+#include <math.h>
+
+/**
+ * @file test_tensor.c
+ * @brief Unit tests for the tensor operations.
+ *
+ * Vector kernels are checked against the scalar reference on every SIMD tier
+ * the machine supports, on shapes that exercise both the padded (per-row) and
+ * the unpadded (single run) paths and every loop remainder.
+ */
+
+static const int SHAPES[][2] = { {1, 1}, {3, 5}, {4, 16}, {7, 37}, {2, 64}, {9, 100} };
+#define SHAPE_COUNT (sizeof(SHAPES) / sizeof(SHAPES[0]))
+
+void setUp(void) {
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+}
+
+void tearDown(void) {
+    auraThreadPoolSetSize(0);
+}
+
+// --- HELPERS ---
+
+static uint32_t seed = 12345;
+
+/** Deterministic pseudo-random float in [lo, hi). */
+static float randomFloat(float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (float)(seed >> 8) / (float)(1u << 24);
+}
+
+static AuraValue randomTensor(int rows, int cols, float lo, float hi) {
+    AuraValue v = createTENSOR(rows, cols);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    for (size_t r = 0; r < t->rows; r++) {
+        for (size_t c = 0; c < t->cols; c++) AURA_TENSOR_AT(t, r, c) = randomFloat(lo, hi);
+    }
+    return v;
+}
+
+static AuraValue randomTensorND(int ndim, const int* shape, float lo, float hi) {
+    AuraValue v = createTENSORND(ndim, shape);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    for (size_t r = 0; r < t->rows; r++) {
+        for (size_t c = 0; c < t->cols; c++) AURA_TENSOR_AT(t, r, c) = randomFloat(lo, hi);
+    }
+    return v;
+}
+
+/** Element at a full N-D index, honouring the tensor's strides (0 for broadcast dims). */
+static float elementAt(const AuraTensor* t, const size_t* index) {
+    const float* p = t->data;
+    for (int d = 0; d < t->ndim; d++) p += index[d] * t->strides[d];
+    return *p;
+}
+
+/**
+ * Asserts that two tensors match within `absTol + relTol * |expected|` and
+ * that the padding of `actual` is still zero.
+ */
+static void assertTensorsClose(AuraValue expected, AuraValue actual, float absTol, float relTol) {
+    TEST_ASSERT_TRUE(AURA_IS_TENSOR(actual));
+    AuraTensor* e = AURA_AS_TENSOR(expected);
+    AuraTensor* a = AURA_AS_TENSOR(actual);
+    TEST_ASSERT_EQUAL_size_t(e->rows, a->rows);
+    TEST_ASSERT_EQUAL_size_t(e->cols, a->cols);
+
+    for (size_t r = 0; r < e->rows; r++) {
+        for (size_t c = 0; c < e->cols; c++) {
+            float want = AURA_TENSOR_AT(e, r, c);
+            float got = AURA_TENSOR_AT(a, r, c);
+            TEST_ASSERT_FLOAT_WITHIN(absTol + relTol * fabsf(want), want, got);
+        }
+        for (size_t c = a->cols; c < a->stride; c++) TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_TENSOR_AT(a, r, c));
+    }
+}
+
+/**
+ * Runs `op` on every supported SIMD tier and compares each result with the
+ * scalar reference.
+ */
+typedef AuraValue (*TensorOp)(AuraValue* operands);
+
+static void compareAllTiers(TensorOp op, AuraValue* operands, float absTol, float relTol) {
+    auraTensorSetSimdLevel(AURA_SIMD_SCALAR);
+    AuraValue reference = op(operands);
+
+    for (int level = AURA_SIMD_SSE2; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        TEST_ASSERT_EQUAL_INT(level, auraTensorSetSimdLevel((AuraSimdLevel)level));
+        AuraValue result = op(operands);
+        assertTensorsClose(reference, result, absTol, relTol);
+        freeValue(result);
+    }
+    freeValue(reference);
+}
+
+static AuraValue opAdd(AuraValue* x) { return auraTensorAdd(x[0], x[1]); }
+static AuraValue opSub(AuraValue* x) { return auraTensorSub(x[0], x[1]); }
+static AuraValue opMul(AuraValue* x) { return auraTensorMul(x[0], x[1]); }
+static AuraValue opDiv(AuraValue* x) { return auraTensorDiv(x[0], x[1]); }
+static AuraValue opFma(AuraValue* x) { return auraTensorFma(x[0], x[1], x[2]); }
+static AuraValue opSubScalar(AuraValue* x) { return auraTensorSub(x[0], createNUMBER(0.75)); }
+static AuraValue opScalarDiv(AuraValue* x) { return auraTensorDiv(createINT(3), x[1]); }
+static AuraValue opRelu(AuraValue* x) { return auraTensorRelu(x[0]); }
+static AuraValue opSigmoid(AuraValue* x) { return auraTensorSigmoid(x[0]); }
+static AuraValue opTanh(AuraValue* x) { return auraTensorTanh(x[0]); }
+static AuraValue opExp(AuraValue* x) { return auraTensorExp(x[0]); }
+
+/** Naive triple-loop matrix product accumulated in double precision. */
+static AuraValue naiveMatmul(AuraValue a, AuraValue b) {
+    AuraTensor* ta = AURA_AS_TENSOR(a);
+    AuraTensor* tb = AURA_AS_TENSOR(b);
+    AuraValue v = createTENSOR((int)ta->rows, (int)tb->cols);
+    AuraTensor* out = AURA_AS_TENSOR(v);
+    for (size_t i = 0; i < ta->rows; i++) {
+        for (size_t j = 0; j < tb->cols; j++) {
+            double sum = 0.0;
+            for (size_t p = 0; p < ta->cols; p++) {
+                sum += (double)AURA_TENSOR_AT(ta, i, p) * AURA_TENSOR_AT(tb, p, j);
+            }
+            AURA_TENSOR_AT(out, i, j) = (float)sum;
+        }
+    }
+    return v;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Tests the scalar reference against direct computation.
+ */
+void test_scalar_reference(void) {
+    auraTensorSetSimdLevel(AURA_SIMD_SCALAR);
+    AuraValue a = randomTensor(3, 5, -4.0f, 4.0f);
+    AuraValue b = randomTensor(3, 5, 0.5f, 4.0f);
+
+    AuraValue sum = auraTensorAdd(a, b);
+    AuraValue quotient = auraTensorDiv(b, a);
+    AuraValue reversed = auraTensorSub(createNUMBER(1.0), a);
+    AuraValue relu = auraTensorRelu(a);
+    AuraValue sigmoid = auraTensorSigmoid(a);
+
+    AuraTensor* ta = AURA_AS_TENSOR(a);
+    AuraTensor* tb = AURA_AS_TENSOR(b);
+    for (size_t r = 0; r < 3; r++) {
+        for (size_t c = 0; c < 5; c++) {
+            float x = AURA_TENSOR_AT(ta, r, c), y = AURA_TENSOR_AT(tb, r, c);
+            TEST_ASSERT_EQUAL_FLOAT(x + y, AURA_TENSOR_AT(AURA_AS_TENSOR(sum), r, c));
+            TEST_ASSERT_EQUAL_FLOAT(y / x, AURA_TENSOR_AT(AURA_AS_TENSOR(quotient), r, c));
+            TEST_ASSERT_EQUAL_FLOAT(1.0f - x, AURA_TENSOR_AT(AURA_AS_TENSOR(reversed), r, c));
+            TEST_ASSERT_EQUAL_FLOAT(x > 0 ? x : 0, AURA_TENSOR_AT(AURA_AS_TENSOR(relu), r, c));
+            TEST_ASSERT_EQUAL_FLOAT(1.0f / (1.0f + expf(-x)), AURA_TENSOR_AT(AURA_AS_TENSOR(sigmoid), r, c));
+        }
+    }
+
+    freeValue(a); freeValue(b); freeValue(sum); freeValue(quotient);
+    freeValue(reversed); freeValue(relu); freeValue(sigmoid);
+}
+
+/**
+ * @brief Tests binary and fma kernels of every tier against the reference.
+ */
+void test_binary_kernels_match_reference(void) {
+    for (size_t s = 0; s < SHAPE_COUNT; s++) {
+        AuraValue x[3];
+        x[0] = randomTensor(SHAPES[s][0], SHAPES[s][1], -10.0f, 10.0f);
+        x[1] = randomTensor(SHAPES[s][0], SHAPES[s][1], 0.25f, 10.0f);
+        x[2] = randomTensor(SHAPES[s][0], SHAPES[s][1], -10.0f, 10.0f);
+
+        compareAllTiers(opAdd, x, 0.0f, 0.0f);
+        compareAllTiers(opSub, x, 0.0f, 0.0f);
+        compareAllTiers(opMul, x, 0.0f, 0.0f);
+        compareAllTiers(opDiv, x, 0.0f, 0.0f);
+        compareAllTiers(opSubScalar, x, 0.0f, 0.0f);
+        compareAllTiers(opScalarDiv, x, 0.0f, 0.0f);
+        // SSE2 rounds the product before the addition.
+        compareAllTiers(opFma, x, 1e-5f, 1e-6f);
+
+        for (int i = 0; i < 3; i++) freeValue(x[i]);
+    }
+}
+
+/**
+ * @brief Tests activation kernels of every tier against the reference.
+ */
+void test_activation_kernels_match_reference(void) {
+    for (size_t s = 0; s < SHAPE_COUNT; s++) {
+        AuraValue x[1];
+        x[0] = randomTensor(SHAPES[s][0], SHAPES[s][1], -20.0f, 20.0f);
+
+        compareAllTiers(opRelu, x, 0.0f, 0.0f);
+        compareAllTiers(opSigmoid, x, 1e-7f, 1e-6f);
+        compareAllTiers(opTanh, x, 1e-6f, 1e-6f);
+        compareAllTiers(opExp, x, 0.0f, 2e-6f);
+
+        freeValue(x[0]);
+    }
+}
+
+/**
+ * @brief Tests activation edge values on the selected tier.
+ */
+void test_activation_edge_values(void) {
+    AuraValue v = createTENSOR(1, 6);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    float inputs[6] = { 0.0f, -0.0f, 100.0f, -100.0f, 1e-3f, -1e-3f };
+    for (int i = 0; i < 6; i++) t->data[i] = inputs[i];
+
+    AuraValue e = auraTensorExp(v);
+    AuraValue th = auraTensorTanh(v);
+    AuraValue sg = auraTensorSigmoid(v);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, AURA_AS_TENSOR(e)->data[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-30f, 0.0f, AURA_AS_TENSOR(e)->data[3]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, AURA_AS_TENSOR(th)->data[2]);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, AURA_AS_TENSOR(th)->data[3]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, tanhf(1e-3f), AURA_AS_TENSOR(th)->data[4]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -tanhf(1e-3f), AURA_AS_TENSOR(th)->data[5]);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, AURA_AS_TENSOR(sg)->data[0]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, AURA_AS_TENSOR(sg)->data[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-30f, 0.0f, AURA_AS_TENSOR(sg)->data[3]);
+
+    freeValue(v); freeValue(e); freeValue(th); freeValue(sg);
+}
+
+/**
+ * @brief Tests GEMM on every tier against a naive product, on shapes that hit
+ * partial tiles, several KC slices and both skinny orientations.
+ */
+void test_matmul_matches_naive(void) {
+    static const int DIMS[][3] = {
+        {1, 1, 1}, {7, 13, 5}, {33, 17, 65}, {64, 64, 64}, {150, 300, 70},
+        {200, 1, 300}, {1, 200, 300}, {3, 257, 2}, {40, 520, 33}
+    };
+
+    for (size_t s = 0; s < sizeof(DIMS) / sizeof(DIMS[0]); s++) {
+        int m = DIMS[s][0], k = DIMS[s][1], n = DIMS[s][2];
+        AuraValue a = randomTensor(m, k, -1.0f, 1.0f);
+        AuraValue b = randomTensor(k, n, -1.0f, 1.0f);
+        AuraValue expected = naiveMatmul(a, b);
+        // Float accumulation error grows with the depth of the dot products.
+        float tolerance = 1e-6f * (float)k + 1e-6f;
+
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            AuraValue product = auraTensorMatmul(a, b);
+            assertTensorsClose(expected, product, tolerance, 0.0f);
+            freeValue(product);
+        }
+
+        freeValue(a); freeValue(b); freeValue(expected);
+    }
+}
+
+/**
+ * @brief Tests exact small products and the identity.
+ */
+void test_matmul_exact(void) {
+    AuraValue a = createTENSOR(2, 3);
+    AuraValue b = createTENSOR(3, 2);
+    float av[6] = { 1, 2, 3, 4, 5, 6 };
+    float bv[6] = { 7, 8, 9, 10, 11, 12 };
+    for (int i = 0; i < 6; i++) {
+        AURA_TENSOR_AT(AURA_AS_TENSOR(a), i / 3, i % 3) = av[i];
+        AURA_TENSOR_AT(AURA_AS_TENSOR(b), i / 2, i % 2) = bv[i];
+    }
+
+    AuraValue c = auraTensorMatmul(a, b);
+    AuraTensor* tc = AURA_AS_TENSOR(c);
+    TEST_ASSERT_EQUAL_size_t(2, tc->rows);
+    TEST_ASSERT_EQUAL_size_t(2, tc->cols);
+    TEST_ASSERT_EQUAL_FLOAT(58.0f, AURA_TENSOR_AT(tc, 0, 0));
+    TEST_ASSERT_EQUAL_FLOAT(64.0f, AURA_TENSOR_AT(tc, 0, 1));
+    TEST_ASSERT_EQUAL_FLOAT(139.0f, AURA_TENSOR_AT(tc, 1, 0));
+    TEST_ASSERT_EQUAL_FLOAT(154.0f, AURA_TENSOR_AT(tc, 1, 1));
+    for (size_t col = tc->cols; col < tc->stride; col++) TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_TENSOR_AT(tc, 0, col));
+
+    AuraValue identity = createTENSOR(3, 3);
+    for (int i = 0; i < 3; i++) AURA_TENSOR_AT(AURA_AS_TENSOR(identity), i, i) = 1.0f;
+    AuraValue same = auraTensorMatmul(a, identity);
+    assertTensorsClose(a, same, 0.0f, 0.0f);
+
+    freeValue(a); freeValue(b); freeValue(c); freeValue(identity); freeValue(same);
+}
+
+/**
+ * @brief Tests that transposes and slices share storage and index correctly.
+ */
+void test_views_share_storage(void) {
+    AuraValue m = randomTensor(5, 7, -1.0f, 1.0f);
+    AuraTensor* tm = AURA_AS_TENSOR(m);
+
+    AuraValue t = auraTensorTranspose(m);
+    AuraValue s = auraTensorSlice(m, 1, 4, 2, 7);
+    AuraValue st = auraTensorSlice(t, 3, 6, 0, 2);         // Slice of a view.
+    AuraTensor* tt = AURA_AS_TENSOR(t);
+    AuraTensor* ts = AURA_AS_TENSOR(s);
+    AuraTensor* tst = AURA_AS_TENSOR(st);
+
+    TEST_ASSERT_EQUAL_size_t(7, tt->rows);
+    TEST_ASSERT_EQUAL_size_t(5, tt->cols);
+    TEST_ASSERT_EQUAL_size_t(3, ts->rows);
+    TEST_ASSERT_EQUAL_size_t(5, ts->cols);
+    TEST_ASSERT_TRUE(tt->base == tm && ts->base == tm && tst->base == tm);
+    TEST_ASSERT_EQUAL_UINT32(4, tm->refs);
+
+    for (size_t r = 0; r < 5; r++) {
+        for (size_t c = 0; c < 7; c++) TEST_ASSERT_EQUAL_FLOAT(AURA_TENSOR_AT(tm, r, c), AURA_TENSOR_AT(tt, c, r));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(AURA_TENSOR_AT(tm, 2, 4), AURA_TENSOR_AT(ts, 1, 2));
+    TEST_ASSERT_EQUAL_FLOAT(AURA_TENSOR_AT(tm, 1, 4), AURA_TENSOR_AT(tst, 1, 1));
+
+    // Writes are visible through every alias.
+    AURA_TENSOR_AT(ts, 0, 0) = 42.0f;
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, AURA_TENSOR_AT(tm, 1, 2));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, AURA_TENSOR_AT(tt, 2, 1));
+
+    // Views keep the storage alive after the original value is released.
+    float kept = AURA_TENSOR_AT(tm, 1, 3);
+    freeValue(m);
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, AURA_TENSOR_AT(tt, 2, 1));
+    freeValue(t);
+    freeValue(s);
+    TEST_ASSERT_EQUAL_FLOAT(kept, AURA_TENSOR_AT(AURA_AS_TENSOR(st), 0, 1));
+    freeValue(st);
+}
+
+/**
+ * @brief Tests operations on views against the same operations on dense copies.
+ */
+void test_view_operations_match_dense(void) {
+    AuraValue m = randomTensor(40, 37, 0.5f, 2.0f);
+    AuraValue n = randomTensor(37, 40, 0.5f, 2.0f);
+    AuraValue t = auraTensorTranspose(n);                   // 40 x 37, strided rows.
+    AuraValue rows = auraTensorSlice(m, 2, 39, 0, 37);      // Contiguous rows, offset.
+    AuraValue cols = auraTensorSlice(n, 0, 37, 3, 40);      // Contiguous rows, narrower.
+
+    AuraValue dt = auraTensorContiguous(t);
+    AuraValue drows = auraTensorContiguous(rows);
+    AuraValue dcols = auraTensorContiguous(cols);
+    AuraTensor* tdt = AURA_AS_TENSOR(dt);
+    TEST_ASSERT_TRUE(tdt->base == NULL && AURA_TENSOR_ROWS_CONTIGUOUS(tdt));
+    for (size_t r = 0; r < 40; r++) {
+        for (size_t c = 0; c < 37; c++) {
+            TEST_ASSERT_EQUAL_FLOAT(AURA_TENSOR_AT(AURA_AS_TENSOR(n), c, r), AURA_TENSOR_AT(tdt, r, c));
+        }
+    }
+    // Dense tensors are returned as they are.
+    AuraValue same = auraTensorContiguous(m);
+    TEST_ASSERT_TRUE(AURA_AS_OBJ(same) == AURA_AS_OBJ(m));
+    freeValue(same);
+
+    AuraValue tcols = auraTensorTranspose(cols);
+    AuraValue dtcols = auraTensorContiguous(tcols);
+    AuraValue results[][2] = {
+        { auraTensorDiv(t, m), auraTensorDiv(dt, m) },
+        { auraTensorFma(rows, cols, tcols), auraTensorFma(drows, dcols, dtcols) },
+        { auraTensorSigmoid(t), auraTensorSigmoid(dt) },
+        { auraTensorSub(createINT(2), cols), auraTensorSub(createINT(2), dcols) },
+        { auraTensorMatmul(t, n), auraTensorMatmul(dt, n) },
+        { auraTensorMatmul(rows, tcols), auraTensorMatmul(drows, dtcols) },
+    };
+    for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+        assertTensorsClose(results[i][1], results[i][0], 0.0f, 0.0f);
+        freeValue(results[i][0]);
+        freeValue(results[i][1]);
+    }
+
+    freeValue(m); freeValue(n); freeValue(t); freeValue(rows); freeValue(cols);
+    freeValue(dt); freeValue(drows); freeValue(dcols); freeValue(tcols); freeValue(dtcols);
+}
+
+/**
+ * @brief Tests the layout of N-D tensors and of views along any axis.
+ */
+void test_nd_layout(void) {
+    int shape[] = { 2, 3, 5 };
+    AuraValue v = randomTensorND(3, shape, -1.0f, 1.0f);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    TEST_ASSERT_EQUAL_UINT8(3, t->ndim);
+    TEST_ASSERT_EQUAL_size_t(6, t->rows);
+    TEST_ASSERT_EQUAL_size_t(5, t->cols);
+    TEST_ASSERT_EQUAL_size_t(AURA_TENSOR_ROW_FLOATS, t->stride);
+    TEST_ASSERT_TRUE(t->uniformRows);
+    TEST_ASSERT_EQUAL_size_t(3 * AURA_TENSOR_ROW_FLOATS, t->strides[0]);
+    for (size_t r = 0; r < t->rows; r++) {
+        TEST_ASSERT_EQUAL_PTR(AURA_TENSOR_ROW(t, r), auraTensorRowPointer(t, r));
+    }
+
+    // Slicing a middle axis leaves a gap between batches: rows are no longer uniform.
+    AuraValue mid = auraTensorSliceAxis(v, 1, 1, 3);
+    AuraTensor* tm = AURA_AS_TENSOR(mid);
+    TEST_ASSERT_EQUAL_size_t(4, tm->rows);
+    TEST_ASSERT_FALSE(tm->uniformRows);
+    size_t index[] = { 1, 0, 4 };
+    size_t source[] = { 1, 1, 4 };
+    TEST_ASSERT_EQUAL_FLOAT(elementAt(t, source), elementAt(tm, index));
+    TEST_ASSERT_EQUAL_FLOAT(elementAt(t, source), auraTensorRowPointer(tm, 2)[4]);
+
+    // A batch slice keeps whole matrices, so rows stay uniform.
+    AuraValue batch = auraTensorSliceAxis(v, 0, 1, 2);
+    TEST_ASSERT_TRUE(AURA_AS_TENSOR(batch)->uniformRows);
+    TEST_ASSERT_EQUAL_size_t(3, AURA_AS_TENSOR(batch)->rows);
+
+    AuraValue t2 = auraTensorTranspose(v);
+    AuraTensor* tt = AURA_AS_TENSOR(t2);
+    TEST_ASSERT_EQUAL_size_t(5, tt->shape[1]);
+    TEST_ASSERT_EQUAL_size_t(3, tt->shape[2]);
+    size_t swapped[] = { 1, 4, 1 };
+    TEST_ASSERT_EQUAL_FLOAT(elementAt(t, source), elementAt(tt, swapped));
+
+    AuraValue dense = auraTensorContiguous(mid);
+    TEST_ASSERT_EQUAL_FLOAT(elementAt(t, source), elementAt(AURA_AS_TENSOR(dense), index));
+
+    AuraValue rejected = auraTensorSliceAxis(v, 3, 0, 1);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorSliceAxis(v, 2, 4, 6);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(mid); freeValue(batch); freeValue(t2); freeValue(dense); freeValue(v);
+}
+
+/**
+ * @brief Tests broadcasting against an explicit loop over the output index.
+ */
+void test_broadcasting_matches_loop(void) {
+    int full[] = { 2, 3, 5 }, bias[] = { 5 }, column[] = { 3, 1 }, perBatch[] = { 2, 1, 1 };
+    AuraValue a = randomTensorND(3, full, -1.0f, 1.0f);
+    AuraValue b = randomTensorND(1, bias, -1.0f, 1.0f);
+    AuraValue c = randomTensorND(2, column, 0.5f, 1.0f);
+    AuraValue d = randomTensorND(3, perBatch, -1.0f, 1.0f);
+    AuraValue mid = auraTensorSliceAxis(a, 1, 0, 1);       // [2, 1, 5] view.
+
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        auraTensorSetSimdLevel((AuraSimdLevel)level);
+        AuraValue sum = auraTensorAdd(a, b);
+        AuraValue quotient = auraTensorDiv(c, a);
+        AuraValue fused = auraTensorFma(c, d, b);           // [2, 3, 5] from three smaller shapes.
+        AuraValue outer = auraTensorMul(mid, c);            // [2, 3, 5] from a view.
+
+        size_t index[3];
+        for (index[0] = 0; index[0] < 2; index[0]++) {
+            for (index[1] = 0; index[1] < 3; index[1]++) {
+                for (index[2] = 0; index[2] < 5; index[2]++) {
+                    float va = elementAt(AURA_AS_TENSOR(a), index);
+                    float vb = AURA_AS_TENSOR(b)->data[index[2]];
+                    float vc = AURA_AS_TENSOR(c)->data[index[1] * AURA_AS_TENSOR(c)->strides[0]];
+                    float vd = AURA_AS_TENSOR(d)->data[index[0] * AURA_AS_TENSOR(d)->strides[0]];
+                    size_t top[] = { index[0], 0, index[2] };
+                    float vm = elementAt(AURA_AS_TENSOR(a), top);
+                    TEST_ASSERT_FLOAT_WITHIN(1e-6f, va + vb, elementAt(AURA_AS_TENSOR(sum), index));
+                    TEST_ASSERT_FLOAT_WITHIN(1e-5f * fabsf(vc / va), vc / va, elementAt(AURA_AS_TENSOR(quotient), index));
+                    TEST_ASSERT_FLOAT_WITHIN(1e-6f, vc * vd + vb, elementAt(AURA_AS_TENSOR(fused), index));
+                    TEST_ASSERT_FLOAT_WITHIN(1e-6f, vm * vc, elementAt(AURA_AS_TENSOR(outer), index));
+                }
+            }
+        }
+        for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_size_t(AURA_AS_TENSOR(a)->shape[i], AURA_AS_TENSOR(fused)->shape[i]);
+        freeValue(sum); freeValue(quotient); freeValue(fused); freeValue(outer);
+    }
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+
+    freeValue(a); freeValue(b); freeValue(c); freeValue(d); freeValue(mid);
+}
+
+/**
+ * @brief Tests that out-of-range slices are rejected.
+ */
+void test_invalid_views(void) {
+    AuraValue m = createTENSOR(3, 4);
+    AuraValue rejected = auraTensorSlice(m, 0, 4, 0, 4);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorSlice(m, 2, 2, 0, 4);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorSlice(m, 0, 3, 3, 5);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorTranspose(createNUMBER(1));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_TENSOR(m)->refs);
+    freeValue(m);
+}
+
+/** Counts how often each index is visited. */
+static void countIndices(void* context, size_t begin, size_t end) {
+    int* visits = (int*)context;
+    for (size_t i = begin; i < end; i++) visits[i]++;
+}
+
+/**
+ * Counts visits only if a nested loop (which must run inline without
+ * deadlocking) also covers its own range exactly once.
+ */
+static void countIndicesNested(void* context, size_t begin, size_t end) {
+    int inner[4] = { 0 };
+    auraParallelFor(4, 1, countIndices, inner);
+    if (inner[0] == 1 && inner[1] == 1 && inner[2] == 1 && inner[3] == 1) countIndices(context, begin, end);
+}
+
+/**
+ * @brief Tests that parallel loops cover their range exactly once.
+ */
+void test_parallel_for_covers_range(void) {
+    TEST_ASSERT_EQUAL_size_t(4, auraThreadPoolSetSize(4));
+    TEST_ASSERT_EQUAL_size_t(4, auraThreadPoolSize());
+
+    static const size_t COUNTS[] = { 1, 2, 3, 7, 64, 999 };
+    for (size_t s = 0; s < sizeof(COUNTS) / sizeof(COUNTS[0]); s++) {
+        for (size_t grain = 1; grain <= 8; grain *= 2) {
+            int visits[1000] = { 0 };
+            auraParallelFor(COUNTS[s], grain, countIndicesNested, visits);
+            for (size_t i = 0; i < COUNTS[s]; i++) TEST_ASSERT_EQUAL_INT(1, visits[i]);
+            for (size_t i = COUNTS[s]; i < 1000; i++) TEST_ASSERT_EQUAL_INT(0, visits[i]);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_size_t(1, auraThreadPoolSetSize(1));
+}
+
+/**
+ * @brief Tests that multithreaded operations give the same bits as one thread.
+ */
+void test_parallel_ops_match_serial(void) {
+    AuraValue a = randomTensor(300, 700, -1.0f, 1.0f);      // Padded rows.
+    AuraValue b = randomTensor(300, 700, 0.5f, 1.0f);
+    AuraValue flat = randomTensor(1000, 512, -1.0f, 1.0f);   // Single run.
+    AuraValue left = randomTensor(130, 90, -1.0f, 1.0f);
+    AuraValue right = randomTensor(90, 70, -1.0f, 1.0f);
+    AuraValue tall = randomTensor(2000, 90, -1.0f, 1.0f);
+
+    auraThreadPoolSetSize(1);
+    AuraValue serial[5] = {
+        auraTensorDiv(a, b), auraTensorFma(a, b, a), auraTensorTanh(flat),
+        auraTensorMatmul(left, right), auraTensorMatmul(tall, right)
+    };
+
+    auraThreadPoolSetSize(3);
+    AuraValue parallel[5] = {
+        auraTensorDiv(a, b), auraTensorFma(a, b, a), auraTensorTanh(flat),
+        auraTensorMatmul(left, right), auraTensorMatmul(tall, right)
+    };
+
+    for (int i = 0; i < 5; i++) {
+        assertTensorsClose(serial[i], parallel[i], 0.0f, 0.0f);
+        freeValue(serial[i]);
+        freeValue(parallel[i]);
+    }
+    freeValue(a); freeValue(b); freeValue(flat);
+    freeValue(left); freeValue(right); freeValue(tall);
+}
+
+/**
+ * @brief Tests fused expressions against the same chain of eager operations.
+ */
+void test_fused_expression_matches_eager(void) {
+    int full[] = { 2, 30, 37 }, bias[] = { 37 }, column[] = { 30, 1 };
+    AuraValue small = randomTensor(40, 37, -1.0f, 1.0f);
+    AuraValue n = randomTensor(37, 40, -1.0f, 1.0f);
+    AuraValue t = auraTensorTranspose(n);                   // Strided rows.
+    AuraValue big = randomTensor(1000, 512, -1.0f, 1.0f);   // Flat, spans many blocks.
+    AuraValue nd = randomTensorND(3, full, -1.0f, 1.0f);
+    AuraValue b = randomTensorND(1, bias, -1.0f, 1.0f);
+    AuraValue col = randomTensorND(2, column, 0.5f, 1.0f);
+
+    // (relu(a * y + b) * 0.5 - tanh(a)) / (a * a + col), with `a` shared.
+    AuraValue cases[][3] = { { small, t, b }, { big, big, createNUMBER(0.25) }, { nd, col, b } };
+    auraThreadPoolSetSize(3);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        AuraValue a = cases[i][0], y = cases[i][1], z = cases[i][2];
+        AuraValue denominatorBias = i == 2 ? col : createINT(2);
+
+        AuraTensorExpr* expr = auraTensorExprCreate();
+        AuraExprNode xa = auraTensorExprInput(expr, a);
+        AuraExprNode fma = auraTensorExprFma(expr, xa, auraTensorExprInput(expr, y), auraTensorExprInput(expr, z));
+        AuraExprNode left = auraTensorExprBinary(expr, AURA_TENSOR_SUB,
+            auraTensorExprBinary(expr, AURA_TENSOR_MUL, auraTensorExprUnary(expr, AURA_TENSOR_RELU, fma),
+                                 auraTensorExprInput(expr, createNUMBER(0.5))),
+            auraTensorExprUnary(expr, AURA_TENSOR_TANH, xa));
+        AuraExprNode right = auraTensorExprBinary(expr, AURA_TENSOR_ADD,
+            auraTensorExprBinary(expr, AURA_TENSOR_MUL, xa, xa), auraTensorExprInput(expr, denominatorBias));
+        AuraExprNode root = auraTensorExprBinary(expr, AURA_TENSOR_DIV, left, right);
+        TEST_ASSERT_TRUE(root >= 0);
+
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            AuraValue steps[9];
+            steps[7] = auraTensorMul(a, y);
+            steps[0] = AURA_IS_TENSOR(z) ? auraTensorFma(a, y, z) : auraTensorAdd(steps[7], z);
+            steps[1] = auraTensorRelu(steps[0]);
+            steps[2] = auraTensorMul(steps[1], createNUMBER(0.5));
+            steps[8] = auraTensorTanh(a);
+            steps[3] = auraTensorSub(steps[2], steps[8]);
+            steps[4] = auraTensorMul(a, a);
+            steps[5] = auraTensorAdd(steps[4], denominatorBias);
+            steps[6] = auraTensorDiv(steps[3], steps[5]);
+
+            AuraValue fused = auraTensorExprEvaluate(expr, root);
+            if (AURA_IS_TENSOR(z)) {
+                assertTensorsClose(steps[6], fused, 0.0f, 0.0f);
+            } else {
+                // The eager chain rounds a * y before adding; the fused FMA does not.
+                assertTensorsClose(steps[6], fused, 1e-5f, 1e-5f);
+            }
+            for (int k = 0; k < 9; k++) freeValue(steps[k]);
+            freeValue(fused);
+        }
+        auraTensorExprFree(expr);
+    }
+    auraTensorSetSimdLevel(auraCpuSimdLevel());
+
+    // Expressions keep their inputs alive and see updates made before evaluation.
+    AuraTensorExpr* expr = auraTensorExprCreate();
+    AuraExprNode doubled = auraTensorExprBinary(expr, AURA_TENSOR_MUL, auraTensorExprInput(expr, small),
+                                                auraTensorExprInput(expr, createINT(2)));
+    TEST_ASSERT_EQUAL_UINT32(2, AURA_AS_TENSOR(small)->refs);
+    AURA_TENSOR_AT(AURA_AS_TENSOR(small), 3, 4) = 21.0f;
+    AuraValue result = auraTensorExprEvaluate(expr, doubled);
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, AURA_TENSOR_AT(AURA_AS_TENSOR(result), 3, 4));
+    auraTensorExprFree(expr);
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_TENSOR(small)->refs);
+
+    freeValue(result); freeValue(small); freeValue(n); freeValue(t); freeValue(big);
+    freeValue(nd); freeValue(b); freeValue(col);
+}
+
+/**
+ * @brief Tests that invalid expressions are rejected and errors propagate.
+ */
+void test_invalid_expressions(void) {
+    AuraValue a = createTENSOR(2, 3);
+    AuraValue b = createTENSOR(3, 2);
+    AuraValue s = createSTRING("text");
+    AuraTensorExpr* expr = auraTensorExprCreate();
+
+    AuraExprNode xa = auraTensorExprInput(expr, a);
+    AuraExprNode xb = auraTensorExprInput(expr, b);
+    AuraExprNode two = auraTensorExprInput(expr, createINT(2));
+    TEST_ASSERT_TRUE(auraTensorExprInput(expr, s) < 0);
+    AuraExprNode bad = auraTensorExprBinary(expr, AURA_TENSOR_ADD, xa, xb);
+    TEST_ASSERT_TRUE(bad < 0);
+    TEST_ASSERT_TRUE(auraTensorExprUnary(expr, AURA_TENSOR_EXP, bad) < 0);
+    TEST_ASSERT_TRUE(auraTensorExprFma(expr, xa, xa, 99) < 0);
+    AuraValue rejected = auraTensorExprEvaluate(expr, bad);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorExprEvaluate(expr, 99);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorExprEvaluate(expr, auraTensorExprBinary(expr, AURA_TENSOR_MUL, two, two));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorExprEvaluate(NULL, 0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    auraTensorExprFree(expr);
+    auraTensorExprFree(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, AURA_AS_TENSOR(a)->refs);
+    freeValue(a); freeValue(b); freeValue(s);
+}
+
+/**
+ * @brief Tests that tensors written to a file load back, zero-copy and read-only.
+ */
+void test_tensor_file_round_trip(void) {
+    const char* path = "test_tensor_file.bin";
+    int shape3[] = { 3, 4, 21 }, shape1[] = { 5 };
+    AuraValue m = randomTensor(7, 37, -1.0f, 1.0f);
+    AuraValue n = randomTensor(5, 9, -1.0f, 1.0f);
+    AuraValue t = auraTensorTranspose(n);
+    AuraValue nd = randomTensorND(3, shape3, -1.0f, 1.0f);
+    AuraValue v = randomTensorND(1, shape1, -1.0f, 1.0f);
+    const char* names[] = { "weights", "transposed", "batch", "bias" };
+    AuraValue tensors[] = { m, t, nd, v };
+    TEST_ASSERT_TRUE(auraTensorFileWrite(path, names, tensors, 4));
+
+    AuraTensorFile* file = auraTensorFileOpen(path);
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL_size_t(4, auraTensorFileCount(file));
+    TEST_ASSERT_EQUAL_STRING("batch", auraTensorFileName(file, 2));
+    TEST_ASSERT_NULL(auraTensorFileName(file, 4));
+
+    AuraValue loaded[4];
+    for (int i = 0; i < 4; i++) {
+        loaded[i] = auraTensorFileLoad(file, names[i]);
+        TEST_ASSERT_TRUE(AURA_IS_TENSOR(loaded[i]));
+        AuraTensor* lt = AURA_AS_TENSOR(loaded[i]);
+        TEST_ASSERT_TRUE(lt->readOnly);
+        TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)lt->data % AURA_TENSOR_ALIGNMENT);
+        TEST_ASSERT_EQUAL_INT(AURA_AS_TENSOR(tensors[i])->ndim, lt->ndim);
+    }
+    AuraValue rejected = auraTensorFileLoad(file, "missing");
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    // Loaded tensors keep the mapping alive after the file is closed.
+    auraTensorFileClose(file);
+
+    AuraValue dt = auraTensorContiguous(t);
+    assertTensorsClose(m, loaded[0], 0.0f, 0.0f);
+    assertTensorsClose(dt, loaded[1], 0.0f, 0.0f);
+    assertTensorsClose(nd, loaded[2], 0.0f, 0.0f);
+    assertTensorsClose(v, loaded[3], 0.0f, 0.0f);
+    for (int d = 0; d < 3; d++) TEST_ASSERT_EQUAL_size_t((size_t)shape3[d], AURA_AS_TENSOR(loaded[2])->shape[d]);
+
+    // Operations and views work on mapped tensors; views inherit read-only
+    // and keep the mapping alive on their own.
+    AuraValue view = auraTensorTranspose(loaded[0]);
+    TEST_ASSERT_TRUE(AURA_AS_TENSOR(view)->readOnly);
+    freeValue(loaded[0]);
+    AuraValue tm = auraTensorTranspose(m);
+    AuraValue results[][2] = {
+        { auraTensorMatmul(tm, m), auraTensorMatmul(view, m) },
+        { auraTensorMatmul(dt, n), auraTensorMatmul(loaded[1], n) },
+        { auraTensorSigmoid(nd), auraTensorSigmoid(loaded[2]) },
+    };
+    for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+        assertTensorsClose(results[i][0], results[i][1], 0.0f, 0.0f);
+        TEST_ASSERT_FALSE(AURA_AS_TENSOR(results[i][1])->readOnly);
+        freeValue(results[i][0]);
+        freeValue(results[i][1]);
+    }
+    rejected = auraTensorAdd(loaded[2], loaded[3]);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));   // 21 vs 5.
+
+    freeValue(tm); freeValue(view);
+    for (int i = 1; i < 4; i++) freeValue(loaded[i]);
+    freeValue(m); freeValue(n); freeValue(t); freeValue(nd); freeValue(v); freeValue(dt);
+    remove(path);
+}
+
+/**
+ * @brief Tests that bad arguments and malformed files are rejected.
+ */
+void test_invalid_tensor_files(void) {
+    const char* path = "test_tensor_file.bin";
+    AuraValue a = createTENSOR(2, 3);
+    AuraValue tensors[] = { a, a };
+    const char* duplicate[] = { "a", "a" };
+    const char* empty[] = { "" };
+    const char* longName[] = { "0123456789012345678901234567890123456789012345678901234567890123" };
+    const char* valid[] = { "a" };
+    AuraValue text = createSTRING("text");
+
+    TEST_ASSERT_FALSE(auraTensorFileWrite(path, duplicate, tensors, 2));
+    TEST_ASSERT_FALSE(auraTensorFileWrite(path, empty, tensors, 1));
+    TEST_ASSERT_FALSE(auraTensorFileWrite(path, longName, tensors, 1));
+    TEST_ASSERT_FALSE(auraTensorFileWrite(path, valid, &text, 1));
+    TEST_ASSERT_FALSE(auraTensorFileWrite("no_such_dir/x.bin", valid, tensors, 1));
+    TEST_ASSERT_NULL(auraTensorFileOpen("no_such_file.bin"));
+
+    // Read a valid file, then replay it damaged in various ways.
+    TEST_ASSERT_TRUE(auraTensorFileWrite(path, valid, tensors, 1));
+    FILE* in = fopen(path, "rb");
+    unsigned char bytes[512];
+    size_t size = fread(bytes, 1, sizeof(bytes), in);
+    fclose(in);
+    TEST_ASSERT_TRUE(size > 256 && size < sizeof(bytes));
+
+    struct { size_t offset; unsigned char value; size_t length; } damage[] = {
+        { 0, 'X', size },       // Magic.
+        { 8, 2, size },         // Version.
+        { 16, 9, size },        // Count larger than the directory.
+        { 64, 0, size },        // Empty name.
+        { 128, 9, size },       // Unknown dtype.
+        { 132, 9, size },       // Rank above AURA_TENSOR_MAX_DIMS.
+        { 136, 0, size },       // Zero dimension.
+        { 200, 8, size },       // Misaligned payload offset.
+        { 0, 'A', size - 64 },  // Truncated.
+    };
+    for (size_t i = 0; i < sizeof(damage) / sizeof(damage[0]); i++) {
+        unsigned char copy[512];
+        memcpy(copy, bytes, size);
+        copy[damage[i].offset] = damage[i].value;
+        FILE* out = fopen(path, "wb");
+        fwrite(copy, 1, damage[i].length, out);
+        fclose(out);
+        TEST_ASSERT_NULL(auraTensorFileOpen(path));
+    }
+
+    remove(path);
+    freeValue(a); freeValue(text);
+}
+
+/** Converts `t` to `dtype` and back to float32. */
+static AuraValue roundTrip(AuraValue t, AuraDType dtype) {
+    AuraValue reduced = auraTensorConvert(t, dtype);
+    AuraValue back = auraTensorConvert(reduced, AURA_DTYPE_F32);
+    freeValue(reduced);
+    return back;
+}
+
+/**
+ * @brief Tests the rounding of the dtype conversions and that every tier
+ * produces the same bits.
+ */
+void test_dtype_conversions(void) {
+    static const float special[] = {
+        0.0f, -0.0f, 1.0f, 1.0f / 3.0f, 65504.0f, 65519.0f, 65520.0f, 4e-8f, 6.1e-5f, -2.5e-6f,
+        INFINITY, -INFINITY, NAN, 3.0e38f, 1.0009765625f, 1.00048828125f
+    };
+    size_t count = sizeof(special) / sizeof(special[0]);
+    AuraValue v = createTENSOR(1, (int)count);
+    for (size_t i = 0; i < count; i++) AURA_TENSOR_AT(AURA_AS_TENSOR(v), 0, i) = special[i];
+
+    auraTensorSetSimdLevel(AURA_SIMD_SCALAR);
+    AuraValue half = roundTrip(v, AURA_DTYPE_F16);
+    AuraValue brain = roundTrip(v, AURA_DTYPE_BF16);
+    AuraTensor* h = AURA_AS_TENSOR(half);
+    AuraTensor* b = AURA_AS_TENSOR(brain);
+    TEST_ASSERT_EQUAL_FLOAT(65504.0f, AURA_TENSOR_AT(h, 0, 4));
+    TEST_ASSERT_EQUAL_FLOAT(65504.0f, AURA_TENSOR_AT(h, 0, 5));
+    TEST_ASSERT_TRUE(isinf(AURA_TENSOR_AT(h, 0, 6)));               // Ties to even: infinity.
+    TEST_ASSERT_EQUAL_FLOAT(5.9604645e-8f, AURA_TENSOR_AT(h, 0, 7)); // Nearest subnormal.
+    TEST_ASSERT_TRUE(isnan(AURA_TENSOR_AT(h, 0, 12)) && isnan(AURA_TENSOR_AT(b, 0, 12)));
+    TEST_ASSERT_TRUE(isinf(AURA_TENSOR_AT(h, 0, 13)));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, AURA_TENSOR_AT(h, 0, 15));         // Tie, rounded to the even 1.0.
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, AURA_TENSOR_AT(b, 0, 14));         // Below half an ulp of bfloat16.
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 3.0f / 1024.0f, 1.0f / 3.0f, AURA_TENSOR_AT(h, 0, 3));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 3.0f / 128.0f, 1.0f / 3.0f, AURA_TENSOR_AT(b, 0, 3));
+    TEST_ASSERT_FLOAT_WITHIN(3.0e38f / 128.0f, 3.0e38f, AURA_TENSOR_AT(b, 0, 13));
+
+    AuraValue m = randomTensor(9, 100, -4.0f, 4.0f);
+    AuraValue t = auraTensorTranspose(m);
+    AuraValue inputs[] = { v, m, t };
+    for (int dtype = AURA_DTYPE_F16; dtype < AURA_DTYPE_COUNT; dtype++) {
+        for (size_t i = 0; i < 3; i++) {
+            auraTensorSetSimdLevel(AURA_SIMD_SCALAR);
+            AuraValue reference = roundTrip(inputs[i], (AuraDType)dtype);
+            for (int level = AURA_SIMD_SSE2; level <= (int)auraCpuMaxSimdLevel(); level++) {
+                auraTensorSetSimdLevel((AuraSimdLevel)level);
+                AuraValue result = roundTrip(inputs[i], (AuraDType)dtype);
+                AuraTensor* e = AURA_AS_TENSOR(reference);
+                AuraTensor* a = AURA_AS_TENSOR(result);
+                for (size_t r = 0; r < e->rows; r++) {
+                    TEST_ASSERT_EQUAL_MEMORY(AURA_TENSOR_ROW(e, r), AURA_TENSOR_ROW(a, r), e->stride * sizeof(float));
+                }
+                freeValue(result);
+            }
+            freeValue(reference);
+        }
+    }
+
+    // Int8 keeps every element within half a quantization step of its row.
+    AuraValue q = auraTensorConvert(m, AURA_DTYPE_I8);
+    AuraValue dq = auraTensorConvert(q, AURA_DTYPE_F32);
+    AuraTensor* tq = AURA_AS_TENSOR(q);
+    TEST_ASSERT_EQUAL_INT(AURA_DTYPE_I8, tq->dtype);
+    TEST_ASSERT_EQUAL_size_t(128, tq->stride);
+    for (size_t r = 0; r < tq->rows; r++) {
+        float max = 0.0f;
+        for (size_t c = 0; c < tq->cols; c++) max = fmaxf(max, fabsf(AURA_TENSOR_AT(AURA_AS_TENSOR(m), r, c)));
+        TEST_ASSERT_EQUAL_FLOAT(max / 127.0f, tq->scales[r]);
+        for (size_t c = 0; c < tq->cols; c++) {
+            TEST_ASSERT_FLOAT_WITHIN(tq->scales[r] * 0.5001f, AURA_TENSOR_AT(AURA_AS_TENSOR(m), r, c),
+                                     AURA_TENSOR_AT(AURA_AS_TENSOR(dq), r, c));
+        }
+    }
+
+    auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+    freeValue(v); freeValue(half); freeValue(brain); freeValue(m); freeValue(t); freeValue(q); freeValue(dq);
+}
+
+/**
+ * @brief Tests the reduced-precision products against float32 products of
+ * the same (rounded) values, on every tier.
+ */
+void test_reduced_precision_matmul(void) {
+    // m, k, n: the fourth size spans several cache blocks of `w`; the last two
+    // have rows larger than a block (f16/bf16 past 65536, int8 past 131072).
+    static const int sizes[][3] = {
+        { 5, 100, 9 }, { 3, 64, 2 }, { 17, 300, 33 }, { 4, 256, 600 }, { 2, 70000, 3 }, { 2, 131100, 3 }
+    };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        AuraValue a = randomTensor(sizes[s][0], sizes[s][1], -1.0f, 1.0f);
+        AuraValue w = randomTensor(sizes[s][2], sizes[s][1], -1.0f, 1.0f);
+
+        // Float32 a x w^T agrees exactly with the explicit transpose.
+        AuraValue wt = auraTensorTranspose(w);
+        AuraValue direct = auraTensorMatmul(a, wt);
+        AuraValue transposed = auraTensorMatmulTransposed(a, w);
+        assertTensorsClose(direct, transposed, 0.0f, 0.0f);
+        freeValue(direct); freeValue(transposed); freeValue(wt);
+
+        for (int dtype = AURA_DTYPE_F16; dtype < AURA_DTYPE_COUNT; dtype++) {
+            AuraValue rw = auraTensorConvert(w, (AuraDType)dtype);
+            AuraValue ra = auraTensorConvert(a, (AuraDType)dtype);
+            AuraValue fa = auraTensorConvert(ra, AURA_DTYPE_F32);
+            AuraValue fw = auraTensorConvert(rw, AURA_DTYPE_F32);
+            AuraValue expected = auraTensorMatmulTransposed(fa, fw);
+            float tolerance = 1e-5f * (float)sizes[s][1];
+
+            for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+                auraTensorSetSimdLevel((AuraSimdLevel)level);
+                AuraValue both = auraTensorMatmulTransposed(ra, rw);
+                AuraValue mixed = auraTensorMatmulTransposed(a, rw);   // Converts `a` on the fly.
+                assertTensorsClose(expected, both, tolerance, 1e-5f);
+                assertTensorsClose(both, mixed, 0.0f, 0.0f);
+                freeValue(both); freeValue(mixed);
+            }
+            auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+            freeValue(rw); freeValue(ra); freeValue(fa); freeValue(fw); freeValue(expected);
+        }
+        freeValue(a); freeValue(w);
+    }
+}
+
+/**
+ * @brief Tests that reduced-precision tensors are stored compactly, survive
+ * a file round trip and are rejected by the float32 operations.
+ */
+void test_reduced_precision_storage(void) {
+    const char* path = "test_tensor_file.bin";
+    int shape[] = { 3, 4, 40 };
+    AuraValue x = randomTensorND(3, shape, -2.0f, 2.0f);
+    AuraValue half = auraTensorConvert(x, AURA_DTYPE_F16);
+    AuraValue brain = auraTensorConvert(x, AURA_DTYPE_BF16);
+    AuraValue q = auraTensorConvert(x, AURA_DTYPE_I8);
+    TEST_ASSERT_EQUAL_size_t(64, AURA_AS_TENSOR(half)->stride);
+    TEST_ASSERT_EQUAL_size_t(64, AURA_AS_TENSOR(q)->stride);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)AURA_AS_TENSOR(q)->scales % sizeof(float));
+    AuraValue same = auraTensorConvert(half, AURA_DTYPE_F16);
+    TEST_ASSERT_TRUE(AURA_AS_OBJ(same) == AURA_AS_OBJ(half));
+    freeValue(same);
+
+    const char* names[] = { "half", "brain", "quantized" };
+    AuraValue tensors[] = { half, brain, q };
+    TEST_ASSERT_TRUE(auraTensorFileWrite(path, names, tensors, 3));
+    AuraTensorFile* file = auraTensorFileOpen(path);
+    TEST_ASSERT_NOT_NULL(file);
+    for (int i = 0; i < 3; i++) {
+        AuraValue loaded = auraTensorFileLoad(file, names[i]);
+        TEST_ASSERT_EQUAL_INT(AURA_AS_TENSOR(tensors[i])->dtype, AURA_AS_TENSOR(loaded)->dtype);
+        AuraValue expected = auraTensorConvert(tensors[i], AURA_DTYPE_F32);
+        AuraValue actual = auraTensorConvert(loaded, AURA_DTYPE_F32);
+        assertTensorsClose(expected, actual, 0.0f, 0.0f);
+        freeValue(expected); freeValue(actual); freeValue(loaded);
+    }
+    auraTensorFileClose(file);
+    remove(path);
+
+    AuraValue rejected = auraTensorAdd(brain, brain);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMul(x, q);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorRelu(half);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorTranspose(q);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorSlice(brain, 0, 1, 0, 1);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorConvert(x, AURA_DTYPE_COUNT);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = createTENSORNDTyped(AURA_DTYPE_COUNT, 3, shape);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    AuraValue m = randomTensor(2, 40, -1.0f, 1.0f);
+    AuraValue qm = auraTensorConvert(m, AURA_DTYPE_I8);
+    AuraValue bm = auraTensorConvert(m, AURA_DTYPE_BF16);
+    rejected = auraTensorMatmul(qm, qm);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmulTransposed(qm, bm);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    freeValue(m); freeValue(qm); freeValue(bm);
+    freeValue(x); freeValue(half); freeValue(brain); freeValue(q);
+}
+
+/**
+ * @brief Tests that invalid operands are rejected.
+ */
+/**
+ * Reduces, in double precision, the elements of `t` that agree with `index`
+ * outside `axis` (every element for AURA_TENSOR_ALL_AXES). `magnitude`
+ * receives the scale of the rounding error: the sum of their absolute values
+ * for sums, 0 for the exact MAX and ARGMAX.
+ */
+static double reduceLoop(const AuraTensor* t, AuraTensorReduceOp op, int axis, size_t* index, double* magnitude) {
+    size_t count = 1;
+    for (int d = 0; d < t->ndim; d++) count *= t->shape[d];
+    if (axis != AURA_TENSOR_ALL_AXES) count = t->shape[axis];
+
+    double sum = 0.0, squares = 0.0, best = -INFINITY;
+    size_t at = 0;
+    *magnitude = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        if (axis == AURA_TENSOR_ALL_AXES) {
+            size_t rest = i;
+            for (int d = t->ndim - 1; d >= 0; d--) {
+                index[d] = rest % t->shape[d];
+                rest /= t->shape[d];
+            }
+        } else {
+            index[axis] = i;
+        }
+        double x = elementAt(t, index);
+        sum += x;
+        squares += x * x;
+        *magnitude += fabs(x);
+        if (x > best) {
+            best = x;
+            at = i;
+        }
+    }
+
+    switch (op) {
+    case AURA_TENSOR_MEAN: *magnitude /= (double)count; return sum / (double)count;
+    case AURA_TENSOR_MAX: *magnitude = 0.0; return best;
+    case AURA_TENSOR_ARGMAX: *magnitude = 0.0; return (double)at;
+    case AURA_TENSOR_NORM: *magnitude = sqrt(squares); return sqrt(squares);
+    default: return sum;
+    }
+}
+
+/**
+ * Checks one reduction of `v` element by element against reduceLoop.
+ */
+static void checkReduction(AuraValue v, AuraTensorReduceOp op, int axis) {
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    AuraValue result = auraTensorReduce(op, v, axis);
+    size_t index[AURA_TENSOR_MAX_DIMS] = { 0 };
+    double magnitude;
+
+    if (axis == AURA_TENSOR_ALL_AXES || t->ndim == 1) {
+        TEST_ASSERT_TRUE(AURA_IS_NUMBER(result));
+        double want = reduceLoop(t, op, AURA_TENSOR_ALL_AXES, index, &magnitude);
+        TEST_ASSERT_DOUBLE_WITHIN(4e-6 * magnitude, want, AURA_AS_NUMBER(result));
+        return;
+    }
+
+    TEST_ASSERT_TRUE(AURA_IS_TENSOR(result));
+    AuraTensor* r = AURA_AS_TENSOR(result);
+    TEST_ASSERT_EQUAL_INT(t->ndim - 1, r->ndim);
+    size_t outputs = r->rows * r->cols;
+    size_t outIndex[AURA_TENSOR_MAX_DIMS];
+    for (size_t o = 0; o < outputs; o++) {
+        size_t rest = o;
+        for (int d = r->ndim - 1; d >= 0; d--) {
+            outIndex[d] = rest % r->shape[d];
+            rest /= r->shape[d];
+        }
+        for (int d = 0, s = 0; d < t->ndim; d++) {
+            if (d != axis) index[d] = outIndex[s++];
+        }
+        double want = reduceLoop(t, op, axis, index, &magnitude);
+        TEST_ASSERT_DOUBLE_WITHIN(4e-6 * magnitude, want, elementAt(r, outIndex));
+    }
+    freeValue(result);
+}
+
+/**
+ * @brief Tests every reduction along every axis, on every tier, against a
+ *        double-precision loop, for dense, flat, transposed and sliced inputs.
+ */
+void test_reductions_match_loop(void) {
+    int shape[] = { 3, 37, 50 }, flatShape[] = { 1100, 64 }, vectorShape[] = { 1000 };
+    AuraValue cube = randomTensorND(3, shape, -1.0f, 2.0f);
+    AuraValue inputs[] = {
+        cube,
+        auraTensorTranspose(cube),
+        auraTensorSliceAxis(cube, 1, 5, 30),
+        randomTensorND(2, flatShape, -1.0f, 2.0f),
+        randomTensorND(1, vectorShape, -1.0f, 2.0f)
+    };
+    size_t count = sizeof(inputs) / sizeof(inputs[0]);
+
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        auraTensorSetSimdLevel((AuraSimdLevel)level);
+        for (size_t i = 0; i < count; i++) {
+            int ndim = AURA_AS_TENSOR(inputs[i])->ndim;
+            for (int op = 0; op < AURA_TENSOR_REDUCE_OP_COUNT; op++) {
+                for (int axis = AURA_TENSOR_ALL_AXES; axis < ndim; axis++) {
+                    checkReduction(inputs[i], (AuraTensorReduceOp)op, axis);
+                }
+            }
+        }
+    }
+    auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+    for (size_t i = 0; i < count; i++) freeValue(inputs[i]);
+}
+
+/**
+ * @brief Tests the accuracy of long sums, the handling of NaNs, independence
+ *        from the thread count and invalid arguments.
+ */
+void test_reduction_properties(void) {
+    // Three million 0.1f: a running float sum drifts by thousands here.
+    int length[] = { 3000000 };
+    AuraValue tenths = createTENSORND(1, length);
+    AuraTensor* t = AURA_AS_TENSOR(tenths);
+    for (size_t i = 0; i < t->cols; i++) t->data[i] = 0.1f;
+    double exact = 3000000.0 * (double)0.1f;
+    for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+        auraTensorSetSimdLevel((AuraSimdLevel)level);
+        TEST_ASSERT_DOUBLE_WITHIN(exact * 1e-6, exact, AURA_AS_NUMBER(auraTensorSum(tenths, AURA_TENSOR_ALL_AXES)));
+    }
+    auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+
+    AuraValue m = randomTensor(3, 40, -1.0f, 1.0f);
+    AURA_TENSOR_AT(AURA_AS_TENSOR(m), 1, 7) = NAN;
+    AURA_TENSOR_AT(AURA_AS_TENSOR(m), 2, 33) = 5.0f;
+    AURA_TENSOR_AT(AURA_AS_TENSOR(m), 0, 33) = 5.0f;
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, AURA_AS_NUMBER(auraTensorMax(m, AURA_TENSOR_ALL_AXES)));
+    TEST_ASSERT_EQUAL_DOUBLE(33.0, AURA_AS_NUMBER(auraTensorArgmax(m, AURA_TENSOR_ALL_AXES)));   // First of the ties.
+    TEST_ASSERT_TRUE(isnan(AURA_AS_NUMBER(auraTensorSum(m, AURA_TENSOR_ALL_AXES))));
+    AuraValue columns = auraTensorArgmax(m, 0);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_AS_TENSOR(columns)->data[33]);
+    freeValue(columns);
+
+    AuraValue big = randomTensor(700, 300, -1.0f, 1.0f);
+    auraThreadPoolSetSize(1);
+    double serialSum = AURA_AS_NUMBER(auraTensorSum(tenths, AURA_TENSOR_ALL_AXES));
+    AuraValue serialRows = auraTensorNorm(big, 1);
+    AuraValue serialColumns = auraTensorMean(big, 0);
+    auraThreadPoolSetSize(3);
+    TEST_ASSERT_EQUAL_DOUBLE(serialSum, AURA_AS_NUMBER(auraTensorSum(tenths, AURA_TENSOR_ALL_AXES)));
+    AuraValue parallelRows = auraTensorNorm(big, 1);
+    AuraValue parallelColumns = auraTensorMean(big, 0);
+    assertTensorsClose(serialRows, parallelRows, 0.0f, 0.0f);
+    assertTensorsClose(serialColumns, parallelColumns, 0.0f, 0.0f);
+
+    AuraValue rejected = auraTensorSum(m, 2);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorSum(m, -2);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorReduce(AURA_TENSOR_REDUCE_OP_COUNT, m, 0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMax(createNUMBER(1), 0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    AuraValue half = auraTensorConvert(m, AURA_DTYPE_F16);
+    rejected = auraTensorMean(half, 0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(serialRows); freeValue(parallelRows);
+    freeValue(serialColumns); freeValue(parallelColumns);
+    freeValue(tenths); freeValue(m); freeValue(big); freeValue(half);
+}
+
+/** A rows x cols tensor where about one element in `every` is non-zero. */
+static AuraValue sparseRandomTensor(int rows, int cols, int every) {
+    AuraValue v = createTENSOR(rows, cols);
+    AuraTensor* t = AURA_AS_TENSOR(v);
+    for (size_t r = 0; r < t->rows; r++) {
+        for (size_t c = 0; c < t->cols; c++) {
+            float x = randomFloat(-1.0f, 1.0f);
+            if (randomFloat(0.0f, (float)every) < 1.0f) AURA_TENSOR_AT(t, r, c) = x;
+        }
+    }
+    return v;
+}
+
+/**
+ * @brief Tests sparse construction and products against the dense operations,
+ *        on every tier, with and without the CSC form.
+ */
+void test_sparse_matches_dense(void) {
+    AuraValue dense = sparseRandomTensor(70, 130, 20);
+    AuraValue transposed = auraTensorTranspose(dense);
+    AuraValue sources[] = { dense, transposed };
+
+    for (size_t i = 0; i < 2; i++) {
+        AuraTensor* t = AURA_AS_TENSOR(sources[i]);
+        AuraValue s = auraSparseFromDense(sources[i]);
+        TEST_ASSERT_TRUE(AURA_IS_SPARSE(s));
+        size_t nonzeros = 0;
+        for (size_t r = 0; r < t->rows; r++) {
+            for (size_t c = 0; c < t->cols; c++) nonzeros += AURA_TENSOR_AT(t, r, c) != 0.0f;
+        }
+        TEST_ASSERT_EQUAL_size_t(nonzeros, AURA_AS_SPARSE(s)->nnz);
+        AuraValue back = auraSparseToDense(s);
+        AuraValue copy = auraTensorContiguous(sources[i]);
+        assertTensorsClose(copy, back, 0.0f, 0.0f);
+
+        int vectorShape[] = { (int)t->cols };
+        AuraValue v = randomTensorND(1, vectorShape, -1.0f, 1.0f);
+        AuraValue asColumn = createTENSOR((int)t->cols, 1);
+        for (size_t c = 0; c < t->cols; c++) AURA_TENSOR_AT(AURA_AS_TENSOR(asColumn), c, 0) = AURA_AS_TENSOR(v)->data[c];
+        AuraValue b = randomTensor((int)t->cols, 37, -1.0f, 1.0f);
+        AuraValue a = randomTensor(9, (int)t->rows, -1.0f, 1.0f);
+        AuraValue expectedVector = auraTensorMatmul(sources[i], asColumn);
+        AuraValue expectedRight = auraTensorMatmul(sources[i], b);
+        AuraValue expectedLeft = auraTensorMatmul(a, sources[i]);
+
+        for (int csc = 0; csc < 2; csc++) {
+            if (csc) TEST_ASSERT_TRUE(auraSparseBuildCsc(s));
+            for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+                auraTensorSetSimdLevel((AuraSimdLevel)level);
+                AuraValue y = auraSparseMatvec(s, v);
+                AuraTensor* yt = AURA_AS_TENSOR(y);
+                TEST_ASSERT_EQUAL_INT(1, yt->ndim);
+                for (size_t r = 0; r < t->rows; r++) {
+                    TEST_ASSERT_FLOAT_WITHIN(1e-5f, AURA_TENSOR_AT(AURA_AS_TENSOR(expectedVector), r, 0), yt->data[r]);
+                }
+                AuraValue right = auraSparseMatmul(s, b);
+                AuraValue left = auraTensorMatmulSparse(a, s);
+                assertTensorsClose(expectedRight, right, 1e-5f, 1e-5f);
+                assertTensorsClose(expectedLeft, left, 1e-5f, 1e-5f);
+                freeValue(y); freeValue(right); freeValue(left);
+            }
+        }
+        auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+
+        freeValue(s); freeValue(back); freeValue(copy); freeValue(v); freeValue(asColumn);
+        freeValue(a); freeValue(b);
+        freeValue(expectedVector); freeValue(expectedRight); freeValue(expectedLeft);
+    }
+
+    // Triplets in any order, with a duplicate that is summed.
+    static const uint32_t rows[] = { 2, 0, 2, 1, 2 };
+    static const uint32_t cols[] = { 3, 1, 0, 1, 3 };
+    static const float values[] = { 1.5f, -2.0f, 4.0f, 3.0f, 0.25f };
+    AuraValue s = auraSparseFromTriplets(3, 4, rows, cols, values, 5);
+    AuraSparseTensor* sparse = AURA_AS_SPARSE(s);
+    TEST_ASSERT_EQUAL_size_t(4, sparse->nnz);
+    static const size_t rowStart[] = { 0, 1, 2, 4 };
+    static const uint32_t colIndex[] = { 1, 1, 0, 3 };
+    static const float sorted[] = { -2.0f, 3.0f, 4.0f, 1.75f };
+    TEST_ASSERT_EQUAL_MEMORY(rowStart, sparse->rowStart, sizeof(rowStart));
+    TEST_ASSERT_EQUAL_MEMORY(colIndex, sparse->colIndex, sizeof(colIndex));
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(sorted, sparse->values, 4);
+    TEST_ASSERT_TRUE(auraSparseBuildCsc(s));
+    static const size_t colStart[] = { 0, 1, 3, 3, 4 };
+    static const uint32_t rowIndex[] = { 2, 0, 1, 2 };
+    TEST_ASSERT_EQUAL_MEMORY(colStart, sparse->colStart, sizeof(colStart));
+    TEST_ASSERT_EQUAL_MEMORY(rowIndex, sparse->rowIndex, sizeof(rowIndex));
+    freeValue(s);
+
+    freeValue(dense);
+    freeValue(transposed);
+}
+
+/**
+ * @brief Tests that malformed sparse operands are rejected.
+ */
+void test_invalid_sparse(void) {
+    AuraValue dense = sparseRandomTensor(4, 6, 3);
+    AuraValue s = auraSparseFromDense(dense);
+    int wrongShape[] = { 5 }, batched[] = { 2, 4, 6 };
+    AuraValue wrong = createTENSORND(1, wrongShape);
+    AuraValue nd = createTENSORND(3, batched);
+    static const uint32_t index[] = { 0, 9 };
+    static const float values[] = { 1.0f, 2.0f };
+
+    AuraValue rejected = auraSparseFromDense(nd);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseFromDense(s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseFromTriplets(4, 6, index, index, values, 2);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseFromTriplets(0, 6, index, index, values, 0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseToDense(dense);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    TEST_ASSERT_FALSE(auraSparseBuildCsc(dense));
+    rejected = auraSparseMatvec(s, wrong);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseMatvec(s, dense);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseMatmul(s, dense);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraSparseMatmul(dense, dense);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmulSparse(dense, s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmulSparse(s, s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(dense); freeValue(s); freeValue(wrong); freeValue(nd);
+}
+
+/** Compares a Vec3 array element with expected components computed in double. */
+static void assertVec3Close(double x, double y, double z, const AuraVec3Array* array, size_t i) {
+    double tol = 1e-5 * (1.0 + fabs(x) + fabs(y) + fabs(z));
+    TEST_ASSERT_DOUBLE_WITHIN(tol, x, array->x[i]);
+    TEST_ASSERT_DOUBLE_WITHIN(tol, y, array->y[i]);
+    TEST_ASSERT_DOUBLE_WITHIN(tol, z, array->z[i]);
+}
+
+/**
+ * @brief Tests every batched Vec3 array operation against a per-element loop
+ *        on every SIMD tier, with array and broadcast Vec3 operands, for
+ *        lengths covering vector tails, kernel blocks and thread pool chunks.
+ */
+void test_vec3_array_matches_loop(void) {
+    static const size_t lengths[] = { 1, 5, 16, 37, 1000, 40000 };
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t n = lengths[l];
+        AuraValue a = auraVec3ArrayCreate(n);
+        AuraValue b = auraVec3ArrayCreate(n);
+        AuraVec3Array* va = AURA_AS_VEC3_ARRAY(a);
+        AuraVec3Array* vb = AURA_AS_VEC3_ARRAY(b);
+        for (size_t i = 0; i < n; i++) {
+            va->x[i] = randomFloat(-4.0f, 4.0f); va->y[i] = randomFloat(-4.0f, 4.0f); va->z[i] = randomFloat(-4.0f, 4.0f);
+            vb->x[i] = randomFloat(-4.0f, 4.0f); vb->y[i] = randomFloat(-4.0f, 4.0f); vb->z[i] = randomFloat(-4.0f, 4.0f);
+        }
+        va->x[n / 2] = va->y[n / 2] = va->z[n / 2] = 0.0f;   // Normalizing a zero vector keeps it zero.
+        AuraValue constant = createVEC3(0.5f, -9.81f, 2.0f);
+
+        for (int level = AURA_SIMD_SCALAR; level <= (int)auraCpuMaxSimdLevel(); level++) {
+            auraTensorSetSimdLevel((AuraSimdLevel)level);
+            for (int broadcast = 0; broadcast < 2; broadcast++) {
+                AuraValue other = broadcast ? constant : b;
+                AuraValue sum = auraVec3ArrayAdd(a, other);
+                AuraValue difference = auraVec3ArraySub(a, other);
+                AuraValue dot = auraVec3ArrayDot(a, other);
+                AuraValue cross = auraVec3ArrayCross(a, other);
+                TEST_ASSERT_TRUE(AURA_IS_VEC3_ARRAY(sum));
+                TEST_ASSERT_EQUAL_size_t(n, AURA_AS_TENSOR(dot)->cols);
+                for (size_t i = 0; i < n; i++) {
+                    double ax = va->x[i], ay = va->y[i], az = va->z[i];
+                    double bx = broadcast ? 0.5 : vb->x[i];
+                    double by = broadcast ? (double)-9.81f : vb->y[i];
+                    double bz = broadcast ? 2.0 : vb->z[i];
+                    assertVec3Close(ax + bx, ay + by, az + bz, AURA_AS_VEC3_ARRAY(sum), i);
+                    assertVec3Close(ax - bx, ay - by, az - bz, AURA_AS_VEC3_ARRAY(difference), i);
+                    assertVec3Close(ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx, AURA_AS_VEC3_ARRAY(cross), i);
+                    TEST_ASSERT_DOUBLE_WITHIN(1e-4, ax * bx + ay * by + az * bz, AURA_AS_TENSOR(dot)->data[i]);
+                }
+                freeValue(sum); freeValue(difference); freeValue(dot); freeValue(cross);
+            }
+
+            AuraValue scaled = auraVec3ArrayScale(a, -0.25f);
+            AuraValue length = auraVec3ArrayLength(a);
+            AuraValue unit = auraVec3ArrayNormalize(a);
+            for (size_t i = 0; i < n; i++) {
+                double ax = va->x[i], ay = va->y[i], az = va->z[i];
+                double norm = sqrt(ax * ax + ay * ay + az * az);
+                assertVec3Close(ax * -0.25, ay * -0.25, az * -0.25, AURA_AS_VEC3_ARRAY(scaled), i);
+                TEST_ASSERT_DOUBLE_WITHIN(1e-5 * (1.0 + norm), norm, AURA_AS_TENSOR(length)->data[i]);
+                if (norm == 0.0) assertVec3Close(0.0, 0.0, 0.0, AURA_AS_VEC3_ARRAY(unit), i);
+                else assertVec3Close(ax / norm, ay / norm, az / norm, AURA_AS_VEC3_ARRAY(unit), i);
+            }
+            freeValue(scaled); freeValue(length); freeValue(unit);
+        }
+        auraTensorSetSimdLevel(AURA_SIMD_AVX512);
+
+        // Component padding stays zero; tensors convert both ways.
+        for (size_t i = n; i < va->capacity; i++) TEST_ASSERT_EQUAL_FLOAT(0.0f, va->x[i]);
+        TEST_ASSERT_EQUAL_size_t(0, (uintptr_t)va->z % AURA_TENSOR_ALIGNMENT);
+        AuraValue asTensor = auraVec3ArrayToTensor(a);
+        AuraValue back = auraVec3ArrayFromTensor(asTensor);
+        TEST_ASSERT_EQUAL_FLOAT_ARRAY(va->x, AURA_AS_VEC3_ARRAY(back)->x, n);
+        TEST_ASSERT_EQUAL_FLOAT_ARRAY(va->y, AURA_AS_VEC3_ARRAY(back)->y, n);
+        TEST_ASSERT_EQUAL_FLOAT_ARRAY(va->z, AURA_AS_VEC3_ARRAY(back)->z, n);
+
+        TEST_ASSERT_TRUE(auraVec3ArraySet(a, n - 1, constant));
+        AuraValue last = auraVec3ArrayGet(a, n - 1);
+        TEST_ASSERT_TRUE(auraValuesEqual(constant, last));
+
+        freeValue(a); freeValue(b); freeValue(constant); freeValue(asTensor); freeValue(back); freeValue(last);
+    }
+}
+
+/**
+ * @brief Tests that malformed Vec3 array operands are rejected.
+ */
+void test_invalid_vec3_array(void) {
+    AuraValue a = auraVec3ArrayCreate(4);
+    AuraValue shorter = auraVec3ArrayCreate(3);
+    AuraValue matrix = createTENSOR(4, 2);
+    AuraValue vec = createVEC3(1.0f, 2.0f, 3.0f);
+
+    AuraValue rejected = auraVec3ArrayCreate(0);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayFromTensor(matrix);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayToTensor(matrix);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayGet(a, 4);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    TEST_ASSERT_FALSE(auraVec3ArraySet(a, 4, vec));
+    TEST_ASSERT_FALSE(auraVec3ArraySet(a, 0, matrix));
+    rejected = auraVec3ArrayAdd(a, shorter);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArraySub(a, matrix);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayDot(vec, a);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayCross(a, createNUMBER(1.0));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayScale(matrix, 2.0f);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayLength(vec);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3ArrayNormalize(matrix);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(a); freeValue(shorter); freeValue(matrix); freeValue(vec);
+}
+
+void test_invalid_operands(void) {
+    AuraValue a = createTENSOR(2, 3);
+    AuraValue b = createTENSOR(3, 2);
+    AuraValue s = createSTRING("text");
+
+    AuraValue rejected = auraTensorAdd(a, b);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMul(a, s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorAdd(createNUMBER(1), createNUMBER(2));
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorFma(a, a, b);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorRelu(s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmul(a, a);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmul(a, s);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    int batched[] = { 2, 2, 3 }, wrong[] = { 4, 1 };
+    AuraValue nd = createTENSORND(3, batched);
+    AuraValue w = createTENSORND(2, wrong);
+    rejected = auraTensorAdd(nd, w);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraTensorMatmul(nd, b);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = createTENSORND(0, batched);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = createTENSORND(AURA_TENSOR_MAX_DIMS + 1, batched);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(a); freeValue(b); freeValue(s); freeValue(nd); freeValue(w);
+}
+
+/**
+ * @brief Tests that the reported tier is consistent with the CPU features.
+ */
+void test_cpu_dispatch(void) {
+    const AuraCpuFeatures* features = auraCpuFeatures();
+    AuraSimdLevel max = auraCpuMaxSimdLevel();
+
+    if (max >= AURA_SIMD_AVX2) TEST_ASSERT_TRUE(features->avx2 && features->fma);
+    if (max >= AURA_SIMD_AVX512) TEST_ASSERT_TRUE(features->avx512f);
+    TEST_ASSERT_TRUE(auraCpuSimdLevel() <= max);
+    TEST_ASSERT_EQUAL_INT(AURA_SIMD_SCALAR, auraTensorSetSimdLevel(AURA_SIMD_SCALAR));
+    TEST_ASSERT_EQUAL_INT(max, auraTensorSetSimdLevel(AURA_SIMD_AVX512));
+    TEST_ASSERT_EQUAL_STRING("avx2", auraSimdLevelName(AURA_SIMD_AVX2));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scalar_reference);
+    RUN_TEST(test_binary_kernels_match_reference);
+    RUN_TEST(test_activation_kernels_match_reference);
+    RUN_TEST(test_activation_edge_values);
+    RUN_TEST(test_matmul_matches_naive);
+    RUN_TEST(test_matmul_exact);
+    RUN_TEST(test_views_share_storage);
+    RUN_TEST(test_view_operations_match_dense);
+    RUN_TEST(test_nd_layout);
+    RUN_TEST(test_broadcasting_matches_loop);
+    RUN_TEST(test_invalid_views);
+    RUN_TEST(test_parallel_for_covers_range);
+    RUN_TEST(test_parallel_ops_match_serial);
+    RUN_TEST(test_fused_expression_matches_eager);
+    RUN_TEST(test_invalid_expressions);
+    RUN_TEST(test_tensor_file_round_trip);
+    RUN_TEST(test_invalid_tensor_files);
+    RUN_TEST(test_dtype_conversions);
+    RUN_TEST(test_reduced_precision_matmul);
+    RUN_TEST(test_reduced_precision_storage);
+    RUN_TEST(test_reductions_match_loop);
+    RUN_TEST(test_reduction_properties);
+    RUN_TEST(test_sparse_matches_dense);
+    RUN_TEST(test_invalid_sparse);
+    RUN_TEST(test_vec3_array_matches_loop);
+    RUN_TEST(test_invalid_vec3_array);
+    RUN_TEST(test_invalid_operands);
+    RUN_TEST(test_cpu_dispatch);
+
+    return UNITY_END();
+}
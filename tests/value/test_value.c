@@ -0,0 +1,310 @@
+#include "../../tests/unity/unity.h"
+#include "value.h"
+#include "aura_string.h"
+#include "vec3.h"
+#include <math.h>
+
+/**
+ * @file test_value.c
+ * @brief Unit tests for the Aura value representation.
+ *
+ * This suite is compiled twice by the Makefile: once with NaN-boxing (the
+ * default) and once with `-DAURA_NO_NAN_BOXING`, so every assertion here must
+ * hold for both physical layouts.
+ */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Verifies the size guarantee of the active representation.
+ */
+void test_value_size(void) {
+#ifdef AURA_NAN_BOXING
+    TEST_ASSERT_EQUAL_size_t(8, sizeof(AuraValue));
+#else
+    TEST_ASSERT_TRUE(sizeof(AuraValue) >= 16);
+#endif
+}
+
+/**
+ * @brief Tests the singleton and boolean values.
+ */
+void test_immediates(void) {
+    TEST_ASSERT_EQUAL_INT(AURA_UNDEFINED, auraTypeOf(createUNDEFINED()));
+    TEST_ASSERT_EQUAL_INT(AURA_NULL, auraTypeOf(createNULL()));
+
+    AuraValue t = createBOOLEAN(42);
+    AuraValue f = createBOOLEAN(0);
+    TEST_ASSERT_EQUAL_INT(AURA_BOOLEAN, auraTypeOf(t));
+    TEST_ASSERT_EQUAL_INT(1, AURA_AS_BOOL(t));
+    TEST_ASSERT_EQUAL_INT(0, AURA_AS_BOOL(f));
+    TEST_ASSERT_FALSE(AURA_IS_NUMBER(t));
+    TEST_ASSERT_FALSE(AURA_IS_OBJ(createNULL()));
+}
+
+/**
+ * @brief Tests that doubles round-trip unchanged, including the special values.
+ */
+void test_numbers_round_trip(void) {
+    double samples[] = { 0.0, -0.0, 1.5, -2.25, 1e308, -1e-308, 1.0 / 0.0, -1.0 / 0.0 };
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        AuraValue v = createNUMBER(samples[i]);
+        TEST_ASSERT_TRUE(AURA_IS_NUMBER(v));
+        TEST_ASSERT_EQUAL_INT(AURA_NUMBER, auraTypeOf(v));
+        TEST_ASSERT_EQUAL_MEMORY(&samples[i], &(double){ AURA_AS_NUMBER(v) }, sizeof(double));
+    }
+}
+
+/**
+ * @brief Tests that any NaN (including the negative hardware default NaN) stays a number.
+ */
+void test_nan_is_canonicalized(void) {
+    union { uint64_t bits; double d; } negative_nan = { 0xfff8000000000000ULL };
+    AuraValue v = createNUMBER(negative_nan.d);
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(v));
+    TEST_ASSERT_TRUE(AURA_AS_NUMBER(v) != AURA_AS_NUMBER(v));
+    TEST_ASSERT_EQUAL_INT(AURA_NUMBER, auraTypeOf(v));
+}
+
+/**
+ * @brief Tests the small integer payload encoding.
+ */
+void test_int_payload(void) {
+    AuraValue a = AURA_INT_VAL(-123456);
+    AuraValue b = AURA_INT_VAL(INT32_MAX);
+    TEST_ASSERT_TRUE(AURA_IS_INT(a));
+    TEST_ASSERT_EQUAL_INT32(-123456, AURA_AS_INT(a));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, AURA_AS_INT(b));
+    TEST_ASSERT_EQUAL_INT(AURA_NUMBER, auraTypeOf(a));
+}
+
+/**
+ * @brief Tests that tensor payloads and rows are cache-line aligned and padded with zeros.
+ */
+void test_tensor_alignment(void) {
+    int shapes[][2] = { {1, 1}, {3, 4}, {5, 16}, {7, 17}, {33, 100}, {2, 1000} };
+
+    for (size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        AuraValue v = createTENSOR(shapes[i][0], shapes[i][1]);
+        AuraTensor* t = AURA_AS_TENSOR(v);
+
+        TEST_ASSERT_EQUAL_UINT(0, t->stride % AURA_TENSOR_ROW_FLOATS);
+        TEST_ASSERT_TRUE(t->stride >= t->cols && t->stride < t->cols + AURA_TENSOR_ROW_FLOATS);
+        // The payload lives inside the tensor's own allocation, right after the header.
+        TEST_ASSERT_TRUE((char*)t->data >= (char*)(t + 1));
+        TEST_ASSERT_TRUE((char*)t->data < (char*)(t + 1) + AURA_TENSOR_ALIGNMENT);
+
+        for (size_t r = 0; r < t->rows; r++) {
+            TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)AURA_TENSOR_ROW(t, r) % AURA_TENSOR_ALIGNMENT);
+            for (size_t c = 0; c < t->stride; c++) {
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, AURA_TENSOR_AT(t, r, c));
+            }
+        }
+        AURA_TENSOR_AT(t, t->rows - 1, t->cols - 1) = 1.0f;
+        freeValue(v);
+    }
+}
+
+/**
+ * @brief Tests heap-backed values: strings, tensors, boxed BigInts and Vec3s.
+ */
+void test_heap_values(void) {
+    AuraValue s = createSTRING("hello");
+    TEST_ASSERT_TRUE(AURA_IS_STRING(s));
+    TEST_ASSERT_EQUAL_STRING("hello", AURA_AS_CSTRING(s));
+    freeValue(s);
+
+    AuraValue t = createTENSOR(3, 4);
+    TEST_ASSERT_TRUE(AURA_IS_TENSOR(t));
+    TEST_ASSERT_EQUAL_size_t(3, AURA_AS_TENSOR(t)->rows);
+    TEST_ASSERT_EQUAL_size_t(4, AURA_AS_TENSOR(t)->cols);
+    freeValue(t);
+
+    AuraValue big = createBIGINT(1234567890123456789LL);
+    TEST_ASSERT_EQUAL_INT(AURA_BIGINT, auraTypeOf(big));
+    TEST_ASSERT_EQUAL_INT64(1234567890123456789LL, auraAsBigInt(big));
+    freeValue(big);
+
+    AuraValue vec = createVEC3(1.0f, -2.0f, 3.5f);
+    AuraVec3 raw = auraAsVec3(vec);
+    TEST_ASSERT_EQUAL_INT(AURA_VEC3, auraTypeOf(vec));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, raw.x);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0f, raw.y);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, raw.z);
+    freeValue(vec);
+}
+
+/** Asserts that `v` is a Vec3 with the given components and a zero pad lane, then frees it. */
+static void assertVec3(float x, float y, float z, AuraValue v) {
+    TEST_ASSERT_TRUE(AURA_IS_VEC3(v));
+    AuraVec3 vec = auraAsVec3(v);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, x, vec.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, y, vec.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, z, vec.z);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, vec.w);
+    freeValue(v);
+}
+
+/**
+ * @brief Tests the native Vec3 operations through the value API.
+ */
+void test_vec3_operations(void) {
+    TEST_ASSERT_EQUAL_size_t(16, sizeof(AuraVec3));
+    AuraValue a = createVEC3(1.0f, -2.0f, 3.0f);
+    AuraValue b = createVEC3(4.0f, 0.5f, -1.0f);
+    AuraValue zero = createVEC3(0.0f, 0.0f, 0.0f);
+
+    assertVec3(5.0f, -1.5f, 2.0f, auraVec3Add(a, b));
+    assertVec3(-3.0f, -2.5f, 4.0f, auraVec3Sub(a, b));
+    assertVec3(2.0f, -4.0f, 6.0f, auraVec3Scale(a, 2.0f));
+    assertVec3(0.5f, 13.0f, 8.5f, auraVec3Cross(a, b));
+    assertVec3(-0.5f, -13.0f, -8.5f, auraVec3Cross(b, a));
+    assertVec3(1.0f / sqrtf(14.0f), -2.0f / sqrtf(14.0f), 3.0f / sqrtf(14.0f), auraVec3Normalize(a));
+    assertVec3(0.0f, 0.0f, 0.0f, auraVec3Normalize(zero));
+    assertVec3(2.5f, -0.75f, 1.0f, auraVec3Lerp(a, b, 0.5f));
+    assertVec3(1.0f, -2.0f, 3.0f, auraVec3Lerp(a, b, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, (float)AURA_AS_NUMBER(auraVec3Dot(a, b)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 14.0f, (float)AURA_AS_NUMBER(auraVec3Dot(a, a)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, sqrtf(14.0f), (float)AURA_AS_NUMBER(auraVec3Length(a)));
+
+    // Infinite scales must not turn the pad lane into NaN (which would poison dot products).
+    AuraValue huge = auraVec3Scale(a, INFINITY);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, auraAsVec3(huge).w);
+    freeValue(huge);
+
+    AuraValue number = createNUMBER(1.0);
+    AuraValue rejected = auraVec3Add(a, number);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3Dot(number, b);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3Normalize(number);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = auraVec3Lerp(a, createNULL(), 0.5f);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+
+    freeValue(a); freeValue(b); freeValue(zero);
+}
+
+/**
+ * @brief Tests that integer arithmetic stays in the small-int representation.
+ */
+void test_int_arithmetic_fast_path(void) {
+    AuraValue sum = auraNumberAdd(createINT(40), createINT(2));
+    AuraValue diff = auraNumberSub(createINT(-5), createINT(10));
+    AuraValue prod = auraNumberMul(createINT(-300), createINT(7));
+
+    TEST_ASSERT_TRUE(AURA_IS_INT(sum));
+    TEST_ASSERT_EQUAL_INT32(42, AURA_AS_INT(sum));
+    TEST_ASSERT_TRUE(AURA_IS_INT(diff));
+    TEST_ASSERT_EQUAL_INT32(-15, AURA_AS_INT(diff));
+    TEST_ASSERT_TRUE(AURA_IS_INT(prod));
+    TEST_ASSERT_EQUAL_INT32(-2100, AURA_AS_INT(prod));
+}
+
+/**
+ * @brief Tests that overflowing integer results are promoted to doubles exactly.
+ */
+void test_int_overflow_promotes(void) {
+    AuraValue sum = auraNumberAdd(createINT(INT32_MAX), createINT(1));
+    AuraValue diff = auraNumberSub(createINT(INT32_MIN), createINT(1));
+    AuraValue prod = auraNumberMul(createINT(65536), createINT(65536));
+
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(sum));
+    TEST_ASSERT_EQUAL_DOUBLE(2147483648.0, AURA_AS_NUMBER(sum));
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(diff));
+    TEST_ASSERT_EQUAL_DOUBLE(-2147483649.0, AURA_AS_NUMBER(diff));
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(prod));
+    TEST_ASSERT_EQUAL_DOUBLE(4294967296.0, AURA_AS_NUMBER(prod));
+}
+
+/**
+ * @brief Tests that 0 * negative produces -0 (a double), as in JS.
+ */
+void test_int_negative_zero(void) {
+    AuraValue prod = auraNumberMul(createINT(0), createINT(-5));
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(prod));
+    TEST_ASSERT_TRUE(signbit(AURA_AS_NUMBER(prod)));
+}
+
+/**
+ * @brief Tests mixed int/double arithmetic and comparisons.
+ */
+void test_mixed_numbers(void) {
+    AuraValue sum = auraNumberAdd(createINT(1), createNUMBER(0.5));
+    TEST_ASSERT_TRUE(AURA_IS_NUMBER(sum));
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, AURA_AS_NUMBER(sum));
+
+    TEST_ASSERT_TRUE(auraNumbersEqual(createINT(3), createNUMBER(3.0)));
+    TEST_ASSERT_TRUE(auraValuesEqual(createNUMBER(3.0), createINT(3)));
+    TEST_ASSERT_FALSE(auraNumbersEqual(createNUMBER(0.0 / 0.0), createNUMBER(0.0 / 0.0)));
+
+    TEST_ASSERT_TRUE(auraNumberLess(createINT(-1), createINT(0)));
+    TEST_ASSERT_TRUE(auraNumberLess(createINT(2), createNUMBER(2.5)));
+    TEST_ASSERT_TRUE(auraNumberLessEqual(createINT(2), createNUMBER(2.0)));
+    TEST_ASSERT_FALSE(auraNumberLess(createNUMBER(0.0 / 0.0), createINT(1)));
+}
+
+/**
+ * @brief Tests the JS ToInt32 conversion used by bitwise operators.
+ */
+void test_to_int32(void) {
+    TEST_ASSERT_EQUAL_INT32(7, auraToInt32(createINT(7)));
+    TEST_ASSERT_EQUAL_INT32(-3, auraToInt32(createNUMBER(-3.9)));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, auraToInt32(createNUMBER(2147483648.0)));
+    TEST_ASSERT_EQUAL_INT32(1, auraToInt32(createNUMBER(4294967297.0)));
+    TEST_ASSERT_EQUAL_INT32(0, auraToInt32(createNUMBER(1.0 / 0.0)));
+}
+
+/**
+ * @brief Tests strict equality across value kinds.
+ */
+void test_values_equal(void) {
+    AuraValue a = createSTRING("same");
+    AuraValue b = createSTRING("same");
+    TEST_ASSERT_TRUE(auraValuesEqual(a, b));
+    TEST_ASSERT_FALSE(auraValuesEqual(a, createNULL()));
+    TEST_ASSERT_TRUE(auraValuesEqual(createNULL(), createNULL()));
+    TEST_ASSERT_FALSE(auraValuesEqual(createNULL(), createUNDEFINED()));
+    freeValue(a);
+    freeValue(b);
+}
+
+/**
+ * @brief Tests that invalid inputs degrade to null instead of crashing.
+ */
+void test_invalid_inputs(void) {
+    AuraValue rejected = createSTRING(NULL);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = createTENSOR(0, 4);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+    rejected = createTENSOR(-1, 4);
+    TEST_ASSERT_TRUE(AURA_IS_NULL(rejected));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_value_size);
+    RUN_TEST(test_immediates);
+    RUN_TEST(test_numbers_round_trip);
+    RUN_TEST(test_nan_is_canonicalized);
+    RUN_TEST(test_int_payload);
+    RUN_TEST(test_heap_values);
+    RUN_TEST(test_tensor_alignment);
+    RUN_TEST(test_vec3_operations);
+    RUN_TEST(test_int_arithmetic_fast_path);
+    RUN_TEST(test_int_overflow_promotes);
+    RUN_TEST(test_int_negative_zero);
+    RUN_TEST(test_mixed_numbers);
+    RUN_TEST(test_to_int32);
+    RUN_TEST(test_values_equal);
+    RUN_TEST(test_invalid_inputs);
+
+    return UNITY_END();
+}